@@ -50,6 +50,11 @@ void Pipeline::BuildPipeline(const Options& options) {
                     TAU_LOG_WARNING("H264 depacketization failed, frame size: " << frame.size() << ", losses: " << losses);
                 }
             });
+            _frame_processor.SetChunkCallback([this](rtp::Frame&& chunk, bool) {
+                if(!_h264_depacketizer.ProcessChunk(std::move(chunk))) {
+                    TAU_LOG_WARNING("H264 depacketization failed, frame chunk");
+                }
+            });
             _h264_depacketizer.SetCallback([this](Buffer&& nalu) {
                 WriteNaluToFile(std::move(nalu));
             });
@@ -64,6 +69,11 @@ void Pipeline::BuildPipeline(const Options& options) {
                     TAU_LOG_WARNING("H265 depacketization failed, frame size: " << frame.size() << ", losses: " << losses);
                 }
             });
+            _frame_processor.SetChunkCallback([this](rtp::Frame&& chunk, bool) {
+                if(!_h265_depacketizer.ProcessChunk(std::move(chunk))) {
+                    TAU_LOG_WARNING("H265 depacketization failed, frame chunk");
+                }
+            });
             _h265_depacketizer.SetCallback([this](Buffer&& nalu) {
                 WriteNaluToFile(std::move(nalu));
             });
@@ -26,6 +26,10 @@ Session::Session(Executor executor, Options&& options)
             .send_buffer_size = 0,
             .recv_buffer_size = 4
         })
+    , _jitter_buffer(
+        rtp::session::JitterBuffer::Dependencies{.clock = _media_clock},
+        rtp::session::JitterBuffer::Options{.rate = options.clock_rate})
+    , _jitter_buffer_timer(_executor)
     , _h264_depacketizer(g_system_allocator)
     , _avc1_nalu_processor(h264::AvcNaluProcessor::Options{
         .type = h264::AvcNaluProcessor::Type::kAvc1,
@@ -47,20 +51,28 @@ uint16_t Session::GetRtpPort() const {
 
 void Session::InitPipeline() {
     _rtp_session.SetRecvRtpCallback([this](Buffer&& rtp_packet) {
-        _frame_processor.PushRtp(std::move(rtp_packet));
+        _jitter_buffer.Push(std::move(rtp_packet));
+        ScheduleJitterBuffer();
     });
     _rtp_session.SetSendRtcpCallback([this](Buffer&& rtcp_packet) {
         if(_remote_endpoint_rtcp) {
             _socket_rtcp->Send(std::move(rtcp_packet), *_remote_endpoint_rtcp);
         }
     });
-    _frame_processor.SetCallback([this](rtp::Frame&& frame, bool losses) {
+    _jitter_buffer.SetCallback([this](rtp::Frame&& frame, bool losses) {
         const auto ok = !losses && _h264_depacketizer.Process(std::move(frame));
         if(!ok) {
             TAU_LOG_INFO("Drop until key-frame, frame rtp packets: " << frame.size() << (losses ? ", losses" : ""));
             _avc1_nalu_processor.DropUntilKeyFrame();
         }
     });
+    _jitter_buffer.SetChunkCallback([this](rtp::Frame&& chunk, bool losses) {
+        const auto ok = !losses && _h264_depacketizer.ProcessChunk(std::move(chunk));
+        if(!ok) {
+            TAU_LOG_INFO("Drop until key-frame, frame chunk" << (losses ? ", losses" : ""));
+            _avc1_nalu_processor.DropUntilKeyFrame();
+        }
+    });
     _h264_depacketizer.SetCallback([this](Buffer&& nal_unit) {
         _avc1_nalu_processor.Push(std::move(nal_unit));
     });
@@ -73,6 +85,28 @@ void Session::InitPipeline() {
     });
 }
 
+void Session::ScheduleJitterBuffer() {
+    const auto deadline = _jitter_buffer.GetNextDeadline();
+    if(deadline == _jitter_buffer_deadline) {
+        return;
+    }
+    _jitter_buffer_deadline = deadline;
+    if(!deadline) {
+        _jitter_buffer_timer.cancel();
+        return;
+    }
+    const auto now = _media_clock.Now();
+    _jitter_buffer_timer.expires_after(std::chrono::nanoseconds((*deadline > now) ? (*deadline - now) : 0)); // cancels the pending wait
+    _jitter_buffer_timer.async_wait([this](boost_ec ec) {
+        if(ec) {
+            return;
+        }
+        _jitter_buffer_deadline.reset();
+        _jitter_buffer.Process();
+        ScheduleJitterBuffer();
+    });
+}
+
 void Session::InitSockets() {
     auto udp_sockets_pair = net::CreateUdpSocketsPair<net::UdpSocketWithExecutor>(
         net::UdpSocketWithExecutor::Options{
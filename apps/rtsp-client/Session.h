@@ -1,10 +1,11 @@
 #pragma once
 
 #include "tau/rtp-session/Session.h"
-#include "tau/rtp-session/FrameProcessor.h"
+#include "tau/rtp-session/JitterBuffer.h"
 #include "tau/rtp-packetization/H264Depacketizer.h"
 #include "tau/video/h264/AvcNaluProcessor.h"
 #include "tau/net/UdpSocketWithExecutor.h"
+#include "tau/asio/Timer.h"
 #include "tau/memory/PoolAllocator.h"
 #include "tau/common/SystemClock.h"
 #include "tau/common/SteadyClock.h"
@@ -31,6 +32,7 @@ public:
 private:
     void InitPipeline();
     void InitSockets();
+    void ScheduleJitterBuffer(); // at the next frame playout
 
 private:
     std::array<uint8_t, 1 * 1024 * 1024> _allocated_memory;
@@ -40,7 +42,9 @@ private:
     SystemClock _system_clock;
 
     rtp::Session _rtp_session;
-    rtp::session::FrameProcessor _frame_processor;
+    rtp::session::JitterBuffer _jitter_buffer;
+    Timer _jitter_buffer_timer;
+    std::optional<Timepoint> _jitter_buffer_deadline;
     rtp::H264Depacketizer _h264_depacketizer;
     h264::AvcNaluProcessor _avc1_nalu_processor;
 
@@ -263,6 +263,11 @@ void Device::CreatePacketizer() {
             _pc->SendRtp(1, std::move(packet));
         }
     });
+    _h264_packetizer->SetSgCallback([this](SgBuffer&& packet) {
+        if(_pc) {
+            _pc->SendRtp(1, std::move(packet));
+        }
+    });
 }
 
 void Device::OnTimer() {
@@ -274,7 +279,7 @@ void Device::OnTimer() {
             if(_frame) {
                 const auto header = reinterpret_cast<const h264::NaluHeader*>(&_frame->GetView().ptr[0]);
                 auto last = (header->type == h264::kIdr) || (header->type == h264::kNonIdr);
-                _h264_packetizer->Process(std::move(*_frame), last);
+                _h264_packetizer->Process(std::move(*_frame), last); // SendRtp flushes out of Process
             }
             _frame.reset();
         }
@@ -0,0 +1,234 @@
+#include "tau/stun/Reader.h"
+#include "tau/stun/Writer.h"
+#include "tau/net/UdpSocket.h"
+#include "tau/net/Port.h"
+#include "tau/memory/host/LockFreePoolAllocator.h"
+#include "tau/common/NetToHost.h"
+#include "tau/common/StdString.h"
+#include "tau/common/Log.h"
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tau;
+
+// Load generator for apps/stun-server: every thread sends binding requests by batches (net::UdpSocket tx queue,
+// sendmmsg/GSO) from its own socket and receives responses (rx thread with recvmmsg), the number of requests
+// in flight is limited by the window. Responses are validated (FINGERPRINT) and matched by the thread index
+// in the transaction ID
+namespace {
+
+constexpr size_t kMaxDatagramSize = 1500;
+// rx queue, rx batch buffers and tx queue of a socket, twice for the datagrams on the fly
+constexpr size_t kBlocksPerThread = 2 * (128 + net::detail::kRxBatchMaxSize + net::detail::kTxBatchMaxSize);
+constexpr auto kDrainTimeout = std::chrono::milliseconds(200);
+constexpr auto kLossTimeout = std::chrono::milliseconds(50);
+constexpr auto kWaitTimeout = std::chrono::milliseconds(1);
+
+struct Options {
+    IpAddress server_address;
+    uint16_t server_port;
+    size_t batch_size;
+    size_t window;
+    std::chrono::steady_clock::duration duration;
+};
+
+struct Stats {
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t invalid = 0;
+    uint64_t lost = 0;
+    uint64_t send_errors = 0;
+
+    Stats& operator+=(const Stats& other) {
+        sent += other.sent;
+        received += other.received;
+        invalid += other.invalid;
+        lost += other.lost;
+        send_errors += other.send_errors;
+        return *this;
+    }
+};
+
+// set by the socket rx thread once responses are queued
+class Wakeup {
+public:
+    void Notify() {
+        {
+            std::lock_guard lock{_mutex};
+            _ready = true;
+        }
+        _cv.notify_one();
+    }
+
+    void WaitFor(std::chrono::steady_clock::duration timeout) {
+        std::unique_lock lock{_mutex};
+        _cv.wait_for(lock, timeout, [this]() { return _ready; });
+        _ready = false;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _ready = false;
+};
+
+// transaction ID: thread index (32 bits) and sequence number (64 bits)
+void WriteRequest(uint8_t* ptr, uint32_t thread_idx, uint64_t sn) {
+    stun::Writer writer(BufferView{.ptr = ptr, .size = stun::kMessageHeaderSize}, stun::kBindingRequest);
+    Write32(ptr + 2 * sizeof(uint32_t), thread_idx);
+    Write64(ptr + 3 * sizeof(uint32_t), sn);
+}
+
+Stats Run(const Options& options, Allocator& allocator, uint32_t thread_idx) {
+    Stats stats;
+    const auto batch_size = std::clamp<size_t>(options.batch_size, 1, net::detail::kTxBatchMaxSize);
+    Wakeup wakeup;
+    auto socket = net::UdpSocket::Create(net::UdpSocket::Options{
+        .allocator = allocator,
+        .local_address = IpAddress{},
+        .rx_batch_size = batch_size,
+        .tx_batch_size = batch_size,
+        .ready_callback = [&wakeup]() { wakeup.Notify(); }
+    });
+    if(!socket->GetLocalEndpoint()) {
+        TAU_LOG_WARNING("Socket failed, thread: " << thread_idx);
+        return stats;
+    }
+    const Endpoint server_endpoint{.address = options.server_address, .port = options.server_port};
+
+    uint64_t in_flight = 0;
+    socket->SetRecvCallback([&](Buffer&& packet, Endpoint) {
+        const auto response = ToConst(packet.GetView());
+        const bool valid = stun::Reader::Validate(response)
+            && (stun::HeaderReader::GetType(response) == stun::kBindingResponse)
+            && (Read32(response.ptr + 2 * sizeof(uint32_t)) == thread_idx);
+        if(valid) {
+            stats.received++;
+        } else {
+            stats.invalid++;
+        }
+        in_flight -= std::min<uint64_t>(in_flight, 1);
+    });
+
+    uint64_t sn = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    auto drain_tp = begin + options.duration;
+    auto last_rx_tp = begin;
+    bool sending = true;
+    while(true) {
+        const auto now = std::chrono::steady_clock::now();
+        if(sending && (now >= drain_tp)) {
+            sending = false;
+            drain_tp = now + kDrainTimeout;
+        }
+        if(!sending && ((in_flight == 0) || (now >= drain_tp))) {
+            break;
+        }
+
+        const bool can_send = sending && (in_flight + batch_size <= options.window);
+        if(can_send) {
+            for(size_t i = 0; i < batch_size; ++i) {
+                auto request = Buffer::Create(allocator);
+                if(request.GetViewWithCapacity().ptr == nullptr) {
+                    TAU_LOG_WARNING_THR(128, "No free buffers, thread: " << thread_idx);
+                    break;
+                }
+                WriteRequest(request.GetViewWithCapacity().ptr, thread_idx, sn++);
+                request.SetSize(stun::kMessageHeaderSize);
+                socket->Send(std::move(request), server_endpoint);
+                stats.sent++;
+                in_flight++;
+            }
+            socket->Flush();
+        }
+
+        if(socket->Receive()) {
+            last_rx_tp = now;
+            continue;
+        }
+        if(can_send) {
+            continue;
+        }
+        if(sending && (now - last_rx_tp > kLossTimeout)) {
+            stats.lost += in_flight; // timeout: the window is reopened
+            in_flight = 0;
+            last_rx_tp = now;
+            continue;
+        }
+        wakeup.WaitFor(kWaitTimeout);
+    }
+    stats.lost += in_flight;
+    stats.send_errors = socket->GetTxStats().dropped;
+    return stats;
+}
+
+}
+
+int main(int argc, char** argv) {
+    namespace po = boost::program_options;
+
+    std::string address = "127.0.0.1";
+    uint16_t port = net::kStunPort;
+    size_t threads = std::thread::hardware_concurrency();
+    size_t batch_size = 32;
+    size_t window = 1024;
+    size_t duration_sec = 10;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help", "produce help message")
+        ("address", po::value<std::string>(&address)->default_value(address), "STUN server address")
+        ("port", po::value<uint16_t>(&port)->default_value(port), "STUN server port")
+        ("threads", po::value<size_t>(&threads)->default_value(threads), "Threads (sockets) count")
+        ("batch", po::value<size_t>(&batch_size)->default_value(batch_size), "Requests per sendmmsg, responses per recvmmsg")
+        ("window", po::value<size_t>(&window)->default_value(window), "Requests in flight per thread")
+        ("duration", po::value<size_t>(&duration_sec)->default_value(duration_sec), "Duration, sec")
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if(vm.count("help")) {
+        TAU_LOG_INFO(ToStdString(desc).data());
+        return 1;
+    }
+
+    const Options options{
+        .server_address = net::MakeIpAddressV4(etl::string_view{address.data(), address.size()}),
+        .server_port = port,
+        .batch_size = batch_size,
+        .window = std::max(window, batch_size),
+        .duration = std::chrono::seconds(duration_sec)
+    };
+    TAU_LOG_INFO("Server: " << options.server_address << ":" << port << ", threads: " << threads
+        << ", batch size: " << batch_size << ", window: " << options.window << ", duration: " << duration_sec << " sec");
+
+    std::vector<uint8_t> allocated_memory(std::max<size_t>(threads, 1) * kBlocksPerThread * kMaxDatagramSize);
+    LockFreePoolAllocator<uint32_t> allocator(allocated_memory.data(), allocated_memory.size(), kMaxDatagramSize); // shared by the threads
+
+    std::vector<Stats> thread_stats(threads);
+    std::vector<std::thread> workers;
+    for(size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i]() {
+            thread_stats[i] = Run(options, allocator, static_cast<uint32_t>(i));
+        });
+    }
+    for(auto& worker : workers) {
+        worker.join();
+    }
+
+    Stats stats;
+    for(const auto& s : thread_stats) {
+        stats += s;
+    }
+    TAU_LOG_INFO("Sent: " << stats.sent << ", received: " << stats.received << ", invalid: " << stats.invalid
+        << ", lost: " << stats.lost << ", send errors: " << stats.send_errors
+        << ", rate: " << stats.received / std::max<size_t>(1, duration_sec) << " rps");
+    return (stats.received > 0) ? 0 : -1;
+}
@@ -0,0 +1,105 @@
+#include "apps/stun-server/Server.h"
+#include "tau/common/Exception.h"
+#include "tau/common/Log.h"
+#include <pthread.h>
+#include <algorithm>
+
+namespace tau {
+
+namespace {
+
+constexpr size_t kMaxDatagramSize = 1500;
+// rx batch buffers and tx queue of a shard, twice for the datagrams on the fly
+constexpr size_t kBlocksPerShard = 2 * (net::detail::kRxBatchMaxSize + net::detail::kTxBatchMaxSize);
+
+void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+    // single writer: no locked read-modify-write on the hot path
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+}
+
+Server::Server(Options&& options)
+    : _options(std::move(options))
+    , _responder(stun::BindingResponder::Options{.software = _options.software})
+    , _allocated_memory(std::max<size_t>(_options.threads, 1) * kBlocksPerShard * kMaxDatagramSize)
+    , _allocator(_allocated_memory.data(), _allocated_memory.size(), kMaxDatagramSize)
+    , _shards(net::UdpSocketShards::Options{
+        .allocator = _allocator,
+        .local_address = _options.local_address,
+        .local_port = _options.port,
+        .shards_count = _options.threads,
+        .rx_batch_size = _options.batch_size,
+        .tx_batch_size = _options.batch_size
+    }) {
+    for(size_t i = 0; i < _shards.GetShardsCount(); ++i) {
+        _contexts.push_back(std::make_unique<ShardContext>());
+        if(_options.pin_threads) {
+            asio::post(_shards.GetExecutor(i), [this, i]() { PinThread(i); });
+        }
+    }
+    _shards.SetRecvCallback([this](size_t shard_idx, Buffer&& packet, Endpoint remote_endpoint) {
+        OnRequest(shard_idx, std::move(packet), remote_endpoint);
+    });
+    TAU_LOG_INFO("Listening: " << _options.local_address << ":" << GetLocalPort() << ", threads: " << GetThreadsCount()
+        << ", batch size: " << _options.batch_size << ", kernel steering: " << _shards.IsKernelSteering());
+}
+
+Server::~Server() {
+    Stop();
+}
+
+void Server::Stop() {
+    _shards.Stop();
+}
+
+Server::Stats Server::GetStats() const {
+    Stats stats;
+    for(auto& ctx : _contexts) {
+        stats.requests += ctx->requests.load(std::memory_order_relaxed);
+        stats.responses += ctx->responses.load(std::memory_order_relaxed);
+        stats.invalid += ctx->invalid.load(std::memory_order_relaxed);
+        stats.send_errors += ctx->send_errors.load(std::memory_order_relaxed);
+        stats.send_syscalls += ctx->send_syscalls.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void Server::OnRequest(size_t shard_idx, Buffer&& packet, Endpoint remote_endpoint) {
+    auto& ctx = *_contexts[shard_idx];
+    Add(ctx.requests, 1);
+    const auto size = _responder.Process(ToConst(packet.GetView()),
+        remote_endpoint.address.GetUint32(), remote_endpoint.port, packet.GetViewWithCapacity());
+    if(size == 0) {
+        Add(ctx.invalid, 1);
+        return;
+    }
+    packet.SetSize(size);
+    _shards.GetSocket(shard_idx).Send(std::move(packet), remote_endpoint);
+    Add(ctx.responses, 1);
+
+    // the queue is flushed once full, the rest is sent after the current rx batch
+    if(!ctx.flush_scheduled) {
+        ctx.flush_scheduled = true;
+        asio::post(_shards.GetExecutor(shard_idx), [this, shard_idx]() { Flush(shard_idx); });
+    }
+}
+
+void Server::Flush(size_t shard_idx) {
+    auto& ctx = *_contexts[shard_idx];
+    ctx.flush_scheduled = false;
+    auto& socket = _shards.GetSocket(shard_idx);
+    socket.Flush();
+    const auto& tx_stats = socket.GetTxStats();
+    ctx.send_syscalls.store(tx_stats.syscalls, std::memory_order_relaxed);
+    ctx.send_errors.store(tx_stats.dropped, std::memory_order_relaxed);
+}
+
+void Server::PinThread(size_t shard_idx) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(shard_idx % std::thread::hardware_concurrency(), &cpu_set);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+}
+
+}
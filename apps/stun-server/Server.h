@@ -0,0 +1,70 @@
+#pragma once
+
+#include "tau/stun/BindingResponder.h"
+#include "tau/net/UdpSocketShards.h"
+#include "tau/memory/host/LockFreePoolAllocator.h"
+#include "tau/net/Port.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace tau {
+
+// Multi-core STUN binding responder on net::UdpSocketShards: a thread per core with its own SO_REUSEPORT socket
+// (clients are steered by 4-tuple hash), datagrams are received by recvmmsg batches and responses are queued
+// for sendmmsg/GSO. Responses are patched from the pre-serialized template in place of the requests
+class Server {
+public:
+    struct Options {
+        IpAddress local_address = {};
+        uint16_t port = net::kStunPort;
+        size_t threads = std::thread::hardware_concurrency();
+        size_t batch_size = 32;
+        bool pin_threads = true;
+        etl::string_view software = "TAU WebRTC Library";
+    };
+
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t responses = 0;
+        uint64_t invalid = 0;
+        uint64_t send_errors = 0;
+        uint64_t send_syscalls = 0;
+    };
+
+public:
+    explicit Server(Options&& options);
+    ~Server();
+
+    void Stop();
+
+    Stats GetStats() const; // merged per-shard stats
+    size_t GetThreadsCount() const { return _shards.GetShardsCount(); }
+    uint16_t GetLocalPort() const { return _shards.GetLocalEndpoint()->port; }
+
+private:
+    // updated by the shard thread only, read by GetStats()
+    struct alignas(64) ShardContext {
+        std::atomic<uint64_t> requests = 0;
+        std::atomic<uint64_t> responses = 0;
+        std::atomic<uint64_t> invalid = 0;
+        std::atomic<uint64_t> send_errors = 0;
+        std::atomic<uint64_t> send_syscalls = 0;
+        bool flush_scheduled = false;
+    };
+
+    void OnRequest(size_t shard_idx, Buffer&& packet, Endpoint remote_endpoint);
+    void Flush(size_t shard_idx);
+    void PinThread(size_t shard_idx);
+
+private:
+    const Options _options;
+    const stun::BindingResponder _responder;
+    std::vector<uint8_t> _allocated_memory;
+    LockFreePoolAllocator<uint32_t> _allocator; // shared by the shards threads
+    std::vector<std::unique_ptr<ShardContext>> _contexts;
+    net::UdpSocketShards _shards;
+};
+
+}
@@ -1,76 +1,74 @@
-#include "tau/net/UdpSocketWithExecutor.h"
-#include "tau/stun/Reader.h"
-#include "tau/stun/Writer.h"
-#include "tau/stun/attribute/XorMappedAddress.h"
-#include "tau/stun/attribute/ByteString.h"
-#include "tau/stun/attribute/Fingerprint.h"
-#include "tau/asio/ThreadPool.h"
-#include "tau/asio/PeriodicTimer.h"
-#include "tau/asio/ToString.h"
-#include "tau/memory/PoolAllocator.h"
-#include "tau/net/Port.h"
+#include "apps/stun-server/Server.h"
+#include "tau/common/StdString.h"
 #include "tau/common/Log.h"
-#include <atomic>
+#include <boost/program_options.hpp>
+#include <csignal>
+#include <chrono>
+#include <string>
 
 using namespace tau;
 
-int main(int /*argc*/, char** /*argv*/) {
-    ThreadPool io(std::thread::hardware_concurrency());
+namespace {
 
-    std::atomic<size_t> requests{0};
-    std::atomic<size_t> responses{0};
+volatile std::sig_atomic_t g_stop = 0;
 
-    std::array<uint8_t, 1 * 1024 * 1024> _allocated_memory;
-    PoolAllocator<> udp_allocator(_allocated_memory.data(), _allocated_memory.size(), 1200);
-    auto udp_socket = net::UdpSocketWithExecutor::Create(
-        net::UdpSocketWithExecutor::Options{
-            .allocator = udp_allocator,
-            .executor = io.GetExecutor(),
-            .local_address = IpAddress{0, 0, 0, 0},
-            .local_port = net::kStunPort
-        });
-    udp_socket->SetRecvCallback([&](Buffer&& message, Endpoint remote_endpoint) {
-        requests.fetch_add(1);
-        auto view_const = ToConst(message.GetView());
-        if(!stun::Reader::Validate(view_const)) {
-            TAU_LOG_WARNING_THR(128, "Invalid STUN message, remote_endpoint: " << remote_endpoint);
-            return;
-        }
-        if(stun::kBindingRequest != stun::HeaderReader::GetType(view_const)) {
-            TAU_LOG_WARNING_THR(128, "STUN message wrong type, remote_endpoint: " << remote_endpoint);
-            return;
-        }
+}
 
-        responses.fetch_add(1);
-        stun::Writer writer(message.GetViewWithCapacity(), stun::kBindingResponse);
-        stun::attribute::XorMappedAddressWriter::Write(writer,
-            stun::AttributeType::kXorMappedAddress,
-            remote_endpoint.address.GetUint32(),
-            remote_endpoint.port);
-        stun::attribute::ByteStringWriter::Write(writer,
-            stun::AttributeType::kSoftware,
-            "TAU WebRTC Library");
-        stun::attribute::FingerprintWriter::Write(writer);
-        message.SetSize(writer.GetSize());
+int main(int argc, char** argv) {
+    namespace po = boost::program_options;
 
-        udp_socket->Send(std::move(message), remote_endpoint);
-    });
-    udp_socket->SetErrorCallback([](boost_ec ec) {
-        TAU_LOG_WARNING_THR(128, "[udp socket] Error: " << ec);
+    std::string address = "0.0.0.0";
+    uint16_t port = net::kStunPort;
+    size_t threads = std::thread::hardware_concurrency();
+    size_t batch_size = 32;
+    size_t stats_period_sec = 60;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help", "produce help message")
+        ("address", po::value<std::string>(&address)->default_value(address), "Local address")
+        ("port", po::value<uint16_t>(&port)->default_value(port), "Local port")
+        ("threads", po::value<size_t>(&threads)->default_value(threads), "Threads (sockets) count")
+        ("batch", po::value<size_t>(&batch_size)->default_value(batch_size), "Datagrams per recvmmsg/sendmmsg")
+        ("stats-period", po::value<size_t>(&stats_period_sec)->default_value(stats_period_sec), "Stats report period, sec")
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if(vm.count("help")) {
+        TAU_LOG_INFO(ToStdString(desc).data());
+        return 1;
+    }
+
+    Server server(Server::Options{
+        .local_address = net::MakeIpAddressV4(etl::string_view{address.data(), address.size()}),
+        .port = port,
+        .threads = threads,
+        .batch_size = batch_size
     });
-    TAU_LOG_INFO("Listening: " << udp_socket->GetLocalEndpoint().value());
 
-    PeriodicTimer timer(io.GetExecutor());
-    constexpr auto kPrintStatsPeriodMs = 5 * 60 * 1000;
-    timer.Start(kPrintStatsPeriodMs, [&](boost_ec ec) {
-        if(ec) {
-            TAU_LOG_WARNING("Error: " << ec);
-            return false;
+    std::signal(SIGINT, [](int) { g_stop = 1; });
+    std::signal(SIGTERM, [](int) { g_stop = 1; });
+
+    auto last = server.GetStats();
+    auto last_tp = std::chrono::steady_clock::now();
+    while(!g_stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const auto now = std::chrono::steady_clock::now();
+        if(now - last_tp < std::chrono::seconds(stats_period_sec)) {
+            continue;
         }
-        TAU_LOG_INFO("[stats] Requests: " << requests.load(std::memory_order_relaxed) << ", responses: " << responses.load(std::memory_order_relaxed));
-        return true;
-    });
+        const auto stats = server.GetStats();
+        const auto sec = std::chrono::duration<double>(now - last_tp).count();
+        TAU_LOG_INFO("[stats] Requests: " << stats.requests << ", responses: " << stats.responses
+            << ", invalid: " << stats.invalid << ", send errors: " << stats.send_errors
+            << ", rate: " << static_cast<size_t>((stats.responses - last.responses) / sec) << " rps"
+            << ", send syscalls: " << stats.send_syscalls);
+        last = stats;
+        last_tp = now;
+    }
 
-    io.Join();
+    server.Stop();
     return 0;
 }
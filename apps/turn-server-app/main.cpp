@@ -0,0 +1,144 @@
+#include "apps/turn-server/TurnServer.h"
+#include "tau/net/UdpSocketWithExecutor.h"
+#include "tau/net/Port.h"
+#include "tau/asio/ThreadPool.h"
+#include "tau/asio/PeriodicTimer.h"
+#include "tau/memory/PoolAllocator.h"
+#include "tau/common/SteadyClock.h"
+#include "tau/common/StdString.h"
+#include "tau/common/Log.h"
+#include <boost/program_options.hpp>
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+using namespace tau;
+
+int main(int argc, char** argv) {
+    namespace po = boost::program_options;
+
+    std::string address = "0.0.0.0";
+    std::string relay_address;
+    uint16_t port = net::kTurnUdpPort;
+    std::string realm = "tau";
+    std::vector<std::string> users;
+    size_t max_allocations = 1024;
+    bool allow_private_peers = false;
+    size_t stats_period_sec = 60;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help", "produce help message")
+        ("address", po::value<std::string>(&address)->default_value(address), "Local address (listening and relay sockets)")
+        ("port", po::value<uint16_t>(&port)->default_value(port), "Local port")
+        ("relay-address", po::value<std::string>(&relay_address), "Public relay address (XOR-RELAYED-ADDRESS), local address by default")
+        ("realm", po::value<std::string>(&realm)->default_value(realm), "Realm of long-term credentials")
+        ("user", po::value<std::vector<std::string>>(&users)->multitoken(), "User credentials: name:password")
+        ("max-allocations", po::value<size_t>(&max_allocations)->default_value(max_allocations), "Max allocations count")
+        ("allow-private-peers", po::bool_switch(&allow_private_peers), "Allow loopback, link-local and private peer addresses")
+        ("stats-period", po::value<size_t>(&stats_period_sec)->default_value(stats_period_sec), "Stats report period, sec")
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if(vm.count("help") || users.empty()) {
+        TAU_LOG_INFO(ToStdString(desc).data());
+        return 1;
+    }
+
+    const auto local_address = net::MakeIpAddressV4(etl::string_view{address.data(), address.size()});
+    TurnServer::Options options{
+        .relay_address = relay_address.empty()
+            ? local_address
+            : net::MakeIpAddressV4(etl::string_view{relay_address.data(), relay_address.size()}),
+        .users = {},
+        .realm = realm,
+        .max_allocations = max_allocations,
+        .allow_private_peers = allow_private_peers
+    };
+    for(auto& user : users) {
+        const auto pos = user.find(':');
+        if(pos == std::string::npos) {
+            TAU_LOG_ERROR("Wrong user credentials: " << user.c_str());
+            return -1;
+        }
+        options.users.emplace(user.substr(0, pos), user.substr(pos + 1));
+    }
+    TAU_LOG_INFO("Listening: " << local_address << ":" << port << ", relay address: " << options.relay_address
+        << ", realm: " << realm.c_str() << ", users: " << options.users.size());
+
+    SteadyClock clock;
+    std::vector<uint8_t> allocated_memory(32 * 1024 * 1024);
+    PoolAllocator udp_allocator(allocated_memory.data(), allocated_memory.size(), kUdpMtuSize);
+    ThreadPool io(1); // the server isn't thread-safe, all sockets and the timer share the thread
+
+    TurnServer server(
+        TurnServer::Dependencies{.clock = clock, .udp_allocator = udp_allocator},
+        std::move(options));
+
+    auto socket = net::UdpSocketWithExecutor::Create(net::UdpSocketWithExecutor::Options{
+        .allocator = udp_allocator,
+        .executor = io.GetExecutor(),
+        .local_address = local_address,
+        .local_port = port
+    });
+    std::unordered_map<uint16_t, net::UdpSocketWithExecutorPtr> relay_sockets;
+
+    server.SetSendCallback([&](Buffer&& packet, Endpoint client) {
+        socket->Send(std::move(packet), client);
+    });
+    server.SetRelayCallback([&](uint16_t relay_port, Buffer&& packet, Endpoint peer) {
+        auto it = relay_sockets.find(relay_port);
+        if(it != relay_sockets.end()) {
+            it->second->Send(std::move(packet), peer);
+        }
+    });
+    server.SetOpenRelayCallback([&]() -> std::optional<uint16_t> {
+        try {
+            auto relay_socket = net::UdpSocketWithExecutor::Create(net::UdpSocketWithExecutor::Options{
+                .allocator = udp_allocator,
+                .executor = io.GetExecutor(),
+                .local_address = local_address,
+                .rx_headroom = TurnServer::kRelayHeadroom // Data indication/ChannelData header is prepended in place
+            });
+            const auto relay_port = relay_socket->GetLocalEndpoint()->port;
+            relay_socket->SetRecvCallback([&server, relay_port](Buffer&& packet, Endpoint peer) {
+                server.RecvFromPeer(relay_port, std::move(packet), peer);
+            });
+            relay_sockets.emplace(relay_port, std::move(relay_socket));
+            return relay_port;
+        } catch(const std::exception& e) {
+            TAU_LOG_WARNING("Relay socket failed: " << e.what());
+            return std::nullopt;
+        }
+    });
+    server.SetCloseRelayCallback([&](uint16_t relay_port) {
+        relay_sockets.erase(relay_port);
+    });
+    socket->SetRecvCallback([&](Buffer&& packet, Endpoint client) {
+        server.RecvFromClient(std::move(packet), client);
+    });
+
+    PeriodicTimer timer(io.GetExecutor());
+    auto stats_tp = clock.Now();
+    timer.Start(1000, [&](boost_ec ec) {
+        if(ec) {
+            TAU_LOG_WARNING("Error: " << ec.message().c_str());
+            return false;
+        }
+        server.Process();
+        const auto now = clock.Now();
+        if(now - stats_tp >= stats_period_sec * kSec) {
+            stats_tp = now;
+            const auto& stats = server.GetStats();
+            TAU_LOG_INFO("[stats] Allocations: " << server.GetAllocationsCount() << ", requests: " << stats.requests
+                << ", errors: " << stats.error_responses << ", to peer: " << stats.to_peer << ", to client: " << stats.to_client
+                << ", copied: " << stats.to_client_copied << ", dropped: " << stats.dropped);
+        }
+        return true;
+    });
+
+    io.Join();
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "apps/turn-server/AllocationTable.h"
+#include "tau/common/Container.h"
+
+namespace tau {
+
+bool AllocationTable::Allocation::AddPermission(IpAddress peer, Timepoint expire_tp, Timepoint now) {
+    auto it = permissions.find(peer);
+    if(it != permissions.end()) {
+        it->second = expire_tp;
+        return true;
+    }
+    if(permissions.full()) {
+        RemoveExpired(now);
+        if(permissions.full()) {
+            return false;
+        }
+    }
+    permissions.insert(etl::make_pair(peer, expire_tp));
+    return true;
+}
+
+bool AllocationTable::Allocation::HasPermission(IpAddress peer, Timepoint now) const {
+    auto it = permissions.find(peer);
+    return (it != permissions.end()) && (now < it->second);
+}
+
+bool AllocationTable::Allocation::BindChannel(uint16_t channel, Endpoint peer, Timepoint expire_tp, Timepoint now) {
+    RemoveExpired(now);
+    auto it = channels.find(channel);
+    if(it != channels.end()) {
+        if(it->second.peer != peer) {
+            return false;
+        }
+        it->second.expire_tp = expire_tp;
+        return true;
+    }
+    if(Contains(peer_to_channel, peer) || channels.full()) {
+        return false;
+    }
+    channels.insert(etl::make_pair(channel, Channel{.peer = peer, .expire_tp = expire_tp}));
+    peer_to_channel.insert(etl::make_pair(peer, channel));
+    return true;
+}
+
+void AllocationTable::Allocation::UnbindChannel(uint16_t channel) {
+    auto it = channels.find(channel);
+    if(it != channels.end()) {
+        peer_to_channel.erase(it->second.peer);
+        channels.erase(it);
+    }
+}
+
+const AllocationTable::Channel* AllocationTable::Allocation::FindChannel(uint16_t channel, Timepoint now) const {
+    auto it = channels.find(channel);
+    if((it == channels.end()) || (now >= it->second.expire_tp)) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+std::optional<uint16_t> AllocationTable::Allocation::FindChannel(Endpoint peer, Timepoint now) const {
+    auto it = peer_to_channel.find(peer);
+    if(it == peer_to_channel.end()) {
+        return std::nullopt;
+    }
+    if(!FindChannel(it->second, now)) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void AllocationTable::Allocation::RemoveExpired(Timepoint now) {
+    for(auto it = permissions.begin(); it != permissions.end();) {
+        if(now >= it->second) {
+            it = permissions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for(auto it = channels.begin(); it != channels.end();) {
+        if(now >= it->second.expire_tp) {
+            peer_to_channel.erase(it->second.peer);
+            it = channels.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+AllocationTable::AllocationTable(size_t capacity)
+    : _slots(capacity) {
+    _free_ids.reserve(capacity);
+    for(size_t i = 0; i < capacity; ++i) {
+        _free_ids.push_back(static_cast<Id>(capacity - 1 - i));
+    }
+    _by_client.reserve(capacity);
+    _by_relay_port.reserve(capacity);
+}
+
+std::optional<AllocationTable::Id> AllocationTable::Insert(Allocation&& allocation) {
+    if(_free_ids.empty() || Contains(_by_client, allocation.client) || Contains(_by_relay_port, allocation.relay_port)) {
+        return std::nullopt;
+    }
+    const auto id = _free_ids.back();
+    _free_ids.pop_back();
+    _by_client.emplace(allocation.client, id);
+    _by_relay_port.emplace(allocation.relay_port, id);
+    _slots[id].emplace(std::move(allocation));
+    return id;
+}
+
+void AllocationTable::Erase(Id id) {
+    auto& slot = _slots[id];
+    if(!slot) {
+        return;
+    }
+    _by_client.erase(slot->client);
+    _by_relay_port.erase(slot->relay_port);
+    slot.reset();
+    _free_ids.push_back(id);
+}
+
+AllocationTable::Allocation* AllocationTable::Get(Id id) {
+    auto& slot = _slots[id];
+    return slot ? &*slot : nullptr;
+}
+
+std::optional<AllocationTable::Id> AllocationTable::FindByClient(Endpoint client) const {
+    auto it = _by_client.find(client);
+    if(it == _by_client.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<AllocationTable::Id> AllocationTable::FindByRelayPort(uint16_t relay_port) const {
+    auto it = _by_relay_port.find(relay_port);
+    if(it == _by_relay_port.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+}
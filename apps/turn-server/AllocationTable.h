@@ -0,0 +1,74 @@
+#pragma once
+
+#include "tau/crypto/Hmac.h"
+#include "tau/net/Endpoint.h"
+#include "tau/common/Clock.h"
+#include <etl/unordered_map.h>
+#include <etl/string.h>
+#include <unordered_map>
+#include <optional>
+#include <vector>
+#include <string>
+
+namespace tau {
+
+// TURN allocations indexed by the client 5-tuple (UDP to the single listening endpoint, so client endpoint only)
+// and by the relay port. Allocations are stored in slots with dense ids (reused after Erase) for TimerWheel
+class AllocationTable {
+public:
+    static constexpr size_t kMaxPermissions = 16;
+    static constexpr size_t kMaxChannels = 16;
+
+    using Id = uint32_t;
+
+    struct Channel {
+        Endpoint peer;
+        Timepoint expire_tp;
+    };
+
+    struct Allocation {
+        Endpoint client;
+        uint16_t relay_port;
+        std::string user;
+        etl::string<32> nonce;
+        crypto::HmacHasher* hasher; // MESSAGE-INTEGRITY with the long-term key of the user, owned by TurnServer
+        uint32_t transaction_hash; // of the Allocate request, to answer retransmissions
+        Timepoint expire_tp;
+
+        etl::unordered_map<IpAddress, Timepoint, kMaxPermissions> permissions = {};
+        etl::unordered_map<uint16_t, Channel, kMaxChannels> channels = {};
+        etl::unordered_map<Endpoint, uint16_t, kMaxChannels> peer_to_channel = {};
+
+        // expired permissions and channels are removed lazily: here and on lookups
+        bool AddPermission(IpAddress peer, Timepoint expire_tp, Timepoint now);
+        bool HasPermission(IpAddress peer, Timepoint now) const;
+        bool BindChannel(uint16_t channel, Endpoint peer, Timepoint expire_tp, Timepoint now);
+        void UnbindChannel(uint16_t channel);
+        const Channel* FindChannel(uint16_t channel, Timepoint now) const;
+        std::optional<uint16_t> FindChannel(Endpoint peer, Timepoint now) const;
+
+    private:
+        void RemoveExpired(Timepoint now);
+    };
+
+public:
+    explicit AllocationTable(size_t capacity);
+
+    std::optional<Id> Insert(Allocation&& allocation);
+    void Erase(Id id);
+
+    Allocation* Get(Id id);
+    std::optional<Id> FindByClient(Endpoint client) const;
+    std::optional<Id> FindByRelayPort(uint16_t relay_port) const;
+
+    size_t GetSize() const { return _by_client.size(); }
+    size_t GetCapacity() const { return _slots.size(); }
+
+private:
+    std::vector<std::optional<Allocation>> _slots;
+    std::vector<Id> _free_ids;
+    std::unordered_map<Endpoint, Id, etl::hash<Endpoint>> _by_client;
+    std::unordered_map<uint16_t, Id> _by_relay_port;
+};
+
+}
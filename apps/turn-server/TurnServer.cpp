@@ -0,0 +1,482 @@
+#include "apps/turn-server/TurnServer.h"
+#include "tau/ice/Credentials.h"
+#include "tau/stun/Reader.h"
+#include "tau/stun/Writer.h"
+#include "tau/stun/ChannelData.h"
+#include "tau/stun/attribute/DataUint32.h"
+#include "tau/stun/attribute/ByteString.h"
+#include "tau/stun/attribute/Data.h"
+#include "tau/stun/attribute/ErrorCode.h"
+#include "tau/stun/attribute/MessageIntegrity.h"
+#include "tau/stun/attribute/Fingerprint.h"
+#include "tau/crypto/Random.h"
+#include "tau/common/String.h"
+#include "tau/common/Math.h"
+#include "tau/common/Log.h"
+#include <etl/array.h>
+#include <algorithm>
+#include <cstring>
+
+namespace tau {
+
+using namespace stun;
+using namespace stun::attribute;
+
+namespace {
+
+constexpr uint32_t kRequestedTransportUdp = 0x11 << 24;
+constexpr size_t kNonceSize = 12; // bytes, hex encoded
+
+}
+
+TurnServer::TurnServer(Dependencies&& deps, Options&& options)
+    : _deps(std::move(deps))
+    , _options(std::move(options))
+    , _binding_responder(BindingResponder::Options{.software = _options.software})
+    , _allocations(_options.max_allocations)
+    , _expirations(_deps.clock.Now()) {
+    const auto realm = etl::string_view{_options.realm.data(), _options.realm.size()};
+    for(auto& [user, password] : _options.users) {
+        etl::string<ice::kLongTermPassword> key(ice::kLongTermPassword, 0);
+        const auto credentials = ice::PeerCredentials{
+            .ufrag = etl::string_view{user.data(), user.size()},
+            .password = etl::string_view{password.data(), password.size()}
+        };
+        if(!ice::CalcLongTermPassword(credentials, realm, reinterpret_cast<uint8_t*>(key.data()))) {
+            TAU_LOG_WARNING(_options.log_ctx << "CalcLongTermPassword failed, user: " << user);
+            continue;
+        }
+        _hashers.emplace(user, crypto::HmacHasher(crypto::HmacHasher::Type::Sha1, key));
+    }
+    RotateNonce();
+}
+
+void TurnServer::RecvFromClient(Buffer&& packet, Endpoint client) {
+    const auto view = ToConst(packet.GetView());
+    if(ChannelDataReader::IsChannelData(view)) {
+        return OnChannelData(std::move(packet), client);
+    }
+    if(!Reader::Validate(view)) {
+        return Drop("Invalid stun message");
+    }
+
+    Request request{
+        .type = HeaderReader::GetType(view),
+        .hash = HeaderReader::GetTransactionIdHash(view)
+    };
+    if(request.type == kBindingRequest) {
+        return OnBindingRequest(std::move(packet), client);
+    }
+    if(!ParseRequest(view, request)) {
+        return Drop("Invalid attributes");
+    }
+    if(request.type == kAllocateRequest) {
+        _stats.requests++;
+        return OnAllocateRequest(std::move(packet), client, request);
+    }
+
+    const auto id = _allocations.FindByClient(client);
+    if(!id) {
+        if(request.type == kSendIndication) {
+            return Drop("Send indication without allocation");
+        }
+        _stats.requests++;
+        return SendErrorResponse(std::move(packet), client, request.type, ErrorCode::kAllocationMismatch, nullptr);
+    }
+    auto& allocation = *_allocations.Get(*id);
+    if(request.type == kSendIndication) {
+        return OnSendIndication(std::move(packet), allocation, request);
+    }
+
+    _stats.requests++;
+    switch(request.type) {
+        case kRefreshRequest:
+        case kCreatePermissionRequest:
+        case kChannelBindRequest:
+            break;
+        default:
+            return SendErrorResponse(std::move(packet), client, request.type, ErrorCode::kBadRequest, nullptr);
+    }
+    if(!Authenticate(packet, client, request)) {
+        return;
+    }
+    switch(request.type) {
+        case kRefreshRequest:          return OnRefreshRequest(std::move(packet), *id, request);
+        case kCreatePermissionRequest: return OnCreatePermissionRequest(std::move(packet), allocation, request);
+        case kChannelBindRequest:      return OnChannelBindRequest(std::move(packet), allocation, request);
+    }
+}
+
+void TurnServer::RecvFromPeer(uint16_t relay_port, Buffer&& packet, Endpoint peer) {
+    const auto id = _allocations.FindByRelayPort(relay_port);
+    if(!id) {
+        return Drop("Unknown relay port");
+    }
+    auto& allocation = *_allocations.Get(*id);
+    const auto now = _deps.clock.Now();
+    if(!allocation.HasPermission(peer.address, now)) {
+        return Drop("No permission");
+    }
+
+    const auto size = packet.GetSize();
+    const auto channel = allocation.FindChannel(peer, now);
+    const auto headroom = channel ? kChannelDataHeaderSize : kRelayHeadroom;
+    const auto padding = channel ? 0 : Align(size, sizeof(uint32_t)) - size;
+    if((packet.GetHeadroom() < headroom) || (packet.GetTailroom() < padding)) {
+        auto copy = Buffer::Create(_deps.udp_allocator);
+        if(copy.GetCapacity() < headroom + size + padding) {
+            return Drop("Too big packet");
+        }
+        copy.ReserveHeadroom(headroom);
+        std::memcpy(copy.GetViewWithCapacity().ptr, packet.GetView().ptr, size);
+        copy.SetSize(size);
+        packet = std::move(copy);
+        _stats.to_client_copied++;
+    }
+    packet.Prepend(headroom);
+
+    auto view = packet.GetViewWithCapacity();
+    if(channel) {
+        ChannelDataWriter::WriteHeader(view, *channel, size);
+    } else {
+        stun::Writer writer(view, kDataIndication);
+        GenerateTransactionId(view.ptr + 2 * sizeof(uint32_t));
+        XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, peer.address.GetUint32(), peer.port);
+        writer.WriteAttributeHeader(AttributeType::kData, size);
+        std::memset(view.ptr + kRelayHeadroom + size, 0, padding);
+        writer.SetHeaderLength(kRelayHeadroom - kMessageHeaderSize + size + padding);
+        packet.SetSize(kRelayHeadroom + size + padding);
+    }
+    _stats.to_client++;
+    _send_callback(std::move(packet), allocation.client);
+}
+
+void TurnServer::Process() {
+    const auto now = _deps.clock.Now();
+    _expirations.Advance(now, [&](TimerWheel::Id id) {
+        auto allocation = _allocations.Get(id);
+        if(!allocation) {
+            return;
+        }
+        if(now >= allocation->expire_tp) {
+            TAU_LOG_INFO(_options.log_ctx << "Allocation expired, client: " << allocation->client << ", relay port: " << allocation->relay_port);
+            RemoveAllocation(id);
+        } else {
+            _expirations.Schedule(id, allocation->expire_tp);
+        }
+    });
+    if(now >= _nonce_rotation_tp) {
+        RotateNonce();
+    }
+}
+
+std::optional<Timepoint> TurnServer::GetNextDeadline() const {
+    const auto expiration = _expirations.GetNextExpiration();
+    return expiration ? std::min(*expiration, _nonce_rotation_tp) : _nonce_rotation_tp;
+}
+
+bool TurnServer::ParseRequest(const BufferViewConst& view, Request& request) const {
+    return Reader::ForEachAttribute(view, [&](AttributeType type, const BufferViewConst& attr) {
+        switch(type) {
+            case AttributeType::kUserName:
+                request.user = ByteStringReader::GetValue(attr);
+                break;
+            case AttributeType::kRealm:
+                request.realm = ByteStringReader::GetValue(attr);
+                break;
+            case AttributeType::kNonce:
+                request.nonce = ByteStringReader::GetValue(attr);
+                break;
+            case AttributeType::kMessageIntegrity:
+                request.message_integrity.emplace(attr);
+                break;
+            case AttributeType::kLifetime:
+                request.lifetime.emplace(DataUint32Reader::GetValue(attr));
+                break;
+            case AttributeType::kRequestedTransport:
+                request.requested_transport.emplace(DataUint32Reader::GetValue(attr));
+                break;
+            case AttributeType::kChannelNumber:
+                request.channel.emplace(DataUint32Reader::GetValue(attr) >> 16);
+                break;
+            case AttributeType::kXorPeerAddress:
+                if(request.peers.full() || (XorMappedAddressReader::GetFamily(attr) != IpFamily::kIpv4)) {
+                    return false;
+                }
+                request.peers.push_back(Endpoint{
+                    .address = IpAddress{XorMappedAddressReader::GetAddressV4(attr)},
+                    .port = XorMappedAddressReader::GetPort(attr)
+                });
+                break;
+            case AttributeType::kData:
+                request.data.emplace(DataReader::GetData(attr));
+                break;
+            default:
+                break;
+        }
+        return true;
+    });
+}
+
+bool TurnServer::IsPeerAllowed(const IpAddress& address) const {
+    if(_options.allow_private_peers) {
+        return true;
+    }
+    return !address.IsLoopback() && !address.IsLinkLocal() && !address.IsPrivate();
+}
+
+bool TurnServer::IsNonceValid(etl::string_view nonce) const {
+    return (nonce == etl::string_view{_nonce.data(), _nonce.size()})
+        || (!_prev_nonce.empty() && (nonce == etl::string_view{_prev_nonce.data(), _prev_nonce.size()}));
+}
+
+void TurnServer::RotateNonce() {
+    _prev_nonce = _nonce;
+    etl::array<uint8_t, kNonceSize> random;
+    crypto::RandomBytes(random.data(), random.size());
+    ToHexDump<false>(random.data(), random.size(), _nonce, "");
+    _nonce_rotation_tp = _deps.clock.Now() + kNonceLifetime;
+}
+
+void TurnServer::OnAllocateRequest(Buffer&& packet, Endpoint client, const Request& request) {
+    if(!request.message_integrity || request.user.empty()) {
+        return SendUnauthorized(std::move(packet), client, request.type, ErrorCode::kUnauthorized);
+    }
+    if(request.realm != etl::string_view{_options.realm.data(), _options.realm.size()}) {
+        return SendUnauthorized(std::move(packet), client, request.type, ErrorCode::kUnauthorized);
+    }
+    if(!IsNonceValid(request.nonce)) {
+        return SendUnauthorized(std::move(packet), client, request.type, ErrorCode::kStaleNonce);
+    }
+    // the long-term key of the user is derived once, in the constructor
+    auto hasher_it = _hashers.find(std::string{request.user.data(), request.user.size()});
+    if(hasher_it == _hashers.end()) {
+        TAU_LOG_WARNING(_options.log_ctx << "Unknown user, client: " << client);
+        return SendUnauthorized(std::move(packet), client, request.type, ErrorCode::kUnauthorized);
+    }
+    auto& hasher = hasher_it->second;
+    if(!MessageIntegrityReader::Validate(*request.message_integrity, ToConst(packet.GetView()), hasher)) {
+        TAU_LOG_WARNING(_options.log_ctx << "Wrong message integrity, client: " << client);
+        return SendUnauthorized(std::move(packet), client, request.type, ErrorCode::kUnauthorized);
+    }
+
+    const auto now = _deps.clock.Now();
+    const auto existing_id = _allocations.FindByClient(client);
+    auto allocation = existing_id ? _allocations.Get(*existing_id) : nullptr;
+    if(allocation) {
+        if(allocation->transaction_hash != request.hash) {
+            return SendErrorResponse(std::move(packet), client, request.type, ErrorCode::kAllocationMismatch, allocation->hasher);
+        }
+        // retransmission: the same response
+    } else {
+        if(!request.requested_transport) {
+            return SendErrorResponse(std::move(packet), client, request.type, ErrorCode::kBadRequest, &hasher);
+        }
+        if(*request.requested_transport != kRequestedTransportUdp) {
+            return SendErrorResponse(std::move(packet), client, request.type, ErrorCode::kUnsupportedTransportProtocol, &hasher);
+        }
+        if(_allocations.GetSize() == _allocations.GetCapacity()) {
+            return SendErrorResponse(std::move(packet), client, request.type, ErrorCode::kAllocationQuotaReached, &hasher);
+        }
+        const auto relay_port = _open_relay_callback();
+        if(!relay_port) {
+            return SendErrorResponse(std::move(packet), client, request.type, ErrorCode::kInsufficientCapacity, &hasher);
+        }
+
+        const auto lifetime = std::clamp<size_t>(request.lifetime.value_or(kLifetimeDefaultSec), kLifetimeDefaultSec, kLifetimeMaxSec);
+        const auto id = _allocations.Insert(AllocationTable::Allocation{
+            .client = client,
+            .relay_port = *relay_port,
+            .user = std::string{request.user.data(), request.user.size()},
+            .nonce = etl::string<32>{request.nonce.data(), request.nonce.size()},
+            .hasher = &hasher,
+            .transaction_hash = request.hash,
+            .expire_tp = now + lifetime * kSec
+        });
+        if(!id) {
+            _close_relay_callback(*relay_port);
+            return Drop("Allocation insert failed");
+        }
+        allocation = _allocations.Get(*id);
+        _expirations.Schedule(*id, allocation->expire_tp);
+        TAU_LOG_INFO(_options.log_ctx << "Allocation, client: " << client << ", user: " << allocation->user.c_str()
+            << ", relay port: " << *relay_port << ", lifetime: " << lifetime << " sec, allocations: " << _allocations.GetSize());
+    }
+
+    stun::Writer writer(packet.GetViewWithCapacity(), kAllocateResponse);
+    XorMappedAddressWriter::Write(writer, AttributeType::kXorRelayedAddress, _options.relay_address.GetUint32(), allocation->relay_port);
+    XorMappedAddressWriter::Write(writer, AttributeType::kXorMappedAddress, client.address.GetUint32(), client.port);
+    DataUint32Writer::Write(writer, AttributeType::kLifetime, (allocation->expire_tp - now) / kSec);
+    SendResponse(std::move(packet), client, writer, allocation->hasher);
+}
+
+void TurnServer::OnRefreshRequest(Buffer&& packet, AllocationTable::Id id, const Request& request) {
+    auto& allocation = *_allocations.Get(id);
+    const auto client = allocation.client;
+    const size_t requested = request.lifetime.value_or(kLifetimeDefaultSec);
+    const auto lifetime = (requested == 0) ? 0 : std::clamp<size_t>(requested, kLifetimeDefaultSec, kLifetimeMaxSec);
+
+    stun::Writer writer(packet.GetViewWithCapacity(), kRefreshResponse);
+    DataUint32Writer::Write(writer, AttributeType::kLifetime, lifetime);
+    SendResponse(std::move(packet), client, writer, allocation.hasher);
+
+    if(lifetime == 0) {
+        TAU_LOG_INFO(_options.log_ctx << "Allocation deleted, client: " << client << ", relay port: " << allocation.relay_port);
+        RemoveAllocation(id);
+    } else {
+        allocation.expire_tp = _deps.clock.Now() + lifetime * kSec;
+        _expirations.Schedule(id, allocation.expire_tp);
+    }
+}
+
+void TurnServer::OnCreatePermissionRequest(Buffer&& packet, AllocationTable::Allocation& allocation, const Request& request) {
+    if(request.peers.empty()) {
+        return SendErrorResponse(std::move(packet), allocation.client, request.type, ErrorCode::kBadRequest, allocation.hasher);
+    }
+    const auto now = _deps.clock.Now();
+    for(auto& peer : request.peers) {
+        if(!IsPeerAllowed(peer.address)) {
+            return SendErrorResponse(std::move(packet), allocation.client, request.type, ErrorCode::kForbidden, allocation.hasher);
+        }
+    }
+    for(auto& peer : request.peers) {
+        if(!allocation.AddPermission(peer.address, now + kPermissionLifetime, now)) {
+            return SendErrorResponse(std::move(packet), allocation.client, request.type, ErrorCode::kInsufficientCapacity, allocation.hasher);
+        }
+    }
+    stun::Writer writer(packet.GetViewWithCapacity(), kCreatePermissionResponse);
+    SendResponse(std::move(packet), allocation.client, writer, allocation.hasher);
+}
+
+void TurnServer::OnChannelBindRequest(Buffer&& packet, AllocationTable::Allocation& allocation, const Request& request) {
+    if(!request.channel || !IsChannelNumberValid(*request.channel) || (request.peers.size() != 1)) {
+        return SendErrorResponse(std::move(packet), allocation.client, request.type, ErrorCode::kBadRequest, allocation.hasher);
+    }
+    const auto now = _deps.clock.Now();
+    const auto peer = request.peers.front();
+    if(!IsPeerAllowed(peer.address)) {
+        return SendErrorResponse(std::move(packet), allocation.client, request.type, ErrorCode::kForbidden, allocation.hasher);
+    }
+    const auto bound = allocation.FindChannel(*request.channel, now);
+    const auto bound_expire_tp = bound ? std::optional<Timepoint>{bound->expire_tp} : std::nullopt;
+    if(!allocation.BindChannel(*request.channel, peer, now + kChannelLifetime, now)) {
+        return SendErrorResponse(std::move(packet), allocation.client, request.type, ErrorCode::kBadRequest, allocation.hasher);
+    }
+    if(!allocation.AddPermission(peer.address, now + kPermissionLifetime, now)) {
+        if(bound_expire_tp) {
+            allocation.BindChannel(*request.channel, peer, *bound_expire_tp, now); // the refresh is rolled back
+        } else {
+            allocation.UnbindChannel(*request.channel);
+        }
+        return SendErrorResponse(std::move(packet), allocation.client, request.type, ErrorCode::kInsufficientCapacity, allocation.hasher);
+    }
+    stun::Writer writer(packet.GetViewWithCapacity(), kChannelBindResponse);
+    SendResponse(std::move(packet), allocation.client, writer, allocation.hasher);
+}
+
+void TurnServer::OnSendIndication(Buffer&& packet, AllocationTable::Allocation& allocation, const Request& request) {
+    if((request.peers.size() != 1) || !request.data) {
+        return Drop("Wrong send indication");
+    }
+    const auto peer = request.peers.front();
+    if(!IsPeerAllowed(peer.address)) {
+        return Drop("Forbidden peer");
+    }
+    if(!allocation.HasPermission(peer.address, _deps.clock.Now())) {
+        return Drop("No permission");
+    }
+    packet.TrimFront(request.data->ptr - packet.GetView().ptr);
+    packet.SetSize(request.data->size);
+    _stats.to_peer++;
+    _relay_callback(allocation.relay_port, std::move(packet), peer);
+}
+
+void TurnServer::OnChannelData(Buffer&& packet, Endpoint client) {
+    const auto view = ToConst(packet.GetView());
+    if(!ChannelDataReader::Validate(view)) {
+        return Drop("Invalid channel data");
+    }
+    const auto id = _allocations.FindByClient(client);
+    if(!id) {
+        return Drop("Channel data without allocation");
+    }
+    auto& allocation = *_allocations.Get(*id);
+    const auto channel = allocation.FindChannel(ChannelDataReader::GetChannelNumber(view), _deps.clock.Now());
+    if(!channel) {
+        return Drop("Unknown channel");
+    }
+    packet.TrimFront(kChannelDataHeaderSize);
+    packet.SetSize(ChannelDataReader::GetData(view).size);
+    _stats.to_peer++;
+    _relay_callback(allocation.relay_port, std::move(packet), channel->peer);
+}
+
+void TurnServer::OnBindingRequest(Buffer&& packet, Endpoint client) {
+    const auto size = _binding_responder.Process(ToConst(packet.GetView()), client.address.GetUint32(), client.port, packet.GetViewWithCapacity());
+    if(size == 0) {
+        return Drop("Invalid binding request");
+    }
+    packet.SetSize(size);
+    _send_callback(std::move(packet), client);
+}
+
+bool TurnServer::Authenticate(Buffer& packet, Endpoint client, const Request& request) {
+    auto& allocation = *_allocations.Get(*_allocations.FindByClient(client));
+    if(!request.message_integrity || request.user.empty()) {
+        SendUnauthorized(std::move(packet), client, request.type, ErrorCode::kUnauthorized);
+        return false;
+    }
+    if(request.user != etl::string_view{allocation.user.data(), allocation.user.size()}) {
+        SendErrorResponse(std::move(packet), client, request.type, ErrorCode::kWrongCredentials, nullptr);
+        return false;
+    }
+    if(!IsNonceValid(request.nonce)) {
+        SendUnauthorized(std::move(packet), client, request.type, ErrorCode::kStaleNonce);
+        return false;
+    }
+    if(!MessageIntegrityReader::Validate(*request.message_integrity, ToConst(packet.GetView()), *allocation.hasher)) {
+        SendUnauthorized(std::move(packet), client, request.type, ErrorCode::kUnauthorized);
+        return false;
+    }
+    allocation.nonce.assign(request.nonce.data(), request.nonce.size()); // the client switched to the rotated nonce
+    return true;
+}
+
+void TurnServer::SendResponse(Buffer&& packet, Endpoint client, stun::Writer& writer, crypto::HmacHasher* hasher) {
+    if(hasher) {
+        MessageIntegrityWriter::Write(writer, *hasher);
+    }
+    FingerprintWriter::Write(writer);
+    packet.SetSize(writer.GetSize());
+    _send_callback(std::move(packet), client);
+}
+
+void TurnServer::SendErrorResponse(Buffer&& packet, Endpoint client, uint16_t type, uint16_t code, crypto::HmacHasher* hasher) {
+    _stats.error_responses++;
+    stun::Writer writer(packet.GetViewWithCapacity(), type | Type::kErrorResponse);
+    ErrorCodeWriter::Write(writer, code);
+    SendResponse(std::move(packet), client, writer, hasher);
+}
+
+void TurnServer::SendUnauthorized(Buffer&& packet, Endpoint client, uint16_t type, uint16_t code) {
+    _stats.error_responses++;
+    stun::Writer writer(packet.GetViewWithCapacity(), type | Type::kErrorResponse);
+    ErrorCodeWriter::Write(writer, code);
+    ByteStringWriter::Write(writer, AttributeType::kRealm, etl::string_view{_options.realm.data(), _options.realm.size()});
+    ByteStringWriter::Write(writer, AttributeType::kNonce, _nonce);
+    SendResponse(std::move(packet), client, writer, nullptr);
+}
+
+void TurnServer::RemoveAllocation(AllocationTable::Id id) {
+    const auto relay_port = _allocations.Get(id)->relay_port;
+    _allocations.Erase(id);
+    _expirations.Cancel(id);
+    _close_relay_callback(relay_port);
+}
+
+void TurnServer::Drop(etl::string_view reason) {
+    TAU_LOG_WARNING_THR(128, _options.log_ctx << reason);
+    _stats.dropped++;
+}
+
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "apps/turn-server/AllocationTable.h"
+#include "tau/stun/BindingResponder.h"
+#include "tau/stun/Writer.h"
+#include "tau/stun/AttributeType.h"
+#include "tau/stun/attribute/XorMappedAddress.h"
+#include "tau/common/TimerWheel.h"
+#include "tau/memory/Buffer.h"
+#include <etl/vector.h>
+#include <functional>
+#include <unordered_map>
+
+namespace tau {
+
+// TURN server core (RFC 8656, UDP relay only) with long-term credentials, sans-IO like ice::TurnClient:
+// the owner delivers datagrams and calls Process(), packets go out by callbacks.
+// Relayed payload never leaves its pooled buffer: Send indication/ChannelData headers are trimmed in place,
+// Data indication/ChannelData headers are prepended into the headroom of the received buffer (see kRelayHeadroom)
+class TurnServer {
+public:
+    // Data indication header: STUN header, XOR-PEER-ADDRESS and DATA attribute header
+    static constexpr size_t kRelayHeadroom = stun::kMessageHeaderSize
+        + stun::kAttributeHeaderSize + stun::attribute::IPv4PayloadSize + stun::kAttributeHeaderSize;
+    static constexpr size_t kLifetimeDefaultSec = 600;
+    static constexpr size_t kLifetimeMaxSec = 3600;
+    static constexpr Timepoint kPermissionLifetime = 5 * kMin;
+    static constexpr Timepoint kChannelLifetime = 10 * kMin;
+    static constexpr Timepoint kNonceLifetime = 60 * kMin;
+
+    struct Dependencies {
+        Clock& clock;
+        Allocator& udp_allocator;
+    };
+
+    struct Options {
+        IpAddress relay_address; // XOR-RELAYED-ADDRESS, public address of relay sockets
+        std::unordered_map<std::string, std::string> users; // user name -> password
+        std::string realm = "tau";
+        size_t max_allocations = 1024;
+        bool allow_private_peers = false; // loopback, link-local and RFC 1918 peer addresses (RFC 8656 section 21.3)
+        etl::string_view software = "TAU WebRTC Library";
+        etl::string_view log_ctx = {};
+    };
+
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t error_responses = 0;
+        uint64_t to_peer = 0;
+        uint64_t to_client = 0;
+        uint64_t to_client_copied = 0; // no headroom in the received buffer
+        uint64_t dropped = 0;
+    };
+
+    using SendCallback = std::function<void(Buffer&& packet, Endpoint client)>;
+    using RelayCallback = std::function<void(uint16_t relay_port, Buffer&& packet, Endpoint peer)>;
+    using OpenRelayCallback = std::function<std::optional<uint16_t>()>; // returns local port of a new relay socket
+    using CloseRelayCallback = std::function<void(uint16_t relay_port)>;
+
+public:
+    TurnServer(Dependencies&& deps, Options&& options);
+
+    void SetSendCallback(SendCallback callback) { _send_callback = std::move(callback); }
+    void SetRelayCallback(RelayCallback callback) { _relay_callback = std::move(callback); }
+    void SetOpenRelayCallback(OpenRelayCallback callback) { _open_relay_callback = std::move(callback); }
+    void SetCloseRelayCallback(CloseRelayCallback callback) { _close_relay_callback = std::move(callback); }
+
+    void RecvFromClient(Buffer&& packet, Endpoint client);
+    void RecvFromPeer(uint16_t relay_port, Buffer&& packet, Endpoint peer);
+
+    void Process(); // expires allocations, rotates the nonce
+    std::optional<Timepoint> GetNextDeadline() const;
+
+    size_t GetAllocationsCount() const { return _allocations.GetSize(); }
+    const Stats& GetStats() const { return _stats; }
+
+private:
+    struct Request {
+        uint16_t type;
+        uint32_t hash;
+        etl::string_view user = {};
+        etl::string_view realm = {};
+        etl::string_view nonce = {};
+        std::optional<BufferViewConst> message_integrity = {};
+        std::optional<uint32_t> lifetime = {};
+        std::optional<uint32_t> requested_transport = {};
+        std::optional<uint16_t> channel = {};
+        etl::vector<Endpoint, AllocationTable::kMaxPermissions> peers = {};
+        std::optional<BufferViewConst> data = {};
+    };
+
+    bool ParseRequest(const BufferViewConst& view, Request& request) const;
+    bool IsPeerAllowed(const IpAddress& address) const;
+    bool IsNonceValid(etl::string_view nonce) const;
+    void RotateNonce();
+
+    void OnAllocateRequest(Buffer&& packet, Endpoint client, const Request& request);
+    void OnRefreshRequest(Buffer&& packet, AllocationTable::Id id, const Request& request);
+    void OnCreatePermissionRequest(Buffer&& packet, AllocationTable::Allocation& allocation, const Request& request);
+    void OnChannelBindRequest(Buffer&& packet, AllocationTable::Allocation& allocation, const Request& request);
+    void OnSendIndication(Buffer&& packet, AllocationTable::Allocation& allocation, const Request& request);
+    void OnChannelData(Buffer&& packet, Endpoint client);
+    void OnBindingRequest(Buffer&& packet, Endpoint client);
+
+    // validates the request of the existing allocation, sends the error response on failure
+    bool Authenticate(Buffer& packet, Endpoint client, const Request& request);
+
+    void SendResponse(Buffer&& packet, Endpoint client, stun::Writer& writer, crypto::HmacHasher* hasher);
+    void SendErrorResponse(Buffer&& packet, Endpoint client, uint16_t type, uint16_t code, crypto::HmacHasher* hasher);
+    void SendUnauthorized(Buffer&& packet, Endpoint client, uint16_t type, uint16_t code);
+    void RemoveAllocation(AllocationTable::Id id);
+    void Drop(etl::string_view reason);
+
+private:
+    Dependencies _deps;
+    const Options _options;
+    const stun::BindingResponder _binding_responder;
+    std::unordered_map<std::string, crypto::HmacHasher> _hashers; // user name -> long-term key, the key is set up once
+    AllocationTable _allocations;
+    TimerWheel _expirations;
+
+    etl::string<32> _nonce;
+    etl::string<32> _prev_nonce;
+    Timepoint _nonce_rotation_tp;
+
+    Stats _stats;
+
+    SendCallback _send_callback;
+    RelayCallback _relay_callback;
+    OpenRelayCallback _open_relay_callback;
+    CloseRelayCallback _close_relay_callback;
+};
+
+}
@@ -12,7 +12,8 @@ Session::Session(Dependencies&& deps, ws::ConnectionPtr connection)
     , _timeout_tp(_clock.Now() + 10 * kMin)
     , _id(CreateRandomId())
     , _log_ctx(CreateLogCtx(_id))
-    , _timer(deps.executor)
+    , _executor(deps.executor)
+    , _timer(_executor)
     , _pc(webrtc::PeerConnection::Dependencies{
             .clock = deps.clock,
             .udp_allocator = deps.udp_allocator
@@ -31,9 +32,29 @@ Session::Session(Dependencies&& deps, ws::ConnectionPtr connection)
     PcInitCallbacks();
 }
 
+std::shared_ptr<Session> Session::CreateAndStart(Dependencies&& deps, ws::ConnectionPtr connection) {
+    auto session = std::make_shared<Session>(std::move(deps), std::move(connection));
+    // PeerConnection is processed at its deadlines only, incoming candidates and packets wake it up earlier
+    session->_pc.SetWakeupCallback([weak_self = session->weak_from_this()]() {
+        if(auto self = weak_self.lock()) {
+            asio::post(self->_executor, [weak_self]() {
+                if(auto self = weak_self.lock()) {
+                    self->ScheduleProcess();
+                }
+            });
+        }
+    });
+    asio::post(session->_executor, [weak_self = session->weak_from_this()]() {
+        if(auto self = weak_self.lock()) {
+            self->ScheduleProcess();
+        }
+    });
+    return session;
+}
+
 Session::~Session() {
     TAU_LOG_INFO(_log_ctx);
-    _timer.Stop();
+    _timer.cancel();
     _pc.Stop();
 }
 
@@ -74,21 +95,32 @@ void Session::PcInitCallbacks() {
             }
         }
     });
+}
 
-    _timer.Start(10, [this](boost_ec ec) {
+void Session::ScheduleProcess() {
+    const auto now = _clock.Now();
+    const auto deadline = std::min(_pc.GetNextDeadline().value_or(_timeout_tp), _timeout_tp);
+    _timer.expires_after(std::chrono::nanoseconds((deadline > now) ? (deadline - now) : 0)); // cancels the pending wait
+    _timer.async_wait([weak_self = weak_from_this()](boost_ec ec) {
         if(ec) {
-            return false;
+            return;
         }
-        if(_clock.Now() > _timeout_tp) {
-            TAU_LOG_INFO(_log_ctx << "Close on timeout");
-            CloseConnection();
-            return false;
+        if(auto self = weak_self.lock()) {
+            self->OnTimer();
         }
-        _pc.Process();
-        return true;
     });
 }
 
+void Session::OnTimer() {
+    if(_clock.Now() > _timeout_tp) {
+        TAU_LOG_INFO(_log_ctx << "Close on timeout");
+        CloseConnection();
+        return;
+    }
+    _pc.Process();
+    ScheduleProcess();
+}
+
 ws::String Session::OnRequest(ws::String request_str) {
     try {
         auto request = Json::parse(request_str.data());
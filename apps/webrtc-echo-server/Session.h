@@ -2,12 +2,12 @@
 
 #include "tau/webrtc/PeerConnection.h"
 #include "tau/ws/Connection.h"
-#include "tau/asio/PeriodicTimer.h"
+#include "tau/asio/Timer.h"
 #include "tau/common/Json.h"
 
 namespace tau {
 
-class Session {
+class Session : public std::enable_shared_from_this<Session> {
 public:
     struct Dependencies {
         Executor executor;
@@ -17,12 +17,15 @@ public:
 
 public:
     Session(Dependencies&& deps, ws::ConnectionPtr connection);
+    static std::shared_ptr<Session> CreateAndStart(Dependencies&& deps, ws::ConnectionPtr connection);
     ~Session();
 
     bool IsActive() const;
 
 private:
     void PcInitCallbacks();
+    void ScheduleProcess(); // at the PeerConnection deadline
+    void OnTimer();
 
     ws::String OnRequest(ws::String request);
     ws::String OnSdpOffer(const Json::value& request);
@@ -42,12 +45,13 @@ private:
     etl::string<12> _id;
     etl::string<16> _log_ctx;
 
-    PeriodicTimer _timer;
+    Executor _executor;
+    Timer _timer;
     webrtc::PeerConnection _pc;
     std::vector<ice::CandidateStr> _local_ice_candidates;
     std::optional<uint32_t> _video_ssrc; // also used as SDP negotiation flag
 };
 
-using SessionPtr = std::unique_ptr<Session>;
+using SessionPtr = std::shared_ptr<Session>;
 
 }
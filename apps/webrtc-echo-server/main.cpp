@@ -4,7 +4,8 @@
 #include "tau/srtp/Common.h"
 #include "tau/crypto/Certificate.h"
 #include "tau/asio/ThreadPool.h"
-#include "tau/memory/PoolAllocator.h"
+#include "tau/asio/PeriodicTimer.h"
+#include "tau/memory/host/LockFreePoolAllocator.h"
 #include "tau/net/Uri.h"
 #include "tau/asio/ToString.h"
 #include "tau/common/File.h"
@@ -50,7 +51,7 @@ int main(int argc, char** argv) {
 
     SteadyClock clock;
     std::array<uint8_t, 4 * 1024 * 1024> allocated_memory;
-    PoolAllocator udp_allocator(allocated_memory.data(), allocated_memory.size(), 1500);
+    LockFreePoolAllocator udp_allocator(allocated_memory.data(), allocated_memory.size(), 1500); // shared by ThreadPool threads
     ThreadPool io(std::thread::hardware_concurrency());
 
     SslContextPtr ssl_ctx = CreateSslContextInternal(config->ssl);
@@ -85,7 +86,7 @@ int main(int argc, char** argv) {
     server.SetOnNewConnectionCallback([&](ws::ConnectionPtr connection) {
         connections.fetch_add(1);
         std::lock_guard lock{mutex};
-        sessions.push_back(std::make_unique<Session>(
+        sessions.push_back(Session::CreateAndStart(
             Session::Dependencies{
                 .executor = io.GetStrand(),
                 .clock = clock,
@@ -0,0 +1,133 @@
+#include "tau/common/TimerWheel.h"
+#include <algorithm>
+#include <bit>
+
+namespace tau {
+
+TimerWheel::TimerWheel(Timepoint now, Timepoint resolution)
+    : _origin(now)
+    , _resolution(resolution) {
+    _heads.fill(kNone);
+}
+
+void TimerWheel::Schedule(Id id, Timepoint deadline) {
+    if(id >= _nodes.size()) {
+        _nodes.resize(id + 1);
+    }
+    if(_nodes[id].slot != kNoSlot) {
+        Unlink(id);
+    }
+    _nodes[id].tick = std::max(ToTick(deadline), _tick + 1);
+    Insert(id);
+}
+
+void TimerWheel::Cancel(Id id) {
+    if(IsScheduled(id)) {
+        Unlink(id);
+    }
+}
+
+bool TimerWheel::IsScheduled(Id id) const {
+    return (id < _nodes.size()) && (_nodes[id].slot != kNoSlot);
+}
+
+std::optional<Timepoint> TimerWheel::GetNextExpiration() const {
+    if(_size == 0) {
+        return std::nullopt;
+    }
+    auto next_tick = std::numeric_limits<uint64_t>::max();
+    for(size_t level = 0; level < kLevels; ++level) {
+        if(_occupied[level] == 0) {
+            continue;
+        }
+        const auto shift = level * kSlotBits;
+        const auto current = static_cast<int>((_tick >> shift) & kSlotMask);
+        // the current slot of any level is empty, so the nearest one is at distance 1..kSlots-1
+        const auto distance = std::countr_zero(std::rotr(_occupied[level], current + 1)) + 1;
+        next_tick = std::min(next_tick, ((_tick >> shift) + distance) << shift);
+    }
+    return _origin + next_tick * _resolution;
+}
+
+uint64_t TimerWheel::ToTick(Timepoint tp) const {
+    if(tp <= _origin) {
+        return 0;
+    }
+    return (tp - _origin + _resolution - 1) / _resolution;
+}
+
+uint64_t TimerWheel::GetNextTick() const {
+    const auto current = _tick & kSlotMask;
+    const auto pending = (current == kSlotMask) ? 0 : (_occupied[0] & (~uint64_t{0} << (current + 1)));
+    if(pending) {
+        return (_tick & ~kSlotMask) + std::countr_zero(pending);
+    }
+    return (_tick | kSlotMask) + 1;
+}
+
+void TimerWheel::Insert(Id id) {
+    auto& node = _nodes[id];
+    size_t level = 0;
+    uint64_t slot = 0;
+    for(; level < kLevels; ++level) {
+        const auto shift = level * kSlotBits;
+        if((node.tick >> shift) - (_tick >> shift) < kSlots) {
+            slot = (node.tick >> shift) & kSlotMask;
+            break;
+        }
+    }
+    if(level == kLevels) {
+        level = kLevels - 1;
+        slot = ((_tick >> (level * kSlotBits)) + kSlotMask) & kSlotMask;
+    }
+
+    const auto idx = level * kSlots + slot;
+    node.slot = static_cast<uint16_t>(idx);
+    node.prev = kNone;
+    node.next = _heads[idx];
+    if(node.next != kNone) {
+        _nodes[node.next].prev = id;
+    }
+    _heads[idx] = id;
+    _occupied[level] |= uint64_t{1} << slot;
+    _size++;
+}
+
+void TimerWheel::Unlink(Id id) {
+    auto& node = _nodes[id];
+    if(node.prev != kNone) {
+        _nodes[node.prev].next = node.next;
+    } else {
+        _heads[node.slot] = node.next;
+        if(node.next == kNone) {
+            _occupied[node.slot / kSlots] &= ~(uint64_t{1} << (node.slot % kSlots));
+        }
+    }
+    if(node.next != kNone) {
+        _nodes[node.next].prev = node.prev;
+    }
+    node.slot = kNoSlot;
+    _size--;
+}
+
+// called on level 0 wrap, moves timers of the reached upper level slots down
+void TimerWheel::Cascade() {
+    for(size_t level = 1; level < kLevels; ++level) {
+        const auto slot = (_tick >> (level * kSlotBits)) & kSlotMask;
+        const auto idx = level * kSlots + slot;
+        auto id = _heads[idx];
+        _heads[idx] = kNone;
+        _occupied[level] &= ~(uint64_t{1} << slot);
+        while(id != kNone) {
+            const auto next = _nodes[id].next;
+            _size--;
+            Insert(id);
+            id = next;
+        }
+        if(slot != 0) {
+            break;
+        }
+    }
+}
+
+}
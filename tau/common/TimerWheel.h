@@ -0,0 +1,101 @@
+#pragma once
+
+#include "tau/common/Clock.h"
+#include <vector>
+#include <array>
+#include <optional>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+namespace tau {
+
+// Hierarchical timer wheel: kLevels x kSlots, a level 0 slot is one tick (resolution), level N slot is kSlots^N ticks.
+// Timers are identified by dense user ids (e.g. session index), every id has at most one deadline.
+// Schedule/Cancel are O(1), Advance visits occupied slots only, so idle timers cost nothing till their deadline.
+// Deadlines beyond the wheel horizon (~4.6h with 1ms resolution) are parked in the last slot and re-cascaded
+class TimerWheel {
+public:
+    static constexpr size_t kLevels = 4;
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlots = 1 << kSlotBits;
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+    static constexpr Timepoint kResolutionDefault = kMs;
+
+    using Id = uint32_t;
+
+public:
+    explicit TimerWheel(Timepoint now, Timepoint resolution = kResolutionDefault);
+
+    // deadline is never fired earlier, expired one is fired by the next Advance
+    void Schedule(Id id, Timepoint deadline);
+    void Cancel(Id id);
+    bool IsScheduled(Id id) const;
+
+    // calls callback(id) for every expired timer in deadline order (with tick accuracy),
+    // the timer is unscheduled before the call, so callback may schedule it again
+    template<typename Callback>
+    size_t Advance(Timepoint now, Callback&& callback) {
+        if(now < _origin) {
+            return 0;
+        }
+        const uint64_t target_tick = (now - _origin) / _resolution;
+        size_t expired = 0;
+        while(_tick < target_tick) {
+            if(_size == 0) {
+                _tick = target_tick;
+                break;
+            }
+            const auto next_tick = GetNextTick();
+            if(next_tick > target_tick) {
+                _tick = target_tick;
+                break;
+            }
+            _tick = next_tick;
+            if((_tick & kSlotMask) == 0) {
+                Cascade();
+            }
+
+            const auto slot = static_cast<size_t>(_tick & kSlotMask);
+            while(_heads[slot] != kNone) {
+                const auto id = _heads[slot];
+                Unlink(id);
+                expired++;
+                callback(id);
+            }
+        }
+        return expired;
+    }
+
+    // lower bound of the next Advance with some work (expiration or cascading), to sleep until
+    std::optional<Timepoint> GetNextExpiration() const;
+    size_t GetSize() const { return _size; }
+
+private:
+    static constexpr Id kNone = std::numeric_limits<Id>::max();
+    static constexpr uint16_t kNoSlot = std::numeric_limits<uint16_t>::max();
+
+    uint64_t ToTick(Timepoint tp) const;
+    uint64_t GetNextTick() const; // next tick of level 0 slot or level 0 wrap
+    void Insert(Id id);
+    void Unlink(Id id);
+    void Cascade();
+
+private:
+    const Timepoint _origin;
+    const Timepoint _resolution;
+    uint64_t _tick = 0; // all ticks up to current one are processed
+
+    struct Node {
+        uint64_t tick = 0;
+        Id prev = kNone;
+        Id next = kNone;
+        uint16_t slot = kNoSlot; // level * kSlots + slot
+    };
+    std::vector<Node> _nodes;
+    std::array<Id, kLevels * kSlots> _heads;
+    std::array<uint64_t, kLevels> _occupied = {}; // bitmap of non-empty slots per level
+    size_t _size = 0;
+};
+
+}
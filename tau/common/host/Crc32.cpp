@@ -1,12 +1,194 @@
 #include <tau/common/Crc32.h>
-#include <boost/crc.hpp>
+#include <tau/common/host/Crc32.h>
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define TAU_CRC32_PCLMUL
+#elif defined(__aarch64__) && (defined(__linux__) || defined(__APPLE__))
+    #include <arm_acle.h>
+    #if defined(__linux__)
+        #include <sys/auxv.h>
+        #include <asm/hwcap.h>
+    #endif
+    #define TAU_CRC32_ARM
+#endif
 
 namespace tau {
+namespace detail {
+
+namespace {
+
+constexpr uint32_t kPolynomial = 0xEDB88320; // reflected 0x04C11DB7
+
+using Crc32Table = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr Crc32Table CreateTable() {
+    Crc32Table table = {};
+    for(uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for(size_t bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+        }
+        table[0][i] = crc;
+    }
+    for(size_t k = 1; k < table.size(); ++k) {
+        for(size_t i = 0; i < 256; ++i) {
+            table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+        }
+    }
+    return table;
+}
+
+constexpr Crc32Table kTable = CreateTable();
+
+uint32_t Crc32Bytewise(uint32_t crc, const uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; ++i) {
+        crc = (crc >> 8) ^ kTable[0][(crc ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(TAU_CRC32_PCLMUL)
+
+// folding by carry-less multiplication: "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction",
+// Intel white paper. The constants are x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32), x^64 mod P(x) and Barrett's mu
+alignas(16) constexpr uint64_t kK1K2[2] = {0x0154442BD4, 0x01C6E41596};
+alignas(16) constexpr uint64_t kK3K4[2] = {0x01751997D0, 0x00CCAA009E};
+alignas(16) constexpr uint64_t kK5K0[2] = {0x0163CD6124, 0x0000000000};
+alignas(16) constexpr uint64_t kPoly[2] = {0x01DB710641, 0x01F7011641};
+
+constexpr size_t kPclmulMinSize = 64;
+
+// lambdas don't inherit the target attribute
+#define TAU_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+
+TAU_TARGET_PCLMUL inline __m128i Load(const uint8_t* ptr) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+
+TAU_TARGET_PCLMUL inline __m128i Fold(__m128i x, __m128i k, __m128i next) {
+    const auto lo = _mm_clmulepi64_si128(x, k, 0x00);
+    const auto hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+// size is multiple of 16 and not less than kPclmulMinSize
+TAU_TARGET_PCLMUL uint32_t Crc32Pclmul(uint32_t crc, const uint8_t* data, size_t size) {
+    auto x1 = _mm_xor_si128(Load(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    auto x2 = Load(data + 16);
+    auto x3 = Load(data + 32);
+    auto x4 = Load(data + 48);
+    data += 64;
+    size -= 64;
+
+    auto k = _mm_load_si128(reinterpret_cast<const __m128i*>(kK1K2));
+    for(; size >= 64; data += 64, size -= 64) {
+        x1 = Fold(x1, k, Load(data));
+        x2 = Fold(x2, k, Load(data + 16));
+        x3 = Fold(x3, k, Load(data + 32));
+        x4 = Fold(x4, k, Load(data + 48));
+    }
+
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(kK3K4));
+    x1 = Fold(x1, k, x2);
+    x1 = Fold(x1, k, x3);
+    x1 = Fold(x1, k, x4);
+    for(; size >= 16; data += 16, size -= 16) {
+        x1 = Fold(x1, k, Load(data));
+    }
+
+    // 128 -> 64 bits
+    const auto mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kK5K0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(kPoly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+#elif defined(TAU_CRC32_ARM)
+
+__attribute__((target("arch=armv8-a+crc")))
+uint32_t Crc32Arm(uint32_t crc, const uint8_t* data, size_t size) {
+    for(; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc = __crc32d(crc, value);
+    }
+    for(; size > 0; ++data, --size) {
+        crc = __crc32b(crc, *data);
+    }
+    return crc;
+}
+
+#endif
+
+}
+
+uint32_t Crc32SliceBy8(uint32_t crc, const uint8_t* data, size_t size) {
+    if constexpr(std::endian::native == std::endian::little) {
+        for(; size >= 8; data += 8, size -= 8) {
+            uint32_t lo, hi;
+            std::memcpy(&lo, data, sizeof(lo));
+            std::memcpy(&hi, data + sizeof(lo), sizeof(hi));
+            lo ^= crc;
+            crc = kTable[7][lo & 0xFF] ^ kTable[6][(lo >> 8) & 0xFF] ^ kTable[5][(lo >> 16) & 0xFF] ^ kTable[4][lo >> 24]
+                ^ kTable[3][hi & 0xFF] ^ kTable[2][(hi >> 8) & 0xFF] ^ kTable[1][(hi >> 16) & 0xFF] ^ kTable[0][hi >> 24];
+        }
+    }
+    return Crc32Bytewise(crc, data, size);
+}
+
+bool Crc32HardwareSupported() {
+#if defined(TAU_CRC32_PCLMUL)
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#elif defined(TAU_CRC32_ARM) && defined(__APPLE__)
+    return true;
+#elif defined(TAU_CRC32_ARM)
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+    return false;
+#endif
+}
+
+uint32_t Crc32Hardware(uint32_t crc, const uint8_t* data, size_t size) {
+    static const bool supported = Crc32HardwareSupported();
+    if(!supported) {
+        return Crc32SliceBy8(crc, data, size);
+    }
+#if defined(TAU_CRC32_PCLMUL)
+    if(size >= kPclmulMinSize) {
+        const auto folded_size = size & ~size_t{15};
+        crc = Crc32Pclmul(crc, data, folded_size);
+        data += folded_size;
+        size -= folded_size;
+    }
+    return Crc32SliceBy8(crc, data, size);
+#elif defined(TAU_CRC32_ARM)
+    return Crc32Arm(crc, data, size);
+#else
+    return Crc32SliceBy8(crc, data, size);
+#endif
+}
+
+}
 
 uint32_t Crc32(const uint8_t* data, size_t size) {
-    boost::crc_32_type crc32;
-    crc32.process_bytes(data, size);
-    return crc32.checksum();
+    using Function = uint32_t(*)(uint32_t, const uint8_t*, size_t);
+    static const Function function = detail::Crc32HardwareSupported() ? detail::Crc32Hardware : detail::Crc32SliceBy8;
+    return ~function(~uint32_t{0}, data, size);
 }
 
 }
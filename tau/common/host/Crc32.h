@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace tau::detail {
+
+// CRC-32 (ISO-HDLC, reflected 0x04C11DB7) implementations selected by Crc32() at runtime,
+// crc is the register value without the initial/final inversion
+uint32_t Crc32SliceBy8(uint32_t crc, const uint8_t* data, size_t size);
+
+// PCLMULQDQ (x86) or CRC32 instructions (ARMv8), falls back to slice-by-8 if the CPU doesn't support them
+bool Crc32HardwareSupported();
+uint32_t Crc32Hardware(uint32_t crc, const uint8_t* data, size_t size);
+
+}
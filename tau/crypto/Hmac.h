@@ -3,12 +3,14 @@
 #include "tau/memory/BufferView.h"
 #include <etl/string.h>
 #include <etl/string_view.h>
+#include <utility>
 
 namespace tau::crypto {
 
 inline constexpr size_t kHmacSha1Length = 20;
 inline constexpr size_t kHmacSha256Length = 32;
 
+// The key is processed once: inner/outer padded key states are cached, Reset() clones them for the next message
 class HmacHasher {
 public:
     enum Type {
@@ -20,6 +22,16 @@ public:
     HmacHasher(Type type, const etl::string_view& password);
     ~HmacHasher();
 
+    HmacHasher(HmacHasher&& other)
+        : _type(other._type)
+        , _password(other._password)
+        , _ctx(std::exchange(other._ctx, nullptr))
+        , _inner_ctx(std::exchange(other._inner_ctx, nullptr))
+        , _outer_ctx(std::exchange(other._outer_ctx, nullptr))
+    {}
+    HmacHasher(const HmacHasher&) = delete;
+    HmacHasher& operator=(const HmacHasher&) = delete;
+
     bool Update(const BufferViewConst& view);
     bool Finalize(uint8_t* output);
     bool Reset();
@@ -32,7 +44,8 @@ private:
     const Type _type;
     const etl::string<32> _password;
     void* _ctx = nullptr;
-    void* _pkey = nullptr;
+    void* _inner_ctx = nullptr;
+    void* _outer_ctx = nullptr;
 };
 
 }
@@ -1,8 +1,14 @@
 #include "tau/crypto/Hmac.h"
-#include <openssl/hmac.h>
+#include <openssl/evp.h>
+#include <etl/array.h>
 
 namespace tau::crypto {
 
+// https://www.rfc-editor.org/rfc/rfc2104
+inline constexpr size_t kBlockSize = 64; // SHA-1 and SHA-256
+inline constexpr uint8_t kInnerPad = 0x36;
+inline constexpr uint8_t kOuterPad = 0x5C;
+
 HmacHasher::HmacHasher(Type type, const etl::string_view& password)
     : _type(type)
     , _password(password) {
@@ -17,7 +23,7 @@ bool HmacHasher::Update(const BufferViewConst& view) {
     if(!_ctx) {
         return false;
     }
-    const auto result = EVP_DigestSignUpdate(reinterpret_cast<EVP_MD_CTX*>(_ctx), view.ptr, view.size);
+    const auto result = EVP_DigestUpdate(reinterpret_cast<EVP_MD_CTX*>(_ctx), view.ptr, view.size);
     return (result == 1);
 }
 
@@ -25,47 +31,69 @@ bool HmacHasher::Finalize(uint8_t* output) {
     if(!_ctx) {
         return false;
     }
-    auto size = (_type == Type::Sha1) ? kHmacSha1Length : kHmacSha256Length;
-    const auto result = EVP_DigestSignFinal(reinterpret_cast<EVP_MD_CTX*>(_ctx), output, &size);
-    return (result == 1);
+    auto ctx = reinterpret_cast<EVP_MD_CTX*>(_ctx);
+    etl::array<uint8_t, EVP_MAX_MD_SIZE> inner_hash;
+    unsigned int size = 0;
+    if(EVP_DigestFinal_ex(ctx, inner_hash.data(), &size) != 1) {
+        return false;
+    }
+    if(EVP_MD_CTX_copy_ex(ctx, reinterpret_cast<EVP_MD_CTX*>(_outer_ctx)) != 1) {
+        return false;
+    }
+    if(EVP_DigestUpdate(ctx, inner_hash.data(), size) != 1) {
+        return false;
+    }
+    return (EVP_DigestFinal_ex(ctx, output, &size) == 1);
 }
 
 bool HmacHasher::Reset() {
-    Deinit();
-    return Init();
-}
-
-bool HmacHasher::Init() {
-    _ctx = EVP_MD_CTX_new();
     if(!_ctx) {
         return false;
     }
+    const auto result = EVP_MD_CTX_copy_ex(reinterpret_cast<EVP_MD_CTX*>(_ctx), reinterpret_cast<EVP_MD_CTX*>(_inner_ctx));
+    return (result == 1);
+}
 
-    _pkey = EVP_PKEY_new_mac_key(EVP_PKEY_HMAC, nullptr, reinterpret_cast<const uint8_t*>(_password.data()), _password.size());
-    if(!_pkey) {
-        _ctx = nullptr;
+bool HmacHasher::Init() {
+    const auto md = (_type == Type::Sha1) ? EVP_sha1() : EVP_sha256();
+    auto ctx = EVP_MD_CTX_new();
+    auto inner_ctx = EVP_MD_CTX_new();
+    auto outer_ctx = EVP_MD_CTX_new();
+    _ctx = ctx;
+    _inner_ctx = inner_ctx;
+    _outer_ctx = outer_ctx;
+    if(!ctx || !inner_ctx || !outer_ctx) {
+        Deinit();
         return false;
     }
 
-    const auto init = EVP_DigestSignInit(reinterpret_cast<EVP_MD_CTX*>(_ctx), nullptr,
-        (_type == Type::Sha1) ? EVP_sha1() : EVP_sha256(),
-        nullptr, reinterpret_cast<EVP_PKEY*>(_pkey));
-    if(init != 1) {
-        _ctx = nullptr;
-        _pkey = nullptr;
+    // the password capacity is less than the block size, so the key is never hashed
+    etl::array<uint8_t, kBlockSize> key = {};
+    std::copy(_password.begin(), _password.end(), key.begin());
+
+    etl::array<uint8_t, kBlockSize> pad;
+    for(auto [pad_ctx, pad_value] : {std::pair{inner_ctx, kInnerPad}, std::pair{outer_ctx, kOuterPad}}) {
+        for(size_t i = 0; i < kBlockSize; ++i) {
+            pad[i] = key[i] ^ pad_value;
+        }
+        if((EVP_DigestInit_ex(pad_ctx, md, nullptr) != 1) || (EVP_DigestUpdate(pad_ctx, pad.data(), pad.size()) != 1)) {
+            Deinit();
+            return false;
+        }
+    }
+    if(!Reset()) {
+        Deinit();
         return false;
     }
     return true;
 }
 
 void HmacHasher::Deinit() {
-    if(_ctx) {
-        EVP_MD_CTX_free(reinterpret_cast<EVP_MD_CTX*>(_ctx));
-        _ctx = nullptr;
-    }
-    if(_pkey) {
-        EVP_PKEY_free(reinterpret_cast<EVP_PKEY*>(_pkey));
-        _pkey = nullptr;
+    for(auto ctx : {&_ctx, &_inner_ctx, &_outer_ctx}) {
+        if(*ctx) {
+            EVP_MD_CTX_free(reinterpret_cast<EVP_MD_CTX*>(*ctx));
+            *ctx = nullptr;
+        }
     }
 }
 
@@ -11,13 +11,13 @@ struct KeyingMaterialSize {
     size_t key;
     size_t salt;
 };
-const etl::unordered_map<Session::SrtpProfile, KeyingMaterialSize, 2> kProfileKeyingMaterialSize = {
+const etl::unordered_map<Session::SrtpProfile, KeyingMaterialSize, Session::kSrtpProfilesCount> kProfileKeyingMaterialSize = {
     {Session::SrtpProfile::kAes128CmSha1_80, KeyingMaterialSize{.key = 16, .salt = 14}},
     {Session::SrtpProfile::kAes128CmSha1_32, KeyingMaterialSize{.key = 16, .salt = 14}},
     // {Session::SrtpProfile::kAes256CmSha1_80, KeyingMaterialSize{.key = 16, .salt = 14}},
     // {Session::SrtpProfile::kAes256CmSha1_32, KeyingMaterialSize{.key = 16, .salt = 14}},
-    // {Session::SrtpProfile::kAeadAes128Gcm,   KeyingMaterialSize{.key = 16, .salt = 12}},
-    // {Session::SrtpProfile::kAeadAes256Gcm,   KeyingMaterialSize{.key = 32, .salt = 12}},
+    {Session::SrtpProfile::kAeadAes128Gcm,   KeyingMaterialSize{.key = 16, .salt = 12}},
+    {Session::SrtpProfile::kAeadAes256Gcm,   KeyingMaterialSize{.key = 32, .salt = 12}},
 };
 
 Session::Session(Dependencies&& deps, Options&& options)
@@ -168,6 +168,16 @@ std::optional<Timepoint> Session::GetTimeout() {
     return std::nullopt;
 }
 
+bool Session::IsProcessRequired() const {
+    switch(_state) {
+        case State::kWaiting:    return (_options.type == Type::kClient);
+        case State::kConnecting: return (BIO_ctrl_pending(_bio_read) > 0);
+        case State::kConnected:  return (BIO_ctrl_pending(_bio_read) > 0) || (BIO_ctrl_pending(_bio_write) > 0);
+        case State::kFailed:     return false;
+    }
+    return false;
+}
+
 std::optional<Session::SrtpProfile> Session::GetSrtpProfile() const {
     if(_state != State::kConnected) {
         return std::nullopt;
@@ -182,6 +192,8 @@ std::optional<Session::SrtpProfile> Session::GetSrtpProfile() const {
     switch(profile) {
         case SrtpProfile::kAes128CmSha1_80:
         case SrtpProfile::kAes128CmSha1_32:
+        case SrtpProfile::kAeadAes128Gcm:
+        case SrtpProfile::kAeadAes256Gcm:
             return profile;
     }
     return std::nullopt;
@@ -196,7 +208,7 @@ srtp::KeyMaterial Session::GetKeyingMaterial(bool encryption) const {
     constexpr etl::string_view kLabel = "EXTRACTOR-dtls_srtp";
     const auto& [key_size, salt_size] = kProfileKeyingMaterialSize.at(*profile);
 
-    etl::vector<uint8_t, 64> keying_material(2 * (key_size + salt_size));
+    etl::vector<uint8_t, 2 * (srtp::kKeyCapacity + srtp::kSaltCapacity)> keying_material(2 * (key_size + salt_size));
     if(!SSL_export_keying_material(_ssl, keying_material.data(), keying_material.size(), kLabel.data(), kLabel.size(), NULL, 0, 0)) {
         return {};
     }
@@ -274,8 +286,8 @@ void Session::SrtpProfilesToString(etl::istring& output, const Options& options)
             case SrtpProfile::kAes128CmSha1_32: ss << "SRTP_AES128_CM_SHA1_32"; break;
             // case SrtpProfile::kAes256CmSha1_80: ss << "SRTP_AES256_CM_SHA1_80"; break;
             // case SrtpProfile::kAes256CmSha1_32: ss << "SRTP_AES256_CM_SHA1_32"; break;
-            // case SrtpProfile::kAeadAes128Gcm:   ss << "SRTP_AEAD_AES_128_GCM"; break;
-            // case SrtpProfile::kAeadAes256Gcm:   ss << "SRTP_AEAD_AES_256_GCM"; break;
+            case SrtpProfile::kAeadAes128Gcm:   ss << "SRTP_AEAD_AES_128_GCM"; break;
+            case SrtpProfile::kAeadAes256Gcm:   ss << "SRTP_AEAD_AES_256_GCM"; break;
         }
     }
 }
@@ -33,10 +33,10 @@ public:
         kAes128CmSha1_32 = 2,
         // kAes256CmSha1_80 = 3,
         // kAes256CmSha1_32 = 4,
-        // kAeadAes128Gcm   = 7,
-        // kAeadAes256Gcm   = 8,
+        kAeadAes128Gcm   = 7,
+        kAeadAes256Gcm   = 8,
     };
-    static constexpr size_t kSrtpProfilesCount = 2;
+    static constexpr size_t kSrtpProfilesCount = 4;
 
     struct Dependencies {
         Allocator& udp_allocator;
@@ -45,7 +45,7 @@ public:
 
     struct Options{
         Type type;
-        etl::vector<SrtpProfile, 2> srtp_profiles;
+        etl::vector<SrtpProfile, kSrtpProfilesCount> srtp_profiles;
         etl::string_view remote_peer_cert_digest;
         etl::string_view log_ctx;
     };
@@ -69,6 +69,7 @@ public:
     void Recv(Buffer&& packet);
 
     std::optional<Timepoint> GetTimeout();
+    bool IsProcessRequired() const; // state transition or received/pending data isn't processed yet
 
     std::optional<SrtpProfile> GetSrtpProfile() const;
     srtp::KeyMaterial GetKeyingMaterial(bool encryption) const;
@@ -21,15 +21,10 @@ Agent::Agent(Dependencies&& deps, Options&& options)
     )
 {
     _check_list.SetSendCallback([this](size_t socket_idx, Endpoint remote, Buffer&& message) {
-        if(socket_idx < _interfaces.size()) {
-            _send_callback(socket_idx, remote, std::move(message));
-        } else {
-            auto turn_client_idx = socket_idx - _interfaces.size();
-            _turn_clients[turn_client_idx].Send(std::move(message), remote);
-        }
+        Send(socket_idx, remote, std::move(message));
     });
     InitStunClients(options.stun_servers);
-    InitTurnClients(options.turn_servers);
+    InitTurnClients(options.turn_servers, options.turn_transports);
 }
 
 Agent::~Agent() {
@@ -71,12 +66,30 @@ void Agent::Process() {
                 }
             }
         }
+        if((current_state == State::kReady) || (current_state == State::kCompleted)) {
+            BindTurnChannel();
+        }
 
         _state = current_state;
         _state_callback(_state);
     }
 }
 
+std::optional<Timepoint> Agent::GetNextDeadline() const {
+    if(_update_turn_permissions || (_state != _check_list.GetState())) {
+        return _deps.clock.Now();
+    }
+    auto deadline = _check_list.GetNextDeadline();
+    auto update = [&deadline](std::optional<Timepoint> tp) {
+        if(tp && (!deadline || (*tp < *deadline))) {
+            deadline = tp;
+        }
+    };
+    for(auto& stun_client : _stun_clients) { update(stun_client.GetNextDeadline()); }
+    for(auto& turn_client : _turn_clients) { update(turn_client.GetNextDeadline()); }
+    return deadline;
+}
+
 void Agent::RecvRemoteCandidate(CandidateStr candidate) {
     _check_list.RecvRemoteCandidate(std::move(candidate));
     _update_turn_permissions = true;
@@ -100,6 +113,15 @@ void Agent::Recv(size_t socket_idx, Endpoint remote, Buffer&& message) {
     _check_list.Recv(socket_idx, remote, std::move(message));
 }
 
+void Agent::Send(size_t socket_idx, Endpoint remote, Buffer&& message) {
+    if(socket_idx < _interfaces.size()) {
+        _send_callback(socket_idx, remote, std::move(message));
+    } else {
+        auto turn_client_idx = socket_idx - _interfaces.size();
+        _turn_clients[turn_client_idx].Send(std::move(message), remote);
+    }
+}
+
 const CandidatePair& Agent::GetBestCandidatePair() const {
     return _check_list.GetBestCandidatePair();
 }
@@ -125,8 +147,12 @@ void Agent::InitStunClients(const etl::ivector<Endpoint>& stun_servers) {
     }
 }
 
-void Agent::InitTurnClients(const etl::iunordered_map<Endpoint, PeerCredentials>& turn_servers) {
+void Agent::InitTurnClients(
+        const etl::iunordered_map<Endpoint, PeerCredentials>& turn_servers,
+        const etl::iunordered_map<Endpoint, TurnTransport>& turn_transports) {
     for(auto& [endpoint, credentials] : turn_servers) {
+        auto transport_it = turn_transports.find(endpoint);
+        const auto transport = (transport_it != turn_transports.end()) ? transport_it->second : TurnTransport::kUdp;
         for(size_t i = 0; i < _interfaces.size(); ++i) {
             size_t idx = _interfaces.size() + _turn_clients.size();
             _turn_clients.emplace_back(
@@ -137,6 +163,7 @@ void Agent::InitTurnClients(const etl::iunordered_map<Endpoint, PeerCredentials>
                 TurnClient::Options{
                     .server = endpoint,
                     .credentials = credentials,
+                    .transport = transport,
                     .log_ctx = _log_ctx
                 }
             );
@@ -154,6 +181,13 @@ void Agent::InitTurnClients(const etl::iunordered_map<Endpoint, PeerCredentials>
     }
 }
 
+void Agent::BindTurnChannel() {
+    const auto& pair = _check_list.GetBestCandidatePair();
+    if(pair.local.socket_idx && (*pair.local.socket_idx >= _interfaces.size())) {
+        _turn_clients[*pair.local.socket_idx - _interfaces.size()].BindChannel(pair.remote.endpoint);
+    }
+}
+
 void Agent::UpdateTurnPermissions() {
     if(_update_turn_permissions) {
         etl::vector<IpAddress, 8> remote_ips;
@@ -30,6 +30,7 @@ public:
         etl::vector<Endpoint, kInterfaceMaxCount> interfaces; // UDP only, only 1 endpoint (port) per IP, ordering is used as user preferences
         etl::vector<Endpoint, kStunMaxCount> stun_servers;
         etl::unordered_map<Endpoint, PeerCredentials, kTurnMaxCount> turn_servers;
+        etl::unordered_map<Endpoint, TurnTransport, kTurnMaxCount> turn_transports = {}; // UDP if not set
         NominatingStrategy nominating_strategy = NominatingStrategy::kBestValid;
         etl::string_view log_ctx = {};
     };
@@ -45,17 +46,22 @@ public:
 
     void Start();
     void Process();
+    std::optional<Timepoint> GetNextDeadline() const;
 
     void RecvRemoteCandidate(CandidateStr candidate);
     void Recv(size_t socket_idx, Endpoint remote, Buffer&& message);
+    void Send(size_t socket_idx, Endpoint remote, Buffer&& message); // relayed socket_idx is sent by TURN client
 
     const CandidatePair& GetBestCandidatePair() const;
 
 private:
     void InitStunClients(const etl::ivector<Endpoint>& stun_servers);
-    void InitTurnClients(const etl::iunordered_map<Endpoint, PeerCredentials>& turn_servers);
+    void InitTurnClients(
+        const etl::iunordered_map<Endpoint, PeerCredentials>& turn_servers,
+        const etl::iunordered_map<Endpoint, TurnTransport>& turn_transports);
 
     void UpdateTurnPermissions();
+    void BindTurnChannel(); // selected pair is relayed: ChannelData instead of Send/Data indications
 
 private:
     Dependencies _deps;
@@ -172,6 +172,22 @@ State CheckList::GetState() const {
     return State::kRunning;
 }
 
+std::optional<Timepoint> CheckList::GetNextDeadline() const {
+    if(_pairs.empty()) {
+        return std::nullopt;
+    }
+    const auto next_ta_tp = _last_ta_tp + kTaDefault;
+    if((_role == Role::kControlling) && (_pairs.front().state == CandidatePair::State::kSucceeded)) {
+        return next_ta_tp;
+    }
+    for(auto& pair : _pairs) {
+        if((pair.state <= CandidatePair::State::kInProgress) || (pair.state == CandidatePair::State::kNominating)) {
+            return next_ta_tp;
+        }
+    }
+    return std::nullopt;
+}
+
 const CandidatePair& CheckList::GetBestCandidatePair() const {
     return _pairs.front();
 }
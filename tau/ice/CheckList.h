@@ -53,6 +53,7 @@ public:
     void Recv(size_t socket_idx, Endpoint remote, Buffer&& message);
 
     State GetState() const;
+    std::optional<Timepoint> GetNextDeadline() const; // Ta paced, none if there is nothing to check
     const CandidatePair& GetBestCandidatePair() const;
     void GetRemoteIps(etl::ivector<IpAddress>& remote_ips);
 
@@ -78,6 +78,10 @@ void StunClient::OnStunResponse(const BufferViewConst& view) {
     }
 }
 
+Timepoint StunClient::GetNextDeadline() const {
+    return _transaction_tracker.GetLastTimepoint(0) + WaitPeriodToNextRequest();
+}
+
 Timepoint StunClient::WaitPeriodToNextRequest() const {
     if(!_reflexive || _transaction_tracker.HasTransaction(_transaction_hash)) {
         return kRtoDefault;
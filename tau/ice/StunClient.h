@@ -25,6 +25,7 @@ public:
 
     void Process();
     void Recv(Buffer&& message);
+    Timepoint GetNextDeadline() const;
 
     bool IsServerEndpoint(Endpoint remote) const;
 
@@ -1,12 +1,14 @@
 #include "tau/ice/TurnClient.h"
 #include "tau/stun/Reader.h"
 #include "tau/stun/Writer.h"
+#include "tau/stun/StreamFramer.h"
 #include "tau/stun/attribute/XorMappedAddress.h"
 #include "tau/stun/attribute/DataUint32.h"
 #include "tau/stun/attribute/ByteString.h"
 #include "tau/stun/attribute/Data.h"
 #include "tau/stun/attribute/MessageIntegrity.h"
 #include "tau/stun/attribute/Fingerprint.h"
+#include "tau/stun/attribute/ErrorCode.h"
 #include "tau/crypto/Md5.h"
 #include "tau/common/Container.h"
 #include "tau/common/Log.h"
@@ -28,22 +30,25 @@ TurnClient::TurnClient(Dependencies&& deps, Options&& options)
 
 void TurnClient::Process() {
     if(_stopped) { return; }
-    if(_deps.clock.Now() < _next_request_tp) {
-        ProcessPermissionsRto();
-        return;
-    }
-
-    if(!_relayed) {
-        SendAllocationRequest(!_realm.empty());
-    } else {
-        if(_deps.clock.Now() + 10 * kSec >= _allocation_eol) {
-            SendRefreshRequest();
+    const auto now = _deps.clock.Now();
+    if(now >= _next_request_tp) {
+        if(!_relayed) {
+            return SendAllocationRequest(!_realm.empty());
+        }
+        if(now + 10 * kSec >= _allocation_eol) {
+            return SendRefreshRequest();
         }
+        _next_request_tp = _allocation_eol - 10 * kSec;
     }
+    ProcessPermissionsRto();
+    ProcessChannels();
 }
 
 void TurnClient::Recv(Buffer&& message) {
     auto view = ToConst(message.GetView());
+    if(ChannelDataReader::IsChannelData(view)) {
+        return OnChannelData(std::move(message));
+    }
     if(!Reader::Validate(view)) {
         TAU_LOG_WARNING(_options.log_ctx << "Invalid stun message");
         return;
@@ -53,6 +58,8 @@ void TurnClient::Recv(Buffer&& message) {
     const auto hash = HeaderReader::GetTransactionIdHash(view);
     switch(type) {
         case kCreatePermissionResponse: return OnCreatePermissionResponse(hash);
+        case kChannelBindResponse:      return OnChannelBindResponse(view, hash, true);
+        case kChannelBindErrorResponse: return OnChannelBindResponse(view, hash, false);
         case kDataIndication:           return OnDataIndication(std::move(message));
         default:
             if((hash != _transaction_hash) && !_transaction_tracker.HasTransaction(hash)) {
@@ -66,6 +73,19 @@ void TurnClient::Recv(Buffer&& message) {
 }
 
 void TurnClient::Send(Buffer&& packet, Endpoint remote) {
+    auto channel_it = _channels.find(remote);
+    if(channel_it != _channels.end()) {
+        if(channel_it->second.done) {
+            SendChannelData(std::move(packet), channel_it->second.number);
+        } else {
+            auto& queue = _queue[remote];
+            if(!queue.full()) {
+                queue.emplace_back(std::move(packet));
+            }
+        }
+        return;
+    }
+
     auto it = _permissions.find(remote.address);
     if(it != _permissions.end()) {
         if(it->second.done) {
@@ -106,6 +126,32 @@ bool TurnClient::HasPermission(IpAddress remote) {
     return false;
 }
 
+void TurnClient::BindChannel(Endpoint remote) {
+    if(_stopped || !_relayed || _channels.full() || Contains(_channels, remote)) {
+        return;
+    }
+    if(!IsChannelNumberValid(_next_channel)) {
+        TAU_LOG_WARNING(_options.log_ctx << "No channel numbers left");
+        return;
+    }
+    const auto number = _next_channel++;
+    _channels.insert(etl::make_pair(remote, Channel{
+        .number = number,
+        .done = false,
+        .request_tp = _deps.clock.Now() + kRtoDefault,
+        .attempts = 1
+    }));
+    SendChannelBindRequest(remote, number);
+}
+
+bool TurnClient::HasChannel(Endpoint remote) const {
+    auto it = _channels.find(remote);
+    if(it != _channels.end()) {
+        return it->second.done;
+    }
+    return false;
+}
+
 void TurnClient::Stop() {
     TAU_LOG_WARNING("Stopping");
     if(!_stopped) {
@@ -124,6 +170,22 @@ bool TurnClient::IsServerEndpoint(Endpoint remote) const {
     return (remote == _options.server);
 }
 
+std::optional<Timepoint> TurnClient::GetNextDeadline() const {
+    if(_stopped) {
+        return std::nullopt;
+    }
+    auto deadline = _next_request_tp;
+    for(auto& [_, permission] : _permissions) {
+        if(!permission.done) {
+            deadline = std::min(deadline, permission.rto_tp);
+        }
+    }
+    for(auto& [_, channel] : _channels) {
+        deadline = std::min(deadline, channel.request_tp);
+    }
+    return deadline;
+}
+
 void TurnClient::ProcessPermissionsRto() {
     const auto now = _deps.clock.Now();
     for(auto& [remote, permission] : _permissions) {
@@ -137,6 +199,26 @@ void TurnClient::ProcessPermissionsRto() {
     }
 }
 
+void TurnClient::ProcessChannels() {
+    const auto now = _deps.clock.Now();
+    for(auto& [remote, channel] : _channels) {
+        if(now < channel.request_tp) {
+            continue;
+        }
+        if(channel.attempts >= kChannelBindAttempts) { // bind or refresh isn't answered
+            TAU_LOG_WARNING(_options.log_ctx << "Channel bind failed, remote: " << net::ToString(remote) << ", done: " << channel.done);
+            const auto peer = remote;
+            _channels.erase(peer);
+            SendQueued(peer); // by Send indications
+            break;
+        }
+        channel.request_tp = now + kRtoDefault;
+        channel.attempts++;
+        SendChannelBindRequest(remote, channel.number);
+        break;
+    }
+}
+
 void TurnClient::SendAllocationRequest(bool authenticated) {
     auto request = Buffer::Create(_deps.udp_allocator);
     auto view = request.GetViewWithCapacity();
@@ -152,13 +234,10 @@ void TurnClient::SendAllocationRequest(bool authenticated) {
         ByteStringWriter::Write(writer, AttributeType::kRealm, _realm);
         ByteStringWriter::Write(writer, AttributeType::kNonce, _nonce);
 
-        etl::array<uint8_t, crypto::kMd5DigestLength> hash;
-        if(!CalcLongTermPassword(_options.credentials, _realm, hash.data())) {
+        if(!_message_integrity_hasher) {
             return;
         }
-        const etl::string_view password{reinterpret_cast<char*>(hash.data()), hash.size()};
-        crypto::HmacHasher hasher(crypto::HmacHasher::Type::Sha1, password);
-        MessageIntegrityWriter::Write(writer, hasher);
+        MessageIntegrityWriter::Write(writer, *_message_integrity_hasher);
         FingerprintWriter::Write(writer);
     }
     request.SetSize(writer.GetSize());
@@ -207,6 +286,25 @@ void TurnClient::SendCreatePermissionRequest(IpAddress remote) {
     _send_callback(_options.server, std::move(request));
 }
 
+void TurnClient::SendChannelBindRequest(Endpoint remote, uint16_t channel) {
+    auto request = Buffer::Create(_deps.udp_allocator);
+    auto view = request.GetViewWithCapacity();
+    stun::Writer writer(view, kChannelBindRequest);
+    _transaction_tracker.SetTransactionId(view, channel);
+
+    DataUint32Writer::Write(writer, AttributeType::kChannelNumber, static_cast<uint32_t>(channel) << 16);
+    XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, remote.address.GetUint32(), remote.port);
+    ByteStringWriter::Write(writer, AttributeType::kUserName, _options.credentials.ufrag);
+    ByteStringWriter::Write(writer, AttributeType::kRealm, _realm);
+    ByteStringWriter::Write(writer, AttributeType::kNonce, _nonce);
+    MessageIntegrityWriter::Write(writer, *_message_integrity_hasher);
+    FingerprintWriter::Write(writer);
+
+    request.SetSize(writer.GetSize());
+
+    _send_callback(_options.server, std::move(request));
+}
+
 void TurnClient::SendDataIndication(Buffer&& packet, Endpoint remote) {
     auto indication = Buffer::Create(_deps.udp_allocator);
     auto view = indication.GetViewWithCapacity();
@@ -216,12 +314,51 @@ void TurnClient::SendDataIndication(Buffer&& packet, Endpoint remote) {
 
     XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, remote.address.GetUint32(), remote.port);
     //TODO: DONT-FRAGMENT attribute
-    DataWriter::Write(writer, ToConst(packet.GetView()));
+    if(!DataWriter::Write(writer, ToConst(packet.GetView()))) {
+        TAU_LOG_WARNING_THR(128, _options.log_ctx << "Too big packet for Send indication: " << packet.GetSize());
+        return;
+    }
     indication.SetSize(writer.GetSize());
 
     _send_callback(_options.server, std::move(indication));
 }
 
+void TurnClient::SendChannelData(Buffer&& packet, uint16_t channel) {
+    const auto size = packet.GetSize();
+    const auto padding = (_options.transport == TurnTransport::kUdp)
+        ? 0
+        : stun::StreamFramer::GetChannelDataPadding(kChannelDataHeaderSize + size);
+    if(packet.IsShared() || (packet.GetTailroom() < padding) || !packet.Prepend(kChannelDataHeaderSize)) {
+        auto message = Buffer::Create(_deps.udp_allocator);
+        if(message.GetCapacity() < kChannelDataHeaderSize + size + padding) {
+            TAU_LOG_WARNING_THR(128, _options.log_ctx << "Too big packet: " << size);
+            return;
+        }
+        std::memcpy(message.GetView().ptr + kChannelDataHeaderSize, packet.GetView().ptr, size);
+        message.SetSize(kChannelDataHeaderSize + size);
+        packet = std::move(message);
+    }
+    ChannelDataWriter::WriteHeader(packet.GetView(), channel, size);
+    if(padding) {
+        packet.SetSize(kChannelDataHeaderSize + size + padding);
+        std::memset(packet.GetView().ptr + kChannelDataHeaderSize + size, 0, padding);
+    }
+
+    _send_callback(_options.server, std::move(packet));
+}
+
+void TurnClient::SendQueued(Endpoint remote) {
+    auto it = _queue.find(remote);
+    if(it == _queue.end()) {
+        return;
+    }
+    auto packets = std::move(it->second);
+    _queue.erase(it);
+    for(auto& packet : packets) {
+        Send(std::move(packet), remote);
+    }
+}
+
 void TurnClient::OnStunResponse(const BufferViewConst& view) {
     auto ok = Reader::ForEachAttribute(view, [&, this](AttributeType type, BufferViewConst attr) {
         switch(type) {
@@ -292,6 +429,72 @@ void TurnClient::OnCreatePermissionResponse(uint32_t hash) {
     _transaction_tracker.RemoveTransaction(hash);
 }
 
+void TurnClient::OnChannelBindResponse(const BufferViewConst& view, uint32_t hash, bool success) {
+    auto result = _transaction_tracker.HasTransaction(hash);
+    if(!result) {
+        TAU_LOG_WARNING(_options.log_ctx << "Unknown hash: " << hash);
+        return;
+    }
+    _transaction_tracker.RemoveTransaction(hash);
+
+    for(auto& [remote, channel] : _channels) {
+        if(channel.number != result->tag) {
+            continue;
+        }
+        if(success) {
+            channel.request_tp = _deps.clock.Now() + kChannelRefreshPeriod;
+            channel.attempts = 0;
+            if(!channel.done) {
+                channel.done = true;
+                SendQueued(remote);
+            }
+            return;
+        }
+
+        bool stale_nonce = false;
+        Reader::ForEachAttribute(view, [&](AttributeType type, BufferViewConst attr) {
+            switch(type) {
+                case AttributeType::kErrorCode:
+                    stale_nonce = (ErrorCodeReader::GetCode(attr) == ErrorCode::kStaleNonce);
+                    break;
+                case AttributeType::kNonce:
+                    _nonce = ByteStringReader::GetValue(attr);
+                    break;
+                default:
+                    break;
+            }
+            return true;
+        });
+        if(stale_nonce) {
+            channel.request_tp = _deps.clock.Now(); // retry with the new nonce
+            return;
+        }
+        TAU_LOG_WARNING(_options.log_ctx << "Channel bind rejected, remote: " << net::ToString(remote));
+        const auto peer = remote;
+        _channels.erase(peer);
+        SendQueued(peer); // by Send indications
+        return;
+    }
+}
+
+void TurnClient::OnChannelData(Buffer&& message) {
+    const auto view = ToConst(message.GetView());
+    if(!ChannelDataReader::Validate(view)) {
+        TAU_LOG_WARNING_THR(128, _options.log_ctx << "Invalid channel data");
+        return;
+    }
+    const auto number = ChannelDataReader::GetChannelNumber(view);
+    for(auto& [remote, channel] : _channels) {
+        if(channel.done && (channel.number == number)) {
+            message.TrimFront(kChannelDataHeaderSize);
+            message.SetSize(ChannelDataReader::GetData(view).size);
+            _recv_callback(remote, std::move(message));
+            return;
+        }
+    }
+    TAU_LOG_WARNING_THR(128, _options.log_ctx << "Unknown channel: " << number);
+}
+
 void TurnClient::OnDataIndication(Buffer&& message) {
     std::optional<Endpoint> remote_peer;
     std::optional<BufferViewConst> data;
@@ -5,6 +5,7 @@
 #include "tau/ice/Credentials.h"
 #include "tau/ice/Constants.h"
 #include "tau/stun/Header.h"
+#include "tau/stun/ChannelData.h"
 #include "tau/crypto/Hmac.h"
 #include "tau/memory/Buffer.h"
 #include <etl/unordered_map.h>
@@ -13,9 +14,20 @@
 
 namespace tau::ice {
 
+// transport to the TURN server, relayed transport is UDP anyway.
+// TCP/TLS: the owner keeps the connection and splits the stream by stun::StreamFramer
+enum class TurnTransport {
+    kUdp,
+    kTcp,
+    kTls,
+};
+
 class TurnClient {
 public:
     static constexpr size_t kRefreshSecDefault = 600;
+    static constexpr size_t kChannelMaxCount = 4;
+    static constexpr Timepoint kChannelRefreshPeriod = 4 * kMin; // binding lives 10 min, its permission 5 min
+    static constexpr size_t kChannelBindAttempts = 4;
 
     struct Dependencies {
         Clock& clock;
@@ -25,6 +37,7 @@ public:
     struct Options {
         Endpoint server;
         PeerCredentials credentials;
+        TurnTransport transport = TurnTransport::kUdp;
         Timepoint start_delay = kRtoDefault / 2;
         etl::string_view log_ctx = {};
     };
@@ -45,9 +58,12 @@ public:
     void Process();
     void Recv(Buffer&& message);
     void Send(Buffer&& message, Endpoint remote);
+    std::optional<Timepoint> GetNextDeadline() const;
 
     void CreatePermission(const etl::ivector<IpAddress>& remote_ips);
     bool HasPermission(IpAddress remote);
+    void BindChannel(Endpoint remote); // ChannelData framing (4-byte header) instead of Send/Data indications
+    bool HasChannel(Endpoint remote) const;
     void Stop();
     bool IsActive() const;
 
@@ -55,15 +71,21 @@ public:
 
 private:
     void ProcessPermissionsRto();
+    void ProcessChannels();
 
     void SendAllocationRequest(bool authenticated);
     void SendRefreshRequest(size_t refresh_sec = kRefreshSecDefault);
     void SendCreatePermissionRequest(IpAddress remote);
+    void SendChannelBindRequest(Endpoint remote, uint16_t channel);
     void SendDataIndication(Buffer&& packet, Endpoint remote);
+    void SendChannelData(Buffer&& packet, uint16_t channel); // padded to 4 bytes over TCP/TLS
+    void SendQueued(Endpoint remote);
 
     void OnStunResponse(const BufferViewConst& view);
     void OnCreatePermissionResponse(uint32_t hash);
+    void OnChannelBindResponse(const BufferViewConst& view, uint32_t hash, bool success);
     void OnDataIndication(Buffer&& message);
+    void OnChannelData(Buffer&& message);
 
     void UpdateMessageIntegrityPassword();
 
@@ -82,6 +104,15 @@ private:
         Timepoint rto_tp;
     };
     etl::unordered_map<IpAddress, Permission, 4> _permissions;
+
+    struct Channel {
+        uint16_t number;
+        bool done;
+        Timepoint request_tp; // retransmission or refresh
+        size_t attempts;
+    };
+    etl::unordered_map<Endpoint, Channel, kChannelMaxCount> _channels;
+    uint16_t _next_channel = stun::kChannelNumberMin;
     etl::unordered_map<Endpoint, etl::vector<Buffer, 16>, 4> _queue;
 
     etl::string<256> _realm;
@@ -14,6 +14,7 @@ public:
     virtual void Deallocate(uint8_t* ptr) = 0;
 
     virtual size_t GetChunkSize() const = 0;
+    virtual size_t GetCapacity() const = 0; // total bytes of all chunks
 };
 
 }
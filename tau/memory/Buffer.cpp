@@ -2,6 +2,7 @@
 #include "tau/common/Base64.h"
 #include "tau/common/Math.h"
 #include "tau/common/Exception.h"
+#include <new>
 
 namespace tau {
 
@@ -38,8 +39,10 @@ Buffer::Buffer(Buffer&& other)
     , _capacity(other._capacity)
     , _size(other._size)
     , _offset(other._offset)
-    , _info(other._info) {
+    , _info(other._info)
+    , _control(other._control) {
     other._block = nullptr;
+    other._control = nullptr;
 }
 
 Buffer& Buffer::operator=(Buffer&& other) {
@@ -47,24 +50,56 @@ Buffer& Buffer::operator=(Buffer&& other) {
         if(&_allocator != &other._allocator) {
             TAU_EXCEPTION(std::runtime_error, "Cannot move-assign with different Allocator");
         }
-        if(_block) {
-            _allocator.Deallocate(_block);
-        }
+        Release();
         _block    = other._block;
         _capacity = other._capacity;
         _size     = other._size;
         _offset   = other._offset;
         _info     = std::move(other._info);
+        _control  = other._control;
 
         other._block = nullptr;
+        other._control = nullptr;
     }
     return *this;
 }
 
 Buffer::~Buffer() {
-    if(_block) {
+    Release();
+}
+
+void Buffer::Release() {
+    if(_control) {
+        if(_control->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            _control->~SharedControl();
+            _allocator.Deallocate(reinterpret_cast<uint8_t*>(_control));
+        }
+        _control = nullptr;
+    } else if(_block) {
         _allocator.Deallocate(_block);
     }
+    _block = nullptr;
+}
+
+Buffer Buffer::CreateShared(Allocator& allocator, Info info) {
+    return CreateShared(allocator, allocator.Allocate(), allocator.GetChunkSize(), info);
+}
+
+Buffer Buffer::CreateShared(Allocator& allocator, size_t capacity, Info info) {
+    return CreateShared(allocator, allocator.Allocate(capacity + kSharedControlSize), capacity + kSharedControlSize, info);
+}
+
+Buffer Buffer::CreateShared(Allocator& allocator, uint8_t* raw, size_t raw_capacity, Info info) {
+    Buffer buffer(allocator);
+    buffer._info = info;
+    if(raw && (raw_capacity > kSharedControlSize)) {
+        buffer._control = new (raw) SharedControl{.ref_count = 1};
+        buffer._block = raw + kSharedControlSize;
+        buffer._capacity = raw_capacity - kSharedControlSize;
+    } else if(raw) {
+        allocator.Deallocate(raw);
+    }
+    return buffer;
 }
 
 Buffer Buffer::Create(Allocator& allocator, const BufferViewConst& view, Info info) {
@@ -76,51 +111,110 @@ Buffer Buffer::Create(Allocator& allocator, const BufferViewConst& view, Info in
 
 Buffer Buffer::MakeCopy() const {
     Buffer buffer_copy(_allocator, _capacity, _info);
+    buffer_copy._offset = _offset;
     buffer_copy.SetSize(_size);
-    memcpy(buffer_copy.GetView().ptr, _block, _size);
+    memcpy(buffer_copy.GetView().ptr, _block + _offset, _size);
     return buffer_copy;
 }
 
+Buffer Buffer::Share() const {
+    if(!_control) {
+        TAU_EXCEPTION(std::runtime_error, "Buffer is not shared");
+    }
+    _control->ref_count.fetch_add(1, std::memory_order_relaxed);
+    Buffer buffer(_allocator);
+    buffer._block    = _block;
+    buffer._capacity = _capacity;
+    buffer._size     = _size;
+    buffer._offset   = _offset;
+    buffer._info     = _info;
+    buffer._control  = _control;
+    return buffer;
+}
+
+Buffer Buffer::Slice(size_t offset, size_t size) const {
+    if(offset + size > _size) {
+        TAU_EXCEPTION(std::out_of_range, "Wrong slice, offset: " << offset << ", size: " << size << ", buffer size: " << _size);
+    }
+    auto buffer = Share();
+    buffer._offset += offset;
+    buffer._size = size;
+    return buffer;
+}
+
+size_t Buffer::GetRefCount() const {
+    if(_control) {
+        return _control->ref_count.load(std::memory_order_relaxed);
+    }
+    return _block ? 1 : 0;
+}
+
 BufferView Buffer::GetView() {
     return BufferView{
-        .ptr = _block,
+        .ptr = _block ? _block + _offset : nullptr,
         .size = _size
     };
 }
 
 BufferViewConst Buffer::GetView() const {
     return BufferViewConst{
-        .ptr = _block,
+        .ptr = _block ? _block + _offset : nullptr,
         .size = _size
     };
 }
 
 BufferView Buffer::GetViewWithCapacity() {
     return BufferView{
-        .ptr = _block,
-        .size = _capacity
+        .ptr = _block ? _block + _offset : nullptr,
+        .size = _capacity - _offset
     };
 }
 
 BufferViewConst Buffer::GetViewWithCapacity() const {
     return BufferViewConst{
-        .ptr = _block,
-        .size = _capacity
+        .ptr = _block ? _block + _offset : nullptr,
+        .size = _capacity - _offset
     };
 }
 
 const etl::string_view Buffer::GetStringView() const {
-    return etl::string_view{reinterpret_cast<const char*>(_block), _size};
+    return etl::string_view{reinterpret_cast<const char*>(_block + _offset), _size};
 }
 
 void Buffer::SetSize(size_t size) {
-    if(size > _capacity) {
+    if(size > _capacity - _offset) {
         //TODO: do exception?
-        size = _capacity;
+        size = _capacity - _offset;
     }
     _size = size;
 }
 
+bool Buffer::ReserveHeadroom(size_t headroom) {
+    if((_size != 0) || (headroom > _capacity)) {
+        return false;
+    }
+    _offset = headroom;
+    return true;
+}
+
+bool Buffer::Prepend(size_t size) {
+    if(size > _offset) {
+        return false;
+    }
+    _offset -= size;
+    _size += size;
+    return true;
+}
+
+bool Buffer::TrimFront(size_t size) {
+    if(size > _size) {
+        return false;
+    }
+    _offset += size;
+    _size -= size;
+    return true;
+}
+
 Buffer CreateBufferFromBase64(Allocator& allocator, etl::string_view str, Buffer::Info info) {
     constexpr size_t kMaxOutputCapacity = 1024;
     const auto expected_size = DivCeil(str.size() * 6, 8);
@@ -5,6 +5,7 @@
 #include "tau/memory/Flags.h"
 #include "tau/common/Clock.h"
 #include <etl/string_view.h>
+#include <atomic>
 
 namespace tau {
 
@@ -34,6 +35,11 @@ public:
         return Buffer(allocator);
     }
 
+    // Shared mode: block starts with a ref counter, Share/Slice return more references to the same block.
+    // Data is shared between references, don't modify it in place (e.g. SRTP) without MakeCopy()
+    static Buffer CreateShared(Allocator& allocator, Info info = Info{.tp = 0, .flags = kFlagsNone});
+    static Buffer CreateShared(Allocator& allocator, size_t capacity, Info info = Info{.tp = 0, .flags = kFlagsNone});
+
     Buffer(const Buffer&) = delete;
     Buffer(Buffer&&);
     Buffer& operator=(const Buffer& other) = delete;
@@ -41,6 +47,11 @@ public:
     ~Buffer();
 
     Buffer MakeCopy() const;
+    Buffer Share() const;
+    Buffer Slice(size_t offset, size_t size) const; // [offset, offset + size) of the current view
+
+    bool IsShared() const { return _control != nullptr; }
+    size_t GetRefCount() const;
 
     BufferView GetView();
     BufferViewConst GetView() const;
@@ -55,6 +66,13 @@ public:
     size_t GetSize() const { return _size; }
     size_t GetCapacity() const { return _capacity; }
 
+    // view is [offset, offset + size) of the block: headroom before it, tailroom after it
+    size_t GetHeadroom() const { return _offset; }
+    size_t GetTailroom() const { return _capacity - _offset - _size; }
+    bool ReserveHeadroom(size_t headroom); // empty buffer only
+    bool Prepend(size_t size);             // extends view to the front, e.g. to write TURN header in place
+    bool TrimFront(size_t size);           // shrinks view from the front, e.g. to strip header without memcpy
+
     Info& GetInfo() { return _info; }
     const Info& GetInfo() const { return _info; }
 
@@ -63,13 +81,23 @@ private:
     Buffer(Allocator& allocator, Info info);
     Buffer(Allocator& allocator);
 
+    struct SharedControl {
+        std::atomic<uint32_t> ref_count;
+    };
+    static constexpr size_t kSharedControlSize = 16;
+    static_assert(sizeof(SharedControl) <= kSharedControlSize);
+
+    static Buffer CreateShared(Allocator& allocator, uint8_t* raw, size_t raw_capacity, Info info);
+    void Release();
+
 private:
     Allocator& _allocator;
     uint8_t* _block;
     size_t _capacity;
     size_t _size;
-    size_t _offset = 0; //TODO: impl
+    size_t _offset = 0;
     Info _info;
+    SharedControl* _control = nullptr; // shared mode, points to the beginning of allocated block
 };
 
 Buffer CreateBufferFromBase64(Allocator& allocator, etl::string_view str, Buffer::Info info = Buffer::Info{.tp = 0, .flags = kFlagsNone});
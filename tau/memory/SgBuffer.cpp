@@ -0,0 +1,58 @@
+#include "tau/memory/SgBuffer.h"
+#include "tau/common/Log.h"
+#include <cstring>
+
+namespace tau {
+
+SgBuffer::SgBuffer(Buffer&& header)
+    : _header(std::move(header))
+{}
+
+SgBuffer::SgBuffer(Buffer&& header, Buffer&& payload)
+    : _header(std::move(header))
+    , _payload(std::move(payload))
+{}
+
+SgBuffer& SgBuffer::operator=(SgBuffer&& other) {
+    if(this != &other) {
+        _header = std::move(other._header);
+        // payloads may come from different allocators, Buffer move-assignment doesn't allow it
+        _payload.reset();
+        if(other._payload) {
+            _payload.emplace(std::move(*other._payload));
+            other._payload.reset();
+        }
+    }
+    return *this;
+}
+
+size_t SgBuffer::GetSize() const {
+    return _header.GetSize() + (_payload ? _payload->GetSize() : 0);
+}
+
+SgBuffer::Views SgBuffer::GetViews() const {
+    Views views;
+    views.push_back(_header.GetView());
+    if(_payload && (_payload->GetSize() > 0)) {
+        views.push_back(_payload->GetView());
+    }
+    return views;
+}
+
+Buffer SgBuffer::Gather() const {
+    auto packet = _header.MakeCopy();
+    if(_payload) {
+        const auto header_size = packet.GetSize();
+        const auto payload = _payload->GetView();
+        if(payload.size > packet.GetTailroom()) {
+            TAU_LOG_WARNING_THR(128, "Not enough tailroom: " << packet.GetTailroom() << ", payload: " << payload.size);
+            packet.SetSize(0);
+            return packet;
+        }
+        packet.SetSize(header_size + payload.size);
+        std::memcpy(packet.GetView().ptr + header_size, payload.ptr, payload.size);
+    }
+    return packet;
+}
+
+}
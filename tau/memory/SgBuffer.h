@@ -0,0 +1,42 @@
+#pragma once
+
+#include "tau/memory/Buffer.h"
+#include <etl/vector.h>
+#include <optional>
+
+namespace tau {
+
+// Scatter-gather packet: header block + payload, usually Buffer::Slice of a shared buffer (e.g. access unit).
+// Payload is not copied until Gather(), which is done right before in-place processing like SRTP
+class SgBuffer {
+public:
+    using Views = etl::vector<BufferViewConst, 2>;
+
+public:
+    explicit SgBuffer(Buffer&& header);
+    SgBuffer(Buffer&& header, Buffer&& payload);
+    SgBuffer(const SgBuffer&) = delete;
+    SgBuffer(SgBuffer&&) = default;
+    SgBuffer& operator=(const SgBuffer&) = delete;
+    SgBuffer& operator=(SgBuffer&& other);
+
+    Buffer& GetHeader() { return _header; }
+    const Buffer& GetHeader() const { return _header; }
+    bool HasPayload() const { return _payload.has_value(); }
+    const Buffer& GetPayload() const { return *_payload; }
+
+    size_t GetSize() const;
+    Buffer::Info& GetInfo() { return _header.GetInfo(); }
+    const Buffer::Info& GetInfo() const { return _header.GetInfo(); }
+
+    Views GetViews() const;
+
+    // contiguous copy, payload is appended into header block tailroom
+    Buffer Gather() const;
+
+private:
+    Buffer _header;
+    std::optional<Buffer> _payload;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "tau/memory/Allocator.h"
 #include <cstdlib>
+#include <limits>
 
 namespace tau {
 
@@ -27,6 +28,10 @@ public:
     size_t GetChunkSize() const override {
         return kDefaultSize;
     }
+
+    size_t GetCapacity() const override {
+        return std::numeric_limits<size_t>::max();
+    }
 };
 
 inline SystemAllocator g_system_allocator;
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <tau/memory/Allocator.h>
+#include <tau/common/Math.h>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <new>
+
+namespace tau {
+
+// Same memory layout and interface as PoolAllocator, but free blocks are kept in a lock-free
+// Treiber stack: head is {tag:32, index:32}, tag is incremented on every pop/push to avoid ABA
+template<typename TIndex = uint16_t>
+class LockFreePoolAllocator : public Allocator {
+public:
+    explicit LockFreePoolAllocator(void* ptr, size_t allocated_size, size_t block_size)
+        : _block_size(Align(block_size, sizeof(size_t)))
+        , _max_block_count(CalcMaxBlockCount(allocated_size, _block_size))
+        , _ptr(reinterpret_cast<uint8_t*>(ptr))
+        , _next(reinterpret_cast<std::atomic<TIndex>*>(_ptr + _max_block_count * _block_size))
+        , _free_block_count(_max_block_count) {
+        for(TIndex i = 0; i < _max_block_count; ++i) {
+            const auto next = (i + 1 < _max_block_count) ? static_cast<TIndex>(i + 1) : static_cast<TIndex>(kNil);
+            new (&_next[i]) std::atomic<TIndex>(next);
+        }
+        _head.store(MakeHead(0, (_max_block_count > 0) ? 0 : kNil), std::memory_order_relaxed);
+    }
+
+    uint8_t* Allocate() override {
+        auto head = _head.load(std::memory_order_acquire);
+        while(true) {
+            const auto index = GetIndex(head);
+            if(index == kNil) {
+                return nullptr; //TODO: abort? debug_assert?
+            }
+            // _next[index] may be stale if the block was popped concurrently, then CAS fails due to tag
+            const auto next = _next[index].load(std::memory_order_relaxed);
+            if(_head.compare_exchange_weak(head, MakeHead(GetTag(head) + 1, next),
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                _free_block_count.fetch_sub(1, std::memory_order_relaxed);
+                return _ptr + static_cast<size_t>(index) * _block_size;
+            }
+        }
+    }
+
+    uint8_t* Allocate(size_t size) override {
+        if(size <= GetChunkSize()) {
+            return Allocate();
+        } else {
+            return nullptr;
+        }
+    }
+
+    void Deallocate(uint8_t* ptr) override {
+        const auto index = static_cast<TIndex>((ptr - _ptr) / _block_size);
+        auto head = _head.load(std::memory_order_relaxed);
+        while(true) {
+            _next[index].store(static_cast<TIndex>(GetIndex(head)), std::memory_order_relaxed);
+            if(_head.compare_exchange_weak(head, MakeHead(GetTag(head) + 1, index),
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                _free_block_count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    size_t GetChunkSize() const override {
+        return _block_size;
+    }
+
+    size_t GetCapacity() const override {
+        return _block_size * GetMaxBlockCount();
+    }
+
+    size_t GetMaxBlockCount() const {
+        return static_cast<size_t>(_max_block_count);
+    }
+
+    size_t GetFreeBlockCount() const {
+        return _free_block_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t kNil = std::numeric_limits<TIndex>::max();
+    static_assert(sizeof(TIndex) <= sizeof(uint32_t));
+    static_assert(sizeof(std::atomic<TIndex>) == sizeof(TIndex));
+
+    static TIndex CalcMaxBlockCount(size_t allocated_size, size_t block_size) {
+        const auto count = allocated_size / (block_size + sizeof(TIndex));
+        return static_cast<TIndex>(std::min<size_t>(count, kNil)); // kNil is reserved for the empty stack
+    }
+
+    static uint64_t MakeHead(uint32_t tag, uint32_t index) { return (static_cast<uint64_t>(tag) << 32) | index; }
+    static uint32_t GetTag(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+    static uint32_t GetIndex(uint64_t head) { return static_cast<uint32_t>(head); }
+
+private:
+    const size_t _block_size;
+    const TIndex _max_block_count;
+    uint8_t* _ptr;
+    std::atomic<TIndex>* _next;
+
+    alignas(64) std::atomic<uint64_t> _head;
+    alignas(64) std::atomic<size_t> _free_block_count;
+};
+
+}
@@ -49,6 +49,10 @@ public:
         return _block_size;
     }
 
+    size_t GetCapacity() const override {
+        return _block_size * GetMaxBlockCount();
+    }
+
     size_t GetMaxBlockCount() const {
         return static_cast<size_t>(_max_block_count);
     }
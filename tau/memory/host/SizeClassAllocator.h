@@ -0,0 +1,175 @@
+#pragma once
+
+#include <tau/memory/host/PoolAllocator.h>
+#include <tau/common/Exception.h>
+#include <etl/vector.h>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <algorithm>
+
+namespace tau {
+
+// One arena split into PoolAllocator regions of different block sizes, e.g. 128/256/512/1500/4K/64K.
+// Allocate(size) takes the smallest class that fits and falls back to bigger ones when it's exhausted
+class SizeClassAllocator : public Allocator {
+public:
+    static constexpr size_t kMaxClassesCount = 8;
+
+    struct SizeClass {
+        size_t block_size;
+        size_t block_count;
+    };
+    using SizeClasses = etl::vector<SizeClass, kMaxClassesCount>;
+
+    struct Stats {
+        size_t block_size = 0;
+        size_t max_block_count = 0;
+        size_t used_block_count = 0;
+        size_t peak_used_block_count = 0;
+        size_t fallback_count = 0; // blocks allocated here because smaller classes were exhausted
+        size_t failed_count = 0;   // requests that fit this class but no class had a free block
+    };
+
+public:
+    // default_block_size selects the class for Allocate() and GetChunkSize()
+    explicit SizeClassAllocator(void* ptr, size_t allocated_size, const SizeClasses& classes, size_t default_block_size)
+        : _ptr(reinterpret_cast<uint8_t*>(ptr)) {
+        if(classes.empty()) {
+            TAU_EXCEPTION(std::invalid_argument, "No size classes");
+        }
+        if(allocated_size < GetRequiredSize(classes)) {
+            TAU_EXCEPTION(std::invalid_argument, "Not enough memory: " << allocated_size << ", required: " << GetRequiredSize(classes));
+        }
+
+        auto sorted = classes;
+        std::sort(sorted.begin(), sorted.end(), [](const SizeClass& a, const SizeClass& b) {
+            return a.block_size < b.block_size;
+        });
+
+        auto region = _ptr;
+        for(const auto& size_class : sorted) {
+            const auto region_size = GetRequiredSize(size_class);
+            auto& ctx = _classes[_classes_count];
+            ctx.begin = region;
+            ctx.end = region + Align(size_class.block_size, sizeof(size_t)) * size_class.block_count;
+            ctx.pool.emplace(region, region_size, size_class.block_size);
+            region += region_size;
+            _classes_count++;
+        }
+
+        _default_class_idx = _classes_count - 1;
+        for(size_t i = 0; i < _classes_count; ++i) {
+            if(_classes[i].pool->GetChunkSize() >= default_block_size) {
+                _default_class_idx = i;
+                break;
+            }
+        }
+    }
+
+    uint8_t* Allocate() override {
+        return AllocateFromClass(_default_class_idx);
+    }
+
+    uint8_t* Allocate(size_t size) override {
+        for(size_t i = 0; i < _classes_count; ++i) {
+            if(size <= _classes[i].pool->GetChunkSize()) {
+                return AllocateFromClass(i);
+            }
+        }
+        return nullptr;
+    }
+
+    void Deallocate(uint8_t* ptr) override {
+        for(size_t i = 0; i < _classes_count; ++i) {
+            auto& ctx = _classes[i];
+            if((ctx.begin <= ptr) && (ptr < ctx.end)) {
+                ctx.pool->Deallocate(ptr);
+                return;
+            }
+        }
+    }
+
+    size_t GetChunkSize() const override {
+        return _classes[_default_class_idx].pool->GetChunkSize();
+    }
+
+    size_t GetCapacity() const override {
+        size_t capacity = 0;
+        for(size_t i = 0; i < _classes_count; ++i) {
+            capacity += _classes[i].pool->GetCapacity();
+        }
+        return capacity;
+    }
+
+    size_t GetClassesCount() const {
+        return _classes_count;
+    }
+
+    Stats GetStats(size_t class_idx) const {
+        const auto& ctx = _classes.at(class_idx);
+        const auto max_block_count = ctx.pool->GetMaxBlockCount();
+        return Stats{
+            .block_size = ctx.pool->GetChunkSize(),
+            .max_block_count = max_block_count,
+            .used_block_count = max_block_count - ctx.pool->GetFreeBlockCount(),
+            .peak_used_block_count = ctx.peak_used_block_count.load(std::memory_order_relaxed),
+            .fallback_count = ctx.fallback_count.load(std::memory_order_relaxed),
+            .failed_count = ctx.failed_count.load(std::memory_order_relaxed)
+        };
+    }
+
+    static size_t GetRequiredSize(const SizeClass& size_class) {
+        // regions are aligned, so blocks of the next class are aligned as well
+        return Align((Align(size_class.block_size, sizeof(size_t)) + sizeof(Index)) * size_class.block_count, sizeof(size_t));
+    }
+
+    static size_t GetRequiredSize(const SizeClasses& classes) {
+        size_t size = 0;
+        for(const auto& size_class : classes) {
+            size += GetRequiredSize(size_class);
+        }
+        return size;
+    }
+
+private:
+    using Index = uint32_t;
+
+    struct ClassContext {
+        uint8_t* begin = nullptr;
+        uint8_t* end = nullptr;
+        std::optional<PoolAllocator<Index>> pool;
+        std::atomic<size_t> peak_used_block_count = 0;
+        std::atomic<size_t> fallback_count = 0;
+        std::atomic<size_t> failed_count = 0;
+    };
+
+    uint8_t* AllocateFromClass(size_t class_idx) {
+        for(size_t i = class_idx; i < _classes_count; ++i) {
+            auto& ctx = _classes[i];
+            if(auto ptr = ctx.pool->Allocate()) {
+                if(i != class_idx) {
+                    ctx.fallback_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                UpdatePeak(ctx);
+                return ptr;
+            }
+        }
+        _classes[class_idx].failed_count.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    static void UpdatePeak(ClassContext& ctx) {
+        const auto used = ctx.pool->GetMaxBlockCount() - ctx.pool->GetFreeBlockCount();
+        auto peak = ctx.peak_used_block_count.load(std::memory_order_relaxed);
+        while((peak < used) && !ctx.peak_used_block_count.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {}
+    }
+
+private:
+    uint8_t* _ptr;
+    std::array<ClassContext, kMaxClassesCount> _classes;
+    size_t _classes_count = 0;
+    size_t _default_class_idx = 0;
+};
+
+}
@@ -49,7 +49,18 @@ struct IpAddress {
     }
 
     bool IsLoopback() const {
-        return (bytes[0] == 127) && (bytes[1] == 0) && (bytes[2] == 0) && (bytes[3] == 1);
+        return (bytes[0] == 127);
+    }
+
+    bool IsLinkLocal() const {
+        return (bytes[0] == 169) && (bytes[1] == 254);
+    }
+
+    // RFC 1918: 10/8, 172.16/12, 192.168/16
+    bool IsPrivate() const {
+        return (bytes[0] == 10)
+            || ((bytes[0] == 172) && ((bytes[1] & 0xF0) == 16))
+            || ((bytes[0] == 192) && (bytes[1] == 168));
     }
 
     bool operator==(const IpAddress& other) const {
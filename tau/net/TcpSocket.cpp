@@ -0,0 +1,262 @@
+#include "tau/net/TcpSocket.h"
+#include "tau/asio/ToString.h"
+#include "tau/common/Exception.h"
+#include "tau/common/Variant.h"
+#include "tau/common/Log.h"
+#include <openssl/ssl.h>
+#include <cstring>
+
+namespace tau::net {
+
+namespace {
+
+asio::ip::tcp::endpoint ToTcpEndpoint(const Endpoint& endpoint) {
+    return asio::ip::tcp::endpoint{
+        asio::ip::address_v4{endpoint.address.GetUint32()},
+        endpoint.port
+    };
+}
+
+}
+
+TcpSocket::TcpSocket(Options&& options, std::optional<Socket>&& accepted)
+    : _allocator(options.allocator)
+    , _frame_header_size(options.frame_header_size)
+    , _frame_size_callback(std::move(options.frame_size_callback))
+    , _server(accepted.has_value())
+    , _socket(CreateSocket(options.executor, options.ssl_ctx, std::move(accepted)))
+    , _rx_buffer(kRxBufferSize)
+{
+    if(options.ssl_ctx && !_server && !options.host.empty()) {
+        // Set SNI Hostname (many hosts need this to handshake successfully)
+        auto& socket = std::get<SslSocket>(_socket);
+        const std::string host(options.host.data(), options.host.size());
+        if(!SSL_set_tlsext_host_name(socket.native_handle(), host.c_str())) {
+            TAU_EXCEPTION(std::runtime_error, "SSL_set_tlsext_host_name failed");
+        }
+    }
+}
+
+TcpSocket::~TcpSocket() {
+    boost_ec ec;
+    GetLowestLayer().close(ec);
+}
+
+void TcpSocket::Connect(Endpoint remote_endpoint) {
+    GetLowestLayer().async_connect(ToTcpEndpoint(remote_endpoint),
+        [self_weak = weak_from_this()](boost_ec ec) {
+            if(auto self = self_weak.lock()) {
+                self->OnConnect(ec);
+            }
+        });
+}
+
+void TcpSocket::Start() {
+    asio::post(GetLowestLayer().get_executor(),
+        [self_weak = weak_from_this()]() {
+            if(auto self = self_weak.lock()) {
+                self->OnConnect({});
+            }
+        });
+}
+
+void TcpSocket::Send(Buffer&& message) {
+    if(_closed || _tx_queue.full()) {
+        _tx_stats.dropped++;
+        TAU_LOG_WARNING_THR(128, "Dropped, closed: " << _closed << ", queue: " << _tx_queue.size());
+        return;
+    }
+    _tx_queue.push_back(std::move(message));
+    _tx_stats.messages++;
+    DoWrite();
+}
+
+void TcpSocket::Close() {
+    if(_closed) {
+        return;
+    }
+    _closed = true;
+    _connected = false;
+
+    boost_ec ec;
+    GetLowestLayer().close(ec);
+}
+
+void TcpSocket::OnConnect(boost_ec ec) {
+    if(ec) {
+        OnError(ec);
+        return;
+    }
+
+    std::visit(overloaded{
+        [this](SslSocket& socket) {
+            socket.async_handshake(_server ? asio_ssl::stream_base::server : asio_ssl::stream_base::client,
+                [self_weak = weak_from_this()](boost_ec ec) {
+                    if(auto self = self_weak.lock()) {
+                        self->OnHandshake(ec);
+                    }
+                });
+        },
+        [this](Socket&) {
+            OnHandshake({});
+        }
+    }, _socket);
+}
+
+void TcpSocket::OnHandshake(boost_ec ec) {
+    if(ec) {
+        OnError(ec);
+        return;
+    }
+
+    boost_ec ignored;
+    GetLowestLayer().set_option(asio::ip::tcp::no_delay(true), ignored);
+
+    _connected = true;
+    if(_connect_callback) {
+        _connect_callback();
+    }
+    DoRead();
+    DoWrite();
+}
+
+void TcpSocket::DoRead() {
+    auto buffer = asio::buffer(_rx_buffer.data() + _rx_size, _rx_buffer.size() - _rx_size);
+    std::visit([this, &buffer](auto& socket) {
+        socket.async_read_some(buffer,
+            [self_weak = weak_from_this()](boost_ec ec, size_t bytes) {
+                if(auto self = self_weak.lock()) {
+                    self->OnRead(ec, bytes);
+                }
+            });
+    }, _socket);
+}
+
+void TcpSocket::OnRead(boost_ec ec, size_t bytes) {
+    if(ec) {
+        OnError(ec);
+        return;
+    }
+    _rx_size += bytes;
+
+    size_t offset = 0;
+    while(_rx_size - offset >= _frame_header_size) {
+        const auto frame_size = _frame_size_callback(BufferViewConst{
+            .ptr = _rx_buffer.data() + offset,
+            .size = _rx_size - offset
+        });
+        if(frame_size == 0) {
+            OnError(boost::system::errc::make_error_code(boost::system::errc::bad_message));
+            return;
+        }
+        if(frame_size > _allocator.GetChunkSize()) {
+            OnError(asio::error::message_size);
+            return;
+        }
+        if(_rx_size - offset < frame_size) {
+            break;
+        }
+        auto message = Buffer::Create(_allocator);
+        std::memcpy(message.GetView().ptr, _rx_buffer.data() + offset, frame_size);
+        message.SetSize(frame_size);
+        offset += frame_size;
+        if(_recv_callback) {
+            _recv_callback(std::move(message));
+        }
+        if(_closed) {
+            return;
+        }
+    }
+    if(offset) {
+        std::memmove(_rx_buffer.data(), _rx_buffer.data() + offset, _rx_size - offset);
+        _rx_size -= offset;
+    }
+
+    DoRead();
+}
+
+void TcpSocket::DoWrite() {
+    if(!_connected || _tx_in_flight || _tx_queue.empty()) {
+        return;
+    }
+
+    auto on_write = [self_weak = weak_from_this()](boost_ec ec, size_t bytes) {
+        if(auto self = self_weak.lock()) {
+            self->OnWrite(ec, bytes);
+        }
+    };
+
+    std::visit(overloaded{
+        [this, &on_write](SslSocket& socket) {
+            // SSL stream encrypts only the first buffer of a sequence per write_some: linearize to one record
+            _tx_record.clear();
+            while(_tx_in_flight < _tx_queue.size()) {
+                const auto view = _tx_queue[_tx_in_flight].GetView();
+                if(_tx_in_flight && (_tx_record.size() + view.size > kTlsRecordMaxSize)) {
+                    break;
+                }
+                _tx_record.insert(_tx_record.end(), view.ptr, view.ptr + view.size);
+                _tx_in_flight++;
+            }
+            asio::async_write(socket, asio::buffer(_tx_record), std::move(on_write));
+        },
+        [this, &on_write](Socket& socket) {
+            _tx_buffers.clear();
+            while((_tx_in_flight < _tx_queue.size()) && !_tx_buffers.full()) {
+                const auto view = _tx_queue[_tx_in_flight].GetView();
+                _tx_buffers.push_back(asio::buffer(view.ptr, view.size));
+                _tx_in_flight++;
+            }
+            asio::async_write(socket, _tx_buffers, std::move(on_write));
+        }
+    }, _socket);
+    _tx_stats.writes++;
+}
+
+void TcpSocket::OnWrite(boost_ec ec, size_t bytes) {
+    if(ec) {
+        TAU_LOG_DEBUG("ec: " << ec << ", bytes: " << bytes);
+        OnError(ec);
+        return;
+    }
+
+    for(; _tx_in_flight; --_tx_in_flight) {
+        _tx_queue.pop_front();
+    }
+    DoWrite();
+}
+
+void TcpSocket::OnError(boost_ec ec) {
+    if(_closed) {
+        return;
+    }
+    if((ec != asio::error::eof) && (ec != asio::error::operation_aborted)) {
+        TAU_LOG_WARNING("ec: " << ec);
+    }
+    Close();
+    if(_error_callback) {
+        _error_callback(ec);
+    }
+}
+
+TcpSocket::Socket& TcpSocket::GetLowestLayer() {
+    return std::visit(overloaded{
+        [](SslSocket& socket) -> Socket& { return socket.next_layer(); },
+        [](Socket& socket) -> Socket& { return socket; }
+    }, _socket);
+}
+
+TcpSocket::SocketVar TcpSocket::CreateSocket(Executor executor, SslContext* ssl_ctx, std::optional<Socket>&& accepted) {
+    if(ssl_ctx) {
+        if(accepted) {
+            return SslSocket(std::move(*accepted), *ssl_ctx);
+        }
+        return SslSocket(executor, *ssl_ctx);
+    }
+    if(accepted) {
+        return std::move(*accepted);
+    }
+    return Socket(executor);
+}
+
+}
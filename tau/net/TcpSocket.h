@@ -0,0 +1,112 @@
+#pragma once
+
+#include "tau/memory/Buffer.h"
+#include "tau/asio/Ssl.h"
+#include "tau/net/Endpoint.h"
+#include <etl/string_view.h>
+#include <etl/deque.h>
+#include <etl/vector.h>
+#include <variant>
+#include <vector>
+
+namespace tau::net {
+
+// Message-oriented TCP/TLS socket: the stream is split into frames by the user's framing (e.g. TURN over TCP),
+// all messages queued while a write is in flight go out with one gathered write.
+// Not thread-safe: Send/Close must be called on the executor
+class TcpSocket : public std::enable_shared_from_this<TcpSocket> {
+    using Socket    = asio::ip::tcp::socket;
+    using SocketVar = std::variant<SslSocket, Socket>;
+
+public:
+    static constexpr size_t kTxQueueMaxSize = 256;
+    static constexpr size_t kTxGatherMaxCount = 64;
+    static constexpr size_t kRxBufferSize = 64 * 1024;
+    static constexpr size_t kTlsRecordMaxSize = 16 * 1024;
+
+    using FrameSizeCallback = std::function<size_t(const BufferViewConst& header)>; // 0 - invalid stream
+
+    struct Options {
+        Allocator& allocator;
+        Executor executor;
+        size_t frame_header_size;
+        FrameSizeCallback frame_size_callback;
+        SslContext* ssl_ctx = nullptr; // TLS if set
+        etl::string_view host = {};    // TLS SNI, client only
+    };
+
+    struct TxStats {
+        size_t messages = 0;
+        size_t writes = 0;
+        size_t dropped = 0;
+    };
+
+    using ConnectCallback = std::function<void()>;
+    using RecvCallback = std::function<void(Buffer&& message)>;
+    using ErrorCallback = std::function<void(boost_ec)>;
+
+public:
+    static auto Create(Options&& options) {
+        std::shared_ptr<TcpSocket> self(new TcpSocket(std::move(options), std::nullopt));
+        return self;
+    }
+    static auto Create(Options&& options, Socket&& accepted) {
+        std::shared_ptr<TcpSocket> self(new TcpSocket(std::move(options), std::move(accepted)));
+        return self;
+    }
+    ~TcpSocket();
+
+    void SetConnectCallback(ConnectCallback callback) { _connect_callback = std::move(callback); }
+    void SetRecvCallback(RecvCallback callback) { _recv_callback = std::move(callback); }
+    void SetErrorCallback(ErrorCallback callback) { _error_callback = std::move(callback); }
+
+    void Connect(Endpoint remote_endpoint); // client
+    void Start();                           // accepted socket: TLS handshake (if any) and reading
+
+    void Send(Buffer&& message); // queued until connected
+    void Close();
+
+    bool IsConnected() const { return _connected; }
+    const TxStats& GetTxStats() const { return _tx_stats; }
+
+private:
+    TcpSocket(Options&& options, std::optional<Socket>&& accepted);
+
+    void OnConnect(boost_ec ec);
+    void OnHandshake(boost_ec ec);
+
+    void DoRead();
+    void OnRead(boost_ec ec, size_t bytes);
+    void DoWrite();
+    void OnWrite(boost_ec ec, size_t bytes);
+    void OnError(boost_ec ec);
+
+    Socket& GetLowestLayer();
+    static SocketVar CreateSocket(Executor executor, SslContext* ssl_ctx, std::optional<Socket>&& accepted);
+
+private:
+    Allocator& _allocator;
+    const size_t _frame_header_size;
+    FrameSizeCallback _frame_size_callback;
+    const bool _server;
+    SocketVar _socket;
+    bool _connected = false;
+    bool _closed = false;
+
+    std::vector<uint8_t> _rx_buffer;
+    size_t _rx_size = 0;
+
+    etl::deque<Buffer, kTxQueueMaxSize> _tx_queue;
+    size_t _tx_in_flight = 0; // messages in front of the queue
+    etl::vector<asio::const_buffer, kTxGatherMaxCount> _tx_buffers;
+    std::vector<uint8_t> _tx_record; // TLS: one record per write
+    TxStats _tx_stats;
+
+    ConnectCallback _connect_callback;
+    RecvCallback _recv_callback;
+    ErrorCallback _error_callback;
+};
+
+using TcpSocketPtr = std::shared_ptr<TcpSocket>;
+
+}
@@ -0,0 +1,122 @@
+#include "tau/net/UdpSocketShards.h"
+#include "tau/common/Exception.h"
+#include "tau/common/Log.h"
+#include <linux/filter.h>
+#include <sys/socket.h>
+
+namespace tau::net {
+
+UdpSocketShards::UdpSocketShards(Options&& options) {
+    if(options.shards_count == 0) {
+        TAU_EXCEPTION(std::runtime_error, "Shards count must be positive");
+    }
+    _shards.reserve(options.shards_count);
+    auto local_port = options.local_port;
+    for(size_t i = 0; i < options.shards_count; ++i) {
+        auto thread = std::make_unique<ThreadPool>(1);
+        auto socket = UdpSocketWithExecutor::Create(UdpSocketWithExecutor::Options{
+            .allocator = options.allocator,
+            .executor = thread->GetExecutor(),
+            .local_address = options.local_address,
+            .local_port = local_port,
+            .reuse_port = true,
+            .rx_batch_size = options.rx_batch_size,
+            .tx_batch_size = options.tx_batch_size
+        });
+        if(i == 0) {
+            _local_endpoint = socket->GetLocalEndpoint();
+            local_port = _local_endpoint->port;
+            // reuseport group index is the bind order, so the program is valid for all shards
+            _kernel_steering = AttachSteeringProgram(socket->GetNativeHandle(), options.shards_count);
+        }
+        _shards.push_back(Shard{
+            .thread = std::move(thread),
+            .socket = std::move(socket),
+            .stats = {}
+        });
+    }
+    TAU_LOG_INFO("Local endpoint: " << *_local_endpoint << ", shards: " << _shards.size() << ", kernel steering: " << _kernel_steering);
+}
+
+UdpSocketShards::~UdpSocketShards() {
+    Stop();
+}
+
+void UdpSocketShards::SetRecvCallback(RecvCallback callback) {
+    _recv_callback = std::move(callback);
+    for(size_t i = 0; i < _shards.size(); ++i) {
+        _shards[i].socket->SetRecvCallback([this, i](Buffer&& packet, Endpoint remote_endpoint) {
+            OnRecv(i, std::move(packet), remote_endpoint);
+        });
+    }
+}
+
+void UdpSocketShards::Stop() {
+    if(_stopped) {
+        return;
+    }
+    _stopped = true;
+    for(auto& shard : _shards) {
+        if(shard.socket) {
+            // socket is closed on its own thread
+            asio::post(shard.thread->GetExecutor(), [socket = std::move(shard.socket)]() mutable {
+                socket.reset();
+            });
+        }
+    }
+    for(auto& shard : _shards) {
+        shard.thread->Join();
+    }
+}
+
+// the same hash as the steering program: (src ip ^ src port) % shards count
+size_t UdpSocketShards::GetShardIdx(const Endpoint& remote_endpoint) const {
+    return (remote_endpoint.address.GetUint32() ^ remote_endpoint.port) % _shards.size();
+}
+
+Executor UdpSocketShards::GetExecutor(size_t shard_idx) {
+    return _shards.at(shard_idx).thread->GetExecutor();
+}
+
+UdpSocketWithExecutor& UdpSocketShards::GetSocket(size_t shard_idx) {
+    return *_shards.at(shard_idx).socket;
+}
+
+void UdpSocketShards::OnRecv(size_t shard_idx, Buffer&& packet, Endpoint remote_endpoint) {
+    auto& stats = _shards[shard_idx].stats;
+    stats.received++;
+    const auto owner_idx = GetShardIdx(remote_endpoint);
+    if(owner_idx == shard_idx) {
+        _recv_callback(shard_idx, std::move(packet), remote_endpoint);
+        return;
+    }
+    stats.forwarded++;
+    asio::post(GetExecutor(owner_idx), [this, owner_idx, packet = std::move(packet), remote_endpoint]() mutable {
+        _recv_callback(owner_idx, std::move(packet), remote_endpoint);
+    });
+}
+
+// https://man7.org/linux/man-pages/man7/socket.7.html SO_ATTACH_REUSEPORT_CBPF
+// UDP payload is the data start, IPv4 header is accessed by SKF_NET_OFF
+bool UdpSocketShards::AttachSteeringProgram(int socket, size_t shards_count) {
+    sock_filter code[] = {
+        {BPF_LD  | BPF_W   | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_NET_OFF + 12)}, // A = src ip
+        {BPF_MISC| BPF_TAX,           0, 0, 0},                                       // X = A
+        {BPF_LD  | BPF_H   | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_NET_OFF + 20)}, // A = src port, IPv4 w/o options
+        {BPF_ALU | BPF_XOR | BPF_X,   0, 0, 0},                                       // A ^= X
+        {BPF_ALU | BPF_MOD | BPF_K,   0, 0, static_cast<uint32_t>(shards_count)},   // A %= shards count
+        {BPF_RET | BPF_A,             0, 0, 0},
+    };
+    sock_fprog program = {
+        .len = sizeof(code) / sizeof(code[0]),
+        .filter = code
+    };
+    auto error = setsockopt(socket, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program));
+    if(error < 0) {
+        TAU_LOG_WARNING("setsockopt SO_ATTACH_REUSEPORT_CBPF failed, error: " << error << ", errno: " << errno);
+        return false;
+    }
+    return true;
+}
+
+}
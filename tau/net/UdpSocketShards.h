@@ -0,0 +1,67 @@
+#pragma once
+
+#include "tau/net/UdpSocketWithExecutor.h"
+#include "tau/asio/ThreadPool.h"
+#include <vector>
+
+namespace tau::net {
+
+// N sockets on the same port (SO_REUSEPORT), each one is served by its own single-threaded executor.
+// Every remote endpoint is owned by one shard: GetShardIdx(remote), so sessions state (PeerConnection, SRTP,
+// rtp::Session) is touched from one thread only, w/o strands and mutexes on the media path.
+// Kernel steering is done by reuseport cBPF program with the same hash, if it can't be attached
+// (or IPv4 header has options) packets received by another shard are posted to the owner
+class UdpSocketShards {
+public:
+    struct Options {
+        Allocator& allocator;
+        IpAddress local_address;
+        std::optional<uint16_t> local_port = std::nullopt;
+        size_t shards_count = std::thread::hardware_concurrency();
+        size_t rx_batch_size = 1;
+        size_t tx_batch_size = 1;
+    };
+
+    using RecvCallback = std::function<void(size_t shard_idx, Buffer&& packet, Endpoint remote_endpoint)>;
+
+    // updated from the shard thread only
+    struct Stats {
+        size_t received = 0;
+        size_t forwarded = 0; // received by the shard, but owned by another one
+    };
+
+public:
+    explicit UdpSocketShards(Options&& options);
+    ~UdpSocketShards();
+
+    void SetRecvCallback(RecvCallback callback); // starts receiving, call once
+    void Stop(); // idempotent, called by the destructor as well
+
+    size_t GetShardsCount() const { return _shards.size(); }
+    size_t GetShardIdx(const Endpoint& remote_endpoint) const;
+    Executor GetExecutor(size_t shard_idx);
+    UdpSocketWithExecutor& GetSocket(size_t shard_idx); // to send from the shard thread
+    const Stats& GetStats(size_t shard_idx) const { return _shards[shard_idx].stats; }
+
+    const std::optional<Endpoint>& GetLocalEndpoint() const { return _local_endpoint; }
+    bool IsKernelSteering() const { return _kernel_steering; }
+
+private:
+    void OnRecv(size_t shard_idx, Buffer&& packet, Endpoint remote_endpoint);
+    static bool AttachSteeringProgram(int socket, size_t shards_count);
+
+private:
+    struct Shard {
+        std::unique_ptr<ThreadPool> thread;
+        UdpSocketWithExecutorPtr socket;
+        Stats stats;
+    };
+    std::vector<Shard> _shards;
+    std::optional<Endpoint> _local_endpoint;
+    bool _kernel_steering = false;
+    bool _stopped = false;
+
+    RecvCallback _recv_callback;
+};
+
+}
@@ -1,4 +1,9 @@
 #include "tau/net/UdpSocketWithExecutor.h"
+#include "tau/common/Log.h"
+#include <etl/array.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <algorithm>
 
 namespace tau::net {
 
@@ -8,12 +13,21 @@ Endpoint ToEndpoint(const asio::ip::udp::endpoint& endpoint);
 UdpSocketWithExecutor::UdpSocketWithExecutor(Options&& options)
     : _allocator(options.allocator)
     , _executor(std::move(options.executor))
+    , _rx_headroom(options.rx_headroom)
+    , _rx_batch_size(std::clamp<size_t>(options.rx_batch_size, 1, detail::kRxBatchMaxSize))
     , _socket(_executor)
-    , _ctx(Context{.buffer = Buffer::Create(_allocator)}) {
+    , _ctx(Context{.buffer = CreateRxBuffer()})
+    , _tx_queue(detail::UdpSendQueue::Options{
+        .batch_size = options.tx_batch_size,
+        .gso = options.tx_gso
+    }) {
     const auto port = options.local_port.value_or(0);
     if(!options.multicast_address) {
         auto local_endpoint = ToEndpoint({options.local_address, port});
         _socket.open(local_endpoint.protocol());
+        if(options.reuse_port) {
+            _socket.set_option(asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+        }
         _socket.bind(local_endpoint);
     } else {
         asio::ip::udp::endpoint local_endpoint{asio::ip::address_v4::any(), port};
@@ -38,16 +52,28 @@ void UdpSocketWithExecutor::SetRecvCallback(RecvCallback callback) {
 
     if(start_receiving) {
         asio::post(_executor, [self = shared_from_this()]() {
-            self->ReceiveAsync();
+            if(self->_rx_batch_size > 1) {
+                self->ReceiveBatchAsync();
+            } else {
+                self->ReceiveAsync();
+            }
         });
     }
 }
 
 void UdpSocketWithExecutor::Send(Buffer&& packet, Endpoint remote_endpoint) {
-    Send(ToConst(packet.GetView()), remote_endpoint);
+    if(_tx_queue.GetBatchSize() == 1) {
+        Send(ToConst(packet.GetView()), remote_endpoint);
+        return;
+    }
+    _tx_queue.Push(std::move(packet), remote_endpoint);
+    if(_tx_queue.Full()) {
+        Flush();
+    }
 }
 
 void UdpSocketWithExecutor::Send(const BufferViewConst& view, Endpoint remote_endpoint) {
+    Flush(); // keep datagrams order
     boost_ec ec;
     _socket.send_to(asio::buffer(view.ptr, view.size), ToEndpoint(remote_endpoint), 0, ec);
     if(ec && _error_callback) {
@@ -55,6 +81,18 @@ void UdpSocketWithExecutor::Send(const BufferViewConst& view, Endpoint remote_en
     }
 }
 
+void UdpSocketWithExecutor::Flush() {
+    if(!_tx_queue.Flush(_socket.native_handle()) && _error_callback) {
+        _error_callback(boost_ec(errno, boost::system::system_category()));
+    }
+}
+
+Buffer UdpSocketWithExecutor::CreateRxBuffer() {
+    auto buffer = Buffer::Create(_allocator);
+    buffer.ReserveHeadroom(_rx_headroom);
+    return buffer;
+}
+
 void UdpSocketWithExecutor::ReceiveAvailable() {
     boost_ec ec;
     while(_socket.available(ec)) {
@@ -65,7 +103,7 @@ void UdpSocketWithExecutor::ReceiveAvailable() {
         auto bytes = _socket.receive_from(asio::buffer(view.ptr, view.size), _ctx.remote_endpoint);
         _ctx.buffer.SetSize(bytes);
         _recv_callback(std::move(_ctx.buffer), ToEndpoint(_ctx.remote_endpoint));
-        _ctx.buffer = Buffer::Create(_allocator);
+        _ctx.buffer = CreateRxBuffer();
     }
 }
 
@@ -85,7 +123,7 @@ void UdpSocketWithExecutor::OnReceiveAsync(const boost_ec& ec, size_t bytes) {
     if(!ec) {
         _ctx.buffer.SetSize(bytes);
         _recv_callback(std::move(_ctx.buffer), ToEndpoint(_ctx.remote_endpoint));
-        _ctx.buffer = Buffer::Create(_allocator);
+        _ctx.buffer = CreateRxBuffer();
         ReceiveAsync();
     } else {
         if(_error_callback) {
@@ -94,6 +132,82 @@ void UdpSocketWithExecutor::OnReceiveAsync(const boost_ec& ec, size_t bytes) {
     }
 }
 
+void UdpSocketWithExecutor::ReceiveBatchAsync() {
+    _socket.async_wait(asio::ip::udp::socket::wait_read,
+        [weak_self = weak_from_this()](const boost_ec& ec) mutable {
+            if(auto self = weak_self.lock()) {
+                if(ec) {
+                    if(self->_error_callback) {
+                        self->_error_callback(ec);
+                    }
+                    return;
+                }
+                if(self->ReceiveBatch()) {
+                    self->ReceiveBatchAsync();
+                }
+            }
+        }
+    );
+}
+
+bool UdpSocketWithExecutor::ReceiveBatch() {
+    etl::array<mmsghdr, detail::kRxBatchMaxSize> messages;
+    etl::array<iovec, detail::kRxBatchMaxSize> iovecs;
+    etl::array<sockaddr_in, detail::kRxBatchMaxSize> src_addrs;
+    while(true) {
+        while(_rx_packets.size() < _rx_batch_size) {
+            auto packet = CreateRxBuffer();
+            if(packet.GetViewWithCapacity().ptr == nullptr) {
+                break;
+            }
+            _rx_packets.push_back(std::move(packet));
+        }
+        if(_rx_packets.empty()) {
+            TAU_LOG_WARNING_THR(128, "No free buffers");
+            return true;
+        }
+
+        for(size_t i = 0; i < _rx_packets.size(); ++i) {
+            auto view = _rx_packets[i].GetViewWithCapacity();
+            iovecs[i] = iovec{
+                .iov_base = view.ptr,
+                .iov_len = view.size
+            };
+            auto& header = messages[i].msg_hdr;
+            header = {};
+            header.msg_name = &src_addrs[i];
+            header.msg_namelen = sizeof(sockaddr_in);
+            header.msg_iov = &iovecs[i];
+            header.msg_iovlen = 1;
+            messages[i].msg_len = 0;
+        }
+
+        const auto count = recvmmsg(_socket.native_handle(), messages.data(), _rx_packets.size(), MSG_DONTWAIT, nullptr);
+        if(count < 0) {
+            const auto error = errno;
+            if((error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR)) {
+                return true;
+            }
+            if(_error_callback) {
+                _error_callback(boost_ec(error, boost::system::system_category()));
+            }
+            return false;
+        }
+        const auto requested = _rx_packets.size();
+        for(int i = 0; i < count; ++i) {
+            _rx_packets[i].SetSize(messages[i].msg_len);
+            _recv_callback(std::move(_rx_packets[i]), Endpoint{
+                .address = IpAddress{src_addrs[i].sin_addr.s_addr, true},
+                .port = ntohs(src_addrs[i].sin_port)
+            });
+        }
+        _rx_packets.erase(_rx_packets.begin(), _rx_packets.begin() + count);
+        if(static_cast<size_t>(count) < requested) {
+            return true; // socket queue is drained
+        }
+    }
+}
+
 asio::ip::udp::endpoint ToEndpoint(const Endpoint& endpoint) {
     return asio::ip::udp::endpoint{
         asio::ip::address_v4{endpoint.address.GetUint32()},
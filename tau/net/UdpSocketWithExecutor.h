@@ -3,6 +3,8 @@
 #include "tau/memory/Buffer.h"
 #include "tau/asio/Common.h"
 #include "tau/net/Endpoint.h"
+#include "tau/net/host/detail/UdpSendQueue.h"
+#include "tau/net/host/detail/UdpSocketRxTask.h"
 
 namespace tau::net {
 
@@ -14,10 +16,16 @@ public:
         IpAddress local_address;
         std::optional<uint16_t> local_port = std::nullopt;
         std::optional<IpAddress> multicast_address = {};
+        bool reuse_port = false; // SO_REUSEPORT, several sockets on the same port, see UdpSocketShards
+        size_t rx_batch_size = 1; // datagrams per recvmmsg call once the socket is readable, 1 - receive_from per datagram
+        size_t tx_batch_size = 1; // datagrams queued before sendmmsg/GSO flush, 1 - send_to per datagram
+        bool tx_gso = true;
+        size_t rx_headroom = 0; // reserved before received datagrams, to prepend a header in place (e.g. TURN relay)
     };
 
     using RecvCallback = std::function<void(Buffer&& packet, Endpoint remote_endpoint)>;
     using ErrorCallback = std::function<void(boost_ec)>;
+    using TxStats = detail::UdpSendQueue::Stats;
 
 public:
     static auto Create(Options&& options) {
@@ -31,19 +39,27 @@ public:
 
     void Send(Buffer&& packet, Endpoint remote_endpoint);
     void Send(const BufferViewConst& packet, Endpoint remote_endpoint);
+    void Flush(); // sends queued datagrams, if tx_batch_size > 1
 
     const std::optional<Endpoint>& GetLocalEndpoint() const { return _local_endpoint; }
+    int GetNativeHandle() { return _socket.native_handle(); }
+    const TxStats& GetTxStats() const { return _tx_queue.GetStats(); }
 
 private:
     UdpSocketWithExecutor(Options&& options);
 
+    Buffer CreateRxBuffer();
     void ReceiveAvailable();
     void ReceiveAsync();
     void OnReceiveAsync(const boost_ec& ec, size_t bytes);
+    void ReceiveBatchAsync();
+    bool ReceiveBatch(); // returns false on socket error
 
 private:
     Allocator& _allocator;
     Executor _executor;
+    const size_t _rx_headroom;
+    const size_t _rx_batch_size;
     asio::ip::udp::socket _socket;
     std::optional<Endpoint> _local_endpoint;
 
@@ -52,6 +68,9 @@ private:
         asio::ip::udp::endpoint remote_endpoint = {};
     };
     Context _ctx;
+    etl::vector<Buffer, detail::kRxBatchMaxSize> _rx_packets; // kept between recvmmsg calls, only consumed ones are refilled
+
+    detail::UdpSendQueue _tx_queue;
 
     RecvCallback _recv_callback;
     ErrorCallback _error_callback;
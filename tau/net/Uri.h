@@ -29,7 +29,7 @@ struct Uri {
     Host host;
     uint16_t port;
     Path path;
-    std::optional<Transport> transport = std::nullopt;
+    std::optional<Transport> transport = std::nullopt; // TURN "?transport=", the owner selects ice::TurnTransport by it
 };
 
 std::optional<Uri> GetUriFromString(etl::string_view str);
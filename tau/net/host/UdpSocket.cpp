@@ -13,6 +13,12 @@ UdpSocket::UdpSocket(Options&& options)
     , _rx_task(detail::UdpSocketRxContext{
         .allocator = _allocator,
         .buffer = _buffer,
+        .batch_size = options.rx_batch_size,
+        .ready_callback = std::move(options.ready_callback)
+    })
+    , _tx_queue(detail::UdpSendQueue::Options{
+        .batch_size = options.tx_batch_size,
+        .gso = options.tx_gso
     })
 {
     _socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
@@ -88,10 +94,34 @@ void UdpSocket::SetRecvCallback(RecvCallback callback) {
 }
 
 void UdpSocket::Send(Buffer&& packet, const Endpoint& remote_endpoint) {
-    Send(ToConst(packet.GetView()), remote_endpoint);
+    std::lock_guard lock{_tx_mutex};
+    if(_tx_queue.GetBatchSize() == 1) {
+        SendTo(ToConst(packet.GetView()), remote_endpoint);
+        return;
+    }
+    _tx_queue.Push(std::move(packet), remote_endpoint);
+    if(_tx_queue.Full()) {
+        FlushQueue();
+    }
 }
 
 void UdpSocket::Send(const BufferViewConst& view, const Endpoint& remote_endpoint) {
+    std::lock_guard lock{_tx_mutex};
+    SendTo(view, remote_endpoint);
+}
+
+void UdpSocket::Flush() {
+    std::lock_guard lock{_tx_mutex};
+    FlushQueue();
+}
+
+UdpSocket::TxStats UdpSocket::GetTxStats() const {
+    std::lock_guard lock{_tx_mutex};
+    return _tx_queue.GetStats();
+}
+
+void UdpSocket::SendTo(const BufferViewConst& view, const Endpoint& remote_endpoint) {
+    FlushQueue(); // keep datagrams order
     sockaddr_in dest = {
         .sin_family = AF_INET,
         .sin_port = htons(remote_endpoint.port),
@@ -105,6 +135,12 @@ void UdpSocket::Send(const BufferViewConst& view, const Endpoint& remote_endpoin
     }
 }
 
+void UdpSocket::FlushQueue() {
+    if(!_tx_queue.Flush(_socket)) {
+        TAU_LOG_WARNING_THR(128, "sendmmsg failed, error: " << errno << ", dropped: " << _tx_queue.GetStats().dropped);
+    }
+}
+
 bool UdpSocket::Receive() {
     size_t count = 0;
     while(!_buffer.Empty()) {
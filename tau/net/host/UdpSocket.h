@@ -1,9 +1,11 @@
 #pragma once
 
 #include "detail/UdpSocketRxTask.h"
+#include "detail/UdpSendQueue.h"
 #include <memory>
 #include <optional>
 #include <functional>
+#include <mutex>
 #include <thread>
 
 namespace tau::net {
@@ -15,9 +17,14 @@ public:
         IpAddress local_address;
         std::optional<uint16_t> local_port = std::nullopt;
         std::optional<IpAddress> multicast_address = std::nullopt;
+        size_t rx_batch_size = 1; // datagrams per recvmmsg call, 1 - recvfrom per datagram
+        size_t tx_batch_size = 1; // datagrams queued before sendmmsg/GSO flush, 1 - sendto per datagram
+        bool tx_gso = true;
+        std::function<void()> ready_callback = {}; // called by the rx thread once datagrams are queued for Receive()
     };
 
     using RecvCallback = std::function<void(Buffer&& packet, Endpoint remote_endpoint)>;
+    using TxStats = detail::UdpSendQueue::Stats;
     // using ErrorCallback = std::function<void(boost_ec)>;
 
 public:
@@ -29,12 +36,15 @@ public:
 
     void SetRecvCallback(RecvCallback callback);
 
+    // thread-safe: the tx queue is guarded, datagrams of a thread keep their order
     void Send(Buffer&& packet, const Endpoint& remote_endpoint);
     void Send(const BufferViewConst& packet, const Endpoint& remote_endpoint);
+    void Flush(); // sends queued datagrams, if tx_batch_size > 1
 
     bool Receive();
 
     const std::optional<Endpoint>& GetLocalEndpoint() const;
+    TxStats GetTxStats() const;
 
 private:
     UdpSocket(Options&& options);
@@ -43,6 +53,9 @@ private:
     void SetRecvBufferSize(int recv_buffer_size);
     void UpdateLocalEndpoint();
 
+    void SendTo(const BufferViewConst& packet, const Endpoint& remote_endpoint);
+    void FlushQueue();
+
 private:
     Allocator& _allocator;
     int _socket = 0;
@@ -52,6 +65,9 @@ private:
     detail::UdpSocketRxContext _rx_task;
     std::optional<std::thread> _rx_thread;
 
+    mutable std::mutex _tx_mutex;
+    detail::UdpSendQueue _tx_queue;
+
     RecvCallback _recv_callback;
 };
 
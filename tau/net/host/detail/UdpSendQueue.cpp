@@ -0,0 +1,178 @@
+#include "UdpSendQueue.h"
+#include <tau/common/Log.h>
+#include <etl/array.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <errno.h>
+#include <algorithm>
+#include <cstring>
+
+#ifndef UDP_SEGMENT
+    #define UDP_SEGMENT 103
+#endif
+
+namespace tau::net::detail {
+
+namespace {
+
+inline constexpr size_t kGsoMaxSize = 65000; // max UDP payload is 65507 for IPv4
+
+sockaddr_in ToSockAddr(const Endpoint& endpoint) {
+    return sockaddr_in{
+        .sin_family = AF_INET,
+        .sin_port = htons(endpoint.port),
+        .sin_addr = {.s_addr = endpoint.address.GetUint32(true)},
+        .sin_zero = {}
+    };
+}
+
+}
+
+UdpSendQueue::UdpSendQueue(Options&& options)
+    : _batch_size(std::clamp<size_t>(options.batch_size, 1, kTxBatchMaxSize))
+    , _gso(options.gso)
+{}
+
+bool UdpSendQueue::Push(Buffer&& packet, const Endpoint& remote_endpoint) {
+    if(Full()) {
+        return false;
+    }
+    _packets.push_back(Item{
+        .packet = std::move(packet),
+        .remote_endpoint = remote_endpoint
+    });
+    return true;
+}
+
+bool UdpSendQueue::Flush(int socket) {
+    if(_packets.empty()) {
+        return true;
+    }
+
+    const auto syscalls = _stats.syscalls;
+    _stats.packets += _packets.size();
+
+    bool ok = false;
+    if(IsGsoApplicable()) {
+        ok = SendGso(socket);
+    }
+    if(!ok) {
+        ok = SendBatch(socket);
+    }
+
+    const auto calls = _stats.syscalls - syscalls;
+    if(_packets.size() > calls) {
+        _stats.syscalls_saved += _packets.size() - calls;
+    }
+    _packets.clear();
+    return ok;
+}
+
+bool UdpSendQueue::IsGsoApplicable() const {
+    if(!_gso || (_packets.size() < 2)) {
+        return false;
+    }
+
+    // GSO splits the payload into equal segments, only the last one may be shorter
+    const auto& remote_endpoint = _packets.front().remote_endpoint;
+    const auto segment_size = _packets.front().packet.GetSize();
+    size_t total_size = 0;
+    for(size_t i = 0; i < _packets.size(); ++i) {
+        const auto& item = _packets[i];
+        const auto size = item.packet.GetSize();
+        if((item.remote_endpoint != remote_endpoint) || (size == 0) || (size > segment_size)) {
+            return false;
+        }
+        if((size < segment_size) && (i + 1 != _packets.size())) {
+            return false;
+        }
+        total_size += size;
+    }
+    return (total_size <= kGsoMaxSize);
+}
+
+bool UdpSendQueue::SendGso(int socket) {
+    etl::array<iovec, kTxBatchMaxSize> iovecs;
+    for(size_t i = 0; i < _packets.size(); ++i) {
+        auto view = _packets[i].packet.GetView();
+        iovecs[i] = iovec{
+            .iov_base = view.ptr,
+            .iov_len = view.size
+        };
+    }
+
+    auto dest = ToSockAddr(_packets.front().remote_endpoint);
+    alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(uint16_t))] = {};
+
+    msghdr header = {};
+    header.msg_name = &dest;
+    header.msg_namelen = sizeof(dest);
+    header.msg_iov = iovecs.data();
+    header.msg_iovlen = _packets.size();
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+
+    auto cmsg = CMSG_FIRSTHDR(&header);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    const uint16_t segment_size = _packets.front().packet.GetSize();
+    std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+    _stats.syscalls++;
+    auto bytes = sendmsg(socket, &header, 0);
+    if(bytes >= 0) {
+        _stats.gso_sends++;
+        return true;
+    }
+
+    const auto error = errno;
+    if((error == EINVAL) || (error == EIO) || (error == ENOPROTOOPT) || (error == EOPNOTSUPP)) {
+        // kernel or NIC doesn't support UDP GSO, use sendmmsg from now on
+        TAU_LOG_WARNING("UDP GSO is not supported, error: " << error << ", fallback to sendmmsg");
+        _gso = false;
+    }
+    return false;
+}
+
+bool UdpSendQueue::SendBatch(int socket) {
+    etl::array<mmsghdr, kTxBatchMaxSize> messages;
+    etl::array<iovec, kTxBatchMaxSize> iovecs;
+    etl::array<sockaddr_in, kTxBatchMaxSize> dests;
+    for(size_t i = 0; i < _packets.size(); ++i) {
+        auto view = _packets[i].packet.GetView();
+        iovecs[i] = iovec{
+            .iov_base = view.ptr,
+            .iov_len = view.size
+        };
+        dests[i] = ToSockAddr(_packets[i].remote_endpoint);
+        auto& header = messages[i].msg_hdr;
+        header = {};
+        header.msg_name = &dests[i];
+        header.msg_namelen = sizeof(sockaddr_in);
+        header.msg_iov = &iovecs[i];
+        header.msg_iovlen = 1;
+        messages[i].msg_len = 0;
+    }
+
+    size_t sent = 0;
+    while(sent < _packets.size()) {
+        _stats.syscalls++;
+        auto count = sendmmsg(socket, messages.data() + sent, _packets.size() - sent, 0);
+        if(count > 0) {
+            sent += count;
+            continue;
+        }
+        if((count < 0) && (errno == EINTR)) {
+            continue;
+        }
+        const auto error = errno;
+        _stats.dropped += _packets.size() - sent;
+        errno = error;
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <tau/memory/Buffer.h>
+#include <tau/net/Endpoint.h>
+#include <etl/vector.h>
+
+namespace tau::net::detail {
+
+inline constexpr size_t kTxBatchMaxSize = 64; // also UDP_MAX_SEGMENTS limit of GSO
+
+// Collects outgoing datagrams and sends them with one sendmmsg call,
+// or with one UDP GSO (UDP_SEGMENT) sendmsg if all datagrams go to the same endpoint
+class UdpSendQueue {
+public:
+    struct Options {
+        size_t batch_size = 1;
+        bool gso = true;
+    };
+
+    struct Stats {
+        size_t packets = 0;
+        size_t syscalls = 0;
+        size_t syscalls_saved = 0;
+        size_t gso_sends = 0;
+        size_t dropped = 0;
+    };
+
+public:
+    UdpSendQueue(Options&& options);
+
+    // returns false if queue is full (datagram is not queued, flush first)
+    bool Push(Buffer&& packet, const Endpoint& remote_endpoint);
+    // returns false on socket error, errno is preserved
+    bool Flush(int socket);
+
+    size_t GetBatchSize() const { return _batch_size; }
+    bool Full() const { return _packets.size() >= _batch_size; }
+    bool Empty() const { return _packets.empty(); }
+    const Stats& GetStats() const { return _stats; }
+
+private:
+    bool IsGsoApplicable() const;
+    bool SendGso(int socket);
+    bool SendBatch(int socket);
+
+private:
+    const size_t _batch_size;
+    bool _gso;
+
+    struct Item {
+        Buffer packet;
+        Endpoint remote_endpoint;
+    };
+    etl::vector<Item, kTxBatchMaxSize> _packets;
+
+    Stats _stats;
+};
+
+}
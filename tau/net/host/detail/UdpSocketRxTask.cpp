@@ -1,67 +1,157 @@
 #include "UdpSocketRxTask.h"
 #include <tau/common/Log.h>
+#include <etl/array.h>
+#include <etl/vector.h>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <netinet/in.h>
 #include <errno.h>
+#include <algorithm>
+#include <thread>
 
 namespace tau::net::detail {
 
-void UdpSocketRxTask(UdpSocketRxContext& ctx) {
-    TAU_LOG_DEBUG("Start");
-    auto& buffer = ctx.buffer;
-    auto& socket = ctx.socket;
+namespace {
 
-    timeval tv = {
-        .tv_sec = 0,
-        .tv_usec = 200 * 1000 // 200 ms
+void PushPacket(UdpSocketRxBuffer& buffer, Buffer&& packet, const sockaddr_storage& src_addr) {
+    PacketContext item{
+        .packet = std::move(packet),
+        .endpoint = Endpoint{
+            .address = IpAddress{},
+            .port = 0
+        }
     };
-    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if(src_addr.ss_family == AF_INET) {
+        auto in = reinterpret_cast<const sockaddr_in*>(&src_addr);
+        item.endpoint.address = IpAddress{in->sin_addr.s_addr, true};
+        item.endpoint.port = ntohs(in->sin_port);
+    }
 
-    while(!ctx.stop) {
-        PacketContext item{
-            .packet = Buffer::Create(ctx.allocator),
-            .endpoint = Endpoint{
-                .address = IpAddress{},
-                .port = 0
-            }
-        };
+    if(buffer.Full() || !buffer.Push(std::move(item))) {
+        TAU_LOG_WARNING_THR(128, "Push failed, full: " << buffer.Full());
+    }
+}
+
+// returns false if the task has to exit
+bool ProcessError(const UdpSocketRxContext& ctx, const char* function) {
+    if(ctx.stop) {
+        return false;
+    }
 
+    int error = errno;
+    if((error == EINTR) || (error == EAGAIN) || (error == EWOULDBLOCK)) {
+        return true;
+    }
+    if((error == EBADF) || (error == ENOTSOCK)) {
+        return false;
+    }
+    TAU_LOG_WARNING(function << " error: " << error);
+    return false;
+}
+
+void RecvSingle(UdpSocketRxContext& ctx) {
+    // the buffer is reused until a datagram is received, timeouts don't touch the allocator
+    auto packet = Buffer::Create(ctx.allocator);
+    while(!ctx.stop) {
         sockaddr_storage src_addr;
         socklen_t src_addr_size = sizeof(src_addr);
-        auto view = item.packet.GetViewWithCapacity();
-        auto bytes = recvfrom(socket, view.ptr, view.size, 0, (sockaddr*)&src_addr, &src_addr_size);
+        auto view = packet.GetViewWithCapacity();
+        auto bytes = recvfrom(ctx.socket, view.ptr, view.size, 0, (sockaddr*)&src_addr, &src_addr_size);
         if(bytes > 0) {
-            item.packet.SetSize(bytes);
-
-            if(src_addr.ss_family == AF_INET) {
-                auto in = reinterpret_cast<sockaddr_in*>(&src_addr);
-                item.endpoint.address = IpAddress{in->sin_addr.s_addr, true};
-                item.endpoint.port = ntohs(in->sin_port);
-            }
-
-            if(buffer.Full() || !buffer.Push(std::move(item))) {
-                TAU_LOG_WARNING("Push failed, full: " << buffer.Full());
+            packet.SetSize(bytes);
+            PushPacket(ctx.buffer, std::move(packet), src_addr);
+            packet = Buffer::Create(ctx.allocator);
+            if(ctx.ready_callback) {
+                ctx.ready_callback();
             }
             continue;
         }
         if(bytes == 0) {
             continue;
         }
-
-        if(ctx.stop) {
+        if(!ProcessError(ctx, "recvfrom")) {
             break;
         }
+    }
+}
+
+void RecvBatched(UdpSocketRxContext& ctx) {
+    const auto batch_size = std::min(ctx.batch_size, kRxBatchMaxSize);
+    etl::vector<Buffer, kRxBatchMaxSize> packets;
+    etl::array<mmsghdr, kRxBatchMaxSize> messages;
+    etl::array<iovec, kRxBatchMaxSize> iovecs;
+    etl::array<sockaddr_storage, kRxBatchMaxSize> src_addrs;
+
+    while(!ctx.stop) {
+        // buffers are kept between calls, only consumed ones are refilled from the pool
+        while(packets.size() < batch_size) {
+            auto packet = Buffer::Create(ctx.allocator);
+            if(packet.GetViewWithCapacity().ptr == nullptr) {
+                break;
+            }
+            packets.push_back(std::move(packet));
+        }
+        if(packets.empty()) {
+            TAU_LOG_WARNING_THR(128, "No free buffers");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
 
-        int error = errno;
-        if((error == EINTR) || (error == EAGAIN) || (error == EWOULDBLOCK)) {
+        for(size_t i = 0; i < packets.size(); ++i) {
+            auto view = packets[i].GetViewWithCapacity();
+            iovecs[i] = iovec{
+                .iov_base = view.ptr,
+                .iov_len = view.size
+            };
+            auto& header = messages[i].msg_hdr;
+            header = {};
+            header.msg_name = &src_addrs[i];
+            header.msg_namelen = sizeof(sockaddr_storage);
+            header.msg_iov = &iovecs[i];
+            header.msg_iovlen = 1;
+            messages[i].msg_len = 0;
+        }
+
+        // MSG_WAITFORONE: block (up to SO_RCVTIMEO) for the first datagram only, then take what is queued
+        auto count = recvmmsg(ctx.socket, messages.data(), packets.size(), MSG_WAITFORONE, nullptr);
+        if(count > 0) {
+            for(int i = 0; i < count; ++i) {
+                if(messages[i].msg_len > 0) {
+                    packets[i].SetSize(messages[i].msg_len);
+                    PushPacket(ctx.buffer, std::move(packets[i]), src_addrs[i]);
+                }
+            }
+            packets.erase(packets.begin(), packets.begin() + count);
+            if(ctx.ready_callback) {
+                ctx.ready_callback();
+            }
             continue;
         }
-        if((error == EBADF) || (error == ENOTSOCK)) {
+        if(count == 0) {
+            continue;
+        }
+        if(!ProcessError(ctx, "recvmmsg")) {
             break;
         }
-        TAU_LOG_WARNING("recvfrom error: " << error);
-        break;
+    }
+}
+
+}
+
+void UdpSocketRxTask(UdpSocketRxContext& ctx) {
+    TAU_LOG_DEBUG("Start, batch size: " << ctx.batch_size);
+    auto& socket = ctx.socket;
+
+    timeval tv = {
+        .tv_sec = 0,
+        .tv_usec = 200 * 1000 // 200 ms
+    };
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    if(ctx.batch_size > 1) {
+        RecvBatched(ctx);
+    } else {
+        RecvSingle(ctx);
     }
 
     TAU_LOG_DEBUG("Close socket");
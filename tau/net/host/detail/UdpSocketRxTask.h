@@ -3,6 +3,7 @@
 #include <tau/memory/Buffer.h>
 #include <tau/net/Endpoint.h>
 #include <tau/common/StaticQueue.h>
+#include <functional>
 
 namespace tau::net::detail {
 
@@ -14,10 +15,14 @@ struct PacketContext {
 //TODO: make capacity configurable?
 using UdpSocketRxBuffer = StaticQueue<PacketContext, 128>;
 
+inline constexpr size_t kRxBatchMaxSize = 64;
+
 struct UdpSocketRxContext {
     Allocator& allocator;
     UdpSocketRxBuffer& buffer;
-    
+    size_t batch_size = 1; // 1: recvfrom per datagram, >1: recvmmsg with up to batch_size datagrams
+    std::function<void()> ready_callback = {}; // called by the rx thread once datagrams are queued
+
     int socket = 0;
     // TaskHandle_t task = nullptr;
     volatile bool stop = false;
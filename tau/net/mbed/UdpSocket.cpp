@@ -12,6 +12,7 @@ UdpSocket::UdpSocket(Options&& options)
     , _rx_task(detail::UdpSocketRxContext{
         .allocator = _allocator,
         .buffer = _buffer,
+        .ready_callback = std::move(options.ready_callback)
     })
 {
     _socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
@@ -20,6 +20,8 @@ public:
         IpAddress local_address;
         std::optional<uint16_t> local_port = std::nullopt;
         // std::optional<IpAddress> multicast_address = std::nullopt; //TODO: implement
+        size_t tx_batch_size = 1; // ignored, lwip sends datagram per call
+        std::function<void()> ready_callback = {}; // called by the rx task once datagrams are queued for Receive()
     };
 
     using RecvCallback = std::function<void(Buffer&& packet, Endpoint remote_endpoint)>;
@@ -36,6 +38,7 @@ public:
 
     void Send(Buffer&& packet, const Endpoint& remote_endpoint);
     void Send(const BufferViewConst& packet, const Endpoint& remote_endpoint);
+    void Flush() {} // datagrams are not queued
 
     bool Receive();
 
@@ -41,6 +41,9 @@ void UdpSocketRxTask(void* arg) {
             if(buffer.Full() || !buffer.Push(std::move(item))) {
                 TAU_LOG_WARNING("Push failed");
             }
+            if(ctx->ready_callback) {
+                ctx->ready_callback();
+            }
             continue;
         }
         if(bytes == 0) {
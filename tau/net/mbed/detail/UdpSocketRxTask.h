@@ -3,6 +3,7 @@
 #include <tau/memory/Buffer.h>
 #include <tau/net/Endpoint.h>
 #include <tau/common/StaticQueue.h>
+#include <functional>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -18,6 +19,7 @@ using UdpSocketRxBuffer = StaticQueue<PacketContext, 64>;
 struct UdpSocketRxContext {
     Allocator& allocator;
     UdpSocketRxBuffer& buffer;
+    std::function<void()> ready_callback = {}; // called by the rx task once datagrams are queued
     
     int socket = 0;
     TaskHandle_t task = nullptr;
@@ -23,6 +23,7 @@ enum Type : uint8_t {
 
 enum RtpfbType : uint8_t {
     kNack  = 1,    // Generic Nack,            RFC-4585
+    kTwcc  = 15,   // Transport-wide Feedback, draft-holmer-rmcat-transport-wide-cc-extensions-01
 };
 
 enum PsfbType : uint8_t {
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "tau/rtp/Sn.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+
+namespace tau::rtcp {
+
+// Ring of SN bits for NACK: SN is mapped to bit (sn % kSize), tracked SNs are in [sn_begin, sn_begin + kSize).
+// The window is moved by Advance(), FCIs are built from the words (see NackWriter)
+class NackBitmap {
+public:
+    static constexpr size_t kSize = 4096;
+    static constexpr size_t kWordBits = 8 * sizeof(uint64_t);
+    static constexpr size_t kWords = kSize / kWordBits;
+    static_assert(0x10000 % kSize == 0, "SN wraparound keeps the mapping");
+
+public:
+    explicit NackBitmap(uint16_t sn_begin)
+        : _sn_begin(sn_begin)
+    {}
+
+    uint16_t GetSnBegin() const { return _sn_begin; }
+    size_t GetSize() const { return _size; }
+    bool IsEmpty() const { return _size == 0; }
+
+    bool InWindow(uint16_t sn) const {
+        return rtp::SnDelta(sn, _sn_begin) < kSize;
+    }
+
+    bool Test(uint16_t sn) const {
+        return InWindow(sn) && (_words[GetWordIndex(sn)] & GetBitMask(sn));
+    }
+
+    bool Set(uint16_t sn) {
+        if(!InWindow(sn)) {
+            return false;
+        }
+        auto& word = _words[GetWordIndex(sn)];
+        const auto mask = GetBitMask(sn);
+        _size += (word & mask) ? 0 : 1;
+        word |= mask;
+        return true;
+    }
+
+    void Reset(uint16_t sn) {
+        if(!InWindow(sn)) {
+            return;
+        }
+        auto& word = _words[GetWordIndex(sn)];
+        const auto mask = GetBitMask(sn);
+        _size -= (word & mask) ? 1 : 0;
+        word &= ~mask;
+    }
+
+    // SNs before sn_begin leave the window
+    void Advance(uint16_t sn_begin) {
+        const auto delta = rtp::SnDelta(sn_begin, _sn_begin);
+        if(delta >= kSize) {
+            Clear(sn_begin);
+            return;
+        }
+        for(uint16_t sn = _sn_begin; sn != sn_begin; ++sn) {
+            Reset(sn);
+        }
+        _sn_begin = sn_begin;
+    }
+
+    void Clear(uint16_t sn_begin) {
+        _words.fill(0);
+        _size = 0;
+        _sn_begin = sn_begin;
+    }
+
+    // up to 64 bits of the window from sn, bit 0 is sn itself
+    uint64_t GetBits(uint16_t sn) const {
+        const auto offset = rtp::SnDelta(sn, _sn_begin);
+        if(offset >= kSize) {
+            return 0;
+        }
+        const auto index = GetWordIndex(sn);
+        const auto shift = sn % kWordBits;
+        uint64_t bits = _words[index] >> shift;
+        if(shift) {
+            bits |= _words[(index + 1) % kWords] << (kWordBits - shift);
+        }
+        const auto tail = kSize - offset;
+        if(tail < kWordBits) {
+            bits &= (uint64_t{1} << tail) - 1; // the ring wraps to the window begin
+        }
+        return bits;
+    }
+
+    // first set SN in [sn, window end)
+    std::optional<uint16_t> FindNext(uint16_t sn) const {
+        for(size_t offset = rtp::SnDelta(sn, _sn_begin); offset < kSize; offset += kWordBits) {
+            const auto next = static_cast<uint16_t>(_sn_begin + offset);
+            const auto bits = GetBits(next);
+            if(bits) {
+                return static_cast<uint16_t>(next + std::countr_zero(bits));
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    static size_t GetWordIndex(uint16_t sn) { return (sn % kSize) / kWordBits; }
+    static uint64_t GetBitMask(uint16_t sn) { return uint64_t{1} << (sn % kWordBits); }
+
+private:
+    uint16_t _sn_begin;
+    size_t _size = 0;
+    std::array<uint64_t, kWords> _words = {};
+};
+
+}
@@ -16,24 +16,34 @@ public:
         return Read32(view.ptr + kHeaderSize + sizeof(uint32_t));
     }
 
-    static NackSns GetSns(const BufferViewConst& view) {
-        NackSns sns;
+    template<typename Callback>
+    static void ForEachSn(const BufferViewConst& view, Callback&& callback) {
         auto begin = view.ptr + kHeaderSize + 2 * sizeof(uint32_t);
         auto end = view.ptr + view.size;
         while(begin + sizeof(NackMessage) <= end) {
             auto pid = Read16(begin);
             auto blp = Read16(begin + sizeof(uint16_t));
-            sns.insert(pid);
+            callback(pid);
             while(blp != 0) {
                 pid++;
                 constexpr uint16_t kLeastBitMask = 1;
                 if((blp & kLeastBitMask) == kLeastBitMask) {
-                    sns.insert(pid);
+                    callback(pid);
                 }
                 blp >>= 1;
             }
             begin += sizeof(NackMessage);
         }
+    }
+
+    // first NackSns capacity SNs, use ForEachSn() for long NACKs
+    static NackSns GetSns(const BufferViewConst& view) {
+        NackSns sns;
+        ForEachSn(view, [&sns](uint16_t sn) {
+            if(!sns.full()) {
+                sns.insert(sn);
+            }
+        });
         return sns;
     }
 
@@ -2,6 +2,7 @@
 
 #include "tau/rtcp/Writer.h"
 #include "tau/rtcp/NackMessage.h"
+#include "tau/rtcp/NackBitmap.h"
 #include "tau/rtp/Sn.h"
 
 namespace tau::rtcp {
@@ -41,7 +42,42 @@ public:
         return true;
     }
 
+    // PID is the next set bit, BLP is the following 16 bits of the bitmap. The oldest SNs are written if all FCIs
+    // don't fit, returns the number of written SNs (the first ones of the bitmap), 0 if nothing is written
+    static size_t Write(Writer& writer, uint32_t sender_ssrc, uint32_t media_ssrc, const NackBitmap& sns) {
+        constexpr auto kFixedLength = kHeaderSize + sizeof(sender_ssrc) + sizeof(media_ssrc);
+        const auto available = writer.GetAvailableSize();
+        if(sns.IsEmpty() || (available < kFixedLength + sizeof(NackMessage))) {
+            return 0;
+        }
+        const auto max_count = (available - kFixedLength) / sizeof(NackMessage);
+        size_t count = 0;
+        ForEachMessage(sns, max_count, [&count](uint16_t, uint16_t) { count++; });
+        const auto length = kFixedLength + count * sizeof(NackMessage);
+
+        writer.WriteHeader(Type::kRtpfb, RtpfbType::kNack, length);
+        writer.Write(sender_ssrc);
+        writer.Write(media_ssrc);
+        size_t written = 0;
+        ForEachMessage(sns, count, [&writer, &written](uint16_t pid, uint16_t blp) {
+            writer.Write(pid);
+            writer.Write(blp);
+            written += 1 + std::popcount(blp);
+        });
+        return written;
+    }
+
 private:
+    template<typename Callback>
+    static void ForEachMessage(const NackBitmap& sns, size_t max_count, Callback&& callback) {
+        auto pid = sns.FindNext(sns.GetSnBegin());
+        for(size_t i = 0; pid && (i < max_count); ++i) {
+            const auto blp = static_cast<uint16_t>(sns.GetBits(*pid) >> 1);
+            callback(*pid, blp);
+            pid = sns.FindNext(rtp::SnForward(*pid, kBlpBitCount + 1));
+        }
+    }
+
     static size_t CalcNackMessagesCount(const NackSns& sns) {
         size_t count = 0;
         uint16_t pid = sns.empty() ? 0 : rtp::SnBackward(*sns.begin(), kBlpBitCount + 1);
@@ -5,6 +5,7 @@
 #include "tau/rtcp/PliReader.h"
 #include "tau/rtcp/FirReader.h"
 #include "tau/rtcp/NackReader.h"
+#include "tau/rtcp/TwccReader.h"
 #include "tau/rtcp/SdesReader.h"
 #include "tau/common/NetToHost.h"
 
@@ -52,6 +53,7 @@ bool Reader::Validate(const BufferViewConst& view) {
                 const auto fmt = GetRc(report.ptr[0]);
                 switch(fmt) {
                     case RtpfbType::kNack: return NackReader::Validate(report);
+                    case RtpfbType::kTwcc: return TwccReader::Validate(report);
                     default:
                         break;
                 }
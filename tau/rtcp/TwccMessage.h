@@ -0,0 +1,34 @@
+#pragma once
+
+#include <etl/vector.h>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+namespace tau::rtcp {
+
+// https://datatracker.ietf.org/doc/html/draft-holmer-rmcat-transport-wide-cc-extensions-01#section-3.1
+// The Transport-wide Feedback message is identified by PT=RTPFB and FMT=15
+
+inline constexpr uint32_t kTwccReferenceTimeUnitUs = 64'000;
+inline constexpr uint32_t kTwccDeltaUnitUs = 250;
+inline constexpr size_t kTwccMaxStatusCount = 1024;
+
+enum TwccSymbol : uint8_t {
+    kNotReceived = 0,
+    kSmallDelta  = 1, // 1 byte, [0, 63.75] ms
+    kLargeDelta  = 2, // 2 bytes, signed
+};
+
+struct TwccFeedback {
+    uint16_t base_sn;
+    uint8_t fb_count;
+    int32_t reference_time; // 24-bit signed, kTwccReferenceTimeUnitUs units
+    // per packet starting from base_sn: receive delta to the previous received packet (to reference time for the first one)
+    // in kTwccDeltaUnitUs units, std::nullopt for not received packets
+    etl::vector<std::optional<int16_t>, kTwccMaxStatusCount> deltas;
+
+    bool operator==(const TwccFeedback&) const = default;
+};
+
+}
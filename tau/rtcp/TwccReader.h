@@ -0,0 +1,98 @@
+#pragma once
+
+#include "tau/rtcp/Header.h"
+#include "tau/rtcp/TwccMessage.h"
+#include "tau/common/NetToHost.h"
+
+namespace tau::rtcp {
+
+class TwccReader {
+public:
+    static constexpr size_t kFixedSize = kHeaderSize + 4 * sizeof(uint32_t);
+
+public:
+    static uint32_t GetSenderSsrc(const BufferViewConst& view) {
+        return Read32(view.ptr + kHeaderSize);
+    }
+
+    static uint32_t GetMediaSsrc(const BufferViewConst& view) {
+        return Read32(view.ptr + kHeaderSize + sizeof(uint32_t));
+    }
+
+    static std::optional<TwccFeedback> GetFeedback(const BufferViewConst& view) {
+        if(view.size < kFixedSize) {
+            return std::nullopt;
+        }
+        auto ptr = view.ptr + kHeaderSize + 2 * sizeof(uint32_t);
+        const auto end = view.ptr + view.size;
+
+        TwccFeedback feedback{
+            .base_sn = Read16(ptr),
+            .fb_count = ptr[7],
+            .reference_time = static_cast<int32_t>(Read24(ptr + 4) << 8) >> 8,
+            .deltas = {}
+        };
+        const size_t status_count = Read16(ptr + sizeof(uint16_t));
+        if((status_count == 0) || (status_count > kTwccMaxStatusCount)) {
+            return std::nullopt;
+        }
+        ptr += 2 * sizeof(uint32_t);
+
+        etl::vector<TwccSymbol, kTwccMaxStatusCount> symbols;
+        while(symbols.size() < status_count) {
+            if(ptr + sizeof(uint16_t) > end) {
+                return std::nullopt;
+            }
+            const auto chunk = Read16(ptr);
+            ptr += sizeof(uint16_t);
+            const auto remaining = status_count - symbols.size();
+            if((chunk & 0x8000) == 0) {
+                const auto symbol = static_cast<TwccSymbol>((chunk >> 13) & 0b11);
+                const size_t run = chunk & 0x1FFF;
+                if((run == 0) || (run > remaining)) {
+                    return std::nullopt;
+                }
+                symbols.insert(symbols.end(), run, symbol);
+            } else if((chunk & 0x4000) == 0) {
+                for(size_t i = 0; i < std::min<size_t>(14, remaining); ++i) {
+                    symbols.push_back(static_cast<TwccSymbol>((chunk >> (13 - i)) & 0b1));
+                }
+            } else {
+                for(size_t i = 0; i < std::min<size_t>(7, remaining); ++i) {
+                    symbols.push_back(static_cast<TwccSymbol>((chunk >> (2 * (6 - i))) & 0b11));
+                }
+            }
+        }
+
+        for(auto symbol : symbols) {
+            switch(symbol) {
+                case TwccSymbol::kNotReceived:
+                    feedback.deltas.push_back(std::nullopt);
+                    break;
+                case TwccSymbol::kSmallDelta:
+                    if(ptr + sizeof(uint8_t) > end) {
+                        return std::nullopt;
+                    }
+                    feedback.deltas.push_back(static_cast<int16_t>(*ptr));
+                    ptr += sizeof(uint8_t);
+                    break;
+                case TwccSymbol::kLargeDelta:
+                    if(ptr + sizeof(uint16_t) > end) {
+                        return std::nullopt;
+                    }
+                    feedback.deltas.push_back(static_cast<int16_t>(Read16(ptr)));
+                    ptr += sizeof(uint16_t);
+                    break;
+                default:
+                    return std::nullopt;
+            }
+        }
+        return feedback;
+    }
+
+    static bool Validate(const BufferViewConst& view) {
+        return (view.size % sizeof(uint32_t) == 0) && GetFeedback(view).has_value();
+    }
+};
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "tau/rtcp/Writer.h"
+#include "tau/rtcp/TwccMessage.h"
+#include <algorithm>
+
+namespace tau::rtcp {
+
+class TwccWriter {
+public:
+    static constexpr size_t kFixedSize = kHeaderSize + 4 * sizeof(uint32_t);
+    static constexpr size_t kRunLengthMax = 0x1FFF;
+    static constexpr size_t kOneBitSymbolsCount = 14;
+    static constexpr size_t kTwoBitSymbolsCount = 7;
+
+public:
+    static bool Write(Writer& writer, uint32_t sender_ssrc, uint32_t media_ssrc, const TwccFeedback& feedback) {
+        const auto& deltas = feedback.deltas;
+        if(deltas.empty()) {
+            return false;
+        }
+
+        etl::vector<uint16_t, kTwccMaxStatusCount> chunks;
+        size_t deltas_size = 0;
+        for(size_t i = 0; i < deltas.size();) {
+            const auto [chunk, count] = BuildChunk(deltas, i);
+            chunks.push_back(chunk);
+            for(size_t j = i; j < i + count; ++j) {
+                deltas_size += GetSymbol(deltas[j]);
+            }
+            i += count;
+        }
+
+        const auto length = kFixedSize + chunks.size() * sizeof(uint16_t) + deltas_size;
+        const auto padded_length = (length + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t);
+        if(writer.GetAvailableSize() < padded_length) {
+            return false;
+        }
+
+        writer.WriteHeader(Type::kRtpfb, RtpfbType::kTwcc, padded_length);
+        writer.Write(sender_ssrc);
+        writer.Write(media_ssrc);
+        writer.Write(feedback.base_sn);
+        writer.Write(static_cast<uint16_t>(deltas.size()));
+        writer.Write((static_cast<uint32_t>(feedback.reference_time) << 8) | feedback.fb_count);
+        for(auto chunk : chunks) {
+            writer.Write(chunk);
+        }
+        for(auto& delta : deltas) {
+            switch(GetSymbol(delta)) {
+                case TwccSymbol::kSmallDelta: writer.Write(static_cast<uint8_t>(*delta)); break;
+                case TwccSymbol::kLargeDelta: writer.Write(static_cast<uint16_t>(*delta)); break;
+                default:
+                    break;
+            }
+        }
+        // zero padding inside the report, the receiver knows the deltas count from the chunks
+        for(auto i = length; i < padded_length; ++i) {
+            writer.Write(uint8_t{0});
+        }
+        return true;
+    }
+
+private:
+    static TwccSymbol GetSymbol(const std::optional<int16_t>& delta) {
+        if(!delta) {
+            return TwccSymbol::kNotReceived;
+        }
+        return ((*delta >= 0) && (*delta <= 0xFF)) ? TwccSymbol::kSmallDelta : TwccSymbol::kLargeDelta;
+    }
+
+    // returns chunk and count of the covered statuses
+    template<typename Deltas>
+    static std::pair<uint16_t, size_t> BuildChunk(const Deltas& deltas, size_t begin) {
+        const auto remaining = deltas.size() - begin;
+        const auto symbol = GetSymbol(deltas[begin]);
+        size_t run = 1;
+        while((run < remaining) && (run < kRunLengthMax) && (GetSymbol(deltas[begin + run]) == symbol)) {
+            run++;
+        }
+        if((run >= kOneBitSymbolsCount) || (run == remaining)) {
+            return {BuildRunLengthChunk(symbol, run), run};
+        }
+
+        const auto one_bit_count = std::min(kOneBitSymbolsCount, remaining);
+        bool one_bit = true;
+        for(size_t i = begin; i < begin + one_bit_count; ++i) {
+            one_bit &= (GetSymbol(deltas[i]) != TwccSymbol::kLargeDelta);
+        }
+        if(one_bit) {
+            uint16_t chunk = 0b1000'0000'0000'0000;
+            for(size_t i = 0; i < one_bit_count; ++i) {
+                chunk |= GetSymbol(deltas[begin + i]) << (kOneBitSymbolsCount - 1 - i);
+            }
+            return {chunk, one_bit_count};
+        }
+        if(run >= kTwoBitSymbolsCount) {
+            return {BuildRunLengthChunk(symbol, run), run};
+        }
+
+        const auto two_bit_count = std::min(kTwoBitSymbolsCount, remaining);
+        uint16_t chunk = 0b1100'0000'0000'0000;
+        for(size_t i = 0; i < two_bit_count; ++i) {
+            chunk |= GetSymbol(deltas[begin + i]) << (2 * (kTwoBitSymbolsCount - 1 - i));
+        }
+        return {chunk, two_bit_count};
+    }
+
+    static uint16_t BuildRunLengthChunk(TwccSymbol symbol, size_t run) {
+        return static_cast<uint16_t>((symbol << 13) | run);
+    }
+};
+
+}
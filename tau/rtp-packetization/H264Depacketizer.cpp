@@ -3,29 +3,65 @@
 #include <tau/rtp/Reader.h>
 #include <tau/video/h264/Nalu.h>
 #include <tau/common/NetToHost.h>
-#include <numeric>
 
 namespace tau::rtp {
 
 using namespace h264;
 
-H264Depacketizer::H264Depacketizer(Allocator& allocator)
+H264Depacketizer::H264Depacketizer(Allocator& allocator, size_t nalu_max_size)
     : _allocator(allocator)
+    , _nalu_max_size(nalu_max_size)
 {}
 
 bool H264Depacketizer::Process(Frame&& frame) {
+    return Process(std::move(frame), true);
+}
+
+bool H264Depacketizer::ProcessChunk(Frame&& chunk) {
+    return Process(std::move(chunk), false);
+}
+
+bool H264Depacketizer::IsKeyFrameStart(BufferViewConst rtp_payload_view) {
+    if(rtp_payload_view.size == 0) {
+        return false;
+    }
+    auto is_key = [](uint8_t type) { return (type == NaluType::kSps) || (type == NaluType::kIdr); };
+    const auto header = reinterpret_cast<const NaluHeader*>(&rtp_payload_view.ptr[0]);
+    if(header->type == NaluType::kFuA) {
+        if(rtp_payload_view.size <= sizeof(FuAIndicator) + sizeof(FuHeader)) {
+            return false;
+        }
+        const auto fu_header = reinterpret_cast<const FuHeader*>(&rtp_payload_view.ptr[1]);
+        return fu_header->start && is_key(fu_header->type);
+    }
+    if(header->type == NaluType::kStapA) {
+        rtp_payload_view.ForwardPtrUnsafe(sizeof(NaluHeader));
+        while(rtp_payload_view.size > sizeof(uint16_t)) {
+            const auto nalu_size = Read16(rtp_payload_view.ptr);
+            if((nalu_size == 0) || (rtp_payload_view.size < sizeof(uint16_t) + nalu_size)) {
+                break;
+            }
+            if(is_key(reinterpret_cast<const NaluHeader*>(&rtp_payload_view.ptr[sizeof(uint16_t)])->type)) {
+                return true;
+            }
+            rtp_payload_view.ForwardPtrUnsafe(sizeof(uint16_t) + nalu_size);
+        }
+        return false;
+    }
+    return is_key(header->type);
+}
+
+bool H264Depacketizer::Process(Frame&& frame, bool frame_end) {
     bool ok = true;
-    _nalu_max_size = GetNaluMaxSize(frame);
     for(size_t i = 0; i < frame.size(); ++i) {
-        const auto& packet = frame[i];
-        Reader reader(packet.GetView());
-        const auto last = reader.Marker() || ((i + 1) == frame.size());
-        ok &= Process(reader.Payload(), packet.GetInfo().tp, last);
+        const auto last = Reader(ToConst(frame[i].GetView())).Marker() || (frame_end && ((i + 1) == frame.size()));
+        ok &= Process(std::move(frame[i]), last);
     }
     return ok;
 }
 
-bool H264Depacketizer::Process(BufferViewConst rtp_payload_view, Timepoint tp, bool last) {
+bool H264Depacketizer::Process(Buffer&& packet, bool last) {
+    const auto rtp_payload_view = Reader(ToConst(packet.GetView())).Payload();
     if(rtp_payload_view.size == 0) {
         return false;
     }
@@ -35,10 +71,11 @@ bool H264Depacketizer::Process(BufferViewConst rtp_payload_view, Timepoint tp, b
     }
 
     if(header->type == NaluType::kFuA) {
-        return ProcessFuA(rtp_payload_view, tp, last);
+        return ProcessFuA(std::move(packet), rtp_payload_view, last);
     }
-    _fua_nal_unit.reset();
+    ResetFuA();
 
+    const auto tp = packet.GetInfo().tp;
     if(header->type == NaluType::kStapA) {
         return ProcessStapA(rtp_payload_view, tp, last);
     }
@@ -55,33 +92,43 @@ bool H264Depacketizer::ProcessSingle(BufferViewConst rtp_payload_view, Timepoint
     return true;
 }
 
-bool H264Depacketizer::ProcessFuA(BufferViewConst rtp_payload_view, Timepoint tp, bool last) {
+bool H264Depacketizer::ProcessFuA(Buffer&& packet, BufferViewConst rtp_payload_view, bool last) {
     if(!ValidateFuA(rtp_payload_view)) {
-        _fua_nal_unit.reset();
+        ResetFuA();
         return false;
     }
     const auto fu_header = reinterpret_cast<const FuHeader*>(&rtp_payload_view.ptr[1]);
     if(fu_header->start) {
-        _fua_nal_unit.emplace(Buffer::Create(_allocator, _nalu_max_size, Buffer::Info{.tp = tp, .flags = kFlagsNone}));
-
+        ResetFuA();
         const auto fua_indicator = reinterpret_cast<const FuAIndicator*>(&rtp_payload_view.ptr[0]);
-        _fua_nal_unit->GetView().ptr[0] = CreateNalUnitHeader(fu_header->type, fua_indicator->nri);
-        _fua_nal_unit->SetSize(sizeof(NaluHeader));
+        _fua_nalu_header = CreateNalUnitHeader(fu_header->type, fua_indicator->nri);
+        _fua_size = sizeof(NaluHeader);
     }
+    const auto end = fu_header->end;
     rtp_payload_view.ForwardPtrUnsafe(sizeof(FuAIndicator) + sizeof(FuHeader));
+    _fua_size += rtp_payload_view.size;
+    if(_fua_size > _nalu_max_size) {
+        ResetFuA();
+        return false;
+    }
+    _fua_fragments.push_back(Fragment{.packet = std::move(packet), .payload = rtp_payload_view});
+    if(!end) {
+        return true;
+    }
 
-    auto nalu_view = _fua_nal_unit->GetView();
-    nalu_view.ForwardPtrUnsafe(nalu_view.size);
-    memcpy(nalu_view.ptr, rtp_payload_view.ptr, rtp_payload_view.size);
-    _fua_nal_unit->SetSize(_fua_nal_unit->GetSize() + rtp_payload_view.size);
-
-    if(fu_header->end) {
-        if(last) {
-            _fua_nal_unit->GetInfo().flags = kFlagsLast;
-        }
-        _callback(std::move(*_fua_nal_unit));
-        _fua_nal_unit.reset();
+    const auto tp = _fua_fragments.front().packet.GetInfo().tp;
+    // shared: a packetizer can reference slices of the reassembled NAL unit instead of copying it
+    auto nalu = Buffer::CreateShared(_allocator, _fua_size, Buffer::Info{.tp = tp, .flags = last ? kFlagsLast : kFlagsNone});
+    auto nalu_view = nalu.GetView();
+    nalu_view.ptr[0] = *_fua_nalu_header;
+    size_t offset = sizeof(NaluHeader);
+    for(const auto& fragment : _fua_fragments) {
+        memcpy(&nalu_view.ptr[offset], fragment.payload.ptr, fragment.payload.size);
+        offset += fragment.payload.size;
     }
+    nalu.SetSize(offset);
+    ResetFuA();
+    _callback(std::move(nalu));
     return true;
 }
 
@@ -112,7 +159,7 @@ bool H264Depacketizer::ValidateFuA(BufferViewConst rtp_payload_view) const {
     if(fu_header->start && fu_header->end) {
         return false;
     }
-    if(!fu_header->start && !_fua_nal_unit.has_value()) {
+    if(!fu_header->start && !_fua_nalu_header.has_value()) {
         return false;
     }
     if(fu_header->type >= NaluType::kStapA) {
@@ -121,11 +168,10 @@ bool H264Depacketizer::ValidateFuA(BufferViewConst rtp_payload_view) const {
     return true;
 }
 
-size_t H264Depacketizer::GetNaluMaxSize(const Frame& frame) {
-    auto sum = std::accumulate(frame.begin(), frame.end(), 0, [](size_t total, const Buffer& packet) {
-        return total + packet.GetSize();
-    });
-    return std::max(sum, kNaluMaxSizeDefault);
+void H264Depacketizer::ResetFuA() {
+    _fua_nalu_header.reset();
+    _fua_fragments.clear();
+    _fua_size = 0;
 }
 
 }
@@ -3,38 +3,52 @@
 #include <tau/rtp/Frame.h>
 #include <functional>
 #include <optional>
+#include <vector>
 
 namespace tau::rtp {
 
+// Frames could be passed by chunks (see FrameProcessor): FU-A fragments are kept as received packets
+// until the end fragment, then NAL unit is gathered at once. nalu_max_size caps the memory of NAL unit in progress
 class H264Depacketizer {
 public:
-    static constexpr auto kNaluMaxSizeDefault = 0x1'0000;
+    static constexpr size_t kNaluMaxSizeDefault = 0x40'0000;
 
     using Callback = std::function<void(Buffer&&)>;
 
 public:
-    explicit H264Depacketizer(Allocator& allocator);
+    explicit H264Depacketizer(Allocator& allocator, size_t nalu_max_size = kNaluMaxSizeDefault);
 
     void SetCallback(Callback callback) { _callback = std::move(callback); }
 
     bool Process(Frame&& frame);
+    bool ProcessChunk(Frame&& chunk); // the frame isn't completed yet
+
+    // the packet starts a key-frame: SPS or the first fragment of IDR (e.g. layer switch of SimulcastForwarder)
+    static bool IsKeyFrameStart(BufferViewConst rtp_payload_view);
 
 private:
-    bool Process(BufferViewConst rtp_payload_view, Timepoint tp, bool last);
+    struct Fragment {
+        Buffer packet;
+        BufferViewConst payload;
+    };
+
+    bool Process(Frame&& frame, bool frame_end);
+    bool Process(Buffer&& packet, bool last);
     bool ProcessSingle(BufferViewConst rtp_payload_view, Timepoint tp, bool last);
-    bool ProcessFuA(BufferViewConst rtp_payload_view, Timepoint tp, bool last);
+    bool ProcessFuA(Buffer&& packet, BufferViewConst rtp_payload_view, bool last);
     bool ProcessStapA(BufferViewConst rtp_payload_view, Timepoint tp, bool last);
 
     bool ValidateFuA(BufferViewConst payload_view) const;
-
-    static size_t GetNaluMaxSize(const Frame& frame);
+    void ResetFuA();
 
 private:
     Allocator& _allocator;
+    const size_t _nalu_max_size;
     Callback _callback;
 
-    size_t _nalu_max_size = kNaluMaxSizeDefault;
-    std::optional<Buffer> _fua_nal_unit;
+    std::optional<uint8_t> _fua_nalu_header;
+    std::vector<Fragment> _fua_fragments;
+    size_t _fua_size = 0;
 };
 
 }
@@ -28,7 +28,7 @@ bool H264Packetizer::Process(const Buffer& au) {
             bool last = (i + 1 == nal_units.size()) && (offset == view.size);
 
             nal_unit.ForwardPtrUnsafe(video::GetStartCodeLength(nal_unit, 0));
-            if(!Process(nal_unit, au.GetInfo().tp, last)) {
+            if(!Process(au, nal_unit, au.GetInfo().tp, last)) {
                 return false;
             }
         }
@@ -38,10 +38,10 @@ bool H264Packetizer::Process(const Buffer& au) {
 }
 
 bool H264Packetizer::Process(const Buffer& nal_unit, bool last) {
-    return Process(nal_unit.GetView(), nal_unit.GetInfo().tp, last);
+    return Process(nal_unit, nal_unit.GetView(), nal_unit.GetInfo().tp, last);
 }
 
-bool H264Packetizer::Process(const BufferViewConst& view, Timepoint tp, bool last) {
+bool H264Packetizer::Process(const Buffer& origin, const BufferViewConst& view, Timepoint tp, bool last) {
     if(view.size <= sizeof(NaluHeader)) {
         return false;
     }
@@ -51,23 +51,19 @@ bool H264Packetizer::Process(const BufferViewConst& view, Timepoint tp, bool las
     }
 
     if(view.size <= _max_payload) {
-        ProcessSingle(view, tp, last);
+        ProcessSingle(origin, view, tp, last);
     } else {
-        ProcessFuA(view, tp, last);
+        ProcessFuA(origin, view, tp, last);
     }
     return true;
 }
 
-void H264Packetizer::ProcessSingle(const BufferViewConst& view, Timepoint tp, bool last) {
+void H264Packetizer::ProcessSingle(const Buffer& origin, const BufferViewConst& view, Timepoint tp, bool last) {
     auto packet = _allocator.Allocate(tp, last);
-    auto header_size = packet.GetSize();
-    auto payload_ptr = packet.GetView().ptr + header_size;
-    memcpy(payload_ptr, view.ptr, view.size);
-    packet.SetSize(header_size + view.size);
-    _callback(std::move(packet));
+    Send(std::move(packet), origin, view);
 }
 
-void H264Packetizer::ProcessFuA(const BufferViewConst& view, Timepoint tp, bool last) {
+void H264Packetizer::ProcessFuA(const Buffer& origin, const BufferViewConst& view, Timepoint tp, bool last) {
     auto nalu_payload = view;
     nalu_payload.ForwardPtrUnsafe(sizeof(FuAIndicator));
 
@@ -83,16 +79,26 @@ void H264Packetizer::ProcessFuA(const BufferViewConst& view, Timepoint tp, bool
         auto payload_ptr = packet.GetView().ptr + rtp_header_size;
         payload_ptr[0] = CreateFuAIndicator(view.ptr[0]);
         payload_ptr[1] = CreateFuHeader(i == 1, i == packets_count, nalu_header->type);
-        payload_ptr += 2;
+        packet.SetSize(rtp_header_size + sizeof(FuAIndicator) + sizeof(FuHeader));
 
         const auto packet_fua_payload_size = DivCeil(nalu_payload.size, packets_count + 1 - i);
         const auto chunk_size = std::min(nalu_payload.size, packet_fua_payload_size);
-        memcpy(payload_ptr, nalu_payload.ptr, chunk_size);
-        packet.SetSize(rtp_header_size + sizeof(FuAIndicator) + sizeof(FuHeader) + chunk_size);
-        _callback(std::move(packet));
+        Send(std::move(packet), origin, BufferViewConst{.ptr = nalu_payload.ptr, .size = chunk_size});
 
         nalu_payload.ForwardPtrUnsafe(chunk_size);
     }
 }
 
+void H264Packetizer::Send(Buffer&& packet, const Buffer& origin, const BufferViewConst& payload) {
+    if(_sg_callback && origin.IsShared()) {
+        const auto offset = static_cast<size_t>(payload.ptr - origin.GetView().ptr);
+        _sg_callback(SgBuffer(std::move(packet), origin.Slice(offset, payload.size)));
+    } else {
+        const auto header_size = packet.GetSize();
+        memcpy(packet.GetView().ptr + header_size, payload.ptr, payload.size);
+        packet.SetSize(header_size + payload.size);
+        _callback(std::move(packet));
+    }
+}
+
 }
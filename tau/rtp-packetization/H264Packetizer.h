@@ -1,6 +1,7 @@
 #pragma once
 
 #include <tau/rtp/RtpAllocator.h>
+#include <tau/memory/SgBuffer.h>
 #include <functional>
 
 namespace tau::rtp {
@@ -8,24 +9,30 @@ namespace tau::rtp {
 class H264Packetizer {
 public:
     using Callback = std::function<void(Buffer&&)>;
+    using SgCallback = std::function<void(SgBuffer&&)>;
 
 public:
     explicit H264Packetizer(RtpAllocator& allocator);
 
     void SetCallback(Callback callback) { _callback = std::move(callback); }
+    // used for shared input buffers: packets reference slices of the input instead of copying it
+    void SetSgCallback(SgCallback callback) { _sg_callback = std::move(callback); }
 
     bool Process(const Buffer& au);
     bool Process(const Buffer& nal_unit, bool last);
 
 private:
-    bool Process(const BufferViewConst& view, Timepoint tp, bool last);
-    void ProcessSingle(const BufferViewConst& view, Timepoint tp, bool last);
-    void ProcessFuA(const BufferViewConst& view, Timepoint tp, bool last);
+    bool Process(const Buffer& origin, const BufferViewConst& view, Timepoint tp, bool last);
+    void ProcessSingle(const Buffer& origin, const BufferViewConst& view, Timepoint tp, bool last);
+    void ProcessFuA(const Buffer& origin, const BufferViewConst& view, Timepoint tp, bool last);
+
+    void Send(Buffer&& packet, const Buffer& origin, const BufferViewConst& payload);
 
 private:
     RtpAllocator& _allocator;
     const size_t _max_payload;
     Callback _callback;
+    SgCallback _sg_callback;
 };
 
 }
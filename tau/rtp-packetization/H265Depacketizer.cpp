@@ -3,29 +3,67 @@
 #include <tau/rtp/Reader.h>
 #include <tau/video/h265/Nalu.h>
 #include <tau/common/NetToHost.h>
-#include <numeric>
 
 namespace tau::rtp {
 
 using namespace h265;
 
-H265Depacketizer::H265Depacketizer(Allocator& allocator)
+H265Depacketizer::H265Depacketizer(Allocator& allocator, size_t nalu_max_size)
     : _allocator(allocator)
+    , _nalu_max_size(nalu_max_size)
 {}
 
 bool H265Depacketizer::Process(Frame&& frame) {
+    return Process(std::move(frame), true);
+}
+
+bool H265Depacketizer::ProcessChunk(Frame&& chunk) {
+    return Process(std::move(chunk), false);
+}
+
+bool H265Depacketizer::IsKeyFrameStart(BufferViewConst rtp_payload_view) {
+    if(rtp_payload_view.size < kNaluHeaderSize) {
+        return false;
+    }
+    auto is_key = [](uint8_t type) {
+        return ((NaluType::kBlaWLp <= type) && (type <= NaluType::kRsvIrapVcl23)) || (type == NaluType::kVps) || (type == NaluType::kSps);
+    };
+    const auto type = GetNaluTypeUnsafe(rtp_payload_view.ptr);
+    if(type == NaluType::kFu) {
+        if(rtp_payload_view.size <= kNaluHeaderSize + sizeof(FuHeader)) {
+            return false;
+        }
+        const auto fu_header = reinterpret_cast<const FuHeader*>(&rtp_payload_view.ptr[kNaluHeaderSize]);
+        return fu_header->start && is_key(fu_header->type);
+    }
+    if(type == NaluType::kAp) {
+        rtp_payload_view.ForwardPtrUnsafe(kNaluHeaderSize);
+        while(rtp_payload_view.size > sizeof(uint16_t)) {
+            const auto nalu_size = Read16(rtp_payload_view.ptr);
+            if((nalu_size < kNaluHeaderSize) || (rtp_payload_view.size < sizeof(uint16_t) + nalu_size)) {
+                break;
+            }
+            if(is_key(GetNaluTypeUnsafe(rtp_payload_view.ptr + sizeof(uint16_t)))) {
+                return true;
+            }
+            rtp_payload_view.ForwardPtrUnsafe(sizeof(uint16_t) + nalu_size);
+        }
+        return false;
+    }
+    return is_key(type);
+}
+
+bool H265Depacketizer::Process(Frame&& frame, bool frame_end) {
     bool ok = true;
-    _nalu_max_size = GetNaluMaxSize(frame);
     for(size_t i = 0; i < frame.size(); ++i) {
-        const auto& packet = frame[i];
-        Reader reader(packet.GetView());
-        const auto last = reader.Marker() || ((i + 1) == frame.size());
-        ok &= Process(reader.Payload(), packet.GetInfo().tp, last);
+        const auto last = Reader(ToConst(frame[i].GetView())).Marker() || (frame_end && ((i + 1) == frame.size()));
+        ok &= Process(std::move(frame[i]), last);
     }
     return ok;
 }
 
-bool H265Depacketizer::Process(BufferViewConst rtp_payload_view, Timepoint tp, bool last) {
+bool H265Depacketizer::Process(Buffer&& packet, bool last) {
+    const auto rtp_payload_view = Reader(ToConst(packet.GetView())).Payload();
     if(rtp_payload_view.size < kNaluHeaderSize) {
         return false;
     }
@@ -34,10 +72,11 @@ bool H265Depacketizer::Process(BufferViewConst rtp_payload_view, Timepoint tp, b
     }
     auto type = GetNaluTypeUnsafe(rtp_payload_view.ptr);
     if(type == NaluType::kFu) {
-        return ProcessFu(rtp_payload_view, tp, last);
+        return ProcessFu(std::move(packet), rtp_payload_view, last);
     }
-    _fu_nal_unit.reset();
+    ResetFu();
 
+    const auto tp = packet.GetInfo().tp;
     if(type == NaluType::kAp) {
         return ProcessAp(rtp_payload_view, tp, last);
     }
@@ -54,35 +93,42 @@ bool H265Depacketizer::ProcessSingle(BufferViewConst rtp_payload_view, Timepoint
     return true;
 }
 
-bool H265Depacketizer::ProcessFu(BufferViewConst rtp_payload_view, Timepoint tp, bool last) {
+bool H265Depacketizer::ProcessFu(Buffer&& packet, BufferViewConst rtp_payload_view, bool last) {
     if(!ValidateFu(rtp_payload_view)) {
-        _fu_nal_unit.reset();
+        ResetFu();
         return false;
     }
     const auto fu_header = reinterpret_cast<const FuHeader*>(&rtp_payload_view.ptr[kNaluHeaderSize]);
     if(fu_header->start) {
-        _fu_nal_unit.emplace(Buffer::Create(_allocator, _nalu_max_size, Buffer::Info{.tp = tp, .flags = kFlagsNone}));
-
-        auto view = _fu_nal_unit->GetView();
-        view.ptr[0] = rtp_payload_view.ptr[0];
-        view.ptr[1] = rtp_payload_view.ptr[1];
-        SetNaluHeaderTypeUnsafe(view.ptr, static_cast<NaluType>(fu_header->type));
-        _fu_nal_unit->SetSize(kNaluHeaderSize);
+        ResetFu();
+        _fu_nalu_header.emplace(std::array<uint8_t, 2>{rtp_payload_view.ptr[0], rtp_payload_view.ptr[1]});
+        SetNaluHeaderTypeUnsafe(_fu_nalu_header->data(), static_cast<NaluType>(fu_header->type));
+        _fu_size = kNaluHeaderSize;
     }
+    const auto end = fu_header->end;
     rtp_payload_view.ForwardPtrUnsafe(kNaluHeaderSize + sizeof(FuHeader));
+    _fu_size += rtp_payload_view.size;
+    if(_fu_size > _nalu_max_size) {
+        ResetFu();
+        return false;
+    }
+    _fu_fragments.push_back(Fragment{.packet = std::move(packet), .payload = rtp_payload_view});
+    if(!end) {
+        return true;
+    }
 
-    auto nalu_view = _fu_nal_unit->GetView();
-    nalu_view.ForwardPtrUnsafe(nalu_view.size);
-    memcpy(nalu_view.ptr, rtp_payload_view.ptr, rtp_payload_view.size);
-    _fu_nal_unit->SetSize(_fu_nal_unit->GetSize() + rtp_payload_view.size);
-
-    if(fu_header->end) {
-        if(last) {
-            _fu_nal_unit->GetInfo().flags = kFlagsLast;
-        }
-        _callback(std::move(*_fu_nal_unit));
-        _fu_nal_unit.reset();
+    const auto tp = _fu_fragments.front().packet.GetInfo().tp;
+    auto nalu = Buffer::Create(_allocator, _fu_size, Buffer::Info{.tp = tp, .flags = last ? kFlagsLast : kFlagsNone});
+    auto nalu_view = nalu.GetView();
+    memcpy(nalu_view.ptr, _fu_nalu_header->data(), kNaluHeaderSize);
+    size_t offset = kNaluHeaderSize;
+    for(const auto& fragment : _fu_fragments) {
+        memcpy(&nalu_view.ptr[offset], fragment.payload.ptr, fragment.payload.size);
+        offset += fragment.payload.size;
     }
+    nalu.SetSize(offset);
+    ResetFu();
+    _callback(std::move(nalu));
     return true;
 }
 
@@ -113,7 +159,7 @@ bool H265Depacketizer::ValidateFu(BufferViewConst rtp_payload_view) const {
     if(fu_header->start && fu_header->end) {
         return false;
     }
-    if(!fu_header->start && !_fu_nal_unit.has_value()) {
+    if(!fu_header->start && !_fu_nalu_header.has_value()) {
         return false;
     }
     if(fu_header->type >= NaluType::kAp) {
@@ -122,11 +168,10 @@ bool H265Depacketizer::ValidateFu(BufferViewConst rtp_payload_view) const {
     return true;
 }
 
-size_t H265Depacketizer::GetNaluMaxSize(const Frame& frame) {
-    auto sum = std::accumulate(frame.begin(), frame.end(), 0, [](size_t total, const Buffer& packet) {
-        return total + packet.GetSize();
-    });
-    return std::max(sum, kNaluMaxSizeDefault);
+void H265Depacketizer::ResetFu() {
+    _fu_nalu_header.reset();
+    _fu_fragments.clear();
+    _fu_size = 0;
 }
 
 }
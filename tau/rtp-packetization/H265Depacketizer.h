@@ -3,38 +3,53 @@
 #include <tau/rtp/Frame.h>
 #include <functional>
 #include <optional>
+#include <array>
+#include <vector>
 
 namespace tau::rtp {
 
+// Frames could be passed by chunks (see FrameProcessor): FU fragments are kept as received packets
+// until the end fragment, then NAL unit is gathered at once. nalu_max_size caps the memory of NAL unit in progress
 class H265Depacketizer {
 public:
-    static constexpr auto kNaluMaxSizeDefault = 0x1'0000;
+    static constexpr size_t kNaluMaxSizeDefault = 0x40'0000;
 
     using Callback = std::function<void(Buffer&&)>;
 
 public:
-    explicit H265Depacketizer(Allocator& allocator);
+    explicit H265Depacketizer(Allocator& allocator, size_t nalu_max_size = kNaluMaxSizeDefault);
 
     void SetCallback(Callback callback) { _callback = std::move(callback); }
 
     bool Process(Frame&& frame);
+    bool ProcessChunk(Frame&& chunk); // the frame isn't completed yet
+
+    // the packet starts a key-frame: VPS/SPS or the first fragment of IRAP picture (e.g. layer switch of SimulcastForwarder)
+    static bool IsKeyFrameStart(BufferViewConst rtp_payload_view);
 
 private:
-    bool Process(BufferViewConst rtp_payload_view, Timepoint tp, bool last);
+    struct Fragment {
+        Buffer packet;
+        BufferViewConst payload;
+    };
+
+    bool Process(Frame&& frame, bool frame_end);
+    bool Process(Buffer&& packet, bool last);
     bool ProcessSingle(BufferViewConst rtp_payload_view, Timepoint tp, bool last);
-    bool ProcessFu(BufferViewConst rtp_payload_view, Timepoint tp, bool last);
+    bool ProcessFu(Buffer&& packet, BufferViewConst rtp_payload_view, bool last);
     bool ProcessAp(BufferViewConst rtp_payload_view, Timepoint tp, bool last);
 
     bool ValidateFu(BufferViewConst payload_view) const;
-
-    static size_t GetNaluMaxSize(const Frame& frame);
+    void ResetFu();
 
 private:
     Allocator& _allocator;
+    const size_t _nalu_max_size;
     Callback _callback;
 
-    size_t _nalu_max_size = kNaluMaxSizeDefault;
-    std::optional<Buffer> _fu_nal_unit;
+    std::optional<std::array<uint8_t, 2>> _fu_nalu_header;
+    std::vector<Fragment> _fu_fragments;
+    size_t _fu_size = 0;
 };
 
 }
@@ -0,0 +1,188 @@
+#include <tau/rtp-session/DelayBasedEstimator.h>
+#include <algorithm>
+#include <cmath>
+
+namespace tau::rtp::session {
+
+namespace {
+
+constexpr double kThresholdMin = 6.0;
+constexpr double kThresholdMax = 600.0;
+constexpr double kThresholdGainUp = 0.0087;
+constexpr double kThresholdGainDown = 0.039;
+constexpr double kThresholdMaxDeviation = 15.0;
+constexpr size_t kTrendlineDeltasCountMax = 60;
+constexpr double kIncreaseFactorPerSec = 1.08;
+constexpr double kResponseTimeSec = 0.2;
+constexpr double kPacketSizeBits = 8.0 * 1200;
+constexpr double kNearCapacityRatio = 0.9;
+constexpr uint32_t kAckedBitrateMargin = 10'000;
+
+double ToMs(Timepoint tp) {
+    return static_cast<double>(tp) / kMs;
+}
+
+}
+
+DelayBasedEstimator::DelayBasedEstimator(Options&& options)
+    : _options(std::move(options))
+    , _target_bitrate(std::clamp(_options.initial_bitrate, _options.min_bitrate, _options.max_bitrate))
+{}
+
+void DelayBasedEstimator::Update(std::span<const PacketResult> results, Timepoint now) {
+    for(auto& result : results) {
+        if(result.recv_tp) {
+            UpdateAckedBitrate(result);
+            UpdateGroup(result);
+        }
+    }
+    UpdateRate(now);
+}
+
+void DelayBasedEstimator::UpdateAckedBitrate(const PacketResult& result) {
+    const auto recv_tp = *result.recv_tp;
+    if(!_acked_window_begin_tp || (recv_tp < *_acked_window_begin_tp)) {
+        _acked_window_begin_tp = recv_tp;
+        _acked_window_bytes = 0;
+    }
+    _acked_window_bytes += result.size;
+    const auto window = recv_tp - *_acked_window_begin_tp;
+    if(window >= kAckedBitrateWindow) {
+        _acked_bitrate = static_cast<uint32_t>(8 * _acked_window_bytes * kSec / window);
+        _acked_window_begin_tp = recv_tp;
+        _acked_window_bytes = 0;
+    }
+}
+
+void DelayBasedEstimator::UpdateGroup(const PacketResult& result) {
+    const auto recv_tp = *result.recv_tp;
+    if(!_group) {
+        _group = Group{.first_send_tp = result.send_tp, .last_send_tp = result.send_tp, .last_recv_tp = recv_tp};
+        return;
+    }
+    if(result.send_tp < _group->first_send_tp) {
+        return; // reordered
+    }
+    if(result.send_tp - _group->first_send_tp <= kGroupDuration) {
+        _group->last_send_tp = std::max(_group->last_send_tp, result.send_tp);
+        _group->last_recv_tp = std::max(_group->last_recv_tp, recv_tp);
+        return;
+    }
+
+    if(_prev_group) {
+        const auto send_delta = _group->last_send_tp - _prev_group->last_send_tp;
+        const auto recv_delta = static_cast<double>(_group->last_recv_tp) - static_cast<double>(_prev_group->last_recv_tp);
+        UpdateTrendline((recv_delta - static_cast<double>(send_delta)) / kMs, _group->last_recv_tp, send_delta);
+    }
+    _prev_group = _group;
+    _group = Group{.first_send_tp = result.send_tp, .last_send_tp = result.send_tp, .last_recv_tp = recv_tp};
+}
+
+void DelayBasedEstimator::UpdateTrendline(double delay_variation_ms, Timepoint recv_tp, Timepoint send_delta) {
+    if(!_first_recv_tp) {
+        _first_recv_tp = recv_tp;
+    }
+    _deltas_count = std::min(_deltas_count + 1, kTrendlineDeltasCountMax);
+    _accumulated_delay += delay_variation_ms;
+    _smoothed_delay = kTrendlineSmoothing * _smoothed_delay + (1 - kTrendlineSmoothing) * _accumulated_delay;
+
+    if(_samples.full()) {
+        _samples.pop_front();
+    }
+    _samples.push_back(Sample{
+        .recv_ms = ToMs(recv_tp - std::min(recv_tp, *_first_recv_tp)),
+        .delay_ms = _smoothed_delay
+    });
+
+    double trend = _prev_trend;
+    if(_samples.full()) {
+        double x_avg = 0, y_avg = 0;
+        for(auto& sample : _samples) {
+            x_avg += sample.recv_ms;
+            y_avg += sample.delay_ms;
+        }
+        x_avg /= _samples.size();
+        y_avg /= _samples.size();
+        double numerator = 0, denominator = 0;
+        for(auto& sample : _samples) {
+            numerator += (sample.recv_ms - x_avg) * (sample.delay_ms - y_avg);
+            denominator += (sample.recv_ms - x_avg) * (sample.recv_ms - x_avg);
+        }
+        if(denominator != 0) {
+            trend = numerator / denominator;
+        }
+    }
+    Detect(trend, send_delta, recv_tp);
+}
+
+void DelayBasedEstimator::Detect(double trend, Timepoint send_delta, Timepoint recv_tp) {
+    const auto modified_trend = static_cast<double>(_deltas_count) * trend * kTrendlineGain;
+    if(modified_trend > _threshold) {
+        _overusing_time = _overusing_time ? (*_overusing_time + send_delta) : (send_delta / 2);
+        _overuse_counter++;
+        if((*_overusing_time > kOveruseTime) && (_overuse_counter > 1) && (trend >= _prev_trend)) {
+            _overusing_time.reset();
+            _overuse_counter = 0;
+            _usage = Usage::kOveruse;
+        }
+    } else if(modified_trend < -_threshold) {
+        _overusing_time.reset();
+        _overuse_counter = 0;
+        _usage = Usage::kUnderuse;
+    } else {
+        _overusing_time.reset();
+        _overuse_counter = 0;
+        _usage = Usage::kNormal;
+    }
+    _prev_trend = trend;
+    UpdateThreshold(modified_trend, recv_tp);
+}
+
+void DelayBasedEstimator::UpdateThreshold(double trend, Timepoint recv_tp) {
+    if(!_last_threshold_update_tp) {
+        _last_threshold_update_tp = recv_tp;
+    }
+    const auto abs_trend = std::fabs(trend);
+    if(abs_trend > _threshold + kThresholdMaxDeviation) {
+        _last_threshold_update_tp = recv_tp; // spikes don't move the threshold
+        return;
+    }
+    const auto k = (abs_trend < _threshold) ? kThresholdGainDown : kThresholdGainUp;
+    const auto dt_ms = std::min(ToMs(recv_tp - std::min(recv_tp, *_last_threshold_update_tp)), 100.0);
+    _threshold = std::clamp(_threshold + k * (abs_trend - _threshold) * dt_ms, kThresholdMin, kThresholdMax);
+    _last_threshold_update_tp = recv_tp;
+}
+
+void DelayBasedEstimator::UpdateRate(Timepoint now) {
+    const auto dt_sec = _last_rate_update_tp ? std::min(DurationSec(*_last_rate_update_tp, now), 1.0) : 0.0;
+    _last_rate_update_tp = now;
+
+    double target = _target_bitrate;
+    switch(_usage) {
+        case Usage::kOveruse:
+            // decrease once per overuse detection
+            _usage = Usage::kNormal;
+            if(_acked_bitrate) {
+                _link_capacity = *_acked_bitrate;
+                target = std::min(target, kDecreaseFactor * *_acked_bitrate);
+            } else {
+                target *= kDecreaseFactor;
+            }
+            break;
+        case Usage::kNormal:
+            if(_link_capacity && (target >= kNearCapacityRatio * *_link_capacity)) {
+                target += std::max(1000.0, kPacketSizeBits / kResponseTimeSec * dt_sec);
+            } else {
+                target *= std::pow(kIncreaseFactorPerSec, dt_sec);
+            }
+            break;
+        case Usage::kUnderuse:
+            break; // hold, queues are draining
+    }
+    if(_acked_bitrate) {
+        target = std::min(target, 1.5 * *_acked_bitrate + kAckedBitrateMargin);
+    }
+    _target_bitrate = static_cast<uint32_t>(std::clamp(target, double(_options.min_bitrate), double(_options.max_bitrate)));
+}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <tau/common/Clock.h>
+#include <etl/deque.h>
+#include <optional>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace tau::rtp::session {
+
+// Sender-side delay-based bandwidth estimation (GCC-like, https://datatracker.ietf.org/doc/html/draft-ietf-rmcat-gcc-02):
+// packets are grouped by send time, one-way delay variation between groups is smoothed and its trend is estimated
+// by linear regression, the trend is compared to adaptive threshold and the usage state drives AIMD rate control
+class DelayBasedEstimator {
+public:
+    static constexpr Timepoint kGroupDuration = 5 * kMs;
+    static constexpr size_t kTrendlineWindowSize = 20;
+    static constexpr double kTrendlineSmoothing = 0.9;
+    static constexpr double kTrendlineGain = 4.0;
+    static constexpr double kThresholdInitial = 12.5;
+    static constexpr Timepoint kOveruseTime = 10 * kMs;
+    static constexpr Timepoint kAckedBitrateWindow = 500 * kMs;
+    static constexpr double kDecreaseFactor = 0.85;
+
+    struct Options {
+        uint32_t initial_bitrate = 300'000;
+        uint32_t min_bitrate = 30'000;
+        uint32_t max_bitrate = 10'000'000;
+    };
+
+    struct PacketResult {
+        Timepoint send_tp;
+        std::optional<Timepoint> recv_tp; // receiver clock, std::nullopt if lost
+        size_t size;
+    };
+
+    enum Usage {
+        kNormal,
+        kUnderuse,
+        kOveruse
+    };
+
+public:
+    explicit DelayBasedEstimator(Options&& options);
+
+    // results of one feedback message in transport-wide sn order
+    void Update(std::span<const PacketResult> results, Timepoint now);
+
+    uint32_t GetTargetBitrate() const { return _target_bitrate; }
+    std::optional<uint32_t> GetAckedBitrate() const { return _acked_bitrate; }
+    Usage GetUsage() const { return _usage; }
+
+private:
+    void UpdateAckedBitrate(const PacketResult& result);
+    void UpdateGroup(const PacketResult& result);
+    void UpdateTrendline(double delay_variation_ms, Timepoint recv_tp, Timepoint send_delta);
+    void Detect(double trend, Timepoint send_delta, Timepoint recv_tp);
+    void UpdateThreshold(double trend, Timepoint recv_tp);
+    void UpdateRate(Timepoint now);
+
+private:
+    const Options _options;
+
+    struct Group {
+        Timepoint first_send_tp;
+        Timepoint last_send_tp;
+        Timepoint last_recv_tp;
+    };
+    std::optional<Group> _group;
+    std::optional<Group> _prev_group;
+
+    std::optional<Timepoint> _first_recv_tp;
+    double _accumulated_delay = 0;
+    double _smoothed_delay = 0;
+    size_t _deltas_count = 0;
+    struct Sample {
+        double recv_ms;
+        double delay_ms;
+    };
+    etl::deque<Sample, kTrendlineWindowSize> _samples;
+
+    double _threshold = kThresholdInitial;
+    std::optional<Timepoint> _last_threshold_update_tp;
+    double _prev_trend = 0;
+    std::optional<Timepoint> _overusing_time;
+    size_t _overuse_counter = 0;
+    Usage _usage = Usage::kNormal;
+
+    std::optional<Timepoint> _acked_window_begin_tp;
+    uint64_t _acked_window_bytes = 0;
+    std::optional<uint32_t> _acked_bitrate;
+
+    uint32_t _target_bitrate;
+    std::optional<Timepoint> _last_rate_update_tp;
+    std::optional<uint32_t> _link_capacity; // acked bitrate at the last decrease
+};
+
+}
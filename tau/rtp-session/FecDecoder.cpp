@@ -0,0 +1,149 @@
+#include "tau/rtp-session/FecDecoder.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/Constants.h"
+#include "tau/rtp/Sn.h"
+#include "tau/rtp/details/FixedHeader.h"
+#include "tau/common/NetToHost.h"
+#include "tau/common/Log.h"
+#include <cstring>
+
+namespace tau::rtp::session {
+
+FecDecoder::FecDecoder(Dependencies&& deps)
+    : _deps(std::move(deps))
+    , _history(kHistorySize) {
+}
+
+void FecDecoder::PushMedia(const Buffer& rtp_packet) {
+    const auto view = rtp_packet.GetView();
+    const auto sn = Reader(view).Sn();
+    if(!_sn_last || SnGreater(sn, *_sn_last)) {
+        _sn_last = sn;
+    }
+    Store(rtp_packet.IsShared() ? rtp_packet.Share() : Buffer::Create(_deps.allocator, view), sn);
+    ProcessRepairs();
+}
+
+void FecDecoder::PushRepair(Buffer&& repair_packet) {
+    const auto view = ToConst(repair_packet.GetView());
+    if(!Reader::Validate(view)) {
+        return;
+    }
+    if(reinterpret_cast<const detail::FixedHeader*>(view.ptr)->cc == 0) {
+        TAU_LOG_WARNING_THR(128, "FlexFEC repair packet without protected SSRC");
+        return;
+    }
+    const auto ssrc = Read32(view.ptr + kFixedHeaderSize); // the first CSRC
+    auto header = FlexFec::ReadHeader(Reader(view).Payload());
+    if(!header) {
+        TAU_LOG_WARNING_THR(128, "Invalid FlexFEC header, size: " << view.size);
+        return;
+    }
+    if(_repairs.size() >= kMaxPendingRepairs) {
+        _repairs.pop_front();
+    }
+    _repairs.push_back(Repair{.packet = std::move(repair_packet), .ssrc = ssrc, .header = std::move(*header)});
+    ProcessRepairs();
+}
+
+void FecDecoder::ProcessRepairs() {
+    bool recovered = true;
+    while(recovered) {
+        recovered = false;
+        for(auto it = _repairs.begin(); it != _repairs.end();) {
+            const auto result = TryRecover(*it);
+            if(result == kPending) {
+                ++it;
+            } else {
+                recovered |= (result == kRecovered); // a recovered packet may complete another group
+                it = _repairs.erase(it);
+            }
+        }
+    }
+}
+
+FecDecoder::Result FecDecoder::TryRecover(const Repair& repair) {
+    const auto& header = repair.header;
+    if(!_sn_last || (SnDelta(*_sn_last, header.sn_base) >= kHistorySize)) {
+        return kDone; // too old, the group isn't in the history
+    }
+
+    std::optional<uint16_t> missing_sn;
+    for(size_t i = 0; i < FlexFec::kMaxMaskSize; ++i) {
+        if(!header.mask[i]) {
+            continue;
+        }
+        const auto sn = SnForward(header.sn_base, i);
+        if(!FindMedia(sn, repair.ssrc)) {
+            if(missing_sn) {
+                return kPending;
+            }
+            missing_sn = sn;
+        }
+    }
+    if(!missing_sn) {
+        return kDone;
+    }
+
+    const auto payload = Reader(repair.packet.GetView()).Payload();
+    const auto data_size = payload.size - header.size;
+    auto recovered = Buffer::Create(_deps.allocator);
+    auto view = recovered.GetViewWithCapacity();
+    if(kFixedHeaderSize + data_size > view.size) {
+        return kDone;
+    }
+
+    uint8_t fields[FlexFec::kRecoveryFieldsSize];
+    std::memcpy(fields, payload.ptr, sizeof(fields));
+    auto data = view.ptr + kFixedHeaderSize;
+    std::memcpy(data, payload.ptr + header.size, data_size);
+    for(size_t i = 0; i < FlexFec::kMaxMaskSize; ++i) {
+        const auto sn = SnForward(header.sn_base, i);
+        if(!header.mask[i] || (sn == *missing_sn)) {
+            continue;
+        }
+        const auto media = FindMedia(sn, repair.ssrc)->GetView();
+        if(media.size - kFixedHeaderSize > data_size) {
+            return kDone; // repair packet doesn't match the media
+        }
+        FlexFec::XorRecoveryFields(fields, media.ptr, media.size);
+        FlexFec::XorData(data, media.ptr + kFixedHeaderSize, media.size - kFixedHeaderSize);
+    }
+
+    const auto length = Read16(fields + 2);
+    if(length > data_size) {
+        return kDone;
+    }
+    view.ptr[0] = 0x80 | (fields[0] & 0x3F);
+    view.ptr[1] = fields[1];
+    Write16(view.ptr + 2, *missing_sn);
+    std::memcpy(view.ptr + 4, fields + 4, sizeof(uint32_t));
+    Write32(view.ptr + 8, repair.ssrc);
+    recovered.SetSize(kFixedHeaderSize + length);
+    if(!Reader::Validate(ToConst(recovered.GetView()))) {
+        TAU_LOG_WARNING_THR(128, "Invalid recovered packet, sn: " << *missing_sn);
+        return kDone;
+    }
+
+    Store(recovered.MakeCopy(), *missing_sn); // the recovered packet could be modified in place by the receiver (e.g. SSRC rewriting)
+    _callback(std::move(recovered));
+    return kRecovered;
+}
+
+const Buffer* FecDecoder::FindMedia(uint16_t sn, uint32_t ssrc) const {
+    const auto& packet = _history[sn % kHistorySize];
+    if(!packet) {
+        return nullptr;
+    }
+    Reader reader(packet->GetView());
+    if((reader.Sn() == sn) && (reader.Ssrc() == ssrc)) {
+        return &*packet;
+    }
+    return nullptr;
+}
+
+void FecDecoder::Store(Buffer&& rtp_packet, uint16_t sn) {
+    _history[sn % kHistorySize].emplace(std::move(rtp_packet));
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <tau/rtp/FlexFec.h>
+#include <tau/memory/Buffer.h>
+#include <tau/memory/Allocator.h>
+#include <functional>
+#include <optional>
+#include <vector>
+#include <deque>
+
+namespace tau::rtp::session {
+
+// FlexFEC (RFC 8627) receiver: recent media packets are kept (shared or copied) to recover a single lost packet of a repair group.
+// Repair packets with several missing packets wait for late media (reordering, RTX) or recovered packets.
+// NOTE: the session passes the received packets to the application, which may rewrite them in place (e.g. simulcast forwarding),
+// so every media packet is copied: one allocation and memcpy per packet, up to kHistorySize packets are held
+class FecDecoder {
+public:
+    static constexpr size_t kHistorySize = 64;
+    static constexpr size_t kMaxPendingRepairs = 16;
+
+    struct Dependencies {
+        Allocator& allocator;
+    };
+
+    using Callback = std::function<void(Buffer&& rtp_packet)>;
+
+public:
+    explicit FecDecoder(Dependencies&& deps);
+
+    void SetCallback(Callback callback) { _callback = std::move(callback); }
+
+    void PushMedia(const Buffer& rtp_packet); // shared packet is referenced, otherwise copied
+    void PushRepair(Buffer&& repair_packet);
+
+private:
+    struct Repair {
+        Buffer packet;
+        uint32_t ssrc; // protected SSRC from the CSRC
+        FlexFec::Header header;
+    };
+
+    enum Result {
+        kPending,   // several packets are missing, the repair packet is kept
+        kRecovered,
+        kDone       // nothing to recover, too old or invalid
+    };
+
+    void ProcessRepairs();
+    Result TryRecover(const Repair& repair);
+    const Buffer* FindMedia(uint16_t sn, uint32_t ssrc) const;
+    void Store(Buffer&& rtp_packet, uint16_t sn);
+
+private:
+    Dependencies _deps;
+    std::vector<std::optional<Buffer>> _history; // indexed by sn
+    std::deque<Repair> _repairs;
+    std::optional<uint16_t> _sn_last;
+    Callback _callback;
+};
+
+}
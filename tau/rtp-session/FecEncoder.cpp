@@ -0,0 +1,105 @@
+#include "tau/rtp-session/FecEncoder.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/Writer.h"
+#include "tau/rtp/Constants.h"
+#include "tau/rtp/Sn.h"
+#include "tau/rtp/details/FixedHeader.h"
+#include "tau/common/NetToHost.h"
+#include "tau/common/Log.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace tau::rtp::session {
+
+FecEncoder::FecEncoder(Dependencies&& deps, Options&& options)
+    : _deps(std::move(deps))
+    , _options(std::move(options))
+    , _sn(_options.sn) {
+    SetProtection(_options.protection);
+}
+
+std::optional<Buffer> FecEncoder::Push(const SgBuffer::Views& rtp_packet) {
+    if(rtp_packet.empty() || (rtp_packet[0].size < kFixedHeaderSize)) {
+        return std::nullopt;
+    }
+    const auto header = rtp_packet[0];
+    Reader reader(header);
+    const auto sn = reader.Sn();
+    if(_repair && ((SnDelta(sn, _sn_base) >= _repair_group_size) || (reader.Ssrc() != _protected_ssrc))) {
+        _repair.reset(); // sn gap or another stream, the group isn't finished
+    }
+    if(!_repair) {
+        StartGroup(sn, reader.Ssrc());
+    }
+
+    size_t size = 0;
+    for(auto& view : rtp_packet) {
+        size += view.size;
+    }
+    const auto data_size = size - kFixedHeaderSize;
+    auto repair_view = _repair->GetViewWithCapacity();
+    if(kRepairHeaderSize + _header_size + data_size <= repair_view.size) {
+        auto payload = repair_view.ptr + kRepairHeaderSize;
+        FlexFec::XorRecoveryFields(payload, header.ptr, size);
+        auto data = payload + _header_size;
+        FlexFec::XorData(data, header.ptr + kFixedHeaderSize, header.size - kFixedHeaderSize);
+        data += header.size - kFixedHeaderSize;
+        for(size_t i = 1; i < rtp_packet.size(); ++i) {
+            FlexFec::XorData(data, rtp_packet[i].ptr, rtp_packet[i].size);
+            data += rtp_packet[i].size;
+        }
+        _data_size = std::max(_data_size, data_size);
+        _mask.set(SnDelta(sn, _sn_base));
+    } else {
+        TAU_LOG_WARNING_THR(128, "Packet isn't protected, size: " << size);
+    }
+
+    if((SnDelta(sn, _sn_base) + 1u >= _repair_group_size) || reader.Marker()) {
+        return FinishGroup(reader.Ts());
+    }
+    return std::nullopt;
+}
+
+void FecEncoder::SetProtection(float protection) {
+    const auto group_size = std::lround(1.0f / std::max(protection, 1.0f / kMaxGroupSize));
+    _group_size = std::clamp<size_t>(group_size, 1, kMaxGroupSize);
+}
+
+void FecEncoder::StartGroup(uint16_t sn, uint32_t ssrc) {
+    _repair.emplace(Buffer::Create(_deps.allocator));
+    auto view = _repair->GetViewWithCapacity();
+    std::memset(view.ptr, 0, view.size);
+    _repair_group_size = _group_size;
+    _protected_ssrc = ssrc;
+    _sn_base = sn;
+    _header_size = FlexFec::GetHeaderSize(_repair_group_size);
+    _data_size = 0;
+    _mask.reset();
+}
+
+std::optional<Buffer> FecEncoder::FinishGroup(uint32_t ts) {
+    auto repair = std::move(*_repair);
+    _repair.reset();
+    if(_mask.none()) {
+        return std::nullopt;
+    }
+
+    auto view = repair.GetViewWithCapacity();
+    Writer::Write(view, Writer::Options{
+        .pt = _options.pt,
+        .ssrc = _options.ssrc,
+        .ts = ts,
+        .sn = _sn++,
+        .marker = false
+    });
+    view.ptr[0] = detail::BuildFixedHeader(false, false, 1); // CSRC is the protected SSRC
+    Write32(view.ptr + kFixedHeaderSize, _protected_ssrc);
+    auto payload = view.ptr + kRepairHeaderSize;
+    payload[0] &= 0x3F; // R = 0, F = 0: flexible mask
+    FlexFec::WriteHeader(payload, _sn_base, _mask, _header_size);
+    repair.SetSize(kRepairHeaderSize + _header_size + _data_size);
+    return repair;
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <tau/rtp/FlexFec.h>
+#include <tau/memory/SgBuffer.h>
+#include <tau/memory/Allocator.h>
+#include <optional>
+
+namespace tau::rtp::session {
+
+// FlexFEC (RFC 8627) sender: outgoing packets are XOR-ed in place into the repair packet of the current group.
+// Group is closed by its size (1 / protection) or by the end of frame, so FEC doesn't delay frames
+class FecEncoder {
+public:
+    static constexpr size_t kMaxGroupSize = 46; // two mask chunks
+    static constexpr size_t kRepairHeaderSize = 4 * sizeof(uint32_t); // fixed header and the protected SSRC as CSRC
+
+    struct Dependencies {
+        Allocator& allocator;
+    };
+
+    struct Options {
+        uint8_t pt;
+        uint32_t ssrc;
+        uint16_t sn = 0;
+        float protection = 0.25; // repair packets per media packet
+    };
+
+public:
+    FecEncoder(Dependencies&& deps, Options&& options);
+
+    // returns repair packet when the group is closed, send it after the media packet
+    std::optional<Buffer> Push(const SgBuffer::Views& rtp_packet);
+
+    void SetProtection(float protection);
+    size_t GetGroupSize() const { return _group_size; }
+
+private:
+    void StartGroup(uint16_t sn, uint32_t ssrc);
+    std::optional<Buffer> FinishGroup(uint32_t ts);
+
+private:
+    Dependencies _deps;
+    const Options _options;
+    size_t _group_size;
+    uint16_t _sn;
+
+    std::optional<Buffer> _repair;
+    size_t _repair_group_size = 0; // group size is updated by the next group
+    uint32_t _protected_ssrc = 0;
+    uint16_t _sn_base = 0;
+    size_t _header_size = 0;
+    size_t _data_size = 0; // the longest protected data after fixed header
+    FlexFec::Mask _mask;
+};
+
+}
@@ -8,13 +8,16 @@
 
 namespace tau::rtp::session {
 
-// Group RTP packets to Frames by TS, detect losses by SN
+// Group RTP packets to Frames by TS, detect losses by SN.
+// Full chunks of huge frames are passed to the chunk callback before the rest of the frame, the memory is bounded
+// by kFrameChunkSize packets. Without the chunk callback they are dropped and the frame is reported with losses
 class FrameProcessor {
 public:
     using Callback = std::function<void(Frame&& frame, bool losses)>;
 
 public:
     void SetCallback(Callback callback) { _callback = std::move(callback); }
+    void SetChunkCallback(Callback callback) { _chunk_callback = std::move(callback); }
 
     void PushRtp(Buffer&& packet) {
         Reader reader(ToConst(packet.GetView()));
@@ -28,6 +31,9 @@ public:
         }
         _ts = ts;
         _sn_next = SnForward(sn, 1);
+        if(_frame.full()) {
+            DoChunkCallback();
+        }
         _frame.push_back(std::move(packet));
         if(reader.Marker()) {
             DoCallback();
@@ -42,12 +48,22 @@ private:
         _frame.clear();
     }
 
+    void DoChunkCallback() {
+        if(_chunk_callback) {
+            _chunk_callback(std::move(_frame), _losses);
+        } else {
+            _losses = true;
+        }
+        _frame.clear();
+    }
+
 private:
     std::optional<uint32_t> _ts;
     std::optional<uint16_t> _sn_next;
     bool _losses = false;
     Frame _frame;
     Callback _callback;
+    Callback _chunk_callback;
 };
 
 }
@@ -0,0 +1,145 @@
+#include "tau/rtp-session/JitterBuffer.h"
+#include <algorithm>
+
+namespace tau::rtp::session {
+
+JitterBuffer::JitterBuffer(Dependencies&& deps, Options&& options)
+    : _deps(std::move(deps))
+    , _options(std::move(options))
+    , _delay(_options.min_delay)
+    , _target_delay(_options.min_delay)
+{
+    _frame_processor.SetCallback([this](Frame&& frame, bool losses) {
+        OnFrame(std::move(frame), losses);
+    });
+    _frame_processor.SetChunkCallback([this](Frame&& chunk, bool) {
+        _chunks.push_back(std::move(chunk));
+    });
+    _stats.delay = _delay;
+    _stats.target_delay = _target_delay;
+    _lateness_sorted.reserve(kLatenessHistorySize + 1);
+}
+
+void JitterBuffer::Push(Buffer&& rtp_packet) {
+    const auto now = _deps.clock.Now();
+    const auto ts = Reader(ToConst(rtp_packet.GetView())).Ts();
+    if(_jitter) {
+        _jitter->Update(ts, now);
+    } else {
+        _jitter.emplace(_options.rate, ts, now);
+    }
+    _frame_processor.PushRtp(std::move(rtp_packet));
+    Process();
+}
+
+void JitterBuffer::Process() {
+    const auto now = static_cast<int64_t>(_deps.clock.Now());
+    while(!_frames.empty()) {
+        const auto overflow = (_frames.size() > _options.max_frames);
+        if(!overflow && (GetPlayoutTp(_frames.front()) > now)) {
+            break;
+        }
+        _stats.overflow += overflow ? 1 : 0;
+        Release();
+    }
+}
+
+std::optional<Timepoint> JitterBuffer::GetNextDeadline() const {
+    if(_frames.empty()) {
+        return std::nullopt;
+    }
+    return static_cast<Timepoint>(std::max<int64_t>(GetPlayoutTp(_frames.front()), 0));
+}
+
+void JitterBuffer::OnFrame(Frame&& frame, bool losses) {
+    const auto now = _deps.clock.Now();
+    Entry entry{.chunks = std::move(_chunks), .frame = std::move(frame), .losses = losses, .media_tp = 0};
+    _chunks.clear();
+    entry.losses |= (!entry.chunks.empty() && !_chunk_callback);
+    const auto ts = Reader(ToConst(entry.frame.front().GetView())).Ts();
+    if(!_ts_converter) {
+        _ts_converter.emplace(TsConverter::Options{.rate = _options.rate, .ts_base = ts, .tp_base = now});
+    }
+    entry.media_tp = _ts_converter->FromTs(ts);
+    const auto transit = static_cast<int64_t>(now) - static_cast<int64_t>(entry.media_tp);
+    UpdateBaseTransit(now, transit);
+    UpdateTargetDelay(static_cast<Timepoint>(transit - *_base_transit));
+
+    _stats.frames++;
+    _stats.losses += entry.losses ? 1 : 0;
+    // a newer frame is already played out (e.g. reordered TS of B-frames): the frame is queued anyway,
+    // its playout time is passed, so it goes out right after the frames before it
+    const auto late = _last_released_media_tp && (entry.media_tp <= *_last_released_media_tp);
+    _frames.push_back(std::move(entry));
+    if(late || (GetPlayoutTp(_frames.back()) < static_cast<int64_t>(now))) {
+        _stats.late++;
+    }
+}
+
+void JitterBuffer::UpdateBaseTransit(Timepoint now, int64_t transit) {
+    // minimum of the current and the previous windows, so clock drift and route changes are followed
+    if(!_base_transit) {
+        _base_transit = transit;
+        _base_transit_window = transit;
+        _base_transit_window_tp = now;
+        return;
+    }
+    if(now >= _base_transit_window_tp + kBaseTransitWindow) {
+        _base_transit = std::min(_base_transit_window, transit);
+        _base_transit_window = transit;
+        _base_transit_window_tp = now;
+        return;
+    }
+    _base_transit_window = std::min(_base_transit_window, transit);
+    _base_transit = std::min(*_base_transit, transit);
+}
+
+void JitterBuffer::UpdateTargetDelay(Timepoint lateness) {
+    // running percentile: the sorted history is updated in place, no allocations per frame
+    _lateness.push_back(lateness);
+    _lateness_sorted.insert(std::upper_bound(_lateness_sorted.begin(), _lateness_sorted.end(), lateness), lateness);
+    if(_lateness.size() > kLatenessHistorySize) {
+        _lateness_sorted.erase(std::lower_bound(_lateness_sorted.begin(), _lateness_sorted.end(), _lateness.front()));
+        _lateness.pop_front();
+    }
+    const auto index = static_cast<size_t>(_options.lateness_percentile * (_lateness_sorted.size() - 1));
+    const auto jitter = static_cast<Timepoint>(_jitter->Get()) * kSec / _options.rate;
+    const auto target = std::max(static_cast<Timepoint>(_options.jitter_factor * jitter), _lateness_sorted[index]);
+
+    _target_delay = std::clamp(target, _options.min_delay, _options.max_delay);
+    _delay = std::max(_delay, _target_delay);
+    _stats.target_delay = _target_delay;
+    _stats.delay = _delay;
+}
+
+int64_t JitterBuffer::GetPlayoutTp(const Entry& entry) const {
+    return static_cast<int64_t>(entry.media_tp) + *_base_transit + static_cast<int64_t>(_delay);
+}
+
+void JitterBuffer::Release() {
+    auto entry = std::move(_frames.front());
+    _frames.pop_front();
+    if(_last_released_media_tp && (entry.media_tp <= *_last_released_media_tp)) {
+        DoCallback(std::move(entry)); // late
+        return;
+    }
+    if(_last_released_media_tp && (_delay > _target_delay)) {
+        const auto duration = entry.media_tp - *_last_released_media_tp;
+        const auto step = static_cast<Timepoint>(_options.shrink_factor * duration);
+        _delay -= std::min(_delay - _target_delay, step);
+        _stats.delay = _delay;
+    }
+    _last_released_media_tp = entry.media_tp;
+    DoCallback(std::move(entry));
+}
+
+void JitterBuffer::DoCallback(Entry&& entry) {
+    if(_chunk_callback) {
+        for(auto& chunk : entry.chunks) {
+            _chunk_callback(std::move(chunk), entry.losses);
+        }
+    }
+    _callback(std::move(entry.frame), entry.losses);
+}
+
+}
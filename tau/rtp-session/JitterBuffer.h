@@ -0,0 +1,103 @@
+#pragma once
+
+#include <tau/rtp-session/FrameProcessor.h>
+#include <tau/rtp/Jitter.h>
+#include <tau/rtp/TsConverter.h>
+#include <tau/common/Clock.h>
+#include <optional>
+#include <deque>
+#include <vector>
+
+namespace tau::rtp::session {
+
+// Adaptive playout buffer for the ordered RTP packets (RecvBuffer output): packets are grouped to frames,
+// frames are released at playout time = media time (by TS) + base transit time + delay.
+// Base transit is the minimal one within the window, the target delay follows the interarrival jitter
+// and the recent frames lateness. Delay grows at once to avoid late frames and shrinks gradually
+// by shrink_factor of frame duration, i.e. playout is faster by this factor.
+// Frames are released in the arrival (decoding) order, a late frame is released right after the frames before it.
+// Chunks of huge frames are kept with the frame and released before it (see FrameProcessor)
+class JitterBuffer {
+public:
+    static constexpr Timepoint kBaseTransitWindow = 5 * kSec;
+    static constexpr size_t kLatenessHistorySize = 128;
+
+    struct Dependencies {
+        Clock& clock;
+    };
+
+    struct Options {
+        uint32_t rate;
+        Timepoint min_delay = 10 * kMs;
+        Timepoint max_delay = 500 * kMs;
+        float jitter_factor = 3;      // target delay of the interarrival jitter (RFC 3550)
+        float lateness_percentile = 0.95;
+        float shrink_factor = 0.05;
+        size_t max_frames = 128;      // frames are released at once on overflow
+    };
+
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t late = 0;            // completed after own playout time or after a newer frame is released
+        uint64_t losses = 0;          // frames with lost packets
+        uint64_t overflow = 0;
+        Timepoint delay = 0;
+        Timepoint target_delay = 0;
+    };
+
+    using Callback = FrameProcessor::Callback;
+
+public:
+    JitterBuffer(Dependencies&& deps, Options&& options);
+
+    void SetCallback(Callback callback) { _callback = std::move(callback); }
+    void SetChunkCallback(Callback callback) { _chunk_callback = std::move(callback); }
+
+    void Push(Buffer&& rtp_packet);
+    void Process();
+    std::optional<Timepoint> GetNextDeadline() const;
+
+    Timepoint GetDelay() const { return _delay; }
+    const Stats& GetStats() const { return _stats; }
+
+private:
+    struct Entry {
+        std::vector<Frame> chunks;
+        Frame frame;
+        bool losses;
+        Timepoint media_tp;
+    };
+
+    void OnFrame(Frame&& frame, bool losses);
+    void UpdateBaseTransit(Timepoint now, int64_t transit);
+    void UpdateTargetDelay(Timepoint lateness);
+    int64_t GetPlayoutTp(const Entry& entry) const;
+    void Release();
+    void DoCallback(Entry&& entry);
+
+private:
+    Dependencies _deps;
+    const Options _options;
+
+    FrameProcessor _frame_processor;
+    std::optional<Jitter> _jitter;
+    std::optional<TsConverter> _ts_converter;
+
+    std::optional<int64_t> _base_transit;
+    int64_t _base_transit_window = 0;
+    Timepoint _base_transit_window_tp = 0;
+    std::deque<Timepoint> _lateness;
+    std::vector<Timepoint> _lateness_sorted; // the same history for the percentile
+
+    Timepoint _delay;
+    Timepoint _target_delay;
+    std::optional<Timepoint> _last_released_media_tp;
+    std::deque<Entry> _frames;
+    std::vector<Frame> _chunks;
+
+    Callback _callback;
+    Callback _chunk_callback;
+    Stats _stats;
+};
+
+}
@@ -0,0 +1,43 @@
+#include "tau/rtp-session/NackTracker.h"
+
+namespace tau::rtp::session {
+
+void NackTracker::Reset(uint16_t sn_begin) {
+    _lost.Clear(sn_begin);
+    _sns_to_nack.Clear(sn_begin);
+}
+
+void NackTracker::Advance(uint16_t sn_begin) {
+    _lost.Advance(sn_begin);
+}
+
+void NackTracker::Add(uint16_t sn) {
+    if(_lost.Set(sn)) {
+        _retries[sn % kSize] = 0;
+        _last_nack_tp[sn % kSize] = 0;
+    }
+}
+
+const rtcp::NackBitmap& NackTracker::GetSnsToNack(Timepoint now, Timepoint retry_interval) {
+    _sns_to_nack.Clear(_lost.GetSnBegin());
+    for(auto sn = _lost.FindNext(_lost.GetSnBegin()); sn; sn = _lost.FindNext(SnForward(*sn, 1))) {
+        const auto index = *sn % kSize;
+        if((_retries[index] < kMaxRetries) && (_last_nack_tp[index] + retry_interval <= now)) {
+            _sns_to_nack.Set(*sn);
+        }
+    }
+    return _sns_to_nack;
+}
+
+void NackTracker::OnNacked(const rtcp::NackBitmap& sns, size_t count, Timepoint now) {
+    auto sn = sns.FindNext(sns.GetSnBegin());
+    for(size_t i = 0; sn && (i < count); ++i, sn = sns.FindNext(SnForward(*sn, 1))) {
+        if(_lost.Test(*sn)) {
+            const auto index = *sn % kSize;
+            _retries[index]++;
+            _last_nack_tp[index] = now;
+        }
+    }
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <tau/rtcp/NackBitmap.h>
+#include <tau/common/Clock.h>
+#include <array>
+
+namespace tau::rtp::session {
+
+// Lost SNs of the receive window with per-SN NACK retries: SN is requested at once,
+// then again after the retry interval (RTT) till recovery, at most kMaxRetries times.
+// A retry is counted by OnNacked() for the written SNs only (the first ones), the rest are due for the next NACK
+class NackTracker {
+public:
+    static constexpr size_t kSize = rtcp::NackBitmap::kSize;
+    static constexpr uint8_t kMaxRetries = 10;
+
+public:
+    void Reset(uint16_t sn_begin);
+    void Advance(uint16_t sn_begin);
+
+    void Add(uint16_t sn);
+    void Remove(uint16_t sn) { _lost.Reset(sn); }
+
+    const rtcp::NackBitmap& GetLost() const { return _lost; }
+    const rtcp::NackBitmap& GetSnsToNack(Timepoint now, Timepoint retry_interval);
+    void OnNacked(const rtcp::NackBitmap& sns, size_t count, Timepoint now);
+
+private:
+    rtcp::NackBitmap _lost{0};
+    rtcp::NackBitmap _sns_to_nack{0};
+    std::array<uint8_t, kSize> _retries = {};
+    std::array<Timepoint, kSize> _last_nack_tp = {};
+};
+
+}
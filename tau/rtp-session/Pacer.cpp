@@ -0,0 +1,117 @@
+#include <tau/rtp-session/Pacer.h>
+#include <tau/common/Log.h>
+#include <algorithm>
+
+namespace tau::rtp::session {
+
+Pacer::Pacer(Dependencies&& deps, Options&& options)
+    : _deps(std::move(deps))
+    , _options(std::move(options))
+    , _bitrate(std::max<uint32_t>(_options.bitrate, 1))
+    , _budget(GetMaxBudget())
+    , _last_refill_tp(_deps.clock.Now()) {
+}
+
+Pacer::SinkId Pacer::AddSink(Callback callback) {
+    _sinks.push_back(std::move(callback));
+    return _sinks.size() - 1;
+}
+
+void Pacer::Push(SinkId sink, Buffer&& packet, Priority priority) {
+    if(_queue_size >= _options.max_queue_size) {
+        DropOldest();
+    }
+    _queue_size++;
+    _queue_bytes += packet.GetSize();
+    _queues[priority].push_back(Entry{
+        .packet = std::move(packet),
+        .sink = sink,
+        .enqueue_tp = _deps.clock.Now()
+    });
+}
+
+void Pacer::Process() {
+    const auto now = _deps.clock.Now();
+    Refill(now);
+    while(auto queue = GetFrontQueue()) {
+        if(_budget < GetRequiredBudget(queue->front())) {
+            break;
+        }
+        auto entry = std::move(queue->front());
+        queue->pop_front();
+
+        const auto size = entry.packet.GetSize();
+        _queue_size--;
+        _queue_bytes -= size;
+        _budget -= static_cast<int64_t>(size * kSec);
+
+        _stats.packets++;
+        _stats.bytes += size;
+        _stats.queue_delay = now - entry.enqueue_tp;
+        _stats.max_queue_delay = std::max(_stats.max_queue_delay, _stats.queue_delay);
+        _sinks[entry.sink](std::move(entry.packet));
+    }
+}
+
+std::optional<Timepoint> Pacer::GetNextDeadline() const {
+    auto queue = GetFrontQueue();
+    if(!queue) {
+        return std::nullopt;
+    }
+    const auto deficit = GetRequiredBudget(queue->front()) - _budget;
+    if(deficit <= 0) {
+        return _last_refill_tp;
+    }
+    const auto bits = static_cast<uint64_t>(deficit) * 8;
+    return _last_refill_tp + (bits + _bitrate - 1) / _bitrate;
+}
+
+std::deque<Pacer::Entry>* Pacer::GetFrontQueue() {
+    for(auto& queue : _queues) {
+        if(!queue.empty()) {
+            return &queue;
+        }
+    }
+    return nullptr;
+}
+
+const std::deque<Pacer::Entry>* Pacer::GetFrontQueue() const {
+    return const_cast<Pacer*>(this)->GetFrontQueue();
+}
+
+int64_t Pacer::GetRequiredBudget(const Entry& entry) const {
+    return std::min(static_cast<int64_t>(entry.packet.GetSize() * kSec), GetMaxBudget());
+}
+
+int64_t Pacer::GetMaxBudget() const {
+    const auto burst = static_cast<int64_t>(_options.burst * kSec);
+    const auto period = static_cast<int64_t>(_options.process_period * _bitrate / 8);
+    return std::max(burst, period);
+}
+
+void Pacer::Refill(Timepoint now) {
+    if(now <= _last_refill_tp) {
+        return;
+    }
+    const auto max_budget = GetMaxBudget();
+    const auto max_duration = static_cast<uint64_t>(max_budget - std::min(_budget, max_budget)) * 8 / _bitrate + 1;
+    const auto duration = std::min(now - _last_refill_tp, max_duration); // no overflow after long idle
+    _budget = std::min(_budget + static_cast<int64_t>(duration * _bitrate / 8), max_budget);
+    _last_refill_tp = now;
+}
+
+void Pacer::DropOldest() {
+    for(auto it = _queues.rbegin(); it != _queues.rend(); ++it) {
+        auto& queue = *it;
+        if(!queue.empty()) {
+            _queue_size--;
+            _queue_bytes -= queue.front().packet.GetSize();
+            queue.pop_front();
+            _stats.dropped++;
+            TAU_LOG_WARNING_THR(128, "Pacer queue overflow, dropped: " << _stats.dropped);
+            return;
+        }
+    }
+}
+
+}
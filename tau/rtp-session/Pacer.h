@@ -0,0 +1,96 @@
+#pragma once
+
+#include <tau/memory/Buffer.h>
+#include <tau/common/Clock.h>
+#include <functional>
+#include <optional>
+#include <vector>
+#include <array>
+#include <deque>
+
+namespace tau::rtp::session {
+
+// Leaky bucket send scheduler: outgoing RTP packets are queued and released by Process() at the pacing bitrate,
+// up to the bucket depth at once (a packet larger than the bucket is released by the full bucket). Queues are strictly prioritized: audio, then retransmissions, then video.
+// One instance per transport (BUNDLE), shared by RTP sessions which are registered as sinks,
+// the owner doesn't process it after the sessions are destroyed
+class Pacer {
+public:
+    static constexpr double kPacingFactor = 2.5; // pacing bitrate relative to the bandwidth estimation
+    static constexpr size_t kMaxQueueSize = 2048;
+
+    enum Priority {
+        kAudio,
+        kRtx,
+        kVideo,
+        kPrioritiesCount
+    };
+
+    struct Dependencies {
+        Clock& clock;
+    };
+
+    struct Options {
+        uint32_t bitrate = 2'500'000;
+        size_t burst = 4 * 1200; // minimal bucket depth in bytes
+        Timepoint process_period = 10 * kMs; // expected interval between Process() calls, the bucket holds at least bitrate * process_period
+        size_t max_queue_size = kMaxQueueSize; // the oldest packets of the lowest priority are dropped on overflow
+    };
+
+    struct Stats {
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t dropped = 0;
+        Timepoint queue_delay = 0; // of the last sent packet
+        Timepoint max_queue_delay = 0;
+    };
+
+    using SinkId = size_t;
+    using Callback = std::function<void(Buffer&&)>;
+
+private:
+    struct Entry {
+        Buffer packet;
+        SinkId sink;
+        Timepoint enqueue_tp;
+    };
+
+public:
+    Pacer(Dependencies&& deps, Options&& options);
+
+    SinkId AddSink(Callback callback);
+
+    void Push(SinkId sink, Buffer&& packet, Priority priority);
+    void Process();
+    std::optional<Timepoint> GetNextDeadline() const;
+
+    void SetBitrate(uint32_t bitrate) { _bitrate = std::max<uint32_t>(bitrate, 1); }
+    uint32_t GetBitrate() const { return _bitrate; }
+    size_t GetQueueSize() const { return _queue_size; }
+    size_t GetQueueBytes() const { return _queue_bytes; }
+    const Stats& GetStats() const { return _stats; }
+
+private:
+    std::deque<Entry>* GetFrontQueue();
+    const std::deque<Entry>* GetFrontQueue() const;
+    int64_t GetRequiredBudget(const Entry& entry) const;
+    int64_t GetMaxBudget() const;
+    void Refill(Timepoint now);
+    void DropOldest();
+
+private:
+    Dependencies _deps;
+    const Options _options;
+    uint32_t _bitrate;
+
+    int64_t _budget; // bytes allowed to send multiplied by kSec, to avoid rounding of refill
+    Timepoint _last_refill_tp;
+    std::array<std::deque<Entry>, kPrioritiesCount> _queues;
+    size_t _queue_size = 0;
+    size_t _queue_bytes = 0;
+
+    std::vector<Callback> _sinks;
+    Stats _stats;
+};
+
+}
@@ -4,21 +4,45 @@
 
 namespace tau::rtp::session {
 
-RecvBuffer::RecvBuffer(size_t size)
-    : _size(std::clamp<size_t>(size, 4, 4096)) {
-    for(size_t i = 0; i < _size; ++i) {
-        _packets.push_back(std::nullopt);
-    }
+RecvBuffer::RecvBuffer(size_t size, size_t max_bytes)
+    : _size(std::clamp(size, kMinSize, kMaxSize))
+    , _max_bytes(max_bytes) {
+    _packets.resize(_size);
 }
 
 RecvBuffer::PacketType RecvBuffer::Push(Buffer&& packet, uint16_t sn) {
     const auto result = InsertPacket(std::move(packet), sn);
-    while(_packets[_index].has_value()) {
+    SendReady();
+    while((_bytes > _max_bytes) && _sn_end) {
         SendAndProcessNext();
+        SendReady();
+    }
+    return result;
+}
+
+RecvBuffer::PacketType RecvBuffer::PushRecovered(Buffer&& packet, uint16_t sn) {
+    const auto result = Push(std::move(packet), sn);
+    if(result == PacketType::kOk) {
+        _stats.recovered++;
     }
     return result;
 }
 
+void RecvBuffer::SetSize(size_t size) {
+    _size = std::clamp(size, kMinSize, kMaxSize);
+    while(_sn_end && (SnDelta(*_sn_end, _sn_next) >= _size)) {
+        SendAndProcessNext();
+        SendReady();
+    }
+    if((_size > _packets.size()) || (2 * _size <= _packets.size())) {
+        Reallocate(_size);
+    }
+}
+
+size_t RecvBuffer::GetMemoryUsage() const {
+    return _packets.capacity() * sizeof(std::optional<Buffer>) + _bytes;
+}
+
 void RecvBuffer::Flush() {
     if(_sn_end.has_value()) {
         const auto expected_sn_end = SnForward(*_sn_end, 1);
@@ -60,8 +84,9 @@ RecvBuffer::PacketType RecvBuffer::InsertPacket(Buffer&& packet, uint16_t sn) {
 RecvBuffer::PacketType RecvBuffer::OnInRangePacket(Buffer&& packet, uint16_t sn) {
     const auto index = GetIndexBySn(sn);
     if(!_packets[index].has_value()) {
+        _bytes += packet.GetSize();
         _packets[index].emplace(std::move(packet));
-        _sns_to_recover.erase(sn);
+        _nack_tracker.Remove(sn);
         return PacketType::kOk;
     } else {
         _stats.discarded++;
@@ -77,13 +102,11 @@ RecvBuffer::PacketType RecvBuffer::OnOrderedPacket(Buffer&& packet, uint16_t sn)
 
     const auto sn_begin_to_recover = _sn_end ? SnForward(*_sn_end, 1) : _sn_next;
     for(uint16_t sn_to_recover = sn_begin_to_recover; sn_to_recover != sn; ++sn_to_recover) {
-        if(_sns_to_recover.size() == _sns_to_recover.capacity()) {
-            break;
-        }
-        _sns_to_recover.insert(sn_to_recover);
+        _nack_tracker.Add(sn_to_recover);
     }
 
     const auto index = GetIndexBySn(sn);
+    _bytes += packet.GetSize();
     _packets[index].emplace(std::move(packet));
     _sn_end = sn;
     return PacketType::kOk;
@@ -94,30 +117,48 @@ void RecvBuffer::DoReset(Buffer&& packet, uint16_t sn) {
     _callback(std::move(packet));
     _sn_next = SnForward(sn, 1);
     _sn_end.reset();
+    _nack_tracker.Reset(_sn_next);
 }
 
 void RecvBuffer::SendAndProcessNext() {
     if(_packets[_index].has_value()) {
+        _bytes -= _packets[_index]->GetSize();
         _callback(std::move(*_packets[_index]));
         _packets[_index].reset();
     } else {
-        _sns_to_recover.erase(_sn_next);
         _stats.lost++;
     }
     IncreaseSnState();
 }
 
+void RecvBuffer::SendReady() {
+    while(_packets[_index].has_value()) {
+        SendAndProcessNext();
+    }
+}
+
 void RecvBuffer::IncreaseSnState() {
     if(_sn_end && (_sn_next == *_sn_end)) {
         _sn_end.reset();
     }
     _sn_next++;
-    _index = (_index + 1) % _size;
+    _index = (_index + 1) % _packets.size();
+    _nack_tracker.Advance(_sn_next);
+}
+
+void RecvBuffer::Reallocate(size_t capacity) {
+    std::vector<std::optional<Buffer>> packets(capacity);
+    const size_t count = _sn_end ? SnDelta(*_sn_end, _sn_next) + 1 : 0;
+    for(size_t i = 0; i < count; ++i) {
+        packets[i] = std::move(_packets[(_index + i) % _packets.size()]);
+    }
+    _packets = std::move(packets);
+    _index = 0;
 }
 
 size_t RecvBuffer::GetIndexBySn(uint16_t sn) const {
     const auto index = _index + SnDelta(sn, _sn_next);
-    return index % _size;
+    return index % _packets.size();
 }
 
 }
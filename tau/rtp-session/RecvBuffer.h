@@ -1,23 +1,28 @@
 #pragma once
 
+#include <tau/rtp-session/NackTracker.h>
 #include <tau/memory/Buffer.h>
-#include <tau/rtcp/NackMessage.h>
-#include <etl/vector.h>
-#include <etl/set.h>
+#include <vector>
 #include <functional>
 #include <optional>
 
 namespace tau::rtp::session {
 
+// Reordering window: packets are released in SN order, gaps are tracked for NACK.
+// Window size (packets) is set at runtime by SetSize() up to the NACK window, the oldest gaps are skipped
+// on overflow of the size or the bytes budget. Storage is reallocated by SetSize() only
 class RecvBuffer {
 public:
     static constexpr size_t kDefaultSize = 256;
-    static constexpr size_t kBufferCapacity = 256;
+    static constexpr size_t kMinSize = 4;
+    static constexpr size_t kMaxSize = NackTracker::kSize;
+    static constexpr size_t kDefaultMaxBytes = 8 * 1024 * 1024;
 
     struct Stats {
         uint64_t packets = 0;
         uint64_t discarded = 0;
         uint64_t lost = 0;
+        uint64_t recovered = 0; // by FEC, included in packets
         uint64_t bytes = 0;
     };
 
@@ -27,19 +32,26 @@ public:
         kReset
     };
 
-    using Sns = rtcp::NackSns;
-
     using Callback = std::function<void(Buffer&&)>;
 
 public:
-    explicit RecvBuffer(size_t size = kDefaultSize);
+    explicit RecvBuffer(size_t size = kDefaultSize, size_t max_bytes = kDefaultMaxBytes);
 
     void SetCallback(Callback callback) { _callback = std::move(callback); }
 
     PacketType Push(Buffer&& packet, uint16_t sn);
+    PacketType PushRecovered(Buffer&& packet, uint16_t sn);
     void Flush();
 
-    const Sns& GetSnsToRecover() const { return _sns_to_recover; }
+    void SetSize(size_t size);
+    size_t GetSize() const { return _size; }
+    size_t GetMemoryUsage() const; // slots and bytes of the held packets
+
+    const rtcp::NackBitmap& GetSnsToRecover() const { return _nack_tracker.GetLost(); }
+    const rtcp::NackBitmap& GetSnsToNack(Timepoint now, Timepoint retry_interval) {
+        return _nack_tracker.GetSnsToNack(now, retry_interval);
+    }
+    void OnNacked(const rtcp::NackBitmap& sns, size_t count, Timepoint now) { _nack_tracker.OnNacked(sns, count, now); }
     const Stats& GetStats() const { return _stats; }
 
 private:
@@ -49,19 +61,23 @@ private:
     void DoReset(Buffer&& packet, uint16_t sn);
 
     void SendAndProcessNext();
+    void SendReady();
     void IncreaseSnState();
+    void Reallocate(size_t capacity);
     size_t GetIndexBySn(uint16_t sn) const;
 
 private:
-    const size_t _size;
+    size_t _size;
+    const size_t _max_bytes;
 
     bool _first_packet = true;
     uint16_t _sn_next = 0;
     std::optional<uint16_t> _sn_end;
 
     size_t _index = 0;
-    etl::vector<std::optional<Buffer>, kBufferCapacity> _packets;
-    Sns _sns_to_recover;
+    std::vector<std::optional<Buffer>> _packets;
+    size_t _bytes = 0;
+    NackTracker _nack_tracker;
 
     Callback _callback;
     Stats _stats;
@@ -4,54 +4,96 @@
 
 namespace tau::rtp::session {
 
-SendBuffer::SendBuffer(size_t size)
-    : _size(std::clamp<size_t>(size, 4, 4096)) {
-    _packets.reserve(_size);
+SendBuffer::SendBuffer(size_t size, size_t max_bytes)
+    : _size(std::clamp(size, kMinSize, kMaxSize))
+    , _max_bytes(max_bytes) {
+    _slots.resize(_size);
 }
 
 void SendBuffer::Push(Buffer&& packet, uint16_t sn) {
-    if(_packets.size() == _size) {
-        std::swap(_packets.at(_index), packet);
-        _sn_begin++;
-        _index = (_index + 1) % _size;
-    } else {
-        if(_packets.empty()) {
-            _sn_begin = sn;
-            _index = 0;
-        }
-        _packets.push_back(std::move(packet));
-    }
-
-    const auto index = GetIndexBySn(sn);
-    auto packet_copy = _packets.at(index).MakeCopy();
-    _callback(std::move(packet_copy));
+    Push(SgBuffer(std::move(packet)), sn);
+}
+
+void SendBuffer::Push(SgBuffer&& packet, uint16_t sn) {
+    const auto size = packet.GetSize();
+    while((_count > 0) && ((_count == _size) || (_bytes + size > _max_bytes))) {
+        PopFront();
+    }
+    if(_count == 0) {
+        _sn_begin = sn;
+        _begin = 0;
+    }
+
+    auto& slot = _slots[(_begin + _count) % _slots.size()];
+    slot.packet.emplace(std::move(packet));
+    slot.rtx_tp.reset();
+    _count++;
+    _bytes += size;
+
+    _callback(slot.packet->Gather(), false);
 
     _stats.packets++;
-    _stats.bytes += _packets.at(index).GetSize();
+    _stats.bytes += size;
 }
 
-bool SendBuffer::SendRtx(uint16_t sn) {
-    if(_packets.empty()) {
+bool SendBuffer::SendRtx(uint16_t sn, Timepoint now, Timepoint min_interval) {
+    if(_count == 0) {
         return false;
     }
-    const auto sn_end = SnForward(_sn_begin, _packets.size() - 1);
+    const auto sn_end = SnForward(_sn_begin, _count - 1);
     if(!InRange(sn, _sn_begin, sn_end)) {
         return false;
     }
 
-    const auto index = GetIndexBySn(sn);
-    auto packet_copy = _packets.at(index).MakeCopy();
-    _callback(std::move(packet_copy));
+    auto& slot = _slots[GetIndexBySn(sn)];
+    if(slot.rtx_tp && (now < *slot.rtx_tp + min_interval)) {
+        _stats.rtx_suppressed++;
+        return false;
+    }
+    slot.rtx_tp = now;
+
+    _callback(slot.packet->Gather(), true);
 
     _stats.packets++;
     _stats.rtx++;
-    _stats.bytes += _packets.at(index).GetSize();
+    _stats.bytes += slot.packet->GetSize();
     return true;
 }
 
+void SendBuffer::SetSize(size_t size) {
+    _size = std::clamp(size, kMinSize, kMaxSize);
+    while(_count > _size) {
+        PopFront();
+    }
+    if((_size > _slots.size()) || (2 * _size <= _slots.size())) {
+        Reallocate(_size);
+    }
+}
+
+size_t SendBuffer::GetMemoryUsage() const {
+    return _slots.capacity() * sizeof(Slot) + _bytes;
+}
+
+void SendBuffer::PopFront() {
+    auto& slot = _slots[_begin];
+    _bytes -= slot.packet->GetSize();
+    slot.packet.reset();
+    _begin = (_begin + 1) % _slots.size();
+    _sn_begin++;
+    _count--;
+}
+
+void SendBuffer::Reallocate(size_t capacity) {
+    std::vector<Slot> slots(capacity);
+    for(size_t i = 0; i < _count; ++i) {
+        slots[i] = std::move(_slots[(_begin + i) % _slots.size()]);
+    }
+    _slots = std::move(slots);
+    _begin = 0;
+}
+
 size_t SendBuffer::GetIndexBySn(uint16_t sn) const {
-    const auto index = _index + SnDelta(sn, _sn_begin);
-    return index % _packets.size();
+    return (_begin + SnDelta(sn, _sn_begin)) % _slots.size();
 }
 
 }
@@ -1,44 +1,68 @@
 #pragma once
 
-#include <tau/memory/Buffer.h>
-#include <etl/vector.h>
+#include <tau/memory/SgBuffer.h>
+#include <tau/common/Clock.h>
+#include <vector>
 #include <functional>
 #include <optional>
 
 namespace tau::rtp::session {
 
+// History of the sent packets for retransmissions. Window size (packets) is set at runtime by SetSize(),
+// the oldest packets are dropped on overflow of the size or the bytes budget.
+// Storage is reallocated by SetSize() only (growth or 2x shrink), Push() doesn't allocate slots
 class SendBuffer {
 public:
     static constexpr size_t kDefaultSize = 256;
-    static constexpr size_t kBufferCapacity = 256;
+    static constexpr size_t kMinSize = 4;
+    static constexpr size_t kMaxSize = 4096;
+    static constexpr size_t kDefaultMaxBytes = 8 * 1024 * 1024;
 
     struct Stats {
         uint64_t packets = 0;
         uint64_t rtx = 0;
+        uint64_t rtx_suppressed = 0;
         uint64_t bytes = 0;
     };
 
-    using Callback = std::function<void(Buffer&&)>;
+    using Callback = std::function<void(Buffer&&, bool rtx)>;
 
 public:
-    explicit SendBuffer(size_t size = kDefaultSize);
+    explicit SendBuffer(size_t size = kDefaultSize, size_t max_bytes = kDefaultMaxBytes);
 
     void SetCallback(Callback callback) { _callback = std::move(callback); }
 
     void Push(Buffer&& packet, uint16_t sn);
-    bool SendRtx(uint16_t sn);
+    void Push(SgBuffer&& packet, uint16_t sn);
+    // the packet isn't resent again within min_interval (e.g. RTT) since its last retransmission
+    bool SendRtx(uint16_t sn, Timepoint now = 0, Timepoint min_interval = 0);
+
+    void SetSize(size_t size);
+    size_t GetSize() const { return _size; }
+    size_t GetCount() const { return _count; }
+    size_t GetMemoryUsage() const; // slots and bytes of the stored packets
 
     const Stats& GetStats() const { return _stats; }
 
 private:
+    struct Slot {
+        std::optional<SgBuffer> packet;
+        std::optional<Timepoint> rtx_tp;
+    };
+
+    void PopFront();
+    void Reallocate(size_t capacity);
     size_t GetIndexBySn(uint16_t sn) const;
 
 private:
-    const size_t _size;
+    size_t _size;
+    const size_t _max_bytes;
 
-    uint16_t _sn_begin;
-    size_t _index = 0;
-    etl::vector<Buffer, kBufferCapacity> _packets;
+    std::vector<Slot> _slots;
+    size_t _begin = 0;
+    size_t _count = 0;
+    size_t _bytes = 0;
+    uint16_t _sn_begin = 0;
 
     Callback _callback;
     Stats _stats;
@@ -1,5 +1,6 @@
 #include "tau/rtp-session/Session.h"
 #include "tau/rtp/Reader.h"
+#include "tau/rtp/Rtx.h"
 #include "tau/rtp/Sn.h"
 #include "tau/rtcp/Reader.h"
 #include "tau/rtcp/Writer.h"
@@ -21,20 +22,60 @@ namespace tau::rtp::session {
 Session::Session(Dependencies&& deps, Options&& options)
     : _deps(std::move(deps))
     , _options(std::move(options))
-    , _send_buffer(_options.send_buffer_size)
-    , _recv_buffer(_options.recv_buffer_size)
+    , _send_buffer(_options.send_buffer_size, _options.send_buffer_max_bytes)
+    , _recv_buffer(_options.recv_buffer_size, _options.recv_buffer_max_bytes)
     , _last_outgoing_rtcp(_deps.media_clock.Now())
     , _last_outgoing_rtcp_sr(_deps.media_clock.Now())
     , _last_outgoing_rtcp_nack(_deps.media_clock.Now()) {
-    _send_buffer.SetCallback([this](Buffer&& rtp_packet) { _send_rtp_callback(std::move(rtp_packet)); });
+    if(_deps.pacer) {
+        _pacer_sink = _deps.pacer->AddSink([this](Buffer&& rtp_packet) { SendRtpToTransport(std::move(rtp_packet)); });
+    }
+    if(_options.rtx_stream) {
+        _rtx_sn = _options.rtx_stream->sn;
+    }
+    _send_buffer.SetCallback([this](Buffer&& rtp_packet, bool rtx) {
+        if(rtx && _options.rtx_stream) {
+            if(!Rtx::Wrap(rtp_packet, _options.rtx_stream->pt, _options.rtx_stream->ssrc, _rtx_sn)) {
+                TAU_LOG_WARNING_THR(128, _options.log_ctx << "Can't wrap RTX, size: " << rtp_packet.GetSize() << ", tailroom: " << rtp_packet.GetTailroom());
+                return;
+            }
+            _rtx_sn++;
+        }
+        SendRtpPaced(std::move(rtp_packet), rtx ? std::min(_options.priority, Pacer::kRtx) : _options.priority);
+    });
     _recv_buffer.SetCallback([this](Buffer&& rtp_packet) { _recv_rtp_callback(std::move(rtp_packet)); });
+    if(_options.fec) {
+        _fec_encoder.emplace(FecEncoder::Dependencies{.allocator = _deps.allocator}, FecEncoder::Options(*_options.fec));
+        _fec_decoder.emplace(FecDecoder::Dependencies{.allocator = _deps.allocator});
+        _fec_decoder->SetCallback([this](Buffer&& rtp_packet) { RecvRecovered(std::move(rtp_packet)); });
+    }
+    _stats.outgoing.buffer_size = _send_buffer.GetSize();
+    _stats.incoming.buffer_size = _recv_buffer.GetSize();
+    _stats.memory = _send_buffer.GetMemoryUsage() + _recv_buffer.GetMemoryUsage();
 }
 
 void Session::SendRtp(Buffer&& rtp_packet) {
     ProcessRtcpSr(rtp_packet);
     ProcessRtcp();
+    if(_fec_encoder && _deps.twcc_sender) {
+        _deps.twcc_sender->Reserve(rtp_packet);
+    }
     Reader reader(ToConst(rtp_packet.GetView()));
+    auto repair_packet = _fec_encoder ? _fec_encoder->Push(SgBuffer::Views{ToConst(rtp_packet.GetView())}) : std::nullopt;
+    _send_buffer.Push(std::move(rtp_packet), reader.Sn());
+    SendFec(std::move(repair_packet));
+}
+
+void Session::SendRtp(SgBuffer&& rtp_packet) {
+    ProcessRtcpSr(rtp_packet.GetHeader());
+    ProcessRtcp();
+    if(_fec_encoder && _deps.twcc_sender) {
+        _deps.twcc_sender->Reserve(rtp_packet.GetHeader());
+    }
+    Reader reader(ToConst(rtp_packet.GetHeader().GetView()));
+    auto repair_packet = _fec_encoder ? _fec_encoder->Push(rtp_packet.GetViews()) : std::nullopt;
     _send_buffer.Push(std::move(rtp_packet), reader.Sn());
+    SendFec(std::move(repair_packet));
 }
 
 void Session::Recv(Buffer&& packet) {
@@ -51,9 +92,17 @@ void Session::RecvRtp(Buffer&& rtp_packet) {
         _stats.incoming.discarded++;
         return;
     }
+    Reader reader(view);
+    if(_options.rtx_stream && (reader.Pt() == _options.rtx_stream->pt)) {
+        RecvRtx(std::move(rtp_packet));
+        return;
+    }
+    if(_fec_decoder && (reader.Pt() == _options.fec->pt)) {
+        RecvFec(std::move(rtp_packet));
+        return;
+    }
     _stats.incoming.rtp++;
 
-    Reader reader(view);
     if(_recv_ctx) {
         if((_recv_ctx->pt != reader.Pt()) || (_rr_block.ssrc != reader.Ssrc())) {
             _stats.incoming.discarded++;
@@ -74,11 +123,21 @@ void Session::RecvRtp(Buffer&& rtp_packet) {
         _rr_block.ssrc = reader.Ssrc();
         _rr_block.ext_highest_sn = SnBackward(reader.Sn(), 1);
     }
+    if(_deps.twcc_receiver) {
+        _deps.twcc_receiver->Recv(view);
+        if(_fec_decoder) {
+            _deps.twcc_receiver->Clear(rtp_packet); // transport-wide sn isn't FEC protected
+        }
+    }
     ProcessSn(reader.Sn());
     ProcessTs(rtp_packet, reader.Ts());
+    if(_fec_decoder) {
+        _fec_decoder->PushMedia(rtp_packet);
+    }
     _recv_buffer.Push(std::move(rtp_packet), reader.Sn());
     ProcessRtcp();
     ProcessRtcpNack();
+    ProcessRtcpTwcc();
 }
 
 void Session::RecvRtcp(Buffer&& rtcp_packet) {
@@ -102,7 +161,35 @@ void Session::RecvRtcp(Buffer&& rtcp_packet) {
 }
 
 void Session::Process() {
+    if(_recv_ctx || _sr_info.ntp) { // reports go on while RTP is paused
+        ProcessRtcpSr();
+        ProcessRtcp();
+    }
     ProcessRtcpNack();
+    ProcessRtcpTwcc();
+    if(_deps.twcc_sender) {
+        _stats.outgoing.target_bitrate = _deps.twcc_sender->GetTargetBitrate();
+    }
+    if(_deps.pacer) {
+        _stats.outgoing.pacer_queue_delay = _deps.pacer->GetStats().queue_delay;
+    }
+}
+
+std::optional<Timepoint> Session::GetNextDeadline() const {
+    std::optional<Timepoint> deadline;
+    if(_recv_ctx || _sr_info.ntp) {
+        deadline = _last_outgoing_rtcp + kSec;
+    }
+    if(_options.rtx && !_recv_buffer.GetSnsToRecover().IsEmpty()) {
+        const auto nack_deadline = _last_outgoing_rtcp_nack + kNackRequestPeriod;
+        deadline = deadline ? std::min(*deadline, nack_deadline) : nack_deadline;
+    }
+    if(_deps.twcc_receiver && _recv_ctx) {
+        if(auto twcc_deadline = _deps.twcc_receiver->GetNextDeadline()) {
+            deadline = deadline ? std::min(*deadline, *twcc_deadline) : *twcc_deadline;
+        }
+    }
+    return deadline;
 }
 
 void Session::PushEvent(Event&& event) {
@@ -131,6 +218,81 @@ void Session::PushEvent(Event&& event) {
     _send_rtcp_callback(std::move(rtcp_packet));
 }
 
+void Session::SendRtpPaced(Buffer&& rtp_packet, Pacer::Priority priority) {
+    if(_pacer_sink) {
+        _deps.pacer->Push(*_pacer_sink, std::move(rtp_packet), priority);
+    } else {
+        SendRtpToTransport(std::move(rtp_packet));
+    }
+}
+
+void Session::SendFec(std::optional<Buffer>&& repair_packet) {
+    if(repair_packet) {
+        _stats.outgoing.fec++;
+        SendRtpPaced(std::move(*repair_packet), _options.priority);
+    }
+}
+
+void Session::SendRtpToTransport(Buffer&& rtp_packet) {
+    if(_deps.twcc_sender) {
+        _deps.twcc_sender->Stamp(rtp_packet);
+    }
+    _send_rtp_callback(std::move(rtp_packet));
+}
+
+// retransmissions are recovered to the original packets, they don't affect sn, jitter and loss stats
+void Session::RecvRtx(Buffer&& rtx_packet) {
+    if(!_recv_ctx) {
+        _stats.incoming.discarded++;
+        return;
+    }
+    if(_deps.twcc_receiver) {
+        _deps.twcc_receiver->Recv(ToConst(rtx_packet.GetView()));
+    }
+    if(!Rtx::Unwrap(rtx_packet, _recv_ctx->pt, _rr_block.ssrc)) {
+        _stats.incoming.discarded++;
+        return;
+    }
+    _stats.incoming.rtx++;
+
+    Reader reader(ToConst(rtx_packet.GetView()));
+    const auto sn = reader.Sn();
+    rtx_packet.GetInfo().tp = _recv_ctx->ts_converter.FromTs(reader.Ts());
+    if(_fec_decoder) {
+        if(_deps.twcc_receiver) {
+            _deps.twcc_receiver->Clear(rtx_packet);
+        }
+        _fec_decoder->PushMedia(rtx_packet);
+    }
+    _recv_buffer.Push(std::move(rtx_packet), sn);
+    ProcessRtcpTwcc();
+}
+
+void Session::RecvFec(Buffer&& repair_packet) {
+    if(!_recv_ctx) {
+        _stats.incoming.discarded++;
+        return;
+    }
+    if(_deps.twcc_receiver) {
+        _deps.twcc_receiver->Recv(ToConst(repair_packet.GetView()));
+    }
+    _stats.incoming.fec++;
+    _fec_decoder->PushRepair(std::move(repair_packet));
+    ProcessRtcpTwcc();
+}
+
+void Session::RecvRecovered(Buffer&& rtp_packet) {
+    Reader reader(ToConst(rtp_packet.GetView()));
+    if(!_recv_ctx || (_recv_ctx->pt != reader.Pt())) {
+        _stats.incoming.discarded++;
+        return;
+    }
+    const auto sn = reader.Sn();
+    rtp_packet.GetInfo().tp = _recv_ctx->ts_converter.FromTs(reader.Ts());
+    _recv_buffer.PushRecovered(std::move(rtp_packet), sn);
+    _stats.incoming.recovered = _recv_buffer.GetStats().recovered;
+}
+
 void Session::ProcessSn(uint16_t sn) {
     const auto sn_delta = SnDelta(sn, _recv_ctx->sn_last);
     if(sn_delta > 4096) { //TODO: name constant
@@ -156,6 +318,7 @@ void Session::ProcessRtcp() {
     if(now < _last_outgoing_rtcp + kSec) {
         return;
     }
+    UpdateBufferSizes(now - _last_outgoing_rtcp);
     _last_outgoing_rtcp = now;
 
     rtcp::RrBlocks rr_blocks;
@@ -192,6 +355,29 @@ void Session::ProcessRtcp() {
     _send_rtcp_callback(std::move(packet));
 }
 
+void Session::UpdateBufferSizes(Timepoint period) {
+    // windows are resized out of the packets path, once per RTCP interval, w/o retransmissions they are fixed
+    if(!_options.rtx) {
+        _stats.memory = _send_buffer.GetMemoryUsage() + _recv_buffer.GetMemoryUsage();
+        return;
+    }
+    const auto window = kBufferRtts * _stats.rtt;
+    const auto& send_stats = _send_buffer.GetStats();
+    const auto sent_packets = send_stats.packets - send_stats.rtx; // retransmissions don't extend the history
+    const auto sent_size = (sent_packets - _last_sent_packets) * window / period;
+    _send_buffer.SetSize(std::max<size_t>(_options.send_buffer_size, sent_size));
+    _last_sent_packets = sent_packets;
+
+    const auto received_packets = _recv_buffer.GetStats().packets;
+    const auto received_size = (received_packets - _last_received_packets) * window / period;
+    _recv_buffer.SetSize(std::max<size_t>(_options.recv_buffer_size, received_size));
+    _last_received_packets = received_packets;
+
+    _stats.outgoing.buffer_size = _send_buffer.GetSize();
+    _stats.incoming.buffer_size = _recv_buffer.GetSize();
+    _stats.memory = _send_buffer.GetMemoryUsage() + _recv_buffer.GetMemoryUsage();
+}
+
 void Session::ProcessRtcpSr(const Buffer& rtp_packet) {
     const auto now = _deps.media_clock.Now();
     if(now < _last_outgoing_rtcp_sr + kSec) {
@@ -210,6 +396,21 @@ void Session::ProcessRtcpSr(const Buffer& rtp_packet) {
     _sr_info.octet_count = sender_stats.bytes;
 }
 
+void Session::ProcessRtcpSr() {
+    const auto now = _deps.media_clock.Now();
+    if(!_sr_info.ntp || (now < _last_outgoing_rtcp_sr + kSec)) {
+        return;
+    }
+    const auto ts_delta = static_cast<uint32_t>(_options.rate * (now - _last_outgoing_rtcp_sr) / kSec);
+    _last_outgoing_rtcp_sr = now;
+
+    const auto& sender_stats = _send_buffer.GetStats();
+    _sr_info.ntp = ToNtp(_deps.system_clock.Now());
+    _sr_info.ts += ts_delta;
+    _sr_info.packet_count = sender_stats.packets;
+    _sr_info.octet_count = sender_stats.bytes;
+}
+
 void Session::ProcessRtcpNack() {
     const auto now = _deps.media_clock.Now();
     if(!_options.rtx || (now < _last_outgoing_rtcp_nack + kNackRequestPeriod)) {
@@ -217,14 +418,35 @@ void Session::ProcessRtcpNack() {
     }
     _last_outgoing_rtcp_nack = now;
 
-    const auto sns = _recv_buffer.GetSnsToRecover();
-    if(sns.empty()) {
+    // lost SN is requested again after RTT till recovery
+    const auto& sns = _recv_buffer.GetSnsToNack(now, _stats.rtt);
+    if(sns.IsEmpty()) {
+        return;
+    }
+
+    auto packet = Buffer::Create(_deps.allocator, Buffer::Info{.tp = now});
+    rtcp::Writer writer(packet.GetViewWithCapacity());
+    const auto written = rtcp::NackWriter::Write(writer, _options.sender_ssrc, _rr_block.ssrc, sns);
+    if(written == 0) {
         return;
     }
+    _recv_buffer.OnNacked(sns, written, now); // the rest is requested by the next NACK
+    packet.SetSize(writer.GetSize());
+    _send_rtcp_callback(std::move(packet));
+}
 
+void Session::ProcessRtcpTwcc() {
+    if(!_deps.twcc_receiver || !_recv_ctx) {
+        return;
+    }
+    const auto now = _deps.media_clock.Now();
+    const auto deadline = _deps.twcc_receiver->GetNextDeadline();
+    if(!deadline || (now < *deadline)) {
+        return; // called on every received packet, the buffer is taken when the feedback is due only
+    }
     auto packet = Buffer::Create(_deps.allocator, Buffer::Info{.tp = now});
     rtcp::Writer writer(packet.GetViewWithCapacity());
-    if(!rtcp::NackWriter::Write(writer, _options.sender_ssrc, _rr_block.ssrc, sns)) {
+    if(!_deps.twcc_receiver->WriteFeedback(writer, _options.sender_ssrc, _rr_block.ssrc)) {
         return;
     }
     packet.SetSize(writer.GetSize());
@@ -277,16 +499,22 @@ void Session::ProcessIncomingRtcpRr(const BufferViewConst& report) {
 
 void Session::ProcessIncomingRtcpPtpfb(const BufferViewConst& report) {
     const auto fmt = rtcp::GetRc(report.ptr[0]);
-    if(fmt == rtcp::RtpfbType::kNack) {
+    if(fmt == rtcp::RtpfbType::kTwcc) {
+        if(_deps.twcc_sender) {
+            _deps.twcc_sender->OnFeedback(report);
+            _stats.outgoing.target_bitrate = _deps.twcc_sender->GetTargetBitrate();
+        }
+    } else if(fmt == rtcp::RtpfbType::kNack) {
         if(_options.rtx) {
             const auto media_ssrc = rtcp::NackReader::GetMediaSsrc(report);
             if(_options.sender_ssrc == media_ssrc) {
-                const auto sns = rtcp::NackReader::GetSns(report);
-                for(auto sn : sns) {
-                    if(!_send_buffer.SendRtx(sn)) {
-                        TAU_LOG_INFO_THR(128, _options.log_ctx << "Can't send RTX, sn: " << sn);
+                // the receiver repeats NACK till recovery, a packet is resent at most once per RTT
+                const auto now = _deps.media_clock.Now();
+                rtcp::NackReader::ForEachSn(report, [&](uint16_t sn) {
+                    if(!_send_buffer.SendRtx(sn, now, _stats.rtt)) {
+                        TAU_LOG_INFO_THR(128, _options.log_ctx << "RTX isn't sent, sn: " << sn);
                     }
-                }
+                });
             } else {
                 TAU_LOG_INFO_THR(128, _options.log_ctx << "Wrong media_ssrc: " << media_ssrc);
             }
@@ -3,6 +3,11 @@
 #include <tau/rtp-session/SendBuffer.h>
 #include <tau/rtp-session/RecvBuffer.h>
 #include <tau/rtp-session/Event.h>
+#include <tau/rtp-session/TwccSender.h>
+#include <tau/rtp-session/TwccReceiver.h>
+#include <tau/rtp-session/Pacer.h>
+#include <tau/rtp-session/FecEncoder.h>
+#include <tau/rtp-session/FecDecoder.h>
 #include <tau/rtp/Jitter.h>
 #include <tau/rtp/TsConverter.h>
 #include <tau/rtcp/SrInfo.h>
@@ -16,11 +21,22 @@ class Session {
 public:
     static constexpr Timepoint kDefaultRtt = 100 * kMs;
     static constexpr Timepoint kNackRequestPeriod = 5 * kMs;
+    static constexpr size_t kBufferRtts = 4; // retransmission history and reordering window, packets of bitrate x RTTs
 
     struct Dependencies {
         Allocator& allocator;
         Clock& media_clock;
         Clock& system_clock;
+        TwccSender* twcc_sender = nullptr;     // shared by sessions of the transport
+        TwccReceiver* twcc_receiver = nullptr; // shared by sessions of the transport
+        Pacer* pacer = nullptr;                // shared by sessions of the transport, RTP is sent by Pacer::Process
+    };
+
+    // RFC 4588 retransmission stream, the same PT is expected for incoming retransmissions
+    struct RtxStream {
+        uint8_t pt;
+        uint32_t ssrc;
+        uint16_t sn = 0;
     };
 
     struct Options {
@@ -28,8 +44,13 @@ public:
         uint32_t sender_ssrc;
         uint32_t base_ts;
         bool rtx = true;
-        size_t send_buffer_size = session::SendBuffer::kDefaultSize;
-        size_t recv_buffer_size = session::RecvBuffer::kDefaultSize;
+        std::optional<RtxStream> rtx_stream = std::nullopt; // w/o it lost packets are resent on the original SSRC
+        std::optional<FecEncoder::Options> fec = std::nullopt; // FlexFEC stream, the same PT is expected for incoming repair packets
+        Pacer::Priority priority = Pacer::kVideo; // retransmissions go before new video
+        size_t send_buffer_size = session::SendBuffer::kDefaultSize; // minimal, the window follows bitrate x RTT with RTX
+        size_t recv_buffer_size = session::RecvBuffer::kDefaultSize; // minimal, the window follows bitrate x RTT with RTX
+        size_t send_buffer_max_bytes = session::SendBuffer::kDefaultMaxBytes;
+        size_t recv_buffer_max_bytes = session::RecvBuffer::kDefaultMaxBytes;
         etl::string_view cname = {};
         etl::string_view log_ctx = {};
     };
@@ -37,21 +58,30 @@ public:
     struct Stats {
         struct Incoming {
             uint64_t rtp = 0;
+            uint64_t rtx = 0;
+            uint64_t fec = 0;
+            uint64_t recovered = 0; // by FEC
             uint64_t discarded = 0;
             uint32_t jitter = 0;
             int32_t lost_packets = 0;
             float loss_rate = 0;
+            size_t buffer_size = 0; // packets
         };
         Incoming incoming = {};
 
         struct Outgoing {
             uint64_t rtp = 0;
+            uint64_t fec = 0;
             int32_t lost_packets = 0;
             float loss_rate = 0;
+            uint32_t target_bitrate = 0; // transport-wide estimation, 0 w/o TWCC
+            Timepoint pacer_queue_delay = 0; // transport-wide, of the last paced packet
+            size_t buffer_size = 0; // packets
         };
         Outgoing outgoing = {};
 
         Timepoint rtt = kDefaultRtt;
+        size_t memory = 0; // bytes of send and recv buffers
     };
 
     using Callback = std::function<void(Buffer&& packet)>;
@@ -66,22 +96,33 @@ public:
     void SetEventCallback(EventCallback callback) { _event_callback = std::move(callback); }
 
     void SendRtp(Buffer&& rtp_packet);
+    void SendRtp(SgBuffer&& rtp_packet); // header block holds RTP header, payload is gathered on send
     void Recv(Buffer&& packet);
     void RecvRtp(Buffer&& rtp_packet);
     void RecvRtcp(Buffer&& rtcp_packet);
 
     void Process();
+    std::optional<Timepoint> GetNextDeadline() const; // RTCP reports once RTP is sent or received, NACK pacing and TWCC feedback
     void PushEvent(Event&& event);
 
     const Stats& GetStats() const { return _stats; }
 
 private:
+    void SendRtpPaced(Buffer&& rtp_packet, Pacer::Priority priority);
+    void SendRtpToTransport(Buffer&& rtp_packet);
+    void SendFec(std::optional<Buffer>&& repair_packet);
+    void RecvRtx(Buffer&& rtx_packet);
+    void RecvFec(Buffer&& repair_packet);
+    void RecvRecovered(Buffer&& rtp_packet);
     void ProcessSn(uint16_t sn);
     void ProcessTs(Buffer& rtcp_packet, uint32_t rtp_ts);
 
     void ProcessRtcp();
+    void UpdateBufferSizes(Timepoint period);
     void ProcessRtcpSr(const Buffer& rtp_packet);
+    void ProcessRtcpSr(); // w/o RTP, the last timestamp is extrapolated
     void ProcessRtcpNack();
+    void ProcessRtcpTwcc();
     void UpdateRrBlock();
 
     void ProcessIncomingRtcpSr(const BufferViewConst& report);
@@ -95,6 +136,10 @@ private:
 
     session::SendBuffer _send_buffer;
     session::RecvBuffer _recv_buffer;
+    std::optional<Pacer::SinkId> _pacer_sink;
+    uint16_t _rtx_sn = 0;
+    std::optional<FecEncoder> _fec_encoder;
+    std::optional<FecDecoder> _fec_decoder;
 
     struct RecvContext {
         uint8_t pt;
@@ -111,6 +156,8 @@ private:
     Timepoint _last_outgoing_rtcp_sr;
     Timepoint _last_outgoing_rtcp_nack;
     rtcp::SrInfo _sr_info;
+    uint64_t _last_sent_packets = 0;
+    uint64_t _last_received_packets = 0;
 
     Timepoint _last_incoming_rtcp_sr = 0;
     rtcp::RrBlock _rr_block;
@@ -0,0 +1,131 @@
+#include "tau/rtp-session/SimulcastForwarder.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/Sn.h"
+#include "tau/common/NetToHost.h"
+#include <algorithm>
+
+namespace tau::rtp::session {
+
+SimulcastForwarder::SimulcastForwarder(Dependencies&& deps, Options&& options)
+    : _deps(std::move(deps))
+    , _options(std::move(options))
+{}
+
+void SimulcastForwarder::Push(size_t layer, Buffer&& packet, bool key_frame) {
+    if(layer >= kMaxLayers) {
+        return;
+    }
+    const auto now = _deps.clock.Now();
+    UpdateBitrate(_layers[layer], packet.GetSize(), now);
+
+    auto view = packet.GetView();
+    const auto reader = Reader(ToConst(view));
+    const auto sn = reader.Sn();
+    const auto ts = reader.Ts();
+    if((_target_layer == layer) && (_layer != layer)) {
+        if(!key_frame) {
+            RequestKeyFrame(now);
+        } else {
+            Switch(layer, sn, ts, now);
+        }
+    }
+    if(_layer != layer) {
+        return;
+    }
+    if(_switch_sn) {
+        if(SnLesser(sn, *_switch_sn)) {
+            _stats.dropped++;
+            return;
+        }
+        if(SnDelta(sn, *_switch_sn) >= kSwitchGuardSns) {
+            _switch_sn.reset();
+        }
+    }
+
+    const auto out_sn = SnForward(sn, _sn_offset);
+    const auto out_ts = ts + _ts_offset;
+    Write16(view.ptr + sizeof(uint16_t), out_sn);
+    Write32(view.ptr + sizeof(uint32_t), out_ts);
+    Write32(view.ptr + 2 * sizeof(uint32_t), _options.ssrc);
+    if(!_last_sn || SnGreater(out_sn, *_last_sn)) {
+        _last_sn = out_sn;
+        _last_ts = out_ts;
+        _last_tp = now;
+    }
+    _stats.packets++;
+    _callback(std::move(packet));
+}
+
+void SimulcastForwarder::SetTargetLayer(size_t layer) {
+    if((layer >= kMaxLayers) || (_target_layer == layer)) {
+        return;
+    }
+    _target_layer = layer;
+    if(_layer != layer) {
+        _key_frame_request_tp.reset();
+        RequestKeyFrame(_deps.clock.Now());
+    }
+}
+
+void SimulcastForwarder::SetAvailableBitrate(uint32_t bitrate) {
+    const auto current_bitrate = _layer ? _layers[*_layer].bitrate : 0;
+    std::optional<size_t> best;
+    std::optional<size_t> lowest;
+    for(size_t i = 0; i < kMaxLayers; ++i) {
+        const auto layer_bitrate = _layers[i].bitrate;
+        if(layer_bitrate == 0) {
+            continue;
+        }
+        if(!lowest || (layer_bitrate < _layers[*lowest].bitrate)) {
+            lowest = i;
+        }
+        const auto required = (layer_bitrate > current_bitrate) ? layer_bitrate * (1 + _options.up_margin) : layer_bitrate;
+        if((required <= bitrate) && (!best || (layer_bitrate > _layers[*best].bitrate))) {
+            best = i;
+        }
+    }
+    if(auto layer = best ? best : lowest) {
+        SetTargetLayer(*layer);
+    }
+}
+
+void SimulcastForwarder::UpdateBitrate(Layer& layer, size_t size, Timepoint now) {
+    if(!layer.window_tp) {
+        layer.window_tp = now;
+    }
+    layer.bytes += size;
+    const auto elapsed = now - *layer.window_tp;
+    if(elapsed >= kBitrateWindow) {
+        layer.bitrate = static_cast<uint32_t>(8 * layer.bytes * kSec / elapsed);
+        layer.bytes = 0;
+        layer.window_tp = now;
+    }
+}
+
+void SimulcastForwarder::Switch(size_t layer, uint16_t sn, uint32_t ts, Timepoint now) {
+    uint16_t out_sn = _options.sn;
+    uint32_t out_ts = _options.ts;
+    if(_last_sn) {
+        out_sn = SnForward(*_last_sn, 1);
+        out_ts = _last_ts + std::max<uint32_t>(1, static_cast<uint32_t>((now - _last_tp) * _options.rate / kSec));
+    }
+    _sn_offset = SnDelta(out_sn, sn);
+    _ts_offset = out_ts - ts;
+    _switch_sn = sn;
+    _layer = layer;
+    _key_frame_request_tp.reset();
+    _stats.switches++;
+}
+
+void SimulcastForwarder::RequestKeyFrame(Timepoint now) {
+    if(_key_frame_request_tp && (now < *_key_frame_request_tp + kKeyFrameRequestPeriod)) {
+        return;
+    }
+    _key_frame_request_tp = now;
+    _stats.key_frame_requests++;
+    if(_key_frame_request_callback) {
+        _key_frame_request_callback(*_target_layer);
+    }
+}
+
+}
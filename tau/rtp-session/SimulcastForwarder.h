@@ -0,0 +1,94 @@
+#pragma once
+
+#include <tau/memory/Buffer.h>
+#include <tau/common/Clock.h>
+#include <functional>
+#include <optional>
+#include <array>
+
+namespace tau::rtp::session {
+
+// SFU forwarding of simulcast layers (e.g. MediaDemuxer output) to a viewer as a single RTP stream: packets of the current
+// layer are passed with the output SSRC, SN and TS are rewritten to be continuous over the layer switches.
+// The layer is switched to the target one on its key-frame, which is requested by the callback. TS gap on switch
+// is the wall clock time since the last forwarded packet. All layers are pushed to measure their bitrates, so the target
+// layer could be selected by the viewer's available bitrate (e.g. TWCC estimation), no transcoding is involved
+class SimulcastForwarder {
+public:
+    static constexpr size_t kMaxLayers = 4;
+    static constexpr Timepoint kBitrateWindow = kSec;
+    static constexpr Timepoint kKeyFrameRequestPeriod = 500 * kMs;
+    static constexpr uint16_t kSwitchGuardSns = 0x1000; // late packets are older than the receive window
+
+    struct Dependencies {
+        Clock& clock;
+    };
+
+    struct Options {
+        uint32_t ssrc;
+        uint32_t rate = 90'000;
+        uint16_t sn = 0;            // the first output SN
+        uint32_t ts = 0;            // the first output TS
+        float up_margin = 0.15;     // the higher layer is selected if the available bitrate exceeds its bitrate by the margin
+    };
+
+    struct Stats {
+        uint64_t packets = 0;
+        uint64_t dropped = 0;       // of the current layer, older than the switch point
+        uint64_t switches = 0;
+        uint64_t key_frame_requests = 0;
+    };
+
+    using Callback = std::function<void(Buffer&& packet)>;
+    using KeyFrameRequestCallback = std::function<void(size_t layer)>;
+
+public:
+    SimulcastForwarder(Dependencies&& deps, Options&& options);
+
+    void SetCallback(Callback callback) { _callback = std::move(callback); }
+    void SetKeyFrameRequestCallback(KeyFrameRequestCallback callback) { _key_frame_request_callback = std::move(callback); }
+
+    // key_frame: the packet starts a key-frame, i.e. the layer could be switched on it
+    void Push(size_t layer, Buffer&& packet, bool key_frame);
+
+    void SetTargetLayer(size_t layer);
+    void SetAvailableBitrate(uint32_t bitrate);
+
+    std::optional<size_t> GetLayer() const { return _layer; }
+    std::optional<size_t> GetTargetLayer() const { return _target_layer; }
+    uint32_t GetLayerBitrate(size_t layer) const { return _layers.at(layer).bitrate; }
+    const Stats& GetStats() const { return _stats; }
+
+private:
+    struct Layer {
+        uint64_t bytes = 0;
+        std::optional<Timepoint> window_tp;
+        uint32_t bitrate = 0;
+    };
+
+    void UpdateBitrate(Layer& layer, size_t size, Timepoint now);
+    void Switch(size_t layer, uint16_t sn, uint32_t ts, Timepoint now);
+    void RequestKeyFrame(Timepoint now);
+
+private:
+    Dependencies _deps;
+    const Options _options;
+
+    std::array<Layer, kMaxLayers> _layers = {};
+    std::optional<size_t> _layer;
+    std::optional<size_t> _target_layer;
+    std::optional<Timepoint> _key_frame_request_tp;
+
+    uint16_t _sn_offset = 0;
+    uint32_t _ts_offset = 0;
+    std::optional<uint16_t> _switch_sn; // late packets guard, cleared after kSwitchGuardSns as SN compare wraps
+    std::optional<uint16_t> _last_sn;
+    uint32_t _last_ts = 0;
+    Timepoint _last_tp = 0;
+
+    Callback _callback;
+    KeyFrameRequestCallback _key_frame_request_callback;
+    Stats _stats;
+};
+
+}
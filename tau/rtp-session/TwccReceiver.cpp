@@ -0,0 +1,118 @@
+#include <tau/rtp-session/TwccReceiver.h>
+#include <tau/rtp/Reader.h>
+#include <tau/rtp/Extension.h>
+#include <tau/rtp/Sn.h>
+#include <tau/rtcp/TwccWriter.h>
+#include <tau/common/NetToHost.h>
+#include <limits>
+#include <cstring>
+
+namespace tau::rtp::session {
+
+TwccReceiver::TwccReceiver(Dependencies&& deps, Options&& options)
+    : _deps(std::move(deps))
+    , _options(std::move(options))
+    , _arrivals(kHistorySize)
+    , _last_feedback_tp(_deps.clock.Now())
+{}
+
+void TwccReceiver::Recv(const BufferViewConst& rtp_packet) {
+    const auto element = ExtensionReader::Find(Reader(rtp_packet).Extensions(), _options.extension_id);
+    if(!element || (element->size != sizeof(uint16_t))) {
+        return;
+    }
+    const auto sn = Read16(element->ptr);
+    const auto now = _deps.clock.Now();
+
+    if(!_sn_begin) {
+        _sn_begin = sn;
+        _sn_end = sn;
+    }
+    if(SnLesser(sn, *_sn_begin)) {
+        return; // already reported
+    }
+    if(!SnLesser(sn, _sn_end)) {
+        const auto sn_end = SnForward(sn, 1);
+        const auto gap = std::min<size_t>(SnDelta(sn_end, _sn_end), kHistorySize);
+        for(size_t i = 0; i < gap; ++i) {
+            _arrivals[SnBackward(sn_end, i + 1) % kHistorySize].reset();
+        }
+        _sn_end = sn_end;
+        if(SnDelta(_sn_end, *_sn_begin) > kHistorySize) {
+            _sn_begin = SnBackward(_sn_end, kHistorySize);
+        }
+    }
+    _arrivals[sn % kHistorySize] = now;
+}
+
+void TwccReceiver::Clear(Buffer& rtp_packet) const {
+    const auto view = rtp_packet.GetView();
+    const auto element = ExtensionReader::Find(Reader(ToConst(view)).Extensions(), _options.extension_id);
+    if(element) {
+        std::memset(view.ptr + (element->ptr - view.ptr), 0, element->size);
+    }
+}
+
+bool TwccReceiver::WriteFeedback(rtcp::Writer& writer, uint32_t sender_ssrc, uint32_t media_ssrc) {
+    const auto deadline = GetNextDeadline();
+    const auto now = _deps.clock.Now();
+    if(!deadline || (now < *deadline)) {
+        return false;
+    }
+
+    const auto count = std::min(GetPendingCount(), kMaxStatusCount);
+    std::optional<Timepoint> reference_tp;
+    for(size_t i = 0; (i < count) && !reference_tp; ++i) {
+        reference_tp = _arrivals[SnForward(*_sn_begin, i) % kHistorySize];
+    }
+    if(!reference_tp) {
+        _sn_begin = SnForward(*_sn_begin, count); // nothing is received in the range, it's skipped
+        return false;
+    }
+
+    constexpr auto kReferenceTimeUnit = rtcp::kTwccReferenceTimeUnitUs * kMicro;
+    constexpr auto kDeltaUnit = rtcp::kTwccDeltaUnitUs * kMicro;
+    const auto reference_time = *reference_tp / kReferenceTimeUnit;
+    rtcp::TwccFeedback feedback{
+        .base_sn = *_sn_begin,
+        .fb_count = _fb_count,
+        .reference_time = static_cast<int32_t>(static_cast<uint32_t>(reference_time) << 8) >> 8,
+        .deltas = {}
+    };
+    auto prev = static_cast<int64_t>(reference_time * (kReferenceTimeUnit / kDeltaUnit));
+    for(size_t i = 0; i < count; ++i) {
+        const auto& arrival = _arrivals[SnForward(*_sn_begin, i) % kHistorySize];
+        if(arrival) {
+            const auto delta = std::clamp<int64_t>(static_cast<int64_t>(*arrival / kDeltaUnit) - prev,
+                std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max());
+            feedback.deltas.push_back(static_cast<int16_t>(delta));
+            prev += delta;
+        } else {
+            feedback.deltas.push_back(std::nullopt);
+        }
+    }
+    if(!rtcp::TwccWriter::Write(writer, sender_ssrc, media_ssrc, feedback)) {
+        return false;
+    }
+    _sn_begin = SnForward(*_sn_begin, count);
+    _fb_count++;
+    _last_feedback_tp = now;
+    return true;
+}
+
+std::optional<Timepoint> TwccReceiver::GetNextDeadline() const {
+    const auto pending = GetPendingCount();
+    if(pending == 0) {
+        return std::nullopt;
+    }
+    if(pending >= kMaxStatusCount) {
+        return _last_feedback_tp;
+    }
+    return _last_feedback_tp + kFeedbackPeriod;
+}
+
+size_t TwccReceiver::GetPendingCount() const {
+    return _sn_begin ? SnDelta(_sn_end, *_sn_begin) : 0;
+}
+
+}
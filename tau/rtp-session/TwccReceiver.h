@@ -0,0 +1,52 @@
+#pragma once
+
+#include <tau/rtcp/Writer.h>
+#include <tau/common/Clock.h>
+#include <tau/memory/Buffer.h>
+#include <vector>
+#include <optional>
+
+namespace tau::rtp::session {
+
+// Arrival times of incoming RTP packets by transport-wide sn, reported by RTCP transport-cc feedback.
+// One instance per transport (BUNDLE), shared by RTP sessions
+class TwccReceiver {
+public:
+    static constexpr size_t kHistorySize = 1024;
+    static constexpr size_t kMaxStatusCount = 256; // per feedback message
+    static constexpr Timepoint kFeedbackPeriod = 100 * kMs;
+
+    struct Dependencies {
+        Clock& clock;
+    };
+
+    struct Options {
+        uint8_t extension_id;
+    };
+
+public:
+    TwccReceiver(Dependencies&& deps, Options&& options);
+
+    void Recv(const BufferViewConst& rtp_packet);
+    // zeroes transport-wide sn (if any) before FEC decoding, it's written after FEC encoding (see TwccSender::Reserve)
+    void Clear(Buffer& rtp_packet) const;
+
+    // writes feedback if there are unreported packets and the feedback period is passed
+    bool WriteFeedback(rtcp::Writer& writer, uint32_t sender_ssrc, uint32_t media_ssrc);
+    std::optional<Timepoint> GetNextDeadline() const;
+
+private:
+    size_t GetPendingCount() const;
+
+private:
+    Dependencies _deps;
+    const Options _options;
+
+    std::vector<std::optional<Timepoint>> _arrivals;
+    std::optional<uint16_t> _sn_begin; // the first unreported
+    uint16_t _sn_end = 0;
+    Timepoint _last_feedback_tp;
+    uint8_t _fb_count = 0;
+};
+
+}
@@ -0,0 +1,85 @@
+#include <tau/rtp-session/TwccSender.h>
+#include <tau/rtp/Extension.h>
+#include <tau/rtcp/TwccReader.h>
+#include <tau/common/NetToHost.h>
+#include <tau/common/Log.h>
+
+namespace tau::rtp::session {
+
+TwccSender::TwccSender(Dependencies&& deps, Options&& options)
+    : _deps(std::move(deps))
+    , _options(std::move(options))
+    , _history(kHistorySize)
+    , _estimator(DelayBasedEstimator::Options(_options.estimator)) {
+    _results.reserve(rtcp::kTwccMaxStatusCount);
+}
+
+bool TwccSender::Stamp(Buffer& rtp_packet) {
+    uint8_t data[sizeof(uint16_t)];
+    Write16(data, _sn);
+    if(!ExtensionWriter::Set(rtp_packet, _options.extension_id, BufferViewConst{.ptr = data, .size = sizeof(data)})) {
+        TAU_LOG_WARNING_THR(128, "Can't write transport-wide sn, size: " << rtp_packet.GetSize() << ", tailroom: " << rtp_packet.GetTailroom());
+        return false;
+    }
+    _history[_sn % kHistorySize] = Packet{
+        .send_tp = _deps.clock.Now(),
+        .size = rtp_packet.GetSize(),
+        .sn = _sn,
+        .sent = true
+    };
+    _sn++;
+    _stats.stamped++;
+    return true;
+}
+
+bool TwccSender::Reserve(Buffer& rtp_packet) {
+    const uint8_t data[sizeof(uint16_t)] = {};
+    if(!ExtensionWriter::Set(rtp_packet, _options.extension_id, BufferViewConst{.ptr = data, .size = sizeof(data)})) {
+        TAU_LOG_WARNING_THR(128, "Can't reserve transport-wide sn, size: " << rtp_packet.GetSize() << ", tailroom: " << rtp_packet.GetTailroom());
+        return false;
+    }
+    return true;
+}
+
+void TwccSender::OnFeedback(const BufferViewConst& report) {
+    const auto feedback = rtcp::TwccReader::GetFeedback(report);
+    if(!feedback) {
+        return;
+    }
+    _stats.feedbacks++;
+
+    // 24-bit reference time wraps every ~12 days
+    if(_reference_time) {
+        const auto delta = static_cast<int32_t>(static_cast<uint32_t>(feedback->reference_time - *_reference_time) << 8) >> 8;
+        *_reference_time += delta;
+    } else {
+        _reference_time = feedback->reference_time & 0xFFFFFF;
+    }
+
+    constexpr auto kDeltaUnit = static_cast<int64_t>(rtcp::kTwccDeltaUnitUs * kMicro);
+    auto recv_time = *_reference_time * static_cast<int64_t>(rtcp::kTwccReferenceTimeUnitUs * kMicro);
+    _results.clear();
+    uint16_t sn = feedback->base_sn;
+    for(auto& delta : feedback->deltas) {
+        const auto& packet = _history[sn % kHistorySize];
+        std::optional<Timepoint> recv_tp;
+        if(delta) {
+            recv_time += *delta * kDeltaUnit;
+            recv_tp = static_cast<Timepoint>(std::max<int64_t>(recv_time, 0));
+            _stats.acked++;
+        } else {
+            _stats.lost++;
+        }
+        if(packet.sent && (packet.sn == sn)) {
+            _results.push_back(DelayBasedEstimator::PacketResult{
+                .send_tp = packet.send_tp,
+                .recv_tp = recv_tp,
+                .size = packet.size
+            });
+        }
+        sn++;
+    }
+    _estimator.Update(_results, _deps.clock.Now());
+}
+
+}
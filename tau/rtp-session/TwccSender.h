@@ -0,0 +1,64 @@
+#pragma once
+
+#include <tau/rtp-session/DelayBasedEstimator.h>
+#include <tau/memory/Buffer.h>
+#include <vector>
+
+namespace tau::rtp::session {
+
+// Transport-wide sequence numbering of outgoing RTP packets and sender-side bandwidth estimation
+// by RTCP transport-cc feedback. One instance per transport (BUNDLE), shared by RTP sessions
+class TwccSender {
+public:
+    static constexpr size_t kHistorySize = 1024;
+
+    struct Dependencies {
+        Clock& clock;
+    };
+
+    struct Options {
+        uint8_t extension_id;
+        DelayBasedEstimator::Options estimator = {};
+    };
+
+    struct Stats {
+        uint64_t stamped = 0;
+        uint64_t feedbacks = 0;
+        uint64_t acked = 0;
+        uint64_t lost = 0;
+    };
+
+public:
+    TwccSender(Dependencies&& deps, Options&& options);
+
+    // writes transport-wide sn header extension, call it right before sending (RTX too)
+    bool Stamp(Buffer& rtp_packet);
+    // zeroed transport-wide sn before FEC encoding, the packet is protected as it's seen by TwccReceiver::Clear
+    bool Reserve(Buffer& rtp_packet);
+    void OnFeedback(const BufferViewConst& report);
+
+    uint32_t GetTargetBitrate() const { return _estimator.GetTargetBitrate(); }
+    const DelayBasedEstimator& GetEstimator() const { return _estimator; }
+    const Stats& GetStats() const { return _stats; }
+
+private:
+    Dependencies _deps;
+    const Options _options;
+
+    uint16_t _sn = 0;
+    struct Packet {
+        Timepoint send_tp = 0;
+        size_t size = 0;
+        uint16_t sn = 0;
+        bool sent = false;
+    };
+    std::vector<Packet> _history;
+
+    std::optional<int64_t> _reference_time; // unwrapped 24-bit reference time of the last feedback
+    std::vector<DelayBasedEstimator::PacketResult> _results;
+    DelayBasedEstimator _estimator;
+
+    Stats _stats;
+};
+
+}
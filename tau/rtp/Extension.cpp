@@ -0,0 +1,121 @@
+#include "tau/rtp/Extension.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/Constants.h"
+#include "tau/rtp/details/FixedHeader.h"
+#include "tau/common/NetToHost.h"
+#include <cstring>
+
+namespace tau::rtp {
+
+using namespace detail;
+
+namespace {
+
+constexpr uint8_t kPaddingByte = 0;
+constexpr uint8_t kReservedId = 15;
+
+// calls callback(id, data) for every element, stops on callback's false
+template<typename Callback>
+void ForEachElement(const BufferViewConst& extensions, Callback&& callback) {
+    if((extensions.size < kExtensionHeaderSize) || (Read16(extensions.ptr) != kOneByteExtensionProfile)) {
+        return;
+    }
+    auto ptr = extensions.ptr + kExtensionHeaderSize;
+    const auto end = extensions.ptr + extensions.size;
+    while(ptr < end) {
+        if(*ptr == kPaddingByte) {
+            ptr++;
+            continue;
+        }
+        const uint8_t id = *ptr >> 4;
+        const size_t size = (*ptr & 0x0F) + 1;
+        if((id == kReservedId) || (ptr + 1 + size > end)) {
+            return;
+        }
+        if(!callback(id, BufferViewConst{.ptr = ptr + 1, .size = size})) {
+            return;
+        }
+        ptr += 1 + size;
+    }
+}
+
+}
+
+std::optional<BufferViewConst> ExtensionReader::Find(const BufferViewConst& extensions, uint8_t id) {
+    std::optional<BufferViewConst> result;
+    ForEachElement(extensions, [&](uint8_t element_id, const BufferViewConst& data) {
+        if(element_id == id) {
+            result = data;
+            return false;
+        }
+        return true;
+    });
+    return result;
+}
+
+size_t ExtensionWriter::Write(BufferView extension, size_t offset, uint8_t id, const BufferViewConst& data) {
+    if((id == 0) || (id > kOneByteExtensionIdMax) || (data.size == 0) || (data.size > kOneByteExtensionDataMaxSize)) {
+        return 0;
+    }
+    if(offset + 1 + data.size > extension.size) {
+        return 0;
+    }
+    extension.ptr[offset] = static_cast<uint8_t>((id << 4) | (data.size - 1));
+    std::memcpy(extension.ptr + offset + 1, data.ptr, data.size);
+    return 1 + data.size;
+}
+
+bool ExtensionWriter::Set(Buffer& rtp_packet, uint8_t id, const BufferViewConst& data) {
+    auto view = rtp_packet.GetView();
+    const auto reader = Reader(ToConst(view));
+    const auto extensions = reader.Extensions();
+    if(auto element = ExtensionReader::Find(extensions, id)) {
+        if(element->size != data.size) {
+            return false;
+        }
+        std::memcpy(const_cast<uint8_t*>(element->ptr), data.ptr, data.size);
+        return true;
+    }
+
+    const auto header = reinterpret_cast<const FixedHeader*>(view.ptr);
+    const bool has_extension = header->x;
+    const size_t extension_offset = kFixedHeaderSize + header->cc * sizeof(uint32_t);
+    size_t used_size = 0;
+    if(has_extension) {
+        if(Read16(extensions.ptr) != kOneByteExtensionProfile) {
+            return false; // two-byte header extensions aren't supported
+        }
+        ForEachElement(extensions, [&](uint8_t, const BufferViewConst& element) {
+            used_size = static_cast<size_t>(element.ptr + element.size - extensions.ptr) - kExtensionHeaderSize;
+            return true;
+        });
+    }
+
+    // the element is appended to the used part, the extension is grown by whole words
+    const size_t current_size = has_extension ? (extensions.size - kExtensionHeaderSize) : 0;
+    const size_t required_size = used_size + 1 + data.size;
+    const size_t new_size = (required_size + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t);
+    const size_t grow_size = (new_size > current_size ? new_size - current_size : 0) + (has_extension ? 0 : kExtensionHeaderSize);
+    if(grow_size > rtp_packet.GetTailroom()) {
+        return false;
+    }
+
+    const auto payload_offset = extension_offset + (has_extension ? extensions.size : 0);
+    if(grow_size) {
+        auto capacity_view = rtp_packet.GetViewWithCapacity();
+        std::memmove(capacity_view.ptr + payload_offset + grow_size, capacity_view.ptr + payload_offset, view.size - payload_offset);
+        rtp_packet.SetSize(view.size + grow_size);
+        view = rtp_packet.GetView();
+    }
+    auto extension = BufferView{
+        .ptr = view.ptr + extension_offset + kExtensionHeaderSize,
+        .size = std::max(current_size, new_size)
+    };
+    std::memset(extension.ptr + used_size, 0, extension.size - used_size);
+    Write16(view.ptr + extension_offset, kOneByteExtensionProfile);
+    Write16(view.ptr + extension_offset + sizeof(uint16_t), static_cast<uint16_t>(extension.size / sizeof(uint32_t)));
+    reinterpret_cast<FixedHeader*>(view.ptr)->x = 1;
+    return (Write(extension, used_size, id, data) > 0);
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "tau/memory/Buffer.h"
+#include <optional>
+
+namespace tau::rtp {
+
+// RFC 8285 one-byte header extensions: 0xBEDE profile, element = [id:4 | length-1:4][data], ids 1..14
+inline constexpr uint16_t kOneByteExtensionProfile = 0xBEDE;
+inline constexpr uint8_t kOneByteExtensionIdMax = 14;
+inline constexpr size_t kOneByteExtensionDataMaxSize = 16;
+
+class ExtensionReader {
+public:
+    // extensions is Reader::Extensions() view (with extension header)
+    static std::optional<BufferViewConst> Find(const BufferViewConst& extensions, uint8_t id);
+};
+
+class ExtensionWriter {
+public:
+    // writes element to Writer::Result::extension, returns written size (0 if there is no space)
+    static size_t Write(BufferView extension, size_t offset, uint8_t id, const BufferViewConst& data);
+
+    // updates element data in-place or appends it, RTP payload is moved if header extension grows
+    static bool Set(Buffer& rtp_packet, uint8_t id, const BufferViewConst& data);
+};
+
+}
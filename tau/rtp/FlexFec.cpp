@@ -0,0 +1,126 @@
+#include "tau/rtp/FlexFec.h"
+#include "tau/rtp/Constants.h"
+#include "tau/common/NetToHost.h"
+#include <cstring>
+
+namespace tau::rtp {
+
+namespace {
+
+constexpr size_t kSnBaseSize = sizeof(uint16_t);
+constexpr size_t kMaskSize0 = 15;
+constexpr size_t kMaskSize1 = 46;
+
+}
+
+size_t FlexFec::GetHeaderSize(size_t mask_size) {
+    constexpr auto kBaseSize = kRecoveryFieldsSize + kSnBaseSize;
+    if(mask_size <= kMaskSize0) {
+        return kBaseSize + sizeof(uint16_t);
+    }
+    if(mask_size <= kMaskSize1) {
+        return kBaseSize + sizeof(uint16_t) + sizeof(uint32_t);
+    }
+    return kBaseSize + sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint64_t);
+}
+
+void FlexFec::WriteHeader(uint8_t* payload, uint16_t sn_base, const Mask& mask, size_t header_size) {
+    Write16(payload + kRecoveryFieldsSize, sn_base);
+    auto ptr = payload + kRecoveryFieldsSize + kSnBaseSize;
+
+    uint16_t mask0 = (header_size == GetHeaderSize(kMaskSize0)) ? 0x8000 : 0;
+    for(size_t i = 0; i < kMaskSize0; ++i) {
+        mask0 |= mask[i] ? (1 << (kMaskSize0 - 1 - i)) : 0;
+    }
+    Write16(ptr, mask0);
+    if(mask0 & 0x8000) {
+        return;
+    }
+
+    uint32_t mask1 = (header_size == GetHeaderSize(kMaskSize1)) ? 0x80000000 : 0;
+    for(size_t i = kMaskSize0; i < kMaskSize1; ++i) {
+        mask1 |= mask[i] ? (1u << (kMaskSize1 - 1 - i)) : 0;
+    }
+    Write32(ptr + sizeof(uint16_t), mask1);
+    if(mask1 & 0x80000000) {
+        return;
+    }
+
+    uint64_t mask2 = 0;
+    for(size_t i = kMaskSize1; i < kMaxMaskSize; ++i) {
+        mask2 |= mask[i] ? (1ull << (kMaxMaskSize - 1 - i)) : 0;
+    }
+    Write64(ptr + sizeof(uint16_t) + sizeof(uint32_t), mask2);
+}
+
+std::optional<FlexFec::Header> FlexFec::ReadHeader(const BufferViewConst& payload) {
+    if(payload.size < GetHeaderSize(kMaskSize0)) {
+        return std::nullopt;
+    }
+    if(payload.ptr[0] & 0xC0) {
+        return std::nullopt; // retransmission or fixed mask aren't supported
+    }
+    Header header{
+        .sn_base = Read16(payload.ptr + kRecoveryFieldsSize),
+        .mask = {},
+        .size = GetHeaderSize(kMaskSize0)
+    };
+    const auto ptr = payload.ptr + kRecoveryFieldsSize + kSnBaseSize;
+
+    const auto mask0 = Read16(ptr);
+    for(size_t i = 0; i < kMaskSize0; ++i) {
+        header.mask[i] = (mask0 >> (kMaskSize0 - 1 - i)) & 1;
+    }
+    if(mask0 & 0x8000) {
+        return header;
+    }
+
+    header.size = GetHeaderSize(kMaskSize1);
+    if(payload.size < header.size) {
+        return std::nullopt;
+    }
+    const auto mask1 = Read32(ptr + sizeof(uint16_t));
+    for(size_t i = kMaskSize0; i < kMaskSize1; ++i) {
+        header.mask[i] = (mask1 >> (kMaskSize1 - 1 - i)) & 1;
+    }
+    if(mask1 & 0x80000000) {
+        return header;
+    }
+
+    header.size = GetHeaderSize(kMaxMaskSize);
+    if(payload.size < header.size) {
+        return std::nullopt;
+    }
+    const auto mask2 = Read64(ptr + sizeof(uint16_t) + sizeof(uint32_t));
+    for(size_t i = kMaskSize1; i < kMaxMaskSize; ++i) {
+        header.mask[i] = (mask2 >> (kMaxMaskSize - 1 - i)) & 1;
+    }
+    return header;
+}
+
+void FlexFec::XorRecoveryFields(uint8_t* payload, const uint8_t* fixed_header, size_t packet_size) {
+    payload[0] ^= fixed_header[0];
+    payload[1] ^= fixed_header[1];
+    const auto length = static_cast<uint16_t>(packet_size - kFixedHeaderSize);
+    payload[2] ^= (length >> 8);
+    payload[3] ^= (length & 0xFF);
+    for(size_t i = 4; i < kRecoveryFieldsSize; ++i) {
+        payload[i] ^= fixed_header[i]; // TS
+    }
+}
+
+void FlexFec::XorData(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t i = 0;
+    for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t a, b;
+        std::memcpy(&a, dst + i, sizeof(a));
+        std::memcpy(&b, src + i, sizeof(b));
+        a ^= b;
+        std::memcpy(dst + i, &a, sizeof(a));
+    }
+    for(; i < size; ++i) {
+        dst[i] ^= src[i];
+    }
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "tau/memory/BufferView.h"
+#include <bitset>
+#include <optional>
+
+namespace tau::rtp {
+
+// RFC 8627 FlexFEC repair payload with flexible mask (R = 0, F = 0), single protected SSRC.
+// Payload is XOR of the protected packets: recovery fields (first byte bits, M/PT, length recovery, TS recovery)
+// followed by SN base and mask, then XOR of everything after the fixed RTP headers.
+// Protected SNs are SN base + indices of the set mask bits
+class FlexFec {
+public:
+    static constexpr size_t kRecoveryFieldsSize = 8;
+    static constexpr size_t kMaxMaskSize = 110; // 15, 46 or 110 bits in 2, 6 or 14 bytes with k-bits
+
+    using Mask = std::bitset<kMaxMaskSize>;
+
+    struct Header {
+        uint16_t sn_base;
+        Mask mask;
+        size_t size; // recovery fields, SN base and mask, protected data follows
+    };
+
+public:
+    static size_t GetHeaderSize(size_t mask_size);
+
+    // SN base and mask only, recovery fields are accumulated by XorRecoveryFields()
+    static void WriteHeader(uint8_t* payload, uint16_t sn_base, const Mask& mask, size_t header_size);
+    static std::optional<Header> ReadHeader(const BufferViewConst& payload);
+
+    // RTP fixed header of the protected packet with its full size
+    static void XorRecoveryFields(uint8_t* payload, const uint8_t* fixed_header, size_t packet_size);
+    static void XorData(uint8_t* dst, const uint8_t* src, size_t size);
+};
+
+}
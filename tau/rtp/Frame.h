@@ -5,7 +5,9 @@
 
 namespace tau::rtp {
 
-//TODO: Huge key-frames could exceed capacity, so we have to process frames by chucks correctly
-using Frame = etl::vector<Buffer, 128>;
+// RTP packets of a frame. Huge frames (e.g. 4K key-frames) exceed the capacity, they are passed by chunks
+// of kFrameChunkSize packets (see FrameProcessor::SetChunkCallback, H264Depacketizer::ProcessChunk)
+inline constexpr size_t kFrameChunkSize = 128;
+using Frame = etl::vector<Buffer, kFrameChunkSize>;
 
 }
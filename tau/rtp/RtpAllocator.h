@@ -11,6 +11,13 @@ namespace tau::rtp {
 
 class RtpAllocator {
 public:
+    static constexpr size_t kTurnHeadroom = 4; // TURN ChannelData header is written in place before the packet
+    static constexpr size_t kTurnTailroom = 3; // ChannelData padding to 4 bytes over TCP/TLS
+    // TURN Send indication (fallback before ChannelBind and for not selected pairs) is written to a new buffer:
+    // STUN header, XOR-PEER-ADDRESS, DATA header and padding
+    static constexpr size_t kTurnSendIndicationSize = 20 + 12 + 4 + 3;
+    static_assert(kTurnHeadroom + kTurnTailroom <= kTurnSendIndicationSize);
+
     struct Options {
         Writer::Options header;
         Timepoint base_tp;
@@ -30,6 +37,7 @@ public:
 
     Buffer Allocate(Timepoint tp, bool marker = false) {
         auto packet = Buffer::Create(_pool, Buffer::Info{.tp = tp});
+        packet.ReserveHeadroom(kTurnHeadroom);
         _options.header.ts = _ts_producer.FromTp(tp);
         _options.header.marker = marker;
         auto result = Writer::Write(packet.GetViewWithCapacity(), _options.header);
@@ -44,17 +52,16 @@ public:
     }
 
     void Deallocate(Buffer&& buffer) {
-        _pool.Deallocate(buffer.GetView().ptr);
+        [[maybe_unused]] auto released = std::move(buffer); // block is returned to the pool by Buffer itself
     }
 
     //TODO: GetBaseTp
 
-    size_t MaxRtpPayload() const { //TODO: TURN, SRTP, MTU options
+    size_t MaxRtpPayload() const { //TODO: SRTP, MTU options
         constexpr size_t kSrtpMaxAuthSize = 16;
-        constexpr size_t kTurnMessageHeaderSize = 20 + 12; // Header + XOR-MAPPED-ADDRESS(IpV4)
-        return _pool.GetChunkSize() - kFixedHeaderSize
+        return _pool.GetChunkSize() - kTurnSendIndicationSize - kFixedHeaderSize
                - HeaderExtensionSize(_options.header.extension_length_in_words)
-               - kSrtpMaxAuthSize - kTurnMessageHeaderSize;
+               - kSrtpMaxAuthSize;
     }
 
 private:
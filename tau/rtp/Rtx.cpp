@@ -0,0 +1,62 @@
+#include "tau/rtp/Rtx.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/details/FixedHeader.h"
+#include "tau/common/NetToHost.h"
+#include <cstring>
+
+namespace tau::rtp {
+
+using namespace detail;
+
+namespace {
+
+void WriteHeader(BufferView view, uint8_t pt, uint32_t ssrc, uint16_t sn) {
+    view.ptr[1] = (view.ptr[1] & 0x80) | (pt & 0x7F);
+    Write16(view.ptr + sizeof(uint16_t), sn);
+    Write32(view.ptr + 2 * sizeof(uint32_t), ssrc);
+    reinterpret_cast<FixedHeader*>(view.ptr)->p = 0;
+}
+
+}
+
+bool Rtx::Wrap(Buffer& rtp_packet, uint8_t rtx_pt, uint32_t rtx_ssrc, uint16_t rtx_sn) {
+    auto view = rtp_packet.GetView();
+    if(!Reader::Validate(ToConst(view))) {
+        return false;
+    }
+    const auto reader = Reader(ToConst(view));
+    const auto payload = reader.Payload();
+    const auto payload_offset = static_cast<size_t>(payload.ptr - view.ptr);
+    const auto size_without_padding = payload_offset + payload.size;
+    if(size_without_padding + kRtxOsnSize > view.size + rtp_packet.GetTailroom()) {
+        return false;
+    }
+
+    const auto osn = reader.Sn();
+    auto capacity_view = rtp_packet.GetViewWithCapacity();
+    std::memmove(capacity_view.ptr + payload_offset + kRtxOsnSize, capacity_view.ptr + payload_offset, payload.size);
+    Write16(capacity_view.ptr + payload_offset, osn);
+    WriteHeader(capacity_view, rtx_pt, rtx_ssrc, rtx_sn);
+    rtp_packet.SetSize(size_without_padding + kRtxOsnSize);
+    return true;
+}
+
+bool Rtx::Unwrap(Buffer& rtx_packet, uint8_t pt, uint32_t ssrc) {
+    auto view = rtx_packet.GetView();
+    if(!Reader::Validate(ToConst(view))) {
+        return false;
+    }
+    const auto reader = Reader(ToConst(view));
+    const auto payload = reader.Payload();
+    if(payload.size < kRtxOsnSize) {
+        return false;
+    }
+    const auto payload_offset = static_cast<size_t>(payload.ptr - view.ptr);
+    const auto osn = Read16(payload.ptr);
+    std::memmove(view.ptr + payload_offset, view.ptr + payload_offset + kRtxOsnSize, payload.size - kRtxOsnSize);
+    WriteHeader(view, pt, ssrc, osn);
+    rtx_packet.SetSize(payload_offset + payload.size - kRtxOsnSize);
+    return true;
+}
+
+}
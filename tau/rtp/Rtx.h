@@ -0,0 +1,20 @@
+#pragma once
+
+#include "tau/memory/Buffer.h"
+
+namespace tau::rtp {
+
+// RFC 4588 retransmission payload format: RTX stream has own SSRC, PT and sn,
+// the original sn (OSN) prefixes the original payload, padding is removed
+inline constexpr size_t kRtxOsnSize = sizeof(uint16_t);
+
+class Rtx {
+public:
+    // converts the original packet in-place, requires kRtxOsnSize of tailroom
+    static bool Wrap(Buffer& rtp_packet, uint8_t rtx_pt, uint32_t rtx_ssrc, uint16_t rtx_sn);
+
+    // restores the original packet in-place with the given original PT and SSRC
+    static bool Unwrap(Buffer& rtx_packet, uint8_t pt, uint32_t ssrc);
+};
+
+}
@@ -1,4 +1,5 @@
 #include "tau/sdp/Media.h"
+#include "tau/common/String.h"
 #include <algorithm>
 
 namespace tau::sdp {
@@ -29,6 +30,65 @@ etl::vector<PtWithPriority, kMaxCodecs> GetPtWithPriority(const CodecsMap& codec
     return pts;
 }
 
+bool IsRtx(const Codec& codec) {
+    return codec.name == "rtx";
+}
+
+std::optional<uint8_t> GetRtxPt(const CodecsMap& codecs, uint8_t pt) {
+    auto it = codecs.find(pt);
+    if((it != codecs.end()) && it->second.rtx_pt) {
+        return it->second.rtx_pt;
+    }
+    for(auto& [rtx_pt, codec] : codecs) {
+        if(IsRtx(codec)) {
+            SplitTokens<2> apt;
+            Split(apt, codec.format, "apt=");
+            if((apt.size() == 2) && (StringToUnsigned<uint8_t>(apt[1]) == pt)) {
+                return rtx_pt;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+bool HasRtx(const Media& media) {
+    for(auto& [_, codec] : media.codecs) {
+        if(IsRtx(codec) || codec.rtx_pt) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IsFec(const Codec& codec) {
+    return codec.name == "flexfec-03";
+}
+
+std::optional<uint8_t> GetFecPt(const Media& media) {
+    if(media.fec_pt) {
+        return media.fec_pt;
+    }
+    for(auto& [pt, codec] : media.codecs) {
+        if(IsFec(codec)) {
+            return pt;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<size_t> GetSimulcastLayer(const Media& media, etl::string_view rid) {
+    if(!media.simulcast) {
+        return std::nullopt;
+    }
+    const auto& rids = media.simulcast->rids;
+    for(size_t i = 0; i < rids.size(); ++i) {
+        if(rids[i] == rid) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
 CodecsMap MakeCodecsMap(std::initializer_list<std::pair<const uint8_t, Codec>> list) {
     CodecsMap result;
     for(auto&& p : list) {
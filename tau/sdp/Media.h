@@ -18,10 +18,26 @@ enum RtcpFb : uint8_t {
     kNack = 1,
     kPli  = 2,
     kFir  = 4,
-    // kTwcc = 8, //TODO: impl transport-cc
+    kTwcc = 8, // transport-cc
 };
 inline constexpr uint8_t kRtcpFbDefault = RtcpFb::kNack | RtcpFb::kPli | RtcpFb::kFir;
 
+inline constexpr etl::string_view kTwccExtensionUri{"http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01"};
+inline constexpr etl::string_view kMidExtensionUri{"urn:ietf:params:rtp-hdrext:sdes:mid"};
+inline constexpr etl::string_view kRidExtensionUri{"urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id"};
+inline constexpr etl::string_view kRepairedRidExtensionUri{"urn:ietf:params:rtp-hdrext:sdes:repaired-rtp-stream-id"};
+
+inline constexpr size_t kMaxSimulcastLayers = 4;
+
+using Rid = etl::string<16>;
+using Rids = etl::vector<Rid, kMaxSimulcastLayers>;
+
+// RFC 8853: a=rid:<rid> send|recv and a=simulcast:send|recv <rid>;<rid>..., layers are indexed in a=simulcast order
+struct Simulcast {
+    Direction direction = Direction::kSend;
+    Rids rids = {};
+};
+
 struct Codec {
     using Name = etl::string<16>;
     using Format = etl::string<128>;
@@ -31,6 +47,7 @@ struct Codec {
     uint32_t clock_rate = 0;
     uint8_t rtcp_fb = 0;
     Format format = {};
+    std::optional<uint8_t> rtx_pt = std::nullopt; // RFC 4588 retransmission pt, written as an "rtx" codec with apt=<pt>
 };
 
 using CodecsMap = etl::unordered_map<uint8_t, Codec, kMaxCodecs>;
@@ -40,10 +57,19 @@ struct Media {
     Mid mid = {};
     Direction direction = Direction::kSendRecv;
     CodecsMap codecs = {};
-    std::optional<uint32_t> ssrc = std::nullopt; //NOTE: should be revised for the case of several streams: video and rtx
+    std::optional<uint32_t> ssrc = std::nullopt; // simulcast streams are identified by RID header extension
+    std::optional<uint8_t> twcc_extension_id = std::nullopt; // a=extmap with kTwccExtensionUri
+    std::optional<uint32_t> rtx_ssrc = std::nullopt; // a=ssrc-group:FID <ssrc> <rtx_ssrc>
+    std::optional<uint8_t> mid_extension_id = std::nullopt;
+    std::optional<uint8_t> rid_extension_id = std::nullopt;
+    std::optional<uint8_t> repaired_rid_extension_id = std::nullopt;
+    std::optional<Simulcast> simulcast = std::nullopt;
+    std::optional<uint8_t> fec_pt = std::nullopt; // RFC 8627 FlexFEC pt, written as a "flexfec-03" codec
+    std::optional<uint32_t> fec_ssrc = std::nullopt; // a=ssrc-group:FEC-FR <ssrc> <fec_ssrc>
 };
 
-using Medias = etl::vector<Media, 3>;
+inline constexpr size_t kMaxMedias = 3;
+using Medias = etl::vector<Media, kMaxMedias>;
 
 struct PtWithPriority {
     uint8_t pt;
@@ -52,6 +78,13 @@ struct PtWithPriority {
 etl::vector<uint8_t, kMaxCodecs> GetPtOrdered(const CodecsMap& codecs);
 etl::vector<PtWithPriority, kMaxCodecs> GetPtWithPriority(const CodecsMap& codecs);
 
+bool IsRtx(const Codec& codec);
+std::optional<uint8_t> GetRtxPt(const CodecsMap& codecs, uint8_t pt);
+bool HasRtx(const Media& media);
+bool IsFec(const Codec& codec);
+std::optional<uint8_t> GetFecPt(const Media& media);
+std::optional<size_t> GetSimulcastLayer(const Media& media, etl::string_view rid);
+
 CodecsMap MakeCodecsMap(std::initializer_list<std::pair<const uint8_t, Codec>> list);
 
 }
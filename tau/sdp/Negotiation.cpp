@@ -6,6 +6,9 @@ namespace tau::sdp {
 
 void SelectAudioMedia(Media& result, const Media& remote, const Media& local);
 void SelectVideoMedia(Media& result, const Media& remote, const Media& local);
+void SelectRtx(Media& result, const Media& remote, const Media& local);
+void SelectFec(Media& result, const Media& remote, const Media& local);
+void SelectSimulcast(Media& result, const Media& remote, const Media& local);
 bool SelectVideoMediaH265(Media& result, const Media& remote, const Media& local);
 bool SelectVideoMediaH264(Media& result, const Media& remote, const Media& local);
 etl::string<256> CreateH264Format(etl::string_view profile, etl::string_view level, bool asymmetry);
@@ -17,7 +20,9 @@ std::optional<Media> SelectMedia(const Media& remote, const Media& local) {
         .mid = remote.mid,
         .direction = SelectDirection(remote.direction, local.direction),
         .codecs = {},
-        .ssrc = local.ssrc
+        .ssrc = local.ssrc,
+        .twcc_extension_id = (remote.twcc_extension_id && local.twcc_extension_id) ? remote.twcc_extension_id : std::nullopt,
+        .rtx_ssrc = local.rtx_ssrc
     };
     if(media.type == MediaType::kAudio) {
         SelectAudioMedia(media, remote, local);
@@ -27,6 +32,11 @@ std::optional<Media> SelectMedia(const Media& remote, const Media& local) {
         //NOTE: not supported
         return std::nullopt;
     }
+    SelectRtx(media, remote, local);
+    if(media.type == MediaType::kVideo) {
+        SelectFec(media, remote, local);
+        SelectSimulcast(media, remote, local);
+    }
     return media;
 }
 
@@ -68,6 +78,43 @@ void SelectVideoMedia(Media& result, const Media& remote, const Media& local) {
     }
 }
 
+void SelectRtx(Media& result, const Media& remote, const Media& local) {
+    bool negotiated = false;
+    if(HasRtx(local)) {
+        for(auto& [pt, codec] : result.codecs) {
+            if(codec.rtcp_fb & RtcpFb::kNack) {
+                codec.rtx_pt = GetRtxPt(remote.codecs, pt);
+                negotiated |= codec.rtx_pt.has_value();
+            }
+        }
+    }
+    if(!negotiated) {
+        result.rtx_ssrc.reset();
+    }
+}
+
+void SelectFec(Media& result, const Media& remote, const Media& local) {
+    const auto remote_fec_pt = GetFecPt(remote);
+    if(GetFecPt(local) && remote_fec_pt) {
+        result.fec_pt = remote_fec_pt;
+        result.fec_ssrc = local.fec_ssrc;
+    }
+}
+
+void SelectSimulcast(Media& result, const Media& remote, const Media& local) {
+    auto select_id = [](const std::optional<uint8_t>& remote_id, const std::optional<uint8_t>& local_id) {
+        return (remote_id && local_id) ? remote_id : std::nullopt;
+    };
+    result.mid_extension_id = select_id(remote.mid_extension_id, local.mid_extension_id);
+    result.rid_extension_id = select_id(remote.rid_extension_id, local.rid_extension_id);
+    result.repaired_rid_extension_id = select_id(remote.repaired_rid_extension_id, local.repaired_rid_extension_id);
+
+    // the remote side sends the layers, so they are received with the same RIDs
+    if(remote.simulcast && (remote.simulcast->direction == Direction::kSend) && (result.direction & Direction::kRecv) && result.rid_extension_id) {
+        result.simulcast = Simulcast{.direction = Direction::kRecv, .rids = remote.simulcast->rids};
+    }
+}
+
 bool SelectVideoMediaH265(Media& result, const Media& remote, const Media& local) {
     const auto remote_h265_codecs = FilterH265Codec(remote.codecs);
     const auto local_h265_codecs = FilterH265Codec(local.codecs);
@@ -18,8 +18,12 @@ bool OnMedia(Sdp& sdp, const etl::string_view& value);
 bool OnAttributeRtpmap(Sdp& sdp, const etl::string_view& value);
 bool OnAttributeFmtp(Sdp& sdp, const etl::string_view& value);
 bool OnAttributeRtcpFb(Sdp& sdp, const etl::string_view& value);
+bool OnAttributeExtmap(Sdp& sdp, const etl::string_view& value);
 bool OnAttributeGroup(Sdp& sdp, const etl::string_view& value);
 bool OnAttributeSsrc(Sdp& sdp, const etl::string_view& value);
+bool OnAttributeSsrcGroup(Sdp& sdp, const etl::string_view& value);
+bool OnAttributeRid(Sdp& sdp, const etl::string_view& value);
+bool OnAttributeSimulcast(Sdp& sdp, const etl::string_view& value);
 bool OnAttributeCandidate(Sdp& sdp, const etl::string_view& value);
 bool OnAttributeIceUfrag(Sdp& sdp, const etl::string_view& value);
 bool OnAttributeIcePwd(Sdp& sdp, const etl::string_view& value);
@@ -39,6 +43,7 @@ SdpPtr ParseSdp(etl::string_view sdp_str) {
                 if(attr_type == "rtpmap")           { return OnAttributeRtpmap(*sdp, attr_value); }
                 else if(attr_type == "fmtp")        { return OnAttributeFmtp(*sdp, attr_value); }
                 else if(attr_type == "rtcp-fb")     { return OnAttributeRtcpFb(*sdp, attr_value); }
+                else if(attr_type == "extmap")      { return OnAttributeExtmap(*sdp, attr_value); }
                 else if(attr_type == "sendrecv")    { sdp->medias.back().direction = Direction::kSendRecv; }
                 else if(attr_type == "sendonly")    { sdp->medias.back().direction = Direction::kSend; }
                 else if(attr_type == "recvonly")    { sdp->medias.back().direction = Direction::kRecv; }
@@ -46,6 +51,9 @@ SdpPtr ParseSdp(etl::string_view sdp_str) {
                 else if(attr_type == "group")       { return OnAttributeGroup(*sdp, attr_value); }
                 else if(attr_type == "mid")         { sdp->medias.back().mid = attr_value; }
                 else if(attr_type == "ssrc")        { return OnAttributeSsrc(*sdp, attr_value); }
+                else if(attr_type == "ssrc-group")  { return OnAttributeSsrcGroup(*sdp, attr_value); }
+                else if(attr_type == "rid")         { return OnAttributeRid(*sdp, attr_value); }
+                else if(attr_type == "simulcast")   { return OnAttributeSimulcast(*sdp, attr_value); }
                 else if(attr_type == "candidate")   { return OnAttributeCandidate(*sdp, attr_value); }
                 else if(attr_type == "ice-ufrag")   { return OnAttributeIceUfrag(*sdp, attr_value); }
                 else if(attr_type == "ice-pwd")     { return OnAttributeIcePwd(*sdp, attr_value); }
@@ -76,7 +84,16 @@ etl::istring& WriteSdp(etl::istring& output, const Sdp& sdp, etl::string_view en
         ss << end_of_line;
     }
     for(auto& media : sdp.medias) {
-        const auto pts = GetPtOrdered(media.codecs);
+        auto pts = GetPtOrdered(media.codecs);
+        for(auto pt : GetPtOrdered(media.codecs)) {
+            const auto& rtx_pt = media.codecs.at(pt).rtx_pt;
+            if(rtx_pt && !media.codecs.contains(*rtx_pt) && !pts.full()) {
+                pts.push_back(*rtx_pt);
+            }
+        }
+        if(media.fec_pt && !media.codecs.contains(*media.fec_pt) && !pts.full()) {
+            pts.push_back(*media.fec_pt);
+        }
         switch(media.type) {
             case MediaType::kAudio:
                 ss << "m="; MediaWriter::Write(ss, MediaType::kAudio, 9, "UDP/TLS/RTP/SAVPF", pts); ss << end_of_line;
@@ -117,7 +134,22 @@ etl::istring& WriteSdp(etl::istring& output, const Sdp& sdp, etl::string_view en
             }
             ss << "a="; AttributeWriter::Write(ss, "fingerprint", "sha-256 "); ss << sdp.dtls->fingerprint_sha256 << end_of_line;
         }
+        if(media.twcc_extension_id) {
+            ss << "a=extmap:"; ExtmapWriter::Write(ss, *media.twcc_extension_id, kTwccExtensionUri); ss << end_of_line;
+        }
+        if(media.mid_extension_id) {
+            ss << "a=extmap:"; ExtmapWriter::Write(ss, *media.mid_extension_id, kMidExtensionUri); ss << end_of_line;
+        }
+        if(media.rid_extension_id) {
+            ss << "a=extmap:"; ExtmapWriter::Write(ss, *media.rid_extension_id, kRidExtensionUri); ss << end_of_line;
+        }
+        if(media.repaired_rid_extension_id) {
+            ss << "a=extmap:"; ExtmapWriter::Write(ss, *media.repaired_rid_extension_id, kRepairedRidExtensionUri); ss << end_of_line;
+        }
         for(auto pt : pts) {
+            if(!media.codecs.contains(pt)) {
+                continue; // rtx_pt and fec_pt are written separately
+            }
             const auto& codec = media.codecs.at(pt);
             const auto rtpmap_params = (codec.name == "opus") ? etl::string_view{"2"} : etl::string_view{};
             ss << "a=rtpmap:"; RtpmapWriter::Write(ss, pt, codec.name, codec.clock_rate, rtpmap_params); ss << end_of_line;
@@ -130,12 +162,49 @@ etl::istring& WriteSdp(etl::istring& output, const Sdp& sdp, etl::string_view en
             if(codec.rtcp_fb & RtcpFb::kFir) {
                 ss << "a=rtcp-fb:"; RtcpFbWriter::Write(ss, pt, "ccm fir"); ss << end_of_line;
             }
+            if(codec.rtcp_fb & RtcpFb::kTwcc) {
+                ss << "a=rtcp-fb:"; RtcpFbWriter::Write(ss, pt, "transport-cc"); ss << end_of_line;
+            }
             if(!codec.format.empty()) {
                 ss << "a=fmtp:"; FmtpWriter::Write(ss, pt, codec.format); ss << end_of_line;
             }
+            if(codec.rtx_pt && !media.codecs.contains(*codec.rtx_pt)) {
+                ss << "a=rtpmap:"; RtpmapWriter::Write(ss, *codec.rtx_pt, "rtx", codec.clock_rate, {}); ss << end_of_line;
+                etl::string<16> apt;
+                etl::string_stream apt_ss(apt);
+                apt_ss << "apt=" << static_cast<uint32_t>(pt);
+                ss << "a=fmtp:"; FmtpWriter::Write(ss, *codec.rtx_pt, apt); ss << end_of_line;
+            }
+        }
+        if(media.fec_pt && !media.codecs.contains(*media.fec_pt)) {
+            ss << "a=rtpmap:"; RtpmapWriter::Write(ss, *media.fec_pt, "flexfec-03", 90000, {}); ss << end_of_line;
+            ss << "a=fmtp:"; FmtpWriter::Write(ss, *media.fec_pt, "repair-window=10000000"); ss << end_of_line;
         }
         if(media.ssrc && !sdp.cname.empty()) {
+            if(media.rtx_ssrc) {
+                ss << "a=ssrc-group:FID " << *media.ssrc << " " << *media.rtx_ssrc << end_of_line;
+            }
+            if(media.fec_ssrc) {
+                ss << "a=ssrc-group:FEC-FR " << *media.ssrc << " " << *media.fec_ssrc << end_of_line;
+            }
             ss << "a=ssrc:" << *media.ssrc << " cname:" << sdp.cname << end_of_line;
+            if(media.rtx_ssrc) {
+                ss << "a=ssrc:" << *media.rtx_ssrc << " cname:" << sdp.cname << end_of_line;
+            }
+            if(media.fec_ssrc) {
+                ss << "a=ssrc:" << *media.fec_ssrc << " cname:" << sdp.cname << end_of_line;
+            }
+        }
+        if(media.simulcast && !media.simulcast->rids.empty()) {
+            const auto direction = (media.simulcast->direction == Direction::kRecv) ? "recv" : "send";
+            for(auto& rid : media.simulcast->rids) {
+                ss << "a=rid:" << rid << " " << direction << end_of_line;
+            }
+            ss << "a=simulcast:" << direction << " ";
+            for(size_t i = 0; i < media.simulcast->rids.size(); ++i) {
+                ss << (i ? ";" : "") << media.simulcast->rids[i];
+            }
+            ss << end_of_line;
         }
     }
     return output;
@@ -199,9 +268,31 @@ bool OnAttributeRtcpFb(Sdp& sdp, const etl::string_view& value) {
     auto& codecs = sdp.medias.back().codecs;
     auto& codec = codecs.at(pt);
     const auto rtcp_fb = RtcpFbReader::GetValue(value);
-    if(rtcp_fb == "nack")          { codec.rtcp_fb |= RtcpFb::kNack; }
-    else if(rtcp_fb == "nack pli") { codec.rtcp_fb |= RtcpFb::kPli; }
-    else if(rtcp_fb == "ccm fir")  { codec.rtcp_fb |= RtcpFb::kFir; }
+    if(rtcp_fb == "nack")              { codec.rtcp_fb |= RtcpFb::kNack; }
+    else if(rtcp_fb == "nack pli")     { codec.rtcp_fb |= RtcpFb::kPli; }
+    else if(rtcp_fb == "ccm fir")      { codec.rtcp_fb |= RtcpFb::kFir; }
+    else if(rtcp_fb == "transport-cc") { codec.rtcp_fb |= RtcpFb::kTwcc; }
+    return true;
+}
+
+bool OnAttributeExtmap(Sdp& sdp, const etl::string_view& value) {
+    if(sdp.medias.empty()) {
+        return false;
+    }
+    if(!ExtmapReader::Validate(value)) {
+        return true; // two-byte extensions aren't supported, skip them
+    }
+    const auto uri = ExtmapReader::GetUri(value);
+    auto& media = sdp.medias.back();
+    if(uri == kTwccExtensionUri) {
+        media.twcc_extension_id = ExtmapReader::GetId(value);
+    } else if(uri == kMidExtensionUri) {
+        media.mid_extension_id = ExtmapReader::GetId(value);
+    } else if(uri == kRidExtensionUri) {
+        media.rid_extension_id = ExtmapReader::GetId(value);
+    } else if(uri == kRepairedRidExtensionUri) {
+        media.repaired_rid_extension_id = ExtmapReader::GetId(value);
+    }
     return true;
 }
 
@@ -251,6 +342,111 @@ bool OnAttributeSsrc(Sdp& sdp, const etl::string_view& value) {
     return true;
 }
 
+bool OnAttributeSsrcGroup(Sdp& sdp, const etl::string_view& value) {
+    if(value.empty() || sdp.medias.empty()) {
+        return false;
+    }
+
+    SplitTokens<3> values;
+    Split(values, value, " ");
+    if((values.size() == 3) && ((values[0] == "FID") || (values[0] == "FEC-FR"))) {
+        const auto ssrc = StringToUnsigned<uint32_t>(values[1]);
+        const auto group_ssrc = StringToUnsigned<uint32_t>(values[2]);
+        if(!ssrc || !group_ssrc) {
+            return false;
+        }
+        auto& media = sdp.medias.back();
+        auto& media_group_ssrc = (values[0] == "FID") ? media.rtx_ssrc : media.fec_ssrc;
+        if(!media_group_ssrc) { // the first group only
+            media.ssrc = *ssrc;
+            media_group_ssrc = *group_ssrc;
+        }
+    }
+    return true;
+}
+
+std::optional<Direction> ParseSimulcastDirection(etl::string_view value) {
+    if(value == "send") {
+        return Direction::kSend;
+    }
+    if(value == "recv") {
+        return Direction::kRecv;
+    }
+    return std::nullopt;
+}
+
+// a=rid:<rid> send|recv [restrictions], the rid is a layer until a=simulcast sets the order
+bool OnAttributeRid(Sdp& sdp, const etl::string_view& value) {
+    if(value.empty() || sdp.medias.empty()) {
+        return false;
+    }
+
+    SplitTokens<3> values;
+    Split(values, value, " ");
+    if(values.size() < 2) {
+        return false;
+    }
+    const auto direction = ParseSimulcastDirection(values[1]);
+    if(!direction) {
+        return false;
+    }
+    if(values[0].size() > Rid::MAX_SIZE) {
+        return true; // the layer isn't supported, the rest of SDP is valid
+    }
+    auto& media = sdp.medias.back();
+    if(!media.simulcast) {
+        media.simulcast = Simulcast{.direction = *direction};
+    }
+    auto& rids = media.simulcast->rids;
+    if(!rids.full() && !GetSimulcastLayer(media, values[0])) {
+        rids.push_back(Rid{values[0]});
+    }
+    return true;
+}
+
+// a=simulcast:send 1,2;~3 recv 4 - the first alternative of each stream is used, paused streams are kept
+bool OnAttributeSimulcast(Sdp& sdp, const etl::string_view& value) {
+    if(value.empty() || sdp.medias.empty()) {
+        return false;
+    }
+
+    SplitTokens<4> values;
+    Split(values, value, " ");
+    if(values.size() < 2) {
+        return false;
+    }
+    const auto direction = ParseSimulcastDirection(values[0]);
+    if(!direction) {
+        return false;
+    }
+    Simulcast simulcast{.direction = *direction};
+    SplitTokens<kMaxSimulcastLayers> streams;
+    Split(streams, values[1], ";");
+    for(auto stream : streams) {
+        if(simulcast.rids.full()) {
+            break;
+        }
+        SplitTokens<1> alternatives;
+        Split(alternatives, stream, ",");
+        if(alternatives.empty()) {
+            continue;
+        }
+        auto rid = alternatives[0];
+        if(!rid.empty() && (rid[0] == '~')) {
+            rid.remove_prefix(1);
+        }
+        if(rid.empty()) {
+            return false;
+        }
+        if(rid.size() > Rid::MAX_SIZE) {
+            continue; // skipped as a=rid
+        }
+        simulcast.rids.push_back(Rid{rid});
+    }
+    sdp.medias.back().simulcast = std::move(simulcast);
+    return true;
+}
+
 bool OnAttributeCandidate(Sdp& sdp, const etl::string_view& value) {
     if(!CandidateReader::Validate(value)) {
         return false;
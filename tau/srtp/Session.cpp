@@ -46,8 +46,32 @@ bool Session::IsValid() const {
 }
 
 bool Session::Encrypt(Buffer&& packet, bool is_rtp) {
+    if(!Protect(packet, is_rtp)) {
+        return false;
+    }
+    _callback(std::move(packet), is_rtp);
+    return true;
+}
+
+bool Session::Decrypt(Buffer&& packet, bool is_rtp) {
+    if(!Unprotect(packet, is_rtp)) {
+        return false;
+    }
+    _callback(std::move(packet), is_rtp);
+    return true;
+}
+
+size_t Session::EncryptBatch(std::span<Buffer> packets, bool is_rtp) {
+    return ProcessBatch(packets, is_rtp, &Session::Protect);
+}
+
+size_t Session::DecryptBatch(std::span<Buffer> packets, bool is_rtp) {
+    return ProcessBatch(packets, is_rtp, &Session::Unprotect);
+}
+
+bool Session::Protect(Buffer& packet, bool is_rtp) {
     auto view = packet.GetView();
-    size_t encrypted_size = packet.GetCapacity();
+    size_t encrypted_size = packet.GetViewWithCapacity().size;
     if(is_rtp) {
         if(auto error = srtp_protect(_session, view.ptr, view.size, view.ptr, &encrypted_size, 0)) {
             TAU_LOG_WARNING_THR(64, _log_ctx << "srtp_protect failed, error: " << error);
@@ -60,11 +84,10 @@ bool Session::Encrypt(Buffer&& packet, bool is_rtp) {
         }
     }
     packet.SetSize(encrypted_size);
-    _callback(std::move(packet), is_rtp);
     return true;
 }
 
-bool Session::Decrypt(Buffer&& packet, bool is_rtp) {
+bool Session::Unprotect(Buffer& packet, bool is_rtp) {
     auto view = packet.GetView();
     size_t decrypted_size = view.size;
     if(is_rtp) {
@@ -79,8 +102,30 @@ bool Session::Decrypt(Buffer&& packet, bool is_rtp) {
         }
     }
     packet.SetSize(decrypted_size);
-    _callback(std::move(packet), is_rtp);
     return true;
 }
 
+size_t Session::ProcessBatch(std::span<Buffer> packets, bool is_rtp, bool (Session::*process)(Buffer&, bool)) {
+    size_t count = 0;
+    for(size_t i = 0; i < packets.size(); ++i) {
+        if(!(this->*process)(packets[i], is_rtp)) {
+            continue;
+        }
+        if(count != i) {
+            packets[count] = std::move(packets[i]);
+        }
+        count++;
+    }
+
+    auto processed = packets.first(count);
+    if(_batch_callback) {
+        _batch_callback(processed, is_rtp);
+    } else {
+        for(auto& packet : processed) {
+            _callback(std::move(packet), is_rtp);
+        }
+    }
+    return count;
+}
+
 }
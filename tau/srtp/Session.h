@@ -3,6 +3,7 @@
 #include <tau/srtp/KeyMaterial.h>
 #include <tau/memory/Buffer.h>
 #include <functional>
+#include <span>
 
 namespace tau::srtp {
 
@@ -23,6 +24,7 @@ public:
     };
 
     using Callback = std::function<void(Buffer&& decrypted, bool is_rtp)>;
+    using BatchCallback = std::function<void(std::span<Buffer> packets, bool is_rtp)>;
 
 public:
     explicit Session(Options&& options);
@@ -30,14 +32,26 @@ public:
 
     bool IsValid() const;
     void SetCallback(Callback callback) { _callback = std::move(callback); }
+    void SetBatchCallback(BatchCallback callback) { _batch_callback = std::move(callback); }
 
     bool Encrypt(Buffer&& packet, bool is_rtp = true);
     bool Decrypt(Buffer&& packet, bool is_rtp = true);
 
+    // Processes packets in place (e.g. rtp::Frame), failed ones are dropped and the rest are moved to the front.
+    // The batch callback is called once, w/o it the per-packet callback is used. Returns processed packets count
+    size_t EncryptBatch(std::span<Buffer> packets, bool is_rtp = true);
+    size_t DecryptBatch(std::span<Buffer> packets, bool is_rtp = true);
+
+private:
+    bool Protect(Buffer& packet, bool is_rtp);
+    bool Unprotect(Buffer& packet, bool is_rtp);
+    size_t ProcessBatch(std::span<Buffer> packets, bool is_rtp, bool (Session::*process)(Buffer&, bool));
+
 private:
     const etl::string_view _log_ctx;
     srtp_t _session = nullptr;
     Callback _callback;
+    BatchCallback _batch_callback;
 };
 
 }
@@ -9,6 +9,7 @@ inline constexpr size_t kAttributeHeaderSize = sizeof(uint32_t);
 enum class AttributeType : uint16_t {
     kUserName           = 0x0006,
     kMessageIntegrity   = 0x0008,
+    kErrorCode          = 0x0009,
     kChannelNumber      = 0x000C,
     kLifetime           = 0x000D,
     kXorPeerAddress     = 0x0012,
@@ -0,0 +1,54 @@
+#include "tau/stun/BindingResponder.h"
+#include "tau/stun/Reader.h"
+#include "tau/stun/Writer.h"
+#include "tau/stun/MagicCookie.h"
+#include "tau/stun/attribute/XorMappedAddress.h"
+#include "tau/stun/attribute/ByteString.h"
+#include "tau/stun/attribute/Fingerprint.h"
+#include "tau/common/Crc32.h"
+#include "tau/common/NetToHost.h"
+#include <cstring>
+
+namespace tau::stun {
+
+using namespace attribute;
+
+inline constexpr size_t kTransactionIdOffset = 2 * sizeof(uint32_t);
+inline constexpr size_t kXorPortOffset = kMessageHeaderSize + kAttributeHeaderSize + sizeof(uint16_t);
+inline constexpr size_t kXorAddressOffset = kMessageHeaderSize + kAttributeHeaderSize + sizeof(uint32_t);
+inline constexpr size_t kFingerprintSize = kAttributeHeaderSize + sizeof(uint32_t);
+inline constexpr size_t kMaxSoftwareSize = BindingResponder::kMaxResponseSize
+    - kMessageHeaderSize - (kAttributeHeaderSize + IPv4PayloadSize) - kAttributeHeaderSize - kFingerprintSize;
+
+BindingResponder::BindingResponder(Options&& options) {
+    Writer writer(BufferView{.ptr = _template.data(), .size = _template.size()}, kBindingResponse);
+    XorMappedAddressWriter::Write(writer, AttributeType::kXorMappedAddress, 0, 0);
+    if(!options.software.empty()) {
+        ByteStringWriter::Write(writer, AttributeType::kSoftware, options.software.substr(0, kMaxSoftwareSize));
+    }
+    FingerprintWriter::Write(writer);
+    _size = writer.GetSize();
+}
+
+size_t BindingResponder::Process(const BufferViewConst& request, uint32_t address, uint16_t port, BufferView output) const {
+    if((request.size < kMessageHeaderSize) || (HeaderReader::GetType(request) != kBindingRequest)) {
+        return 0;
+    }
+    if(!Reader::Validate(request) || (output.size < _size)) {
+        return 0;
+    }
+
+    etl::array<uint8_t, kTransactionIdSize> transaction_id;
+    std::memcpy(transaction_id.data(), request.ptr + kTransactionIdOffset, transaction_id.size());
+
+    auto ptr = output.ptr;
+    std::memcpy(ptr, _template.data(), _size);
+    std::memcpy(ptr + kTransactionIdOffset, transaction_id.data(), transaction_id.size());
+    Write16(ptr + kXorPortOffset, port ^ (kMagicCookie >> 16));
+    Write32(ptr + kXorAddressOffset, address ^ kMagicCookie);
+    const auto crc_size = _size - kFingerprintSize;
+    Write32(ptr + crc_size + kAttributeHeaderSize, Crc32(ptr, crc_size) ^ kFingerprintXorValue);
+    return _size;
+}
+
+}
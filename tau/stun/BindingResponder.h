@@ -0,0 +1,34 @@
+#pragma once
+
+#include "tau/stun/Header.h"
+#include "tau/memory/BufferView.h"
+#include <etl/array.h>
+#include <etl/string_view.h>
+
+namespace tau::stun {
+
+// Binding response is pre-serialized once (XOR-MAPPED-ADDRESS, SOFTWARE, FINGERPRINT),
+// per request only transaction ID, XOR-MAPPED-ADDRESS value and FINGERPRINT are patched
+class BindingResponder {
+public:
+    static constexpr size_t kMaxResponseSize = 128;
+
+    struct Options {
+        etl::string_view software = "TAU WebRTC Library";
+    };
+
+public:
+    explicit BindingResponder(Options&& options);
+
+    // returns the response size, 0 if the request isn't a valid binding request or the output is too small.
+    // output could be the request buffer itself
+    size_t Process(const BufferViewConst& request, uint32_t address, uint16_t port, BufferView output) const;
+
+    size_t GetResponseSize() const { return _size; }
+
+private:
+    etl::array<uint8_t, kMaxResponseSize> _template = {};
+    size_t _size = 0;
+};
+
+}
@@ -0,0 +1,38 @@
+#include "tau/stun/ChannelData.h"
+#include "tau/common/NetToHost.h"
+#include <cassert>
+
+namespace tau::stun {
+
+bool ChannelDataReader::IsChannelData(const BufferViewConst& view) {
+    return (view.size != 0) && ((view.ptr[0] & 0xC0) == 0x40);
+}
+
+uint16_t ChannelDataReader::GetChannelNumber(const BufferViewConst& view) {
+    return Read16(view.ptr);
+}
+
+BufferViewConst ChannelDataReader::GetData(const BufferViewConst& view) {
+    return BufferViewConst{
+        .ptr = view.ptr + kChannelDataHeaderSize,
+        .size = Read16(view.ptr + sizeof(uint16_t))
+    };
+}
+
+bool ChannelDataReader::Validate(const BufferViewConst& view) {
+    if(view.size < kChannelDataHeaderSize) {
+        return false;
+    }
+    if(!IsChannelNumberValid(GetChannelNumber(view))) {
+        return false;
+    }
+    return (kChannelDataHeaderSize + Read16(view.ptr + sizeof(uint16_t)) <= view.size);
+}
+
+void ChannelDataWriter::WriteHeader(BufferView view, uint16_t channel, size_t length) {
+    assert(kChannelDataHeaderSize <= view.size);
+    Write16(view.ptr, channel);
+    Write16(view.ptr + sizeof(uint16_t), static_cast<uint16_t>(length));
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "tau/memory/BufferView.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace tau::stun {
+
+inline constexpr size_t kChannelDataHeaderSize = sizeof(uint32_t);
+inline constexpr uint16_t kChannelNumberMin = 0x4000;
+inline constexpr uint16_t kChannelNumberMax = 0x4FFF;
+
+inline constexpr bool IsChannelNumberValid(uint16_t channel) {
+    return (kChannelNumberMin <= channel) && (channel <= kChannelNumberMax);
+}
+
+// TURN ChannelData message: 4-byte header (channel number and length) instead of STUN Send/Data indication
+// https://www.rfc-editor.org/rfc/rfc8656#section-12.4
+class ChannelDataReader {
+public:
+    static bool IsChannelData(const BufferViewConst& view); // first byte only, to demux from STUN
+    static uint16_t GetChannelNumber(const BufferViewConst& view);
+    static BufferViewConst GetData(const BufferViewConst& view);
+
+    static bool Validate(const BufferViewConst& view); // UDP datagram may be padded
+};
+
+class ChannelDataWriter {
+public:
+    static void WriteHeader(BufferView view, uint16_t channel, size_t length);
+};
+
+}
@@ -6,6 +6,7 @@
 #include "tau/stun/attribute/ByteString.h"
 #include "tau/stun/attribute/MessageIntegrity.h"
 #include "tau/stun/attribute/Fingerprint.h"
+#include "tau/stun/attribute/ErrorCode.h"
 #include "tau/common/NetToHost.h"
 #include "tau/common/Math.h"
 
@@ -37,6 +38,7 @@ bool Reader::Validate(const BufferViewConst& view) {
             case AttributeType::kPriority:           return attribute::DataUint32Reader::Validate(attr);
             case AttributeType::kRequestedTransport: return attribute::DataUint32Reader::Validate(attr);
             case AttributeType::kLifetime:           return attribute::DataUint32Reader::Validate(attr);
+            case AttributeType::kChannelNumber:      return attribute::DataUint32Reader::Validate(attr);
             case AttributeType::kIceControlled:      return attribute::IceRoleReader::Validate(attr);
             case AttributeType::kIceControlling:     return attribute::IceRoleReader::Validate(attr);
             case AttributeType::kFingerprint:        return attribute::FingerprintReader::Validate(attr, view);
@@ -44,6 +46,7 @@ bool Reader::Validate(const BufferViewConst& view) {
             case AttributeType::kRealm:              return attribute::ByteStringReader::Validate(attr);
             case AttributeType::kNonce:              return attribute::ByteStringReader::Validate(attr);
             case AttributeType::kMessageIntegrity:   return attribute::MessageIntegrityReader::Validate(attr);
+            case AttributeType::kErrorCode:          return attribute::ErrorCodeReader::Validate(attr);
             default:
                 break;
         }
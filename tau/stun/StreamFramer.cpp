@@ -0,0 +1,30 @@
+#include "tau/stun/StreamFramer.h"
+#include "tau/stun/ChannelData.h"
+#include "tau/stun/Header.h"
+#include "tau/common/NetToHost.h"
+#include "tau/common/Math.h"
+
+namespace tau::stun {
+
+size_t StreamFramer::GetFrameSize(const BufferViewConst& view) {
+    if(view.size < kHeaderSize) {
+        return 0;
+    }
+    const auto length = Read16(view.ptr + sizeof(uint16_t));
+    switch(view.ptr[0] & 0xC0) {
+        case 0x00:
+            if(length % sizeof(uint32_t) != 0) {
+                return 0;
+            }
+            return kMessageHeaderSize + length;
+        case 0x40:
+            return Align(kChannelDataHeaderSize + length, sizeof(uint32_t));
+    }
+    return 0;
+}
+
+size_t StreamFramer::GetChannelDataPadding(size_t channel_data_size) {
+    return Align(channel_data_size, sizeof(uint32_t)) - channel_data_size;
+}
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "tau/memory/BufferView.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace tau::stun {
+
+// TURN over TCP/TLS: STUN messages and ChannelData (padded to 4 bytes) are sent back to back, no extra framing
+// https://www.rfc-editor.org/rfc/rfc8656#section-12.5
+class StreamFramer {
+public:
+    static constexpr size_t kHeaderSize = sizeof(uint32_t); // enough to get the frame size
+
+    static size_t GetFrameSize(const BufferViewConst& view); // 0 if neither STUN nor ChannelData
+    static size_t GetChannelDataPadding(size_t channel_data_size);
+};
+
+}
@@ -34,8 +34,13 @@ inline constexpr uint16_t kAllocateResponse         = MessageType(Method::kAlloc
 inline constexpr uint16_t kAllocateErrorResponse    = MessageType(Method::kAllocate, Type::kErrorResponse);
 inline constexpr uint16_t kRefreshRequest           = MessageType(Method::kRefresh,  Type::kRequest);
 inline constexpr uint16_t kRefreshResponse          = MessageType(Method::kRefresh,  Type::kResponse);
+inline constexpr uint16_t kRefreshErrorResponse     = MessageType(Method::kRefresh,  Type::kErrorResponse);
 inline constexpr uint16_t kCreatePermissionRequest  = MessageType(Method::kCreatePermission, Type::kRequest);
 inline constexpr uint16_t kCreatePermissionResponse = MessageType(Method::kCreatePermission, Type::kResponse);
+inline constexpr uint16_t kCreatePermissionErrorResponse = MessageType(Method::kCreatePermission, Type::kErrorResponse);
+inline constexpr uint16_t kChannelBindRequest       = MessageType(Method::kChannelBind, Type::kRequest);
+inline constexpr uint16_t kChannelBindResponse      = MessageType(Method::kChannelBind, Type::kResponse);
+inline constexpr uint16_t kChannelBindErrorResponse = MessageType(Method::kChannelBind, Type::kErrorResponse);
 inline constexpr uint16_t kSendIndication           = MessageType(Method::kSend,     Type::kIndication);
 inline constexpr uint16_t kDataIndication           = MessageType(Method::kData,     Type::kIndication);
 
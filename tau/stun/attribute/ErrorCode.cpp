@@ -0,0 +1,44 @@
+#include "tau/stun/attribute/ErrorCode.h"
+#include "tau/common/NetToHost.h"
+#include "tau/common/Math.h"
+
+namespace tau::stun::attribute {
+
+uint16_t ErrorCodeReader::GetCode(const BufferViewConst& view) {
+    const auto ptr = view.ptr + kAttributeHeaderSize;
+    return (ptr[2] & 0x07) * 100 + ptr[3];
+}
+
+etl::string_view ErrorCodeReader::GetReason(const BufferViewConst& view) {
+    constexpr auto kOffset = kAttributeHeaderSize + sizeof(uint32_t);
+    return etl::string_view{reinterpret_cast<const char*>(view.ptr + kOffset), view.size - kOffset};
+}
+
+bool ErrorCodeReader::Validate(const BufferViewConst& view) {
+    if(view.size < kAttributeHeaderSize + sizeof(uint32_t)) {
+        return false;
+    }
+    const auto ptr = view.ptr + kAttributeHeaderSize;
+    const auto error_class = ptr[2] & 0x07;
+    return (3 <= error_class) && (error_class <= 6) && (ptr[3] < 100);
+}
+
+bool ErrorCodeWriter::Write(Writer& writer, uint16_t code, etl::string_view reason) {
+    const auto size = sizeof(uint32_t) + reason.size();
+    const auto padding = Align(size, sizeof(uint32_t)) - size;
+    if(writer.GetAvailableSize() < kAttributeHeaderSize + size + padding) {
+        return false;
+    }
+    writer.WriteAttributeHeader(AttributeType::kErrorCode, size);
+    writer.Write(static_cast<uint16_t>(0));
+    writer.Write(static_cast<uint8_t>(code / 100));
+    writer.Write(static_cast<uint8_t>(code % 100));
+    writer.Write(reason);
+    for(size_t i = 0; i < padding; ++i) {
+        writer.Write((uint8_t)0);
+    }
+    writer.UpdateHeaderLength();
+    return true;
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "tau/stun/Writer.h"
+#include "tau/stun/AttributeType.h"
+
+namespace tau::stun::attribute {
+
+enum ErrorCode : uint16_t {
+    kBadRequest                   = 400,
+    kUnauthorized                 = 401,
+    kForbidden                    = 403,
+    kAllocationMismatch           = 437,
+    kStaleNonce                   = 438,
+    kWrongCredentials             = 441,
+    kUnsupportedTransportProtocol = 442,
+    kAllocationQuotaReached       = 486,
+    kInsufficientCapacity         = 508,
+};
+
+// https://www.rfc-editor.org/rfc/rfc8489#section-14.8
+class ErrorCodeReader {
+public:
+    static uint16_t GetCode(const BufferViewConst& view); // class * 100 + number
+    static etl::string_view GetReason(const BufferViewConst& view);
+
+    static bool Validate(const BufferViewConst& view);
+};
+
+class ErrorCodeWriter {
+public:
+    static bool Write(Writer& writer, uint16_t code, etl::string_view reason = {});
+};
+
+}
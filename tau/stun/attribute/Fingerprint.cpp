@@ -5,15 +5,13 @@
 
 namespace tau::stun::attribute {
 
-constexpr uint32_t kXorValue = 0x5354554E; // "STUN"
-
 bool FingerprintReader::Validate(const BufferViewConst& view, const BufferViewConst& message) {
     if(view.size != (kAttributeHeaderSize + sizeof(uint32_t))) {
         return false;
     }
     const auto value = Read32(view.ptr + kAttributeHeaderSize);
     const auto crc32 = Crc32(message.ptr, message.size - view.size);
-    const auto crc32_xored = crc32 ^ kXorValue;
+    const auto crc32_xored = crc32 ^ kFingerprintXorValue;
     return value == crc32_xored;
 }
 
@@ -24,7 +22,7 @@ bool FingerprintWriter::Write(Writer& writer) {
     auto message_view = writer.GetView();
     writer.SetHeaderLength(writer.GetSize() - kMessageHeaderSize + kAttributeHeaderSize + sizeof(uint32_t));
     writer.WriteAttributeHeader(AttributeType::kFingerprint, sizeof(uint32_t));
-    writer.Write(Crc32(message_view.ptr, message_view.size) ^ kXorValue);
+    writer.Write(Crc32(message_view.ptr, message_view.size) ^ kFingerprintXorValue);
     writer.UpdateHeaderLength();
     return true;
 }
@@ -5,6 +5,8 @@
 
 namespace tau::stun::attribute {
 
+inline constexpr uint32_t kFingerprintXorValue = 0x5354554E; // "STUN"
+
 // https://www.rfc-editor.org/rfc/rfc8489.html#section-14.7
 class FingerprintReader {
 public:
@@ -1,5 +1,5 @@
 #include "tau/webrtc/MediaDemuxer.h"
-#include "tau/rtp/Reader.h"
+#include "tau/rtp/Extension.h"
 #include "tau/rtcp/Reader.h"
 #include "tau/common/NetToHost.h"
 #include "tau/common/Log.h"
@@ -14,10 +14,30 @@ MediaDemuxer::MediaDemuxer(Options&& options)
             if(media_local.ssrc) {
                 _local_media_ssrc_to_media_idx.insert({*media_local.ssrc, i});
             }
+            if(media_local.rtx_ssrc) {
+                _local_media_ssrc_to_media_idx.insert({*media_local.rtx_ssrc, i});
+            }
+            if(media_local.fec_ssrc) {
+                _local_media_ssrc_to_media_idx.insert({*media_local.fec_ssrc, i});
+            }
             auto& media_remote = options.remote_sdp.medias[i];
             if(media_remote.ssrc) {
-                _remote_media_ssrc_to_media_idx.insert({*media_remote.ssrc, i});
+                _remote_ssrc_to_stream.insert({*media_remote.ssrc, Stream{.idx = i, .layer = 0}});
+            }
+            if(media_remote.rtx_ssrc) {
+                _remote_ssrc_to_stream.insert({*media_remote.rtx_ssrc, Stream{.idx = i, .layer = 0}});
             }
+            if(media_remote.fec_ssrc) {
+                _remote_ssrc_to_stream.insert({*media_remote.fec_ssrc, Stream{.idx = i, .layer = 0}});
+            }
+            _recv_medias.push_back(RecvMedia{
+                .idx = i,
+                .mid = media_local.mid,
+                .mid_extension_id = media_local.mid_extension_id,
+                .rid_extension_id = media_local.rid_extension_id,
+                .repaired_rid_extension_id = media_local.repaired_rid_extension_id,
+                .simulcast = media_local.simulcast
+            });
         }
     }
 }
@@ -29,10 +49,14 @@ void MediaDemuxer::Process(Buffer&& packet, bool is_rtp) {
         auto reader = rtp::Reader(view);
         ssrc = reader.Ssrc();
 
-        auto it = _remote_media_ssrc_to_media_idx.find(ssrc);
-        if(it != _remote_media_ssrc_to_media_idx.end()) {
-            const auto& idx = it->second;
-            _callback(idx, std::move(packet), is_rtp);
+        auto it = _remote_ssrc_to_stream.find(ssrc);
+        if(it != _remote_ssrc_to_stream.end()) {
+            const auto stream = it->second;
+            _callback(stream.idx, stream.layer, std::move(packet), is_rtp);
+        } else if(auto stream = LearnStream(reader)) {
+            TAU_LOG_INFO(_log_ctx << "New remote stream, ssrc: " << ssrc << ", media idx: " << stream->idx << ", layer: " << stream->layer);
+            _remote_ssrc_to_stream.insert({ssrc, *stream});
+            _callback(stream->idx, stream->layer, std::move(packet), is_rtp);
         } else {
             TAU_LOG_WARNING_THR(128, _log_ctx << "Unexpected media, ssrc: " << ssrc << ", is_rtp: " << is_rtp);
         }
@@ -43,7 +67,7 @@ void MediaDemuxer::Process(Buffer&& packet, bool is_rtp) {
             auto it = _local_media_ssrc_to_media_idx.find(ssrc);
             if(it != _local_media_ssrc_to_media_idx.end()) {
                 const auto& idx = it->second;
-                _callback(idx, std::move(packet), is_rtp);
+                _callback(idx, 0, std::move(packet), is_rtp);
             } else {
                 TAU_LOG_WARNING_THR(128, _log_ctx << "Unexpected media, ssrc: " << ssrc << ", is_rtp: " << is_rtp);
             }
@@ -53,6 +77,51 @@ void MediaDemuxer::Process(Buffer&& packet, bool is_rtp) {
     }
 }
 
+std::optional<MediaDemuxer::Stream> MediaDemuxer::LearnStream(const rtp::Reader& reader) {
+    if(_remote_ssrc_to_stream.full()) {
+        return std::nullopt;
+    }
+    const auto extensions = reader.Extensions();
+    if(extensions.size == 0) {
+        return std::nullopt;
+    }
+    for(auto& media : _recv_medias) {
+        if(!media.mid_extension_id) {
+            continue;
+        }
+        const auto mid = rtp::ExtensionReader::Find(extensions, *media.mid_extension_id);
+        if(!mid || (etl::string_view{reinterpret_cast<const char*>(mid->ptr), mid->size} != media.mid)) {
+            continue;
+        }
+        if(auto layer = GetLayer(media, extensions)) {
+            return Stream{.idx = media.idx, .layer = *layer};
+        }
+        return std::nullopt;
+    }
+    return std::nullopt;
+}
+
+std::optional<size_t> MediaDemuxer::GetLayer(const RecvMedia& media, const BufferViewConst& extensions) {
+    if(!media.simulcast) {
+        return 0;
+    }
+    for(auto id : {media.rid_extension_id, media.repaired_rid_extension_id}) {
+        if(!id) {
+            continue;
+        }
+        if(auto rid = rtp::ExtensionReader::Find(extensions, *id)) {
+            const auto& rids = media.simulcast->rids;
+            for(size_t i = 0; i < rids.size(); ++i) {
+                if(etl::string_view{reinterpret_cast<const char*>(rid->ptr), rid->size} == etl::string_view{rids[i]}) {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+    }
+    return std::nullopt; // the stream isn't identified by RID yet
+}
+
 std::optional<uint32_t> MediaDemuxer::GetSsrcFromRtcp(const BufferViewConst& view) const {
     if(!rtcp::Reader::Validate(view)) {
         TAU_LOG_WARNING_THR(128, _log_ctx << "Invalid RTCP, size: " << view.size);
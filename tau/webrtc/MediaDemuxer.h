@@ -1,23 +1,30 @@
 #pragma once
 
 #include "tau/sdp/Sdp.h"
+#include "tau/rtp/Reader.h"
 #include "tau/memory/Buffer.h"
 #include <etl/unordered_map.h>
+#include <etl/vector.h>
 #include <functional>
 
 namespace tau::webrtc {
 
-//NOTE: Simplified version uses SSRC values from SDP only
-//TODO: Add parsing of MID from RTP header extension, and RTCP SDES (ssrc/cname data)
+// RTP is mapped by the remote SSRC values from SDP, unknown SSRCs are learned from MID and RID
+// (RTX: repaired RID) header extensions, the simulcast layer is the RID index in a=simulcast.
+// RTCP is mapped by the local SSRC values.
+//TODO: Add RTCP SDES (ssrc/cname data) parsing
 class MediaDemuxer {
 public:
+    static constexpr size_t kMaxRemoteStreams = 16;
+
     struct Options {
         const sdp::Sdp& local_sdp;
         const sdp::Sdp& remote_sdp;
         etl::string_view log_ctx = {};
     };
 
-    using Callback = std::function<void(size_t idx, Buffer&& packet, bool is_rtp)>;
+    // layer is 0 for RTCP and non-simulcast streams
+    using Callback = std::function<void(size_t idx, size_t layer, Buffer&& packet, bool is_rtp)>;
 
 public:
     explicit MediaDemuxer(Options&& options);
@@ -27,12 +34,29 @@ public:
     void Process(Buffer&& packet, bool is_rtp);
 
 private:
+    struct Stream {
+        size_t idx;
+        size_t layer;
+    };
+
+    struct RecvMedia {
+        size_t idx;
+        sdp::Mid mid;
+        std::optional<uint8_t> mid_extension_id;
+        std::optional<uint8_t> rid_extension_id;
+        std::optional<uint8_t> repaired_rid_extension_id;
+        std::optional<sdp::Simulcast> simulcast;
+    };
+
+    std::optional<Stream> LearnStream(const rtp::Reader& reader);
+    static std::optional<size_t> GetLayer(const RecvMedia& media, const BufferViewConst& extensions);
     std::optional<uint32_t> GetSsrcFromRtcp(const BufferViewConst& view) const;
 
 private:
     const etl::string_view _log_ctx;
-    etl::unordered_map<uint32_t, size_t, 2> _local_media_ssrc_to_media_idx;
-    etl::unordered_map<uint32_t, size_t, 2> _remote_media_ssrc_to_media_idx;
+    etl::unordered_map<uint32_t, size_t, 4> _local_media_ssrc_to_media_idx;
+    etl::unordered_map<uint32_t, Stream, kMaxRemoteStreams> _remote_ssrc_to_stream;
+    etl::vector<RecvMedia, sdp::kMaxMedias> _recv_medias;
     Callback _callback;
 };
 
@@ -1,6 +1,8 @@
 #include "tau/webrtc/PeerConnection.h"
 #include "tau/sdp/Negotiation.h"
 #include "tau/rtp/Reader.h"
+#include "tau/rtp-packetization/H264Depacketizer.h"
+#include "tau/rtp-packetization/H265Depacketizer.h"
 #include "tau/rtcp/Header.h"
 #include "tau/net/Interface.h"
 #include "tau/net/Resolver.h"
@@ -25,31 +27,48 @@ PeerConnection::~PeerConnection() {
 
 void PeerConnection::Start() {
     InitMediaDemuxer();
-    StartIceAgent();
+    if(!StartIceAgent()) {
+        _state = State::kFailed;
+        _state_callback(_state);
+        return;
+    }
     if(GetLocalSdp().dtls->setup != sdp::Setup::kActive) {
         StartDtlsSession();
     }
+    RequestWakeup();
 }
 
 void PeerConnection::Stop() {
     TAU_LOG_DEBUG("");
     _mdns_ctx.reset();
     _udp_sockets.clear();
+    if(_udp_mux_registered) {
+        _deps.udp_mux->Unregister(_ice_ufrag);
+        _udp_mux_registered = false;
+    }
     _ice_agent.reset();
     if(_dtls_session) {
         _dtls_session->Stop();
         _dtls_session.reset();
     }
+    _simulcast.reset();
     _rtp_sessions.clear();
+    _twcc_sender.reset();
+    _twcc_receiver.reset();
+    _pacer.reset();
 }
 
 void PeerConnection::Process() {
+    _sockets_ready = false;
     for(auto& udp_socket : _udp_sockets) {
         udp_socket->Receive();
     }
     if(_mdns_ctx) {
         _mdns_ctx->socket->Receive();
     }
+    DecryptRtpBatch();
+    _wakeup_requested = false;
+    _processing = true;
     if(_ice_agent) {
         _ice_agent->Process();
     }
@@ -59,6 +78,66 @@ void PeerConnection::Process() {
     for(auto& session : _rtp_sessions) {
         session.Process();
     }
+    if(_simulcast) {
+        for(auto& session : _simulcast->layers) {
+            session.Process();
+        }
+    }
+    if(_simulcast && _twcc_sender && _options.simulcast_by_bitrate) {
+        _simulcast->forwarder.SetAvailableBitrate(_twcc_sender->GetTargetBitrate());
+    }
+    if(_pacer) {
+        if(_twcc_sender) {
+            _pacer->SetBitrate(static_cast<uint32_t>(rtp::session::Pacer::kPacingFactor * _twcc_sender->GetTargetBitrate()));
+        }
+        _pacer->Process();
+    }
+    _processing = false;
+    EncryptRtpBatch();
+    Flush();
+}
+
+void PeerConnection::Flush() {
+    for(auto& udp_socket : _udp_sockets) {
+        udp_socket->Flush();
+    }
+    if(_deps.udp_mux) {
+        _deps.udp_mux->Flush();
+    }
+}
+
+std::optional<Timepoint> PeerConnection::GetNextDeadline() {
+    const auto now = _deps.clock.Now();
+    if(_wakeup_requested || _sockets_ready || (_dtls_session && _dtls_session->IsProcessRequired())) {
+        return now;
+    }
+
+    std::optional<Timepoint> deadline;
+    auto update = [&deadline](std::optional<Timepoint> tp) {
+        if(tp && (!deadline || (*tp < *deadline))) {
+            deadline = tp;
+        }
+    };
+    if(_ice_agent) {
+        update(_ice_agent->GetNextDeadline());
+    }
+    if(_dtls_session) {
+        if(auto timeout = _dtls_session->GetTimeout()) {
+            update(now + *timeout);
+        }
+    }
+    for(auto& session : _rtp_sessions) {
+        update(session.GetNextDeadline());
+    }
+    if(_simulcast) {
+        for(auto& session : _simulcast->layers) {
+            update(session.GetNextDeadline());
+        }
+    }
+    if(_pacer) {
+        update(_pacer->GetNextDeadline());
+    }
+    return deadline;
 }
 
 void PeerConnection::CreateSdpOffer() {
@@ -83,7 +162,8 @@ void PeerConnection::CreateSdpOffer() {
     _sdp_offer->bundle_mids.push_back("1");
     _sdp_offer->medias.push_back(_options.sdp.audio);
     _sdp_offer->medias.push_back(_options.sdp.video);
-    crypto::RandomBase64(_ice_ufrag, 4);
+    AddDemuxExtensions(_sdp_offer->medias.back());
+    crypto::RandomBase64(_ice_ufrag, _deps.udp_mux ? kIceUfragSizeShared : kIceUfragSize);
     crypto::RandomBase64(_ice_password, 24);
     _sdp_offer->ice->ufrag = _ice_ufrag;
     _sdp_offer->ice->pwd = _ice_password;
@@ -91,6 +171,12 @@ void PeerConnection::CreateSdpOffer() {
     for(size_t i = 0; i < 2; ++i) {
         _sdp_offer->medias[i].mid = _sdp_offer->bundle_mids[i];
         _sdp_offer->medias[i].ssrc = _random.Int<uint32_t>();
+        if(sdp::HasRtx(_sdp_offer->medias[i])) {
+            _sdp_offer->medias[i].rtx_ssrc = _random.Int<uint32_t>();
+        }
+        if(_sdp_offer->medias[i].fec_pt) {
+            _sdp_offer->medias[i].fec_ssrc = _random.Int<uint32_t>();
+        }
     }
 }
 
@@ -118,13 +204,16 @@ bool PeerConnection::ProcessSdpOffer(const etl::string_view& offer) {
         },
     });
     crypto::RandomBase64(_sdp_answer->cname, 8);
-    crypto::RandomBase64(_ice_ufrag, 4);
+    crypto::RandomBase64(_ice_ufrag, _deps.udp_mux ? kIceUfragSizeShared : kIceUfragSize);
     crypto::RandomBase64(_ice_password, 24);
     _sdp_answer->ice->ufrag = _ice_ufrag;
     _sdp_answer->ice->pwd = _ice_password;
 
     for(auto& remote_media : _sdp_offer->medias) {
-        auto& media_params = (remote_media.type == sdp::MediaType::kAudio) ? _options.sdp.audio : _options.sdp.video;
+        auto media_params = (remote_media.type == sdp::MediaType::kAudio) ? _options.sdp.audio : _options.sdp.video;
+        if(media_params.type == sdp::MediaType::kVideo) {
+            AddDemuxExtensions(media_params);
+        }
         auto local_media = sdp::SelectMedia(remote_media, media_params);
         if(!local_media || local_media->codecs.empty()) {
             TAU_LOG_WARNING(_options.log_ctx << "SDP negotiation failed, media type: " << (size_t)remote_media.type);
@@ -132,6 +221,12 @@ bool PeerConnection::ProcessSdpOffer(const etl::string_view& offer) {
             return false;
         }
         local_media->ssrc = _random.Int<uint32_t>();
+        if(sdp::HasRtx(*local_media)) {
+            local_media->rtx_ssrc = _random.Int<uint32_t>();
+        }
+        if(local_media->fec_pt) {
+            local_media->fec_ssrc = _random.Int<uint32_t>();
+        }
         _sdp_answer->medias.push_back(*local_media);
     }
     return true;
@@ -176,15 +271,31 @@ bool PeerConnection::ProcessSdpAnswer(const etl::string_view& answer) {
 
 void PeerConnection::SetRemoteIceCandidate(ice::CandidateStr candidate) {
     SetRemoteIceCandidateInternal(std::move(candidate));
+    RequestWakeup();
 }
 
 void PeerConnection::SendRtp(size_t media_idx, Buffer&& packet) {
     auto& rtp_session = _rtp_sessions.at(media_idx);
     rtp_session.SendRtp(std::move(packet));
+    if(_pacer) {
+        RequestWakeup();
+    } else if(!_processing) {
+        Flush();
+    }
 }
 
-void PeerConnection::SendEvent(size_t media_idx, Event&& event) {
+void PeerConnection::SendRtp(size_t media_idx, SgBuffer&& packet) {
     auto& rtp_session = _rtp_sessions.at(media_idx);
+    rtp_session.SendRtp(std::move(packet));
+    if(_pacer) {
+        RequestWakeup();
+    } else if(!_processing) {
+        Flush();
+    }
+}
+
+void PeerConnection::SendEvent(size_t media_idx, Event&& event) {
+    auto& rtp_session = GetRecvSession(media_idx);
     std::visit(overloaded{
         [&rtp_session, media_idx](EventPli&) {
             rtp_session.PushEvent(rtp::session::Event::kPli);
@@ -193,6 +304,20 @@ void PeerConnection::SendEvent(size_t media_idx, Event&& event) {
             rtp_session.PushEvent(rtp::session::Event::kFir);
         }
     }, event);
+    if(!_processing) {
+        Flush();
+    }
+}
+
+void PeerConnection::SetSimulcastLayer(size_t media_idx, size_t layer) {
+    if(!_simulcast || (_simulcast->media_idx != media_idx) || (layer > _simulcast->layers.size())) {
+        TAU_LOG_WARNING(_options.log_ctx << "No simulcast layer, media idx: " << media_idx << ", layer: " << layer);
+        return;
+    }
+    _simulcast->forwarder.SetTargetLayer(layer);
+    if(!_processing) {
+        Flush();
+    }
 }
 
 const sdp::Sdp& PeerConnection::GetLocalSdp() const {
@@ -219,9 +344,19 @@ State PeerConnection::GetState() const {
     return _state;
 }
 
-void PeerConnection::StartIceAgent() {
+bool PeerConnection::StartIceAgent() {
     etl::vector<Endpoint, 3> interface_endpoints;
-    auto interfaces = net::EnumerateInterfaces(true);
+    if(_deps.udp_mux) {
+        interface_endpoints.push_back(_deps.udp_mux->GetLocalEndpoint().value());
+        _udp_mux_registered = _deps.udp_mux->Register(_ice_ufrag, [this](Buffer&& packet, Endpoint remote_endpoint) {
+            DemuxIncomingPacket(0, std::move(packet), remote_endpoint);
+        });
+        if(!_udp_mux_registered) {
+            TAU_LOG_ERROR(_options.log_ctx << "Shared UDP socket rejected the session, ufrag: " << _ice_ufrag);
+            return false;
+        }
+    }
+    auto interfaces = _deps.udp_mux ? net::Interfaces{} : net::EnumerateInterfaces(true);
     for(auto& interface : interfaces) {
         if(interface_endpoints.full()) {
             break;
@@ -233,7 +368,9 @@ void PeerConnection::StartIceAgent() {
         const auto idx = _udp_sockets.size();
         auto udp_socket = net::UdpSocket::Create(net::UdpSocket::Options{
             .allocator = _deps.udp_allocator,
-            .local_address = interface.address
+            .local_address = interface.address,
+            .tx_batch_size = kUdpTxBatchSize,
+            .ready_callback = [this]() { OnSocketReady(); }
         });
         if(!udp_socket || !udp_socket->GetLocalEndpoint()) {
             continue;
@@ -303,7 +440,10 @@ void PeerConnection::StartIceAgent() {
         _ice_candidate_callback(candidate);
     });
     _ice_agent->SetSendCallback([this](size_t socket_idx, Endpoint remote, Buffer&& message) {
-        _udp_sockets[socket_idx]->Send(std::move(message), remote);
+        if(_deps.udp_mux && UdpMux::IsBindable(ToConst(message.GetView()))) {
+            _deps.udp_mux->Bind(_ice_ufrag, remote); // replies come w/o USERNAME
+        }
+        SendUdp(socket_idx, std::move(message), remote);
     });
     if(_mdns_ctx) {
         _ice_agent->SetMdnsEndpointCallback([this](Endpoint endpoint) {
@@ -311,6 +451,7 @@ void PeerConnection::StartIceAgent() {
         });
     }
     _ice_agent->Start();
+    return true;
 }
 
 void PeerConnection::StartDtlsSession() {
@@ -329,7 +470,9 @@ void PeerConnection::StartDtlsSession() {
             .type = (local_sdp.dtls->setup == sdp::Setup::kActive)
                 ? dtls::Session::Type::kClient
                 : dtls::Session::Type::kServer,
-            .srtp_profiles = etl::vector<dtls::Session::SrtpProfile, 2>{
+            .srtp_profiles = etl::vector<dtls::Session::SrtpProfile, dtls::Session::kSrtpProfilesCount>{
+                dtls::Session::SrtpProfile::kAeadAes128Gcm,
+                dtls::Session::SrtpProfile::kAeadAes256Gcm,
                 dtls::Session::SrtpProfile::kAes128CmSha1_80,
                 dtls::Session::SrtpProfile::kAes128CmSha1_32
             },
@@ -350,6 +493,12 @@ void PeerConnection::StartDtlsSession() {
                     case dtls::Session::SrtpProfile::kAes128CmSha1_32:
                         srtp_profile = srtp_profile_t::srtp_profile_aes128_cm_sha1_32;
                         break;
+                    case dtls::Session::SrtpProfile::kAeadAes128Gcm:
+                        srtp_profile = srtp_profile_t::srtp_profile_aead_aes_128_gcm;
+                        break;
+                    case dtls::Session::SrtpProfile::kAeadAes256Gcm:
+                        srtp_profile = srtp_profile_t::srtp_profile_aead_aes_256_gcm;
+                        break;
                 }
             }
 
@@ -375,7 +524,7 @@ void PeerConnection::StartDtlsSession() {
                     if(loss_rate && (_random.Real() < *loss_rate)) {
                         return;
                     }
-                    _udp_sockets.at(_ice_pair->socket_idx)->Send(std::move(packet), _ice_pair->remote_endpoint);
+                    SendUdp(_ice_pair->socket_idx, std::move(packet), _ice_pair->remote_endpoint);
                 });
 
                 _state = State::kConnected;
@@ -390,7 +539,7 @@ void PeerConnection::StartDtlsSession() {
     });
     _dtls_session->SetSendCallback([this](Buffer&& packet) {
         TAU_LOG_TRACE(_options.log_ctx << "[DTLS] socket_idx: " << _ice_pair->socket_idx << ", remote: " << _ice_pair->remote_endpoint);
-        _udp_sockets.at(_ice_pair->socket_idx)->Send(std::move(packet), _ice_pair->remote_endpoint);
+        SendUdp(_ice_pair->socket_idx, std::move(packet), _ice_pair->remote_endpoint);
     });
 }
 
@@ -406,7 +555,8 @@ void PeerConnection::InitMdnsClient() {
                 .allocator = _deps.udp_allocator,
                 .local_address = {},
                 .local_port = mdns.port,
-                .multicast_address = mdns.address
+                .multicast_address = mdns.address,
+                .ready_callback = [this]() { OnSocketReady(); }
             }),
         mdns::Client::Dependencies{
             .udp_allocator = _deps.udp_allocator,
@@ -432,7 +582,14 @@ void PeerConnection::InitMediaDemuxer() {
         .remote_sdp = GetRemoteSdp(),
         .log_ctx = _options.log_ctx
     });
-    _media_demuxer->SetCallback([this](size_t idx, Buffer&& packet, bool is_rtp) {
+    _media_demuxer->SetCallback([this](size_t idx, size_t layer, Buffer&& packet, bool is_rtp) {
+        if(layer != 0) {
+            // RTP session of the layer unwraps RTX (repaired RID) and requests retransmissions of its SSRC
+            if(is_rtp && _simulcast && (_simulcast->media_idx == idx) && (layer <= _simulcast->layers.size())) {
+                _simulcast->layers[layer - 1].RecvRtp(std::move(packet));
+            }
+            return;
+        }
         auto& rtp_session = _rtp_sessions.at(idx);
         if(is_rtp) {
             rtp_session.RecvRtp(std::move(packet));
@@ -442,26 +599,61 @@ void PeerConnection::InitMediaDemuxer() {
     });
 
     const auto& local_sdp = GetLocalSdp();
+    const auto& remote_sdp = GetRemoteSdp();
+    for(size_t i = 0; i < local_sdp.medias.size(); ++i) {
+        const auto& media = local_sdp.medias[i];
+        if(!media.twcc_extension_id || media.codecs.empty() || (i >= remote_sdp.medias.size()) || !remote_sdp.medias[i].twcc_extension_id) {
+            continue;
+        }
+        if((media.codecs.begin()->second.rtcp_fb & sdp::RtcpFb::kTwcc) && !_twcc_sender) {
+            TAU_LOG_INFO(_options.log_ctx << "Transport-wide CC, extension id: " << (size_t)*media.twcc_extension_id);
+            _twcc_sender.emplace(
+                rtp::session::TwccSender::Dependencies{.clock = _deps.clock},
+                rtp::session::TwccSender::Options{.extension_id = *media.twcc_extension_id});
+            _twcc_receiver.emplace(
+                rtp::session::TwccReceiver::Dependencies{.clock = _deps.clock},
+                rtp::session::TwccReceiver::Options{.extension_id = *media.twcc_extension_id});
+        }
+    }
+
+    if(_options.pacer) {
+        _pacer.emplace(
+            rtp::session::Pacer::Dependencies{.clock = _deps.clock},
+            rtp::session::Pacer::Options(*_options.pacer));
+    }
+
+    const auto rtp_buffer_max_bytes = std::min(_options.rtp_buffer_max_bytes, _deps.udp_allocator.GetCapacity() / kRtpBufferCapacityShare);
     _rtp_sessions.reserve(local_sdp.medias.size());
     for(auto& media : local_sdp.medias) {
         if((media.type == sdp::MediaType::kAudio) || (media.type == sdp::MediaType::kVideo)) {
             const auto idx = _rtp_sessions.size();
             auto& [pt, codec] = *media.codecs.begin();
-            _rtp_sessions.emplace_back(
-                rtp::Session::Dependencies{
-                    .allocator = _deps.udp_allocator,
-                    .media_clock = _deps.clock,
-                    .system_clock = _system_clock
-                },
-                rtp::Session::Options{
-                    .rate = codec.clock_rate,
-                    .sender_ssrc = *media.ssrc,
-                    .base_ts = 0, //TODO: fix it
-                    .rtx = ((codec.rtcp_fb & sdp::RtcpFb::kNack) == sdp::RtcpFb::kNack),
-                    .cname = local_sdp.cname,
-                    .log_ctx = _options.log_ctx
-                }
-            );
+            const rtp::Session::Dependencies session_deps{
+                .allocator = _deps.udp_allocator,
+                .media_clock = _deps.clock,
+                .system_clock = _system_clock,
+                .twcc_sender = _twcc_sender ? &*_twcc_sender : nullptr,
+                .twcc_receiver = _twcc_receiver ? &*_twcc_receiver : nullptr,
+                .pacer = _pacer ? &*_pacer : nullptr
+            };
+            const rtp::Session::Options session_options{
+                .rate = codec.clock_rate,
+                .sender_ssrc = *media.ssrc,
+                .base_ts = 0, //TODO: fix it
+                .rtx = ((codec.rtcp_fb & sdp::RtcpFb::kNack) == sdp::RtcpFb::kNack),
+                .rtx_stream = (codec.rtx_pt && media.rtx_ssrc)
+                    ? std::optional{rtp::Session::RtxStream{.pt = *codec.rtx_pt, .ssrc = *media.rtx_ssrc, .sn = _random.Int<uint16_t>()}}
+                    : std::nullopt,
+                .fec = (media.fec_pt && media.fec_ssrc)
+                    ? std::optional{rtp::session::FecEncoder::Options{.pt = *media.fec_pt, .ssrc = *media.fec_ssrc, .sn = _random.Int<uint16_t>()}}
+                    : std::nullopt,
+                .priority = (media.type == sdp::MediaType::kAudio) ? rtp::session::Pacer::kAudio : rtp::session::Pacer::kVideo,
+                .send_buffer_max_bytes = rtp_buffer_max_bytes,
+                .recv_buffer_max_bytes = rtp_buffer_max_bytes,
+                .cname = local_sdp.cname,
+                .log_ctx = _options.log_ctx
+            };
+            _rtp_sessions.emplace_back(rtp::Session::Dependencies(session_deps), rtp::Session::Options(session_options));
             auto& rtp_session = _rtp_sessions.back();
             rtp_session.SetEventCallback([this, idx](rtp::session::Event&& event) {
                 TAU_LOG_DEBUG(_options.log_ctx << "Incoming event, RTP session idx: " << idx << ", event: " << event);
@@ -475,20 +667,72 @@ void PeerConnection::InitMediaDemuxer() {
                 }
             });
             rtp_session.SetSendRtpCallback([this](Buffer&& packet) {
-                _srtp_encryptor->Encrypt(std::move(packet), true);
+                if(_processing) {
+                    _srtp_tx_batch.push_back(std::move(packet));
+                } else {
+                    _srtp_encryptor->Encrypt(std::move(packet), true);
+                }
             });
             rtp_session.SetSendRtcpCallback([this](Buffer&& packet) {
                 _srtp_encryptor->Encrypt(std::move(packet), false);
             });
             rtp_session.SetRecvRtpCallback([this, idx](Buffer&& packet) {
-                _recv_rtp_callback(idx, std::move(packet));
+                RecvRtp(idx, 0, std::move(packet));
             });
+            if(media.simulcast && (media.simulcast->direction == sdp::Direction::kRecv) && !_simulcast) {
+                InitSimulcast(session_deps, session_options, idx);
+            }
         } else {
             break;
         }
     }
 }
 
+void PeerConnection::InitSimulcast(const rtp::Session::Dependencies& deps, const rtp::Session::Options& options, size_t media_idx) {
+    const auto& media = GetLocalSdp().medias[media_idx];
+    const auto& rids = media.simulcast->rids;
+    TAU_LOG_INFO(_options.log_ctx << "Simulcast, media idx: " << media_idx << ", layers: " << rids.size());
+    _simulcast.emplace(Simulcast{
+        .media_idx = media_idx,
+        .h265 = (media.codecs.begin()->second.name == "H265"),
+        .layers = {},
+        .forwarder = rtp::session::SimulcastForwarder(
+            rtp::session::SimulcastForwarder::Dependencies{.clock = _deps.clock},
+            rtp::session::SimulcastForwarder::Options{
+                .ssrc = _random.Int<uint32_t>(),
+                .rate = options.rate,
+                .sn = _random.Int<uint16_t>(),
+                .ts = _random.Int<uint32_t>()
+            })
+    });
+
+    // layers are received only, no RTP is sent by their sessions
+    auto layer_deps = deps;
+    layer_deps.twcc_sender = nullptr;
+    layer_deps.pacer = nullptr;
+    for(size_t layer = 1; layer < rids.size(); ++layer) {
+        auto& rtp_session = _simulcast->layers.emplace_back(rtp::Session::Dependencies(layer_deps), rtp::Session::Options(options));
+        rtp_session.SetEventCallback([](rtp::session::Event&&) {});
+        rtp_session.SetSendRtpCallback([](Buffer&&) {});
+        rtp_session.SetSendRtcpCallback([this](Buffer&& packet) {
+            _srtp_encryptor->Encrypt(std::move(packet), false);
+        });
+        rtp_session.SetRecvRtpCallback([this, media_idx, layer](Buffer&& packet) {
+            RecvRtp(media_idx, layer, std::move(packet));
+        });
+    }
+
+    auto& forwarder = _simulcast->forwarder;
+    forwarder.SetTargetLayer(0);
+    forwarder.SetCallback([this, media_idx](Buffer&& packet) {
+        _recv_rtp_callback(media_idx, std::move(packet));
+    });
+    forwarder.SetKeyFrameRequestCallback([this](size_t layer) {
+        auto& rtp_session = (layer == 0) ? _rtp_sessions.at(_simulcast->media_idx) : _simulcast->layers.at(layer - 1);
+        rtp_session.PushEvent(rtp::session::Event::kPli);
+    });
+}
+
 void PeerConnection::SetRemoteIceCandidateInternal(ice::CandidateStr candidate) {
     if(!_ice_agent) {
         TAU_LOG_WARNING(_options.log_ctx << "ICE agent isn't initialized");
@@ -508,12 +752,21 @@ void PeerConnection::SetRemoteIceCandidateInternal(ice::CandidateStr candidate)
     }
 }
 
+void PeerConnection::SendUdp(size_t socket_idx, Buffer&& packet, const Endpoint& remote_endpoint) {
+    if(_deps.udp_mux) {
+        _deps.udp_mux->Send(std::move(packet), remote_endpoint);
+    } else {
+        _udp_sockets.at(socket_idx)->Send(std::move(packet), remote_endpoint);
+    }
+}
+
 // https://datatracker.ietf.org/doc/html/rfc7983#section-7
 void PeerConnection::DemuxIncomingPacket(size_t socket_idx, Buffer&& packet, Endpoint remote_endpoint) {
     const auto view = packet.GetView();
     if(view.size == 0) {
         return;
     }
+    RequestWakeup();
     const auto byte = view.ptr[0];
     if((byte <= 3) || ((64 <= byte) && (byte <= 79))) {
         TAU_LOG_DEBUG(_options.log_ctx << "[STUN/TURN] size: " << view.size << ", socket: " << socket_idx << ", remote: " << remote_endpoint);
@@ -548,11 +801,65 @@ void PeerConnection::OnIncomingRtpRtcp(Buffer&& packet) {
         };
     } else {
         if(rtp::Reader::Validate(view)) {
-            if(!_srtp_decryptor->Decrypt(std::move(packet), true)) {
-                TAU_LOG_INFO_THR(128, _options.log_ctx << "SRTP decryption failed, packet size: " << view.size);
-            }
+            _srtp_rx_batch.push_back(std::move(packet));
+        }
+    }
+}
+
+void PeerConnection::DecryptRtpBatch() {
+    if(_srtp_rx_batch.empty()) {
+        return;
+    }
+    const auto processed = _srtp_decryptor->DecryptBatch(_srtp_rx_batch, true);
+    if(processed != _srtp_rx_batch.size()) {
+        TAU_LOG_INFO_THR(128, _options.log_ctx << "SRTP decryption failed, packets: " << (_srtp_rx_batch.size() - processed));
+    }
+    _srtp_rx_batch.clear();
+}
+
+void PeerConnection::EncryptRtpBatch() {
+    if(_srtp_tx_batch.empty()) {
+        return;
+    }
+    _srtp_encryptor->EncryptBatch(_srtp_tx_batch, true);
+    _srtp_tx_batch.clear();
+}
+
+void PeerConnection::RecvRtp(size_t media_idx, size_t layer, Buffer&& packet) {
+    if(!_simulcast || (_simulcast->media_idx != media_idx)) {
+        _recv_rtp_callback(media_idx, std::move(packet));
+        return;
+    }
+    const auto payload = rtp::Reader(ToConst(packet.GetView())).Payload();
+    const auto key_frame = _simulcast->h265
+        ? rtp::H265Depacketizer::IsKeyFrameStart(payload)
+        : rtp::H264Depacketizer::IsKeyFrameStart(payload);
+    _simulcast->forwarder.Push(layer, std::move(packet), key_frame);
+}
+
+rtp::Session& PeerConnection::GetRecvSession(size_t media_idx) {
+    if(_simulcast && (_simulcast->media_idx == media_idx)) {
+        const auto layer = _simulcast->forwarder.GetLayer().value_or(0);
+        if(layer != 0) {
+            return _simulcast->layers.at(layer - 1);
         }
     }
+    return _rtp_sessions.at(media_idx);
+}
+
+void PeerConnection::RequestWakeup() {
+    if(!_wakeup_requested) {
+        _wakeup_requested = true;
+        if(_wakeup_callback) {
+            _wakeup_callback();
+        }
+    }
+}
+
+void PeerConnection::OnSocketReady() {
+    if(!_sockets_ready.exchange(true) && _wakeup_callback) {
+        _wakeup_callback();
+    }
 }
 
 ice::Credentials PeerConnection::CreateIceCredentials(const sdp::Sdp& local, const sdp::Sdp& remote) {
@@ -568,6 +875,23 @@ ice::Credentials PeerConnection::CreateIceCredentials(const sdp::Sdp& local, con
     };
 }
 
+// MID and RID header extensions identify the remote streams w/o a=ssrc, e.g. simulcast layers
+void PeerConnection::AddDemuxExtensions(sdp::Media& media) {
+    uint8_t id = 1;
+    auto next_free_id = [&media, &id]() {
+        while((media.twcc_extension_id == id) || (media.mid_extension_id == id)
+           || (media.rid_extension_id == id) || (media.repaired_rid_extension_id == id)) {
+            ++id;
+        }
+        return id;
+    };
+    for(auto* extension_id : {&media.mid_extension_id, &media.rid_extension_id, &media.repaired_rid_extension_id}) {
+        if(!*extension_id) {
+            *extension_id = next_free_id();
+        }
+    }
+}
+
 bool PeerConnection::ValidateSdpOffer(const sdp::Sdp& sdp, const etl::string_view& log_ctx) {
     if(sdp.bundle_mids.empty() || (sdp.bundle_mids.size() != sdp.medias.size())) {
         TAU_LOG_WARNING(log_ctx << "Sdp offer bundle mids validation failed");
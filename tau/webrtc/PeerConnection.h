@@ -1,17 +1,22 @@
 #pragma once
 
 #include "tau/webrtc/MediaDemuxer.h"
+#include "tau/webrtc/UdpMux.h"
 #include "tau/webrtc/State.h"
 #include "tau/webrtc/Event.h"
 #include "tau/ice/Agent.h"
 #include "tau/dtls/Session.h"
 #include "tau/srtp/Session.h"
 #include "tau/rtp-session/Session.h"
+#include "tau/rtp-session/SimulcastForwarder.h"
 #include "tau/net/UdpSocket.h"
 #include "tau/mdns/Client.h"
 #include "tau/crypto/Certificate.h"
 #include "tau/common/SystemClock.h"
 #include "tau/common/Random.h"
+#include <vector>
+#include <deque>
+#include <atomic>
 
 namespace tau::webrtc {
 
@@ -20,6 +25,7 @@ public:
     struct Dependencies {
         Clock& clock;
         Allocator& udp_allocator;
+        UdpMux* udp_mux = nullptr; // shared socket instead of own sockets per interface, received by the owner
     };
 
     struct Options {
@@ -37,6 +43,9 @@ public:
             std::optional<Mdns> mdns = std::nullopt;
         };
         Ice ice = {};
+        std::optional<rtp::session::Pacer::Options> pacer = std::nullopt; // bitrate follows TWCC estimation if negotiated
+        size_t rtp_buffer_max_bytes = kRtpBufferMaxBytes; // per send/recv buffer of RTP session, bounded by the allocator capacity
+        bool simulcast_by_bitrate = false; // received simulcast layer follows TWCC estimation (e.g. it's sent back), SetSimulcastLayer otherwise
         struct Debug {
             std::optional<double> loss_rate = std::nullopt;
         };
@@ -48,9 +57,16 @@ public:
     using IceCandidateCallback = std::function<void(ice::CandidateStr candidate)>; //TODO: ice callback alias?
     using Callback = std::function<void(size_t media_idx, Buffer&& packet)>;
     using EventCallback = std::function<void(size_t media_idx, Event&& event)>;
+    using WakeupCallback = std::function<void()>;
 
     using SdpStr = etl::string<8192>;
 
+    static constexpr size_t kUdpTxBatchSize = 32;
+    static constexpr size_t kRtpBufferMaxBytes = 1024 * 1024;
+    static constexpr size_t kRtpBufferCapacityShare = 16; // a buffer takes up to 1/16 of the allocator capacity shared by sessions
+    static constexpr size_t kIceUfragSize = 4;
+    static constexpr size_t kIceUfragSizeShared = 8; // fewer collisions between UdpMux sessions
+
 public:
     PeerConnection(Dependencies&& deps, Options&& options);
     ~PeerConnection();
@@ -59,10 +75,17 @@ public:
     void SetIceCandidateCallback(IceCandidateCallback callback) { _ice_candidate_callback = std::move(callback); }
     void SetRecvRtpCallback(Callback callback) { _recv_rtp_callback = std::move(callback); }
     void SetEventCallback(EventCallback callback) { _event_callback = std::move(callback); }
+    void SetWakeupCallback(WakeupCallback callback) { _wakeup_callback = std::move(callback); }
 
     void Start(); // ICE/DTLS start
     void Stop();
     void Process();
+    void Flush(); // sends outgoing packets batched since the last Process/Flush, Send* methods flush out of Process
+
+    // the earliest ICE/DTLS/RTP deadline, Process isn't needed before it (e.g. timer wheel driven sessions),
+    // wakeup callback is called once an incoming packet or candidate requires Process earlier.
+    // NOTE: own sockets call it from their rx threads, set it before Start and make it thread-safe (e.g. post to the executor)
+    std::optional<Timepoint> GetNextDeadline();
 
     void CreateSdpOffer();
     bool ProcessSdpOffer(const etl::string_view& offer);
@@ -71,7 +94,9 @@ public:
     void SetRemoteIceCandidate(ice::CandidateStr candidate);
 
     void SendRtp(size_t media_idx, Buffer&& packet);
+    void SendRtp(size_t media_idx, SgBuffer&& packet); // e.g. H264Packetizer SG mode, gathered before SRTP
     void SendEvent(size_t media_idx, Event&& event);
+    void SetSimulcastLayer(size_t media_idx, size_t layer); // received simulcast layer (a=simulcast order), the first by default
 
     const sdp::Sdp& GetLocalSdp() const;
     const sdp::Sdp& GetRemoteSdp() const;
@@ -80,18 +105,27 @@ public:
     State GetState() const;
 
 private:
-    void StartIceAgent();
+    bool StartIceAgent();
     void StartDtlsSession();
     void InitMdnsClient();
     void InitMediaDemuxer();
+    void InitSimulcast(const rtp::Session::Dependencies& deps, const rtp::Session::Options& options, size_t media_idx);
 
     void SetRemoteIceCandidateInternal(ice::CandidateStr candidate);
 
+    void SendUdp(size_t socket_idx, Buffer&& packet, const Endpoint& remote_endpoint);
     void DemuxIncomingPacket(size_t socket_idx, Buffer&& packet, Endpoint remote_endpoint);
     void OnIncomingRtpRtcp(Buffer&& packet);
+    void DecryptRtpBatch(); // of the received datagrams
+    void EncryptRtpBatch(); // of the packets sent by Process
+    void RecvRtp(size_t media_idx, size_t layer, Buffer&& packet);
+    rtp::Session& GetRecvSession(size_t media_idx); // of the forwarded simulcast layer
+    void RequestWakeup();
+    void OnSocketReady(); // rx thread
 
     static ice::Credentials CreateIceCredentials(const sdp::Sdp& local, const sdp::Sdp& remote);
     static bool ValidateSdpOffer(const sdp::Sdp& sdp, const etl::string_view& log_ctx);
+    static void AddDemuxExtensions(sdp::Media& media);
 
 private:
     Dependencies _deps;
@@ -113,7 +147,8 @@ private:
     std::optional<ice::Agent> _ice_agent;
     etl::vector<net::UdpSocketPtr, 3> _udp_sockets;
 
-    etl::string<4> _ice_ufrag;
+    etl::string<8> _ice_ufrag;
+    bool _udp_mux_registered = false; // don't unregister another session with the same ufrag
     etl::string<24> _ice_password;
 
     struct IcePair{
@@ -126,14 +161,33 @@ private:
     std::optional<dtls::Session> _dtls_session;
     std::optional<srtp::Session> _srtp_decryptor;
     std::optional<srtp::Session> _srtp_encryptor;
+    std::vector<Buffer> _srtp_rx_batch;
+    std::vector<Buffer> _srtp_tx_batch;
 
     std::optional<MediaDemuxer> _media_demuxer;
+    std::optional<rtp::session::TwccSender> _twcc_sender;     // shared by all RTP sessions (BUNDLE)
+    std::optional<rtp::session::TwccReceiver> _twcc_receiver;
+    std::optional<rtp::session::Pacer> _pacer;
     etl::vector<rtp::Session, 2> _rtp_sessions;
 
+    // received simulcast video: RTP session per layer (NACK, PLI and RTX of the layer SSRC), the media session receives
+    // the first layer. The selected layer is passed to the recv callback as a single stream
+    struct Simulcast {
+        size_t media_idx;
+        bool h265;
+        std::deque<rtp::Session> layers; // the second and next layers
+        rtp::session::SimulcastForwarder forwarder;
+    };
+    std::optional<Simulcast> _simulcast;
+
     StateCallback _state_callback;
     IceCandidateCallback _ice_candidate_callback;
     Callback _recv_rtp_callback;
     EventCallback _event_callback;
+    WakeupCallback _wakeup_callback;
+    bool _wakeup_requested = false;
+    std::atomic<bool> _sockets_ready = false; // own sockets have queued datagrams
+    bool _processing = false; // outgoing packets are flushed by the end of Process
 
     Random _random;
 };
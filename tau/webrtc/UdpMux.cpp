@@ -0,0 +1,190 @@
+#include "tau/webrtc/UdpMux.h"
+#include "tau/stun/Reader.h"
+#include "tau/stun/attribute/ByteString.h"
+#include "tau/common/Exception.h"
+#include "tau/common/Log.h"
+#include <cassert>
+
+namespace tau::webrtc {
+
+UdpMux::UdpMux(Dependencies&& deps, Options&& options)
+    : _deps(std::move(deps))
+    , _log_ctx(options.log_ctx)
+    , _socket(net::UdpSocket::Create(net::UdpSocket::Options{
+        .allocator = _deps.allocator,
+        .local_address = options.local_address,
+        .local_port = options.local_port,
+        .rx_batch_size = options.rx_batch_size,
+        .tx_batch_size = options.tx_batch_size
+    }))
+{
+    if(!_socket->GetLocalEndpoint()) {
+        TAU_EXCEPTION(std::runtime_error, "Shared UDP socket isn't bound, address: " << options.local_address);
+    }
+    _socket->SetRecvCallback([this](Buffer&& packet, Endpoint remote_endpoint) {
+        OnRecv(std::move(packet), remote_endpoint);
+    });
+}
+
+bool UdpMux::Register(etl::string_view local_ufrag, RecvCallback callback) {
+    CheckThread();
+    if((local_ufrag.size() > Ufrag::MAX_SIZE) || _sessions.full()) {
+        TAU_LOG_WARNING(_log_ctx << "Session isn't registered, ufrag: " << local_ufrag << ", sessions: " << _sessions.size());
+        return false;
+    }
+    auto [it, ok] = _sessions.insert({Ufrag(local_ufrag), Session{.callback = std::move(callback)}});
+    if(!ok) {
+        TAU_LOG_WARNING(_log_ctx << "Session is already registered, ufrag: " << local_ufrag);
+    }
+    return ok;
+}
+
+void UdpMux::Unregister(etl::string_view local_ufrag) {
+    CheckThread();
+    auto session = FindSession(local_ufrag);
+    if(!session) {
+        return;
+    }
+    for(auto it = _endpoint_to_session.begin(); it != _endpoint_to_session.end();) {
+        if(it->second.session == session) {
+            it = _endpoint_to_session.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    _sessions.erase(Ufrag(local_ufrag));
+}
+
+bool UdpMux::Bind(etl::string_view local_ufrag, const Endpoint& remote_endpoint) {
+    CheckThread();
+    auto session = FindSession(local_ufrag);
+    if(!session) {
+        return false;
+    }
+    const auto now = _deps.clock.Now();
+    auto it = _endpoint_to_session.find(remote_endpoint);
+    if(it != _endpoint_to_session.end()) {
+        if(it->second.session != session) {
+            return false;
+        }
+        it->second.last_tp = now;
+        return true;
+    }
+    if(_endpoint_to_session.full()) {
+        RemoveExpired(now);
+    }
+    if(_endpoint_to_session.full()) {
+        TAU_LOG_WARNING_THR(128, _log_ctx << "Endpoints limit is reached, remote: " << remote_endpoint);
+        return false;
+    }
+    _endpoint_to_session.insert({remote_endpoint, Binding{.session = session, .last_tp = now}});
+    return true;
+}
+
+bool UdpMux::Receive() {
+    CheckThread();
+    const auto now = _deps.clock.Now();
+    if(now >= _expiration_tp) {
+        _expiration_tp = now + kExpirationPeriod;
+        RemoveExpired(now);
+    }
+    return _socket->Receive();
+}
+
+void UdpMux::Send(Buffer&& packet, const Endpoint& remote_endpoint) {
+    CheckThread();
+    _socket->Send(std::move(packet), remote_endpoint);
+}
+
+void UdpMux::Flush() {
+    CheckThread();
+    _socket->Flush();
+}
+
+void UdpMux::OnRecv(Buffer&& packet, Endpoint remote_endpoint) {
+    _stats.packets++;
+    if(auto it = _endpoint_to_session.find(remote_endpoint); it != _endpoint_to_session.end()) {
+        it->second.last_tp = _deps.clock.Now();
+        it->second.session->callback(std::move(packet), remote_endpoint);
+        return;
+    }
+
+    // not bound until ICE validates MESSAGE-INTEGRITY and answers (Bind by the session)
+    const auto local_ufrag = GetLocalUfrag(ToConst(packet.GetView()));
+    if(local_ufrag) {
+        if(auto session = FindSession(*local_ufrag)) {
+            _stats.by_ufrag++;
+            session->callback(std::move(packet), remote_endpoint);
+            return;
+        }
+    }
+    TAU_LOG_DEBUG_THR(128, _log_ctx << "Unknown remote: " << remote_endpoint << ", size: " << packet.GetSize());
+    _stats.dropped++;
+}
+
+UdpMux::Session* UdpMux::FindSession(etl::string_view local_ufrag) {
+    if(local_ufrag.size() > Ufrag::MAX_SIZE) {
+        return nullptr;
+    }
+    auto it = _sessions.find(Ufrag(local_ufrag));
+    return (it != _sessions.end()) ? &it->second : nullptr;
+}
+
+void UdpMux::RemoveExpired(Timepoint now) {
+    for(auto it = _endpoint_to_session.begin(); it != _endpoint_to_session.end();) {
+        if(now - it->second.last_tp >= kEndpointTimeout) {
+            TAU_LOG_DEBUG(_log_ctx << "Expired remote: " << it->first);
+            it = _endpoint_to_session.erase(it);
+            _stats.expired++;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UdpMux::CheckThread() {
+#ifndef NDEBUG
+    const auto thread_id = std::this_thread::get_id();
+    if(!_thread_id) {
+        _thread_id = thread_id;
+    }
+    assert((*_thread_id == thread_id) && "UdpMux is used from another thread");
+#endif
+}
+
+bool UdpMux::IsBindable(const BufferViewConst& view) {
+    if((view.size == 0) || (view.ptr[0] > 3) || !stun::HeaderReader::Validate(view)) {
+        return true; // ChannelData to TURN server
+    }
+    switch(stun::HeaderReader::GetType(view)) {
+        case stun::kBindingResponse:      return true; // ICE answers authenticated checks only
+        case stun::kBindingRequest:       return !GetLocalUfrag(view).has_value(); // STUN server, checks have USERNAME
+        case stun::kBindingErrorResponse: return false;
+        case stun::kBindingIndication:    return false;
+        default:                          return true; // TURN server
+    }
+}
+
+std::optional<etl::string_view> UdpMux::GetLocalUfrag(const BufferViewConst& view) {
+    if((view.size == 0) || (view.ptr[0] > 3) || !stun::HeaderReader::Validate(view)) {
+        return std::nullopt;
+    }
+    if(stun::HeaderReader::GetType(view) != stun::kBindingRequest) {
+        return std::nullopt;
+    }
+
+    std::optional<etl::string_view> local_ufrag;
+    stun::Reader::ForEachAttribute(view, [&](stun::AttributeType type, const BufferViewConst& attr) {
+        if((type == stun::AttributeType::kUserName) && stun::attribute::ByteStringReader::Validate(attr)) {
+            const auto user_name = stun::attribute::ByteStringReader::GetValue(attr);
+            if(auto pos = user_name.find(':'); pos != etl::string_view::npos) {
+                local_ufrag = user_name.substr(0, pos);
+            }
+            return false;
+        }
+        return true;
+    });
+    return local_ufrag;
+}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "tau/net/UdpSocket.h"
+#include "tau/common/Clock.h"
+#include <etl/unordered_map.h>
+#include <etl/string.h>
+#include <thread>
+
+namespace tau::webrtc {
+
+// Shared UDP socket for many PeerConnections on a single port (ICE-lite servers style).
+// Incoming packets are demultiplexed by remote endpoint. STUN Binding requests from unknown endpoints are passed
+// to the session by the local ufrag from USERNAME ("local:remote") without binding: the endpoint is bound by
+// Bind() when ICE answers the authenticated request. Endpoints without incoming packets expire.
+// Not thread-safe: the owner receives and all sessions sharing the mux are processed on one thread (asserted in debug)
+class UdpMux {
+public:
+    static constexpr size_t kMaxSessions = 2048;
+    static constexpr size_t kMaxEndpoints = 4 * kMaxSessions;
+    static constexpr Timepoint kEndpointTimeout = 30 * kSec; // ICE consent freshness
+    static constexpr Timepoint kExpirationPeriod = 1 * kSec;
+
+    struct Dependencies {
+        Clock& clock;
+        Allocator& allocator;
+    };
+
+    struct Options {
+        IpAddress local_address;
+        std::optional<uint16_t> local_port = std::nullopt;
+        size_t rx_batch_size = 32;
+        size_t tx_batch_size = 32;
+        etl::string_view log_ctx = {};
+    };
+
+    using Ufrag = etl::string<32>;
+    using RecvCallback = net::UdpSocket::RecvCallback;
+
+    struct Stats {
+        size_t packets = 0;
+        size_t by_ufrag = 0; // unbound Binding requests passed to the session
+        size_t expired = 0;
+        size_t dropped = 0;
+    };
+
+public:
+    UdpMux(Dependencies&& deps, Options&& options);
+
+    bool Register(etl::string_view local_ufrag, RecvCallback callback);
+    void Unregister(etl::string_view local_ufrag);
+    bool Bind(etl::string_view local_ufrag, const Endpoint& remote_endpoint); // replies come w/o USERNAME, see IsBindable
+
+    bool Receive(); // dispatches incoming packets to the registered callbacks
+    void Send(Buffer&& packet, const Endpoint& remote_endpoint);
+    void Flush();
+
+    const std::optional<Endpoint>& GetLocalEndpoint() const { return _socket->GetLocalEndpoint(); }
+    size_t GetSessionsCount() const { return _sessions.size(); }
+    size_t GetEndpointsCount() const { return _endpoint_to_session.size(); }
+    const Stats& GetStats() const { return _stats; }
+
+private:
+    struct Session {
+        RecvCallback callback;
+    };
+
+    struct Binding {
+        Session* session;
+        Timepoint last_tp;
+    };
+
+    void OnRecv(Buffer&& packet, Endpoint remote_endpoint);
+    Session* FindSession(etl::string_view local_ufrag);
+    void RemoveExpired(Timepoint now);
+    void CheckThread();
+
+public:
+    // outgoing ICE message validates its remote: a response to the authenticated check or a STUN/TURN server transaction,
+    // not a check to the unvalidated pair
+    static bool IsBindable(const BufferViewConst& view);
+
+private:
+    static std::optional<etl::string_view> GetLocalUfrag(const BufferViewConst& view);
+
+private:
+    Dependencies _deps;
+    const etl::string_view _log_ctx;
+    net::UdpSocketPtr _socket;
+    std::optional<std::thread::id> _thread_id; // latched by the first call
+
+    etl::unordered_map<Ufrag, Session, kMaxSessions> _sessions;
+    etl::unordered_map<Endpoint, Binding, kMaxEndpoints> _endpoint_to_session;
+    Timepoint _expiration_tp = 0;
+
+    Stats _stats;
+};
+
+}
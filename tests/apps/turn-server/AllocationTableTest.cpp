@@ -0,0 +1,99 @@
+#include "apps/turn-server/AllocationTable.h"
+#include "tests/lib/Common.h"
+
+namespace tau {
+
+using namespace tau::net;
+
+class AllocationTableTest : public ::testing::Test {
+public:
+    static inline const Endpoint kClient1{MakeIpAddressV4("192.168.0.1"), 11111};
+    static inline const Endpoint kClient2{MakeIpAddressV4("192.168.0.2"), 22222};
+    static inline const Endpoint kPeer1{MakeIpAddressV4("10.0.0.1"), 33333};
+    static inline const Endpoint kPeer2{MakeIpAddressV4("10.0.0.2"), 44444};
+
+protected:
+    static AllocationTable::Allocation CreateAllocation(Endpoint client, uint16_t relay_port) {
+        return AllocationTable::Allocation{
+            .client = client,
+            .relay_port = relay_port,
+            .user = "user",
+            .nonce = "nonce",
+            .hasher = nullptr,
+            .transaction_hash = 0,
+            .expire_tp = 600 * kSec
+        };
+    }
+};
+
+TEST_F(AllocationTableTest, Basic) {
+    AllocationTable table(2);
+    const auto id1 = table.Insert(CreateAllocation(kClient1, 50000));
+    const auto id2 = table.Insert(CreateAllocation(kClient2, 50001));
+    ASSERT_TRUE(id1);
+    ASSERT_TRUE(id2);
+    ASSERT_NE(*id1, *id2);
+    ASSERT_EQ(2, table.GetSize());
+    ASSERT_FALSE(table.Insert(CreateAllocation(kPeer1, 50002))); // full
+
+    ASSERT_EQ(id1, table.FindByClient(kClient1));
+    ASSERT_EQ(id2, table.FindByClient(kClient2));
+    ASSERT_EQ(id1, table.FindByRelayPort(50000));
+    ASSERT_EQ(id2, table.FindByRelayPort(50001));
+    ASSERT_FALSE(table.FindByClient(kPeer1));
+    ASSERT_FALSE(table.FindByRelayPort(50002));
+    ASSERT_EQ(50001, table.Get(*id2)->relay_port);
+
+    table.Erase(*id1);
+    ASSERT_EQ(1, table.GetSize());
+    ASSERT_EQ(nullptr, table.Get(*id1));
+    ASSERT_FALSE(table.FindByClient(kClient1));
+    ASSERT_FALSE(table.FindByRelayPort(50000));
+
+    ASSERT_FALSE(table.Insert(CreateAllocation(kClient2, 50003))); // the same client
+    ASSERT_FALSE(table.Insert(CreateAllocation(kClient1, 50001))); // the same relay port
+    const auto id3 = table.Insert(CreateAllocation(kClient1, 50003));
+    ASSERT_EQ(id1, id3); // reused
+}
+
+TEST_F(AllocationTableTest, Permissions) {
+    auto allocation = CreateAllocation(kClient1, 50000);
+    ASSERT_FALSE(allocation.HasPermission(kPeer1.address, 0));
+    ASSERT_TRUE(allocation.AddPermission(kPeer1.address, 300 * kSec, 0));
+    ASSERT_TRUE(allocation.HasPermission(kPeer1.address, 299 * kSec));
+    ASSERT_FALSE(allocation.HasPermission(kPeer1.address, 300 * kSec));
+    ASSERT_FALSE(allocation.HasPermission(kPeer2.address, 0));
+
+    ASSERT_TRUE(allocation.AddPermission(kPeer1.address, 600 * kSec, 299 * kSec)); // refresh
+    ASSERT_TRUE(allocation.HasPermission(kPeer1.address, 599 * kSec));
+
+    for(size_t i = 1; i < AllocationTable::kMaxPermissions; ++i) {
+        ASSERT_TRUE(allocation.AddPermission(IpAddress{static_cast<uint32_t>(i)}, 100 * kSec, 0));
+    }
+    ASSERT_FALSE(allocation.AddPermission(kPeer2.address, 200 * kSec, 0));
+    ASSERT_TRUE(allocation.AddPermission(kPeer2.address, 200 * kSec, 100 * kSec)); // expired are removed
+    ASSERT_TRUE(allocation.HasPermission(kPeer2.address, 100 * kSec));
+    ASSERT_TRUE(allocation.HasPermission(kPeer1.address, 100 * kSec));
+}
+
+TEST_F(AllocationTableTest, Channels) {
+    auto allocation = CreateAllocation(kClient1, 50000);
+    ASSERT_TRUE(allocation.BindChannel(0x4000, kPeer1, 600 * kSec, 0));
+    ASSERT_TRUE(allocation.BindChannel(0x4000, kPeer1, 700 * kSec, 100 * kSec)); // refresh
+    ASSERT_FALSE(allocation.BindChannel(0x4000, kPeer2, 700 * kSec, 100 * kSec)); // channel is bound to another peer
+    ASSERT_FALSE(allocation.BindChannel(0x4001, kPeer1, 700 * kSec, 100 * kSec)); // peer is bound to another channel
+    ASSERT_TRUE(allocation.BindChannel(0x4001, kPeer2, 700 * kSec, 100 * kSec));
+
+    auto channel = allocation.FindChannel(0x4000, 699 * kSec);
+    ASSERT_NE(nullptr, channel);
+    ASSERT_EQ(kPeer1, channel->peer);
+    ASSERT_EQ(0x4001, allocation.FindChannel(kPeer2, 0));
+    ASSERT_EQ(nullptr, allocation.FindChannel(0x4002, 0));
+
+    ASSERT_EQ(nullptr, allocation.FindChannel(0x4000, 700 * kSec));
+    ASSERT_FALSE(allocation.FindChannel(kPeer1, 700 * kSec));
+    ASSERT_TRUE(allocation.BindChannel(0x4002, kPeer1, 1400 * kSec, 700 * kSec)); // expired binding is removed
+    ASSERT_EQ(0x4002, allocation.FindChannel(kPeer1, 700 * kSec));
+}
+
+}
@@ -0,0 +1,562 @@
+#include "apps/turn-server/TurnServer.h"
+#include "tau/ice/TurnClient.h"
+#include "tau/ice/Credentials.h"
+#include "tau/stun/Reader.h"
+#include "tau/stun/Writer.h"
+#include "tau/stun/ChannelData.h"
+#include "tau/stun/attribute/XorMappedAddress.h"
+#include "tau/stun/attribute/DataUint32.h"
+#include "tau/stun/attribute/ByteString.h"
+#include "tau/stun/attribute/Data.h"
+#include "tau/stun/attribute/ErrorCode.h"
+#include "tau/stun/attribute/MessageIntegrity.h"
+#include "tau/stun/attribute/Fingerprint.h"
+#include "tau/net/Port.h"
+#include "tests/lib/Common.h"
+#include <deque>
+#include <set>
+
+namespace tau {
+
+using namespace tau::net;
+using namespace tau::stun;
+using namespace tau::stun::attribute;
+
+class TurnServerTest : public ::testing::Test {
+public:
+    static inline const Endpoint kClient{MakeIpAddressV4("192.168.0.77"), 44444};
+    static inline const Endpoint kServer{MakeIpAddressV4("111.111.111.111"), kTurnUdpPort};
+    static inline const Endpoint kPeer{MakeIpAddressV4("99.0.0.1"), 55555};
+    static constexpr uint16_t kRelayPortFirst = 50000;
+    static constexpr etl::string_view kUser = "user";
+    static constexpr etl::string_view kPassword = "password";
+
+    struct ToPeer {
+        uint16_t relay_port;
+        Endpoint peer;
+        Buffer packet;
+    };
+
+public:
+    explicit TurnServerTest(bool allow_private_peers = false)
+        : _server(
+            TurnServer::Dependencies{.clock = _clock, .udp_allocator = g_udp_allocator},
+            TurnServer::Options{
+                .relay_address = kServer.address,
+                .users = {{std::string{kUser.data(), kUser.size()}, std::string{kPassword.data(), kPassword.size()}}},
+                .allow_private_peers = allow_private_peers
+            }) {
+        _server.SetSendCallback([this](Buffer&& packet, Endpoint client) {
+            EXPECT_EQ(kClient, client);
+            _to_client.push_back(std::move(packet));
+        });
+        _server.SetRelayCallback([this](uint16_t relay_port, Buffer&& packet, Endpoint peer) {
+            _to_peer.push_back(ToPeer{.relay_port = relay_port, .peer = peer, .packet = std::move(packet)});
+        });
+        _server.SetOpenRelayCallback([this]() -> std::optional<uint16_t> {
+            if(!_relays_available) {
+                return std::nullopt;
+            }
+            _relays.insert(_next_relay_port);
+            return _next_relay_port++;
+        });
+        _server.SetCloseRelayCallback([this](uint16_t relay_port) {
+            EXPECT_EQ(1, _relays.erase(relay_port));
+        });
+    }
+
+protected:
+    void InitClient() {
+        _client.emplace(
+            ice::TurnClient::Dependencies{.clock = _clock, .udp_allocator = g_udp_allocator},
+            ice::TurnClient::Options{.server = kServer, .credentials = {kUser, kPassword}});
+        _client->SetCandidateCallback([this](Endpoint relayed) {
+            _relayed = relayed;
+        });
+        _client->SetSendCallback([this](Endpoint remote, Buffer&& packet) {
+            EXPECT_EQ(kServer, remote);
+            _to_server.push_back(std::move(packet));
+        });
+        _client->SetRecvCallback([this](Endpoint remote, Buffer&& packet) {
+            _from_peer.emplace_back(remote, std::move(packet));
+        });
+    }
+
+    void Pump() {
+        while(!_to_server.empty() || (_client && !_to_client.empty())) {
+            while(!_to_server.empty()) {
+                auto packet = std::move(_to_server.front());
+                _to_server.pop_front();
+                _server.RecvFromClient(std::move(packet), kClient);
+            }
+            while(_client && !_to_client.empty()) {
+                auto packet = std::move(_to_client.front());
+                _to_client.pop_front();
+                _client->Recv(std::move(packet));
+            }
+        }
+    }
+
+    void Process(Timepoint period = 50 * kMs) {
+        _clock.Add(period);
+        if(_client) {
+            _client->Process();
+        }
+        _server.Process();
+        Pump();
+    }
+
+    void AllocateByClient() {
+        InitClient();
+        for(size_t i = 0; (i < 10) && !_relayed; ++i) {
+            Process();
+        }
+        ASSERT_TRUE(_relayed);
+        ASSERT_EQ((Endpoint{kServer.address, kRelayPortFirst}), *_relayed);
+        ASSERT_EQ(1, _server.GetAllocationsCount());
+    }
+
+    static Buffer CreatePacket(size_t size, size_t headroom = TurnServer::kRelayHeadroom) {
+        auto packet = Buffer::Create(g_udp_allocator);
+        packet.ReserveHeadroom(headroom);
+        packet.SetSize(size);
+        for(size_t i = 0; i < size; ++i) {
+            packet.GetView().ptr[i] = static_cast<uint8_t>(i);
+        }
+        return packet;
+    }
+
+    static void AssertPacket(const BufferViewConst& view, size_t target_size) {
+        ASSERT_EQ(target_size, view.size);
+        for(size_t i = 0; i < target_size; ++i) {
+            ASSERT_EQ(static_cast<uint8_t>(i), view.ptr[i]);
+        }
+    }
+
+    // raw client: hand-crafted requests, responses are left in _to_client
+    void SendRequest(uint16_t type, const std::function<void(stun::Writer&)>& write_attributes, bool authenticated = true) {
+        auto request = Buffer::Create(g_udp_allocator);
+        auto view = request.GetViewWithCapacity();
+        stun::Writer writer(view, type);
+        GenerateTransactionId(view.ptr + 2 * sizeof(uint32_t));
+        write_attributes(writer);
+        if(authenticated) {
+            ByteStringWriter::Write(writer, AttributeType::kUserName, kUser);
+            ByteStringWriter::Write(writer, AttributeType::kRealm, _realm);
+            ByteStringWriter::Write(writer, AttributeType::kNonce, _nonce);
+            MessageIntegrityWriter::Write(writer, *_hasher);
+        }
+        FingerprintWriter::Write(writer);
+        request.SetSize(writer.GetSize());
+        _server.RecvFromClient(std::move(request), kClient);
+    }
+
+    Buffer PopResponse() {
+        EXPECT_EQ(1, _to_client.size());
+        auto response = std::move(_to_client.front());
+        _to_client.pop_front();
+        return response;
+    }
+
+    // error code, 0 for success, validates MESSAGE-INTEGRITY if present
+    uint16_t ParseResponse(const Buffer& response, uint16_t target_type) {
+        const auto view = response.GetView();
+        EXPECT_TRUE(Reader::Validate(view));
+        const auto type = HeaderReader::GetType(view);
+        EXPECT_EQ(target_type, type & ~Type::kErrorResponse);
+        uint16_t code = 0;
+        EXPECT_TRUE(Reader::ForEachAttribute(view, [&](AttributeType attr_type, const BufferViewConst& attr) {
+            switch(attr_type) {
+                case AttributeType::kErrorCode:
+                    code = ErrorCodeReader::GetCode(attr);
+                    break;
+                case AttributeType::kRealm:
+                    _realm = ByteStringReader::GetValue(attr);
+                    break;
+                case AttributeType::kNonce:
+                    _nonce = ByteStringReader::GetValue(attr);
+                    break;
+                case AttributeType::kXorRelayedAddress:
+                    _relayed = Endpoint{
+                        .address = IpAddress{XorMappedAddressReader::GetAddressV4(attr)},
+                        .port = XorMappedAddressReader::GetPort(attr)
+                    };
+                    break;
+                case AttributeType::kMessageIntegrity:
+                    return MessageIntegrityReader::Validate(attr, view, *_hasher);
+                default:
+                    break;
+            }
+            return true;
+        }));
+        EXPECT_EQ(code != 0, (type & Type::kErrorResponse) == Type::kErrorResponse);
+        return code;
+    }
+
+    void InitHasher(etl::string_view password) {
+        std::array<uint8_t, ice::kLongTermPassword> key;
+        ASSERT_TRUE(ice::CalcLongTermPassword({kUser, password}, _realm, key.data()));
+        _hasher.emplace(crypto::HmacHasher::Type::Sha1, etl::string_view{reinterpret_cast<const char*>(key.data()), key.size()});
+    }
+
+    void AllocateRaw(etl::string_view password = kPassword, uint32_t transport = 0x11 << 24) {
+        SendRequest(kAllocateRequest, [](stun::Writer&) {}, false);
+        ASSERT_EQ(ErrorCode::kUnauthorized, ParseResponse(PopResponse(), kAllocateRequest));
+        ASSERT_FALSE(_realm.empty());
+        ASSERT_FALSE(_nonce.empty());
+        InitHasher(password);
+        SendRequest(kAllocateRequest, [transport](stun::Writer& writer) {
+            DataUint32Writer::Write(writer, AttributeType::kRequestedTransport, transport);
+        });
+    }
+
+    void SendCreatePermission(IpAddress peer) {
+        SendRequest(kCreatePermissionRequest, [&](stun::Writer& writer) {
+            XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, peer.GetUint32(), 0);
+        });
+    }
+
+    void SendChannelBind(uint16_t channel, Endpoint peer) {
+        SendRequest(kChannelBindRequest, [&](stun::Writer& writer) {
+            DataUint32Writer::Write(writer, AttributeType::kChannelNumber, static_cast<uint32_t>(channel) << 16);
+            XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, peer.address.GetUint32(), peer.port);
+        });
+    }
+
+protected:
+    TestClock _clock;
+    TurnServer _server;
+    std::optional<ice::TurnClient> _client;
+    std::optional<Endpoint> _relayed;
+
+    bool _relays_available = true;
+    uint16_t _next_relay_port = kRelayPortFirst;
+    std::set<uint16_t> _relays;
+
+    std::deque<Buffer> _to_server;
+    std::deque<Buffer> _to_client;
+    std::vector<ToPeer> _to_peer;
+    std::vector<std::pair<Endpoint, Buffer>> _from_peer;
+
+    etl::string<64> _realm;
+    etl::string<64> _nonce;
+    std::optional<crypto::HmacHasher> _hasher;
+};
+
+TEST_F(TurnServerTest, TurnClient) {
+    ASSERT_NO_FATAL_FAILURE(AllocateByClient());
+    ASSERT_EQ(1, _relays.size());
+
+    _client->Send(CreatePacket(100), kPeer);
+    Pump();
+    ASSERT_TRUE(_client->HasPermission(kPeer.address));
+    ASSERT_EQ(1, _to_peer.size());
+    ASSERT_EQ(kRelayPortFirst, _to_peer[0].relay_port);
+    ASSERT_EQ(kPeer, _to_peer[0].peer);
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToConst(_to_peer[0].packet.GetView()), 100));
+
+    for(size_t size : {1, 2, 3, 4, 1000}) {
+        _server.RecvFromPeer(kRelayPortFirst, CreatePacket(size), kPeer);
+        Pump();
+        ASSERT_EQ(1, _from_peer.size());
+        ASSERT_EQ(kPeer, _from_peer[0].first);
+        ASSERT_NO_FATAL_FAILURE(AssertPacket(ToConst(_from_peer[0].second.GetView()), size));
+        _from_peer.clear();
+    }
+    ASSERT_EQ(0, _server.GetStats().to_client_copied);
+
+    _server.RecvFromPeer(kRelayPortFirst, CreatePacket(200, 0), kPeer); // no headroom
+    Pump();
+    ASSERT_EQ(1, _from_peer.size());
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToConst(_from_peer[0].second.GetView()), 200));
+    ASSERT_EQ(1, _server.GetStats().to_client_copied);
+
+    _server.RecvFromPeer(kRelayPortFirst, CreatePacket(100), Endpoint{MakeIpAddressV4("99.0.0.2"), 55555}); // no permission
+    _server.RecvFromPeer(kRelayPortFirst + 1, CreatePacket(100), kPeer); // unknown relay
+    Pump();
+    ASSERT_EQ(1, _from_peer.size());
+    ASSERT_EQ(2, _server.GetStats().dropped);
+
+    _client->Stop();
+    Pump();
+    ASSERT_EQ(0, _server.GetAllocationsCount());
+    ASSERT_TRUE(_relays.empty());
+}
+
+TEST_F(TurnServerTest, TurnClientChannel) {
+    ASSERT_NO_FATAL_FAILURE(AllocateByClient());
+    _client->BindChannel(kPeer);
+    _client->Send(CreatePacket(100), kPeer); // queued until the channel is bound
+    Pump();
+    ASSERT_TRUE(_client->HasChannel(kPeer));
+    ASSERT_EQ(1, _to_peer.size());
+    ASSERT_EQ(kPeer, _to_peer[0].peer);
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToConst(_to_peer[0].packet.GetView()), 100));
+
+    for(size_t size : {1, 2, 3, 4, 1000}) {
+        _server.RecvFromPeer(kRelayPortFirst, CreatePacket(size, kChannelDataHeaderSize), kPeer);
+        Pump();
+        ASSERT_EQ(1, _from_peer.size());
+        ASSERT_EQ(kPeer, _from_peer[0].first);
+        ASSERT_NO_FATAL_FAILURE(AssertPacket(ToConst(_from_peer[0].second.GetView()), size));
+        _from_peer.clear();
+    }
+    ASSERT_EQ(0, _server.GetStats().to_client_copied);
+
+    const auto error_responses = _server.GetStats().error_responses; // 401 of the allocation
+    for(size_t i = 0; i < 2 * TurnServer::kChannelLifetime / kSec; ++i) {
+        Process(kSec); // ChannelBind refresh
+    }
+    ASSERT_TRUE(_client->HasChannel(kPeer));
+    _client->Send(CreatePacket(200, kChannelDataHeaderSize), kPeer);
+    Pump();
+    ASSERT_EQ(2, _to_peer.size());
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToConst(_to_peer[1].packet.GetView()), 200));
+    ASSERT_EQ(error_responses, _server.GetStats().error_responses);
+}
+
+TEST_F(TurnServerTest, RefreshAndExpiration) {
+    ASSERT_NO_FATAL_FAILURE(AllocateByClient());
+    for(size_t i = 0; i < 3 * TurnServer::kLifetimeDefaultSec; ++i) {
+        Process(kSec);
+    }
+    ASSERT_EQ(1, _server.GetAllocationsCount());
+    ASSERT_EQ(1, _relays.size());
+
+    _client.reset(); // no more refresh requests
+    for(size_t i = 0; i < TurnServer::kLifetimeDefaultSec; ++i) {
+        Process(kSec);
+    }
+    ASSERT_EQ(0, _server.GetAllocationsCount());
+    ASSERT_TRUE(_relays.empty());
+}
+
+TEST_F(TurnServerTest, ChannelData) {
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw());
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kAllocateRequest));
+    ASSERT_EQ((Endpoint{kServer.address, kRelayPortFirst}), *_relayed);
+
+    constexpr uint16_t kChannel = 0x4000;
+    SendChannelBind(kChannel, kPeer);
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kChannelBindRequest));
+    SendChannelBind(kChannel, kPeer); // refresh
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kChannelBindRequest));
+
+    // client -> peer: 4-byte header is trimmed
+    auto channel_data = CreatePacket(kChannelDataHeaderSize + 10, 0);
+    ChannelDataWriter::WriteHeader(channel_data.GetView(), kChannel, 10);
+    channel_data.SetSize(kChannelDataHeaderSize + Align(10, sizeof(uint32_t))); // padded
+    const auto payload_ptr = channel_data.GetView().ptr + kChannelDataHeaderSize;
+    _server.RecvFromClient(std::move(channel_data), kClient);
+    ASSERT_EQ(1, _to_peer.size());
+    ASSERT_EQ(kPeer, _to_peer[0].peer);
+    ASSERT_EQ(10, _to_peer[0].packet.GetSize());
+    ASSERT_EQ(payload_ptr, _to_peer[0].packet.GetView().ptr); // zero-copy
+
+    // peer -> client: 4-byte header is prepended
+    auto packet = CreatePacket(100);
+    const auto packet_ptr = packet.GetView().ptr;
+    _server.RecvFromPeer(kRelayPortFirst, std::move(packet), kPeer);
+    auto response = PopResponse();
+    const auto view = ToConst(response.GetView());
+    ASSERT_EQ(kChannelDataHeaderSize + 100, view.size);
+    ASSERT_EQ(packet_ptr, view.ptr + kChannelDataHeaderSize); // zero-copy
+    ASSERT_TRUE(ChannelDataReader::Validate(view));
+    ASSERT_EQ(kChannel, ChannelDataReader::GetChannelNumber(view));
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ChannelDataReader::GetData(view), 100));
+
+    SendChannelBind(kChannelNumberMin - 1, kPeer); // wrong number
+    ASSERT_EQ(ErrorCode::kBadRequest, ParseResponse(PopResponse(), kChannelBindRequest));
+    SendChannelBind(kChannel, Endpoint{MakeIpAddressV4("99.0.0.2"), 55555}); // bound to another peer
+    ASSERT_EQ(ErrorCode::kBadRequest, ParseResponse(PopResponse(), kChannelBindRequest));
+    SendChannelBind(kChannel + 1, kPeer); // peer is bound to another channel
+    ASSERT_EQ(ErrorCode::kBadRequest, ParseResponse(PopResponse(), kChannelBindRequest));
+
+    channel_data = CreatePacket(kChannelDataHeaderSize + 10, 0);
+    ChannelDataWriter::WriteHeader(channel_data.GetView(), kChannel + 1, 10);
+    _server.RecvFromClient(std::move(channel_data), kClient); // unknown channel
+    ASSERT_EQ(1, _to_peer.size());
+    ASSERT_EQ(1, _server.GetStats().dropped);
+
+    // channel binding expires
+    _clock.Add(TurnServer::kChannelLifetime);
+    channel_data = CreatePacket(kChannelDataHeaderSize + 10, 0);
+    ChannelDataWriter::WriteHeader(channel_data.GetView(), kChannel, 10);
+    _server.RecvFromClient(std::move(channel_data), kClient);
+    ASSERT_EQ(1, _to_peer.size());
+}
+
+TEST_F(TurnServerTest, Errors) {
+    SendRequest(kRefreshRequest, [](stun::Writer&) {}, false); // no allocation
+    ASSERT_EQ(ErrorCode::kAllocationMismatch, ParseResponse(PopResponse(), kRefreshRequest));
+
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw("wrong password"));
+    const auto code = ParseResponse(PopResponse(), kAllocateRequest);
+    ASSERT_EQ(ErrorCode::kUnauthorized, code);
+    ASSERT_EQ(0, _server.GetAllocationsCount());
+
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw(kPassword, 0x06 << 24));
+    ASSERT_EQ(ErrorCode::kUnsupportedTransportProtocol, ParseResponse(PopResponse(), kAllocateRequest));
+
+    _relays_available = false;
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw());
+    ASSERT_EQ(ErrorCode::kInsufficientCapacity, ParseResponse(PopResponse(), kAllocateRequest));
+    ASSERT_EQ(0, _server.GetAllocationsCount());
+
+    _relays_available = true;
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw());
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kAllocateRequest));
+    ASSERT_EQ(1, _server.GetAllocationsCount());
+
+    SendRequest(kAllocateRequest, [](stun::Writer& writer) { // another transaction
+        DataUint32Writer::Write(writer, AttributeType::kRequestedTransport, 0x11 << 24);
+    });
+    ASSERT_EQ(ErrorCode::kAllocationMismatch, ParseResponse(PopResponse(), kAllocateRequest));
+
+    SendRequest(kCreatePermissionRequest, [](stun::Writer&) {}); // no peer address
+    ASSERT_EQ(ErrorCode::kBadRequest, ParseResponse(PopResponse(), kCreatePermissionRequest));
+
+    InitHasher("wrong password");
+    SendRequest(kCreatePermissionRequest, [](stun::Writer& writer) {
+        XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, kPeer.address.GetUint32(), 0);
+    });
+    ASSERT_EQ(ErrorCode::kUnauthorized, ParseResponse(PopResponse(), kCreatePermissionRequest));
+
+    InitHasher(kPassword);
+    _nonce = "stale";
+    SendRequest(kRefreshRequest, [](stun::Writer&) {});
+    ASSERT_EQ(ErrorCode::kStaleNonce, ParseResponse(PopResponse(), kRefreshRequest));
+
+    SendRequest(kRefreshRequest, [](stun::Writer& writer) { // nonce of the allocation is returned
+        DataUint32Writer::Write(writer, AttributeType::kLifetime, 0);
+    });
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kRefreshRequest));
+    ASSERT_EQ(0, _server.GetAllocationsCount());
+    ASSERT_TRUE(_relays.empty());
+}
+
+TEST_F(TurnServerTest, NonceRotation) {
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw());
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kAllocateRequest));
+
+    size_t stale_nonces = 0;
+    constexpr Timepoint kRefreshPeriod = TurnServer::kLifetimeDefaultSec * kSec / 2;
+    for(Timepoint elapsed = 0; elapsed < 3 * TurnServer::kNonceLifetime; elapsed += kRefreshPeriod) {
+        _clock.Add(kRefreshPeriod);
+        _server.Process();
+        SendRequest(kRefreshRequest, [](stun::Writer&) {});
+        auto code = ParseResponse(PopResponse(), kRefreshRequest);
+        if(code == ErrorCode::kStaleNonce) { // the rotated nonce is returned
+            stale_nonces++;
+            SendRequest(kRefreshRequest, [](stun::Writer&) {});
+            code = ParseResponse(PopResponse(), kRefreshRequest);
+        }
+        ASSERT_EQ(0, code);
+    }
+    ASSERT_LT(0, stale_nonces);
+    ASSERT_EQ(1, _server.GetAllocationsCount());
+}
+
+TEST_F(TurnServerTest, ChannelBindRollback) {
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw());
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kAllocateRequest));
+
+    std::vector<Endpoint> peers;
+    for(size_t i = 0; i <= AllocationTable::kMaxPermissions; ++i) {
+        peers.push_back(Endpoint{IpAddress{kPeer.address.GetUint32() + static_cast<uint32_t>(i)}, kPeer.port});
+    }
+    for(size_t i = 0; i < AllocationTable::kMaxPermissions; ++i) {
+        SendRequest(kCreatePermissionRequest, [&](stun::Writer& writer) {
+            XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, peers[i].address.GetUint32(), 0);
+        });
+        ASSERT_EQ(0, ParseResponse(PopResponse(), kCreatePermissionRequest));
+    }
+
+    constexpr uint16_t kChannel = 0x4000;
+    SendChannelBind(kChannel, peers.back()); // no room for the permission
+    ASSERT_EQ(ErrorCode::kInsufficientCapacity, ParseResponse(PopResponse(), kChannelBindRequest));
+    SendChannelBind(kChannel, peers.front()); // the channel isn't bound to the failed peer
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kChannelBindRequest));
+}
+
+TEST_F(TurnServerTest, ForbiddenPeers) {
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw());
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kAllocateRequest));
+
+    constexpr uint16_t kChannel = 0x4000;
+    for(auto address : {"127.0.0.1", "127.1.2.3", "169.254.0.1", "10.0.0.1", "172.16.0.1", "172.31.0.1", "192.168.0.1"}) {
+        const auto peer = Endpoint{MakeIpAddressV4(address), 55555};
+        SendCreatePermission(peer.address);
+        ASSERT_EQ(ErrorCode::kForbidden, ParseResponse(PopResponse(), kCreatePermissionRequest)) << address;
+        SendChannelBind(kChannel, peer);
+        ASSERT_EQ(ErrorCode::kForbidden, ParseResponse(PopResponse(), kChannelBindRequest)) << address;
+        ASSERT_EQ(1, _server.GetAllocationsCount());
+    }
+
+    // no permission is added if one of the peers is forbidden
+    SendRequest(kCreatePermissionRequest, [](stun::Writer& writer) {
+        XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, kPeer.address.GetUint32(), 0);
+        XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, MakeIpAddressV4("10.0.0.1").GetUint32(), 0);
+    });
+    ASSERT_EQ(ErrorCode::kForbidden, ParseResponse(PopResponse(), kCreatePermissionRequest));
+    _server.RecvFromPeer(kRelayPortFirst, CreatePacket(100), kPeer);
+    ASSERT_TRUE(_to_client.empty());
+
+    SendCreatePermission(MakeIpAddressV4("172.32.0.1"));
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kCreatePermissionRequest));
+    SendChannelBind(kChannel, kPeer);
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kChannelBindRequest));
+
+    const auto dropped = _server.GetStats().dropped;
+    const uint8_t data[4] = {1, 2, 3, 4};
+    SendRequest(kSendIndication, [&](stun::Writer& writer) {
+        XorMappedAddressWriter::Write(writer, AttributeType::kXorPeerAddress, MakeIpAddressV4("10.0.0.1").GetUint32(), 55555);
+        DataWriter::Write(writer, BufferViewConst{.ptr = data, .size = sizeof(data)});
+    }, false);
+    ASSERT_TRUE(_to_peer.empty());
+    ASSERT_EQ(dropped + 1, _server.GetStats().dropped);
+}
+
+class TurnServerPrivatePeersTest : public TurnServerTest {
+public:
+    TurnServerPrivatePeersTest() : TurnServerTest(true) {}
+};
+
+TEST_F(TurnServerPrivatePeersTest, Allowed) {
+    ASSERT_NO_FATAL_FAILURE(AllocateRaw());
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kAllocateRequest));
+
+    const auto peer = Endpoint{MakeIpAddressV4("192.168.0.1"), 55555};
+    SendCreatePermission(MakeIpAddressV4("127.0.0.1"));
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kCreatePermissionRequest));
+    SendChannelBind(0x4000, peer);
+    ASSERT_EQ(0, ParseResponse(PopResponse(), kChannelBindRequest));
+
+    _server.RecvFromPeer(kRelayPortFirst, CreatePacket(100), peer);
+    ASSERT_EQ(1, _to_client.size());
+}
+
+TEST_F(TurnServerTest, Binding) {
+    auto request = Buffer::Create(g_udp_allocator);
+    stun::Writer writer(request.GetViewWithCapacity(), kBindingRequest);
+    GenerateTransactionId(request.GetViewWithCapacity().ptr + 2 * sizeof(uint32_t));
+    request.SetSize(writer.GetSize());
+    _server.RecvFromClient(std::move(request), kClient);
+
+    auto response = PopResponse();
+    const auto view = ToConst(response.GetView());
+    ASSERT_TRUE(Reader::Validate(view));
+    ASSERT_EQ(kBindingResponse, HeaderReader::GetType(view));
+    bool mapped = false;
+    ASSERT_TRUE(Reader::ForEachAttribute(view, [&](AttributeType type, const BufferViewConst& attr) {
+        if(type == AttributeType::kXorMappedAddress) {
+            mapped = true;
+            EXPECT_EQ(kClient.address.GetUint32(), XorMappedAddressReader::GetAddressV4(attr));
+            EXPECT_EQ(kClient.port, XorMappedAddressReader::GetPort(attr));
+        }
+        return true;
+    }));
+    ASSERT_TRUE(mapped);
+}
+
+}
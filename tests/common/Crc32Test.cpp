@@ -0,0 +1,58 @@
+#include "tau/common/Crc32.h"
+#include "tau/common/host/Crc32.h"
+#include "tests/lib/Common.h"
+#include <boost/crc.hpp>
+
+namespace tau {
+
+class Crc32Test : public ::testing::Test {
+protected:
+    static uint32_t Reference(const uint8_t* data, size_t size) {
+        boost::crc_32_type crc32;
+        crc32.process_bytes(data, size);
+        return crc32.checksum();
+    }
+};
+
+TEST_F(Crc32Test, Basic) {
+    constexpr std::string_view kData = "123456789";
+    const auto data = reinterpret_cast<const uint8_t*>(kData.data());
+    ASSERT_EQ(0xCBF43926, Crc32(data, kData.size()));
+    ASSERT_EQ(0xCBF43926, ~detail::Crc32SliceBy8(~uint32_t{0}, data, kData.size()));
+    ASSERT_EQ(0xCBF43926, ~detail::Crc32Hardware(~uint32_t{0}, data, kData.size()));
+    ASSERT_EQ(0, Crc32(data, 0));
+}
+
+TEST_F(Crc32Test, Randomized) {
+    TAU_LOG_INFO("Hardware CRC32 supported: " << detail::Crc32HardwareSupported());
+    std::vector<uint8_t> data(4096 + 16);
+    for(auto& value : data) {
+        value = g_random.Int<uint8_t>();
+    }
+    for(size_t size = 0; size <= 300; ++size) {
+        for(size_t offset : {0, 1, 3, 8}) {
+            const auto ptr = data.data() + offset;
+            const auto target = Reference(ptr, size);
+            ASSERT_EQ(target, Crc32(ptr, size)) << "size: " << size << ", offset: " << offset;
+            ASSERT_EQ(target, ~detail::Crc32SliceBy8(~uint32_t{0}, ptr, size));
+            ASSERT_EQ(target, ~detail::Crc32Hardware(~uint32_t{0}, ptr, size));
+        }
+    }
+    for(size_t i = 0; i < 100; ++i) {
+        const auto size = g_random.Int<size_t>(0, 4096);
+        ASSERT_EQ(Reference(data.data(), size), Crc32(data.data(), size));
+    }
+}
+
+TEST_F(Crc32Test, Incremental) {
+    std::vector<uint8_t> data(1000);
+    for(auto& value : data) {
+        value = g_random.Int<uint8_t>();
+    }
+    const auto split = g_random.Int<size_t>(0, data.size());
+    auto crc = detail::Crc32Hardware(~uint32_t{0}, data.data(), split);
+    crc = detail::Crc32SliceBy8(crc, data.data() + split, data.size() - split);
+    ASSERT_EQ(Reference(data.data(), data.size()), ~crc);
+}
+
+}
@@ -0,0 +1,127 @@
+#include "tau/common/TimerWheel.h"
+#include "tests/lib/Common.h"
+
+namespace tau {
+
+class TimerWheelTest : public ::testing::Test {
+public:
+    static constexpr Timepoint kStart = 1000 * kSec;
+
+protected:
+    size_t Advance(Timepoint now) {
+        return _wheel.Advance(now, [&](TimerWheel::Id id) {
+            _expired.emplace_back(id, now);
+        });
+    }
+
+protected:
+    TimerWheel _wheel{kStart};
+    std::vector<std::pair<TimerWheel::Id, Timepoint>> _expired;
+};
+
+TEST_F(TimerWheelTest, Basic) {
+    _wheel.Schedule(0, kStart + 10 * kMs);
+    _wheel.Schedule(1, kStart + 5 * kMs);
+    _wheel.Schedule(2, kStart + 5 * kMs + 1);
+    ASSERT_EQ(3, _wheel.GetSize());
+    ASSERT_EQ(kStart + 5 * kMs, _wheel.GetNextExpiration().value());
+
+    ASSERT_EQ(0, Advance(kStart + 4 * kMs));
+    ASSERT_EQ(1, Advance(kStart + 5 * kMs));
+    ASSERT_EQ(1, _expired.back().first);
+    ASSERT_FALSE(_wheel.IsScheduled(1));
+    ASSERT_EQ(0, Advance(kStart + 5 * kMs + kMs / 2)); // never earlier than deadline
+    ASSERT_EQ(2, Advance(kStart + 20 * kMs));
+    ASSERT_EQ(2, _expired[1].first);
+    ASSERT_EQ(0, _expired[2].first);
+    ASSERT_EQ(0, _wheel.GetSize());
+    ASSERT_FALSE(_wheel.GetNextExpiration().has_value());
+
+    // expired deadline is fired by the next advance
+    _wheel.Schedule(5, kStart);
+    ASSERT_EQ(1, Advance(kStart + 21 * kMs));
+    ASSERT_EQ(5, _expired.back().first);
+}
+
+TEST_F(TimerWheelTest, RescheduleAndCancel) {
+    _wheel.Schedule(0, kStart + 10 * kMs);
+    _wheel.Schedule(1, kStart + 10 * kMs);
+    _wheel.Schedule(2, kStart + 10 * kMs);
+    _wheel.Schedule(0, kStart + 100 * kMs);
+    _wheel.Cancel(1);
+    _wheel.Cancel(1);
+    _wheel.Cancel(77);
+    ASSERT_EQ(2, _wheel.GetSize());
+
+    ASSERT_EQ(1, Advance(kStart + 50 * kMs));
+    ASSERT_EQ(2, _expired.back().first);
+    ASSERT_EQ(1, Advance(kStart + 100 * kMs));
+    ASSERT_EQ(0, _expired.back().first);
+
+    // periodic timer from the callback
+    size_t count = 0;
+    _wheel.Schedule(3, kStart + 110 * kMs);
+    for(auto now = kStart + 100 * kMs; now <= kStart + 1100 * kMs; now += kMs) {
+        _wheel.Advance(now, [&](TimerWheel::Id id) {
+            count++;
+            _wheel.Schedule(id, now + 10 * kMs);
+        });
+    }
+    ASSERT_EQ(100, count);
+}
+
+TEST_F(TimerWheelTest, LongDeadlines) {
+    const std::vector<Timepoint> periods = {63 * kMs, 64 * kMs, 65 * kMs, 4095 * kMs, 4096 * kMs, 4097 * kMs, kMin, kHour, 5 * kHour, 50 * kHour};
+    for(size_t i = 0; i < periods.size(); ++i) {
+        _wheel.Schedule(i, kStart + periods[i]);
+    }
+    auto now = kStart;
+    while(_wheel.GetSize() > 0) {
+        auto next = _wheel.GetNextExpiration().value();
+        ASSERT_LT(now, next);
+        now = next;
+        Advance(now);
+    }
+    ASSERT_EQ(periods.size(), _expired.size());
+    for(size_t i = 0; i < periods.size(); ++i) {
+        ASSERT_EQ(i, _expired[i].first);
+        ASSERT_EQ(kStart + periods[i], _expired[i].second); // wakeup at exact deadline (1ms aligned)
+    }
+}
+
+TEST_F(TimerWheelTest, Randomized) {
+    constexpr size_t kTimers = 1000;
+    std::vector<std::optional<Timepoint>> deadlines(kTimers);
+    auto now = kStart;
+    for(size_t iteration = 0; iteration < 20'000; ++iteration) {
+        const auto id = g_random.Int<TimerWheel::Id>(0, kTimers - 1);
+        if(g_random.Real() < 0.1) {
+            _wheel.Cancel(id);
+            deadlines[id].reset();
+        } else {
+            const auto deadline = now + g_random.Int<Timepoint>(0, (g_random.Real() < 0.9) ? 10 * kSec : 10 * kMin);
+            _wheel.Schedule(id, deadline);
+            deadlines[id] = std::max(deadline, now + 1);
+        }
+
+        now += g_random.Int<Timepoint>(0, 20 * kMs);
+        _wheel.Advance(now, [&](TimerWheel::Id id) {
+            ASSERT_TRUE(deadlines[id].has_value());
+            ASSERT_LE(*deadlines[id], now);
+            deadlines[id].reset();
+        });
+        ASSERT_EQ(std::count_if(deadlines.begin(), deadlines.end(), [&](auto& deadline) {
+            return deadline.has_value();
+        }), _wheel.GetSize());
+    }
+
+    now += kHour;
+    _wheel.Advance(now, [&](TimerWheel::Id id) {
+        ASSERT_TRUE(deadlines[id].has_value());
+        ASSERT_LE(*deadlines[id], now);
+        deadlines[id].reset();
+    });
+    ASSERT_EQ(0, _wheel.GetSize());
+}
+
+}
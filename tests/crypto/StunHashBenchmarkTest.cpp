@@ -0,0 +1,108 @@
+#include "tau/crypto/Hmac.h"
+#include "tau/common/Crc32.h"
+#include "tau/common/host/Crc32.h"
+#include "tau/common/SteadyClock.h"
+#include "tests/lib/Common.h"
+#include <openssl/evp.h>
+#include <boost/crc.hpp>
+
+namespace tau::crypto {
+
+// STUN hot path: FINGERPRINT (CRC-32) and MESSAGE-INTEGRITY (HMAC-SHA1) per message,
+// compared with bytewise CRC and HMAC key setup per message
+class StunHashBenchmarkTest : public ::testing::Test {
+public:
+    static constexpr size_t kIterations = 100'000;
+    static constexpr etl::string_view kPassword = "0123456789abcdef0123";
+
+protected:
+    static std::vector<uint8_t> CreateMessage(size_t size) {
+        std::vector<uint8_t> message(size);
+        for(auto& value : message) {
+            value = g_random.Int<uint8_t>();
+        }
+        return message;
+    }
+
+    static bool HmacWithKeySetup(const std::vector<uint8_t>& message, uint8_t* output) {
+        auto ctx = EVP_MD_CTX_new();
+        auto pkey = EVP_PKEY_new_mac_key(EVP_PKEY_HMAC, nullptr, reinterpret_cast<const uint8_t*>(kPassword.data()), kPassword.size());
+        size_t size = kHmacSha1Length;
+        const auto ok = (EVP_DigestSignInit(ctx, nullptr, EVP_sha1(), nullptr, pkey) == 1)
+            && (EVP_DigestSignUpdate(ctx, message.data(), message.size()) == 1)
+            && (EVP_DigestSignFinal(ctx, output, &size) == 1);
+        EVP_PKEY_free(pkey);
+        EVP_MD_CTX_free(ctx);
+        return ok;
+    }
+
+protected:
+    SteadyClock _clock;
+};
+
+TEST_F(StunHashBenchmarkTest, DISABLED_MANUAL_Crc32) {
+    TAU_LOG_INFO("Hardware CRC32 supported: " << detail::Crc32HardwareSupported());
+    for(size_t size : {100, 500, 1200}) {
+        const auto message = CreateMessage(size);
+        uint32_t target = 0;
+        uint32_t crc = 0;
+
+        const auto bytewise_begin = _clock.Now();
+        for(size_t i = 0; i < kIterations; ++i) {
+            boost::crc_32_type crc32;
+            crc32.process_bytes(message.data(), message.size());
+            target ^= crc32.checksum();
+        }
+        const auto bytewise_sec = DurationSec(bytewise_begin, _clock.Now());
+
+        const auto slice_begin = _clock.Now();
+        for(size_t i = 0; i < kIterations; ++i) {
+            crc ^= ~detail::Crc32SliceBy8(~uint32_t{0}, message.data(), message.size());
+        }
+        const auto slice_sec = DurationSec(slice_begin, _clock.Now());
+        ASSERT_EQ(target, crc);
+
+        crc = 0;
+        const auto dispatch_begin = _clock.Now();
+        for(size_t i = 0; i < kIterations; ++i) {
+            crc ^= Crc32(message.data(), message.size());
+        }
+        const auto dispatch_sec = DurationSec(dispatch_begin, _clock.Now());
+        ASSERT_EQ(target, crc);
+
+        TAU_LOG_INFO("CRC32, size: " << size
+            << ", bytewise: " << static_cast<size_t>(1e9 * bytewise_sec / kIterations) << " ns"
+            << ", slice-by-8: " << static_cast<size_t>(1e9 * slice_sec / kIterations) << " ns"
+            << ", dispatched: " << static_cast<size_t>(1e9 * dispatch_sec / kIterations) << " ns");
+    }
+}
+
+TEST_F(StunHashBenchmarkTest, DISABLED_MANUAL_HmacSha1) {
+    HmacHasher hasher(HmacHasher::Type::Sha1, kPassword);
+    for(size_t size : {100, 500, 1200}) {
+        const auto message = CreateMessage(size);
+        std::array<uint8_t, kHmacSha1Length> target;
+        std::array<uint8_t, kHmacSha1Length> hash;
+
+        const auto key_setup_begin = _clock.Now();
+        for(size_t i = 0; i < kIterations; ++i) {
+            ASSERT_TRUE(HmacWithKeySetup(message, target.data()));
+        }
+        const auto key_setup_sec = DurationSec(key_setup_begin, _clock.Now());
+
+        const auto cached_begin = _clock.Now();
+        for(size_t i = 0; i < kIterations; ++i) {
+            ASSERT_TRUE(hasher.Reset());
+            ASSERT_TRUE(hasher.Update(BufferViewConst{.ptr = message.data(), .size = message.size()}));
+            ASSERT_TRUE(hasher.Finalize(hash.data()));
+        }
+        const auto cached_sec = DurationSec(cached_begin, _clock.Now());
+        ASSERT_EQ(target, hash);
+
+        TAU_LOG_INFO("HMAC-SHA1, size: " << size
+            << ", key setup per message: " << static_cast<size_t>(1e9 * key_setup_sec / kIterations) << " ns"
+            << ", cached key state: " << static_cast<size_t>(1e9 * cached_sec / kIterations) << " ns");
+    }
+}
+
+}
@@ -115,7 +115,7 @@ protected:
 
     Session::Options _client_options{
         .type = Session::Type::kClient,
-        .srtp_profiles = etl::vector<Session::SrtpProfile, 2>{
+        .srtp_profiles = etl::vector<Session::SrtpProfile, Session::kSrtpProfilesCount>{
             Session::SrtpProfile::kAes128CmSha1_80,
             Session::SrtpProfile::kAes128CmSha1_32
         },
@@ -124,7 +124,7 @@ protected:
     };
     Session::Options _server_options{
         .type = Session::Type::kServer,
-        .srtp_profiles = etl::vector<Session::SrtpProfile, 2>{
+        .srtp_profiles = etl::vector<Session::SrtpProfile, Session::kSrtpProfilesCount>{
             Session::SrtpProfile::kAes128CmSha1_80,
             Session::SrtpProfile::kAes128CmSha1_32
         },
@@ -177,7 +177,7 @@ TEST_F(SessionTest, WithRemoteCertificateValidation) {
 }
 
 TEST_F(SessionTest, SelectNonDefaultSrtpProfile) {
-    _client_options.srtp_profiles = etl::vector<Session::SrtpProfile, 2>{
+    _client_options.srtp_profiles = etl::vector<Session::SrtpProfile, Session::kSrtpProfilesCount>{
         Session::SrtpProfile::kAes128CmSha1_32
     };
     auto server_cert = _server_certificate.GetDigestSha256String();
@@ -200,6 +200,35 @@ TEST_F(SessionTest, SelectNonDefaultSrtpProfile) {
     Process();
 }
 
+TEST_F(SessionTest, AeadGcmSrtpProfile) {
+    _server_options.srtp_profiles = etl::vector<Session::SrtpProfile, Session::kSrtpProfilesCount>{
+        Session::SrtpProfile::kAeadAes128Gcm,
+        Session::SrtpProfile::kAeadAes256Gcm,
+        Session::SrtpProfile::kAes128CmSha1_80,
+        Session::SrtpProfile::kAes128CmSha1_32
+    };
+    _client_options.srtp_profiles = etl::vector<Session::SrtpProfile, Session::kSrtpProfilesCount>{
+        Session::SrtpProfile::kAeadAes256Gcm,
+        Session::SrtpProfile::kAes128CmSha1_80
+    };
+    Init();
+
+    Process();
+
+    ASSERT_NO_FATAL_FAILURE(AssertStates(_client_states, {Session::State::kConnecting, Session::State::kConnected}));
+    ASSERT_NO_FATAL_FAILURE(AssertStates(_server_states, {Session::State::kConnecting, Session::State::kConnected}));
+    ASSERT_NO_FATAL_FAILURE(AssertSrtpProfile(Session::SrtpProfile::kAeadAes256Gcm));
+    ASSERT_NO_FATAL_FAILURE(AssertKeyingMaterial());
+    ASSERT_EQ(32, _client->GetKeyingMaterial(true).key.size());
+    ASSERT_EQ(12, _client->GetKeyingMaterial(true).salt.size());
+    ASSERT_NO_FATAL_FAILURE(AssertSendData());
+    ASSERT_NO_FATAL_FAILURE(AssertReceivedData());
+
+    _client->Stop();
+    _server->Stop();
+    Process();
+}
+
 TEST_F(SessionTest, PacketLoss) {
     _client->Process();
     _queue.pop();
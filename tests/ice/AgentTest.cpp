@@ -74,6 +74,7 @@ public:
                 .interfaces = _sockets1,
                 .stun_servers = stun_servers,
                 .turn_servers = CreateTurnServersOptions(params.peer1_has_turn),
+                .turn_transports = CreateTurnTransportsOptions(params.peer1_has_turn),
                 .nominating_strategy = params.nominating_strategy_best
                     ? Agent::NominatingStrategy::kBestValid
                     : Agent::NominatingStrategy::kFirstValid,
@@ -218,6 +219,15 @@ public:
         return turn_servers;
     }
 
+    // TCP stream is emulated by NAT datagrams: ChannelData is padded, STUN messages are the same
+    etl::unordered_map<Endpoint, TurnTransport, 3> CreateTurnTransportsOptions(bool enable) {
+        etl::unordered_map<Endpoint, TurnTransport, 3> turn_transports;
+        if(enable) {
+            turn_transports[Endpoint{kTurnServerIp1, 3478}] = TurnTransport::kTcp;
+        }
+        return turn_transports;
+    }
+
     //TODO: move to utils file?
     static void OnStunServerRequest(Buffer& message, Endpoint src) {
         stun::Writer writer(message.GetViewWithCapacity(), stun::kBindingResponse);
@@ -269,6 +279,22 @@ TEST_P(AgentTest, Main) {
     }
 
     ASSERT_NO_FATAL_FAILURE(AssertState(GetParam().success));
+
+    if(GetParam().success) {
+        // relayed pair is switched to ChannelData framing
+        const auto& pair = _agent1->GetBestCandidatePair();
+        const auto channel_data_count = _turn_server1.GetChannelDataCount();
+        const auto dropped_count = _turn_server1.GetDroppedPacketsCount();
+        auto packet = Buffer::Create(g_udp_allocator);
+        packet.SetSize(101);
+        _agent1->Send(*pair.local.socket_idx, pair.remote.endpoint, std::move(packet));
+        _clock.Add(50 * kMs);
+        _nat1->Process();
+        if(pair.local.type == CandidateType::kRelayed) {
+            ASSERT_LT(channel_data_count, _turn_server1.GetChannelDataCount());
+            ASSERT_EQ(dropped_count, _turn_server1.GetDroppedPacketsCount());
+        }
+    }
 }
 
 std::vector<AgentTestParams> MakeAgentTestParams(bool use_turn) {
@@ -100,6 +100,27 @@ TEST_F(StunClientTest, Stun) {
     }
 }
 
+TEST_F(StunClientTest, NextDeadline) {
+    Init();
+
+    _client->Process();
+    ASSERT_EQ(1, _send_packets_count);
+    ASSERT_EQ(_clock.Now() + kRtoDefault, _client->GetNextDeadline());
+    const auto request_tp = _clock.Now();
+    _clock.Add(50 * kMs);
+    _nat->Process();
+    ASSERT_EQ(1, _local_candidates.size());
+
+    const auto deadline = _client->GetNextDeadline();
+    ASSERT_EQ(request_tp + kStunServerKeepAlivePeriod, deadline);
+    _clock.Add(deadline - _clock.Now() - 1);
+    _client->Process();
+    ASSERT_EQ(1, _send_packets_count);
+    _clock.Add(1);
+    _client->Process();
+    ASSERT_EQ(2, _send_packets_count);
+}
+
 TEST_F(StunClientTest, StunRequestRetransmitOnLost) {
     _nat.emplace(_clock, NatEmulator::Options{.type = NatEmulator::Type::kLocalNetworkOnly});
     Init();
@@ -0,0 +1,214 @@
+#include "tau/ice/TurnClient.h"
+#include "TurnServerEmulator.h"
+#include "tau/net/TcpSocket.h"
+#include "tau/stun/StreamFramer.h"
+#include "tau/asio/ThreadPool.h"
+#include "tau/crypto/Certificate.h"
+#include "tau/common/SteadyClock.h"
+
+namespace tau::ice {
+
+using namespace tau::net;
+
+// TURN over TCP/TLS: the emulator is behind a real local TCP/TLS server, both sides run on one executor
+class TurnClientTcpTest : public ::testing::TestWithParam<bool> {
+public:
+    static inline const IpAddress kLocalHost{MakeIpAddressV4("127.0.0.1")};
+    static inline const Endpoint kPeerEndpoint{MakeIpAddressV4("10.20.30.40"), 50000};
+
+public:
+    TurnClientTcpTest()
+        : _io(1)
+        , _acceptor(_io.GetExecutor(), asio::ip::tcp::endpoint{asio::ip::make_address_v4("127.0.0.1"), 0})
+        , _server_ssl_ctx(CreateSslContextPtr(_certificate.GetCertificateBuffer(), _certificate.GetPrivateKeyBuffer()))
+        , _client_ssl_ctx(asio_ssl::context::tls)
+        , _server_endpoint{kLocalHost, _acceptor.local_endpoint().port()}
+        , _turn_server(_clock, TurnServerEmulator::Options{})
+    {}
+
+    ~TurnClientTcpTest() {
+        Run([this]() {
+            EXPECT_EQ(0, _turn_server.GetDroppedPacketsCount());
+            _client_socket.reset();
+            _server_socket.reset();
+            boost_ec ec;
+            _acceptor.close(ec);
+        });
+        _io.Join();
+    }
+
+    void Init() {
+        const bool tls = GetParam();
+        _acceptor.async_accept([this, tls](boost_ec ec, asio::ip::tcp::socket socket) {
+            ASSERT_FALSE(ec);
+            _client_endpoint = Endpoint{kLocalHost, socket.remote_endpoint().port()};
+            _server_socket = TcpSocket::Create(CreateSocketOptions(tls ? _server_ssl_ctx.get() : nullptr), std::move(socket));
+            _server_socket->SetRecvCallback([this](Buffer&& message) {
+                _turn_server.Recv(std::move(message), _client_endpoint, TurnServerEmulator::kEndpointDefault);
+            });
+            _server_socket->Start();
+        });
+
+        _turn_server.SetOnSendCallback([this](Buffer&& message, Endpoint, Endpoint dest) {
+            if(dest == _client_endpoint) {
+                const auto size = message.GetSize();
+                if(stun::ChannelDataReader::IsChannelData(ToConst(message.GetView()))) {
+                    const auto padding = stun::StreamFramer::GetChannelDataPadding(size);
+                    message.SetSize(size + padding);
+                    std::memset(message.GetView().ptr + size, 0, padding);
+                }
+                _server_socket->Send(std::move(message));
+            } else {
+                _to_remote_peer_packets.push_back(std::make_pair(dest, std::move(message)));
+            }
+        });
+
+        _client_socket = TcpSocket::Create(CreateSocketOptions(tls ? &_client_ssl_ctx : nullptr));
+        _client_socket->SetRecvCallback([this](Buffer&& message) {
+            _client->Recv(std::move(message));
+        });
+
+        _client.emplace(
+            TurnClient::Dependencies{
+                .clock = _clock,
+                .udp_allocator = g_udp_allocator
+            },
+            TurnClient::Options{
+                .server = _server_endpoint,
+                .credentials = {
+                    .ufrag = "username",
+                    .password = "password"
+                },
+                .transport = tls ? TurnTransport::kTls : TurnTransport::kTcp,
+                .start_delay = 0
+            }
+        );
+        _client->SetCandidateCallback([this](Endpoint relayed) {
+            _local_candidates.push_back(relayed);
+        });
+        _client->SetSendCallback([this](Endpoint remote, Buffer&& message) {
+            EXPECT_TRUE(_client->IsServerEndpoint(remote));
+            _client_socket->Send(std::move(message));
+        });
+        _client->SetRecvCallback([this](Endpoint remote, Buffer&& message) {
+            _from_remote_peer_packets.push_back(std::make_pair(remote, std::move(message)));
+        });
+
+        Run([this]() { _client_socket->Connect(_server_endpoint); });
+    }
+
+    TcpSocket::Options CreateSocketOptions(SslContext* ssl_ctx) {
+        return TcpSocket::Options{
+            .allocator = g_udp_allocator,
+            .executor = _io.GetExecutor(),
+            .frame_header_size = stun::StreamFramer::kHeaderSize,
+            .frame_size_callback = &stun::StreamFramer::GetFrameSize,
+            .ssl_ctx = ssl_ctx,
+            .host = "localhost"
+        };
+    }
+
+    template<typename TFunction>
+    void Run(TFunction&& function) {
+        Event event;
+        asio::post(_io.GetExecutor(), [&]() {
+            function();
+            event.Set();
+        });
+        ASSERT_TRUE(event.WaitFor(1000ms));
+    }
+
+    template<typename TCondition>
+    bool ProcessUntil(TCondition&& condition) {
+        return WaitForCondition([&]() {
+            bool done = false;
+            Run([&]() {
+                _client->Process();
+                done = condition();
+            });
+            return done;
+        });
+    }
+
+    static Buffer CreatePacket(size_t size) {
+        auto packet = Buffer::Create(g_udp_allocator);
+        for(size_t i = 0; i < size; ++i) {
+            packet.GetView().ptr[i] = static_cast<uint8_t>(i);
+        }
+        packet.SetSize(size);
+        return packet;
+    }
+
+    static void AssertPacket(const Buffer& packet, size_t size) {
+        ASSERT_EQ(size, packet.GetSize());
+        for(size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(static_cast<uint8_t>(i), packet.GetView().ptr[i]);
+        }
+    }
+
+protected:
+    SteadyClock _clock;
+    ThreadPool _io;
+    asio::ip::tcp::acceptor _acceptor;
+    crypto::Certificate _certificate;
+    SslContextPtr _server_ssl_ctx;
+    SslContext _client_ssl_ctx;
+    const Endpoint _server_endpoint;
+
+    TurnServerEmulator _turn_server;
+    Endpoint _client_endpoint;
+    TcpSocketPtr _server_socket;
+    TcpSocketPtr _client_socket;
+    std::optional<TurnClient> _client;
+
+    std::vector<Endpoint> _local_candidates;
+    std::vector<std::pair<Endpoint, Buffer>> _from_remote_peer_packets;
+    std::vector<std::pair<Endpoint, Buffer>> _to_remote_peer_packets;
+};
+
+TEST_P(TurnClientTcpTest, Main) {
+    Init();
+    ASSERT_TRUE(ProcessUntil([this]() { return !_local_candidates.empty(); }));
+    const auto relayed = _local_candidates.back();
+    ASSERT_EQ(TurnServerEmulator::kPublicIpDefault, relayed.address);
+
+    // Send/Data indications
+    Run([this]() { _client->Send(CreatePacket(101), kPeerEndpoint); });
+    ASSERT_TRUE(ProcessUntil([this]() { return _to_remote_peer_packets.size() == 1; }));
+    Run([&]() {
+        ASSERT_EQ(kPeerEndpoint, _to_remote_peer_packets[0].first);
+        ASSERT_NO_FATAL_FAILURE(AssertPacket(_to_remote_peer_packets[0].second, 101));
+        _turn_server.Recv(CreatePacket(55), kPeerEndpoint, relayed);
+    });
+    ASSERT_TRUE(ProcessUntil([this]() { return _from_remote_peer_packets.size() == 1; }));
+
+    // ChannelData, padded to 4 bytes in both directions
+    Run([this]() { _client->BindChannel(kPeerEndpoint); });
+    ASSERT_TRUE(ProcessUntil([this]() { return _client->HasChannel(kPeerEndpoint); }));
+    const auto channel_data_count = _turn_server.GetChannelDataCount();
+    Run([&]() {
+        _client->Send(CreatePacket(101), kPeerEndpoint);
+        _client->Send(CreatePacket(102), kPeerEndpoint);
+        _turn_server.Recv(CreatePacket(55), kPeerEndpoint, relayed);
+        _turn_server.Recv(CreatePacket(56), kPeerEndpoint, relayed);
+    });
+    ASSERT_TRUE(ProcessUntil([this]() {
+        return (_to_remote_peer_packets.size() == 3) && (_from_remote_peer_packets.size() == 3);
+    }));
+    Run([&]() {
+        ASSERT_EQ(channel_data_count + 4, _turn_server.GetChannelDataCount());
+        ASSERT_NO_FATAL_FAILURE(AssertPacket(_to_remote_peer_packets[1].second, 101));
+        ASSERT_NO_FATAL_FAILURE(AssertPacket(_to_remote_peer_packets[2].second, 102));
+        for(size_t i = 0; i < _from_remote_peer_packets.size(); ++i) {
+            ASSERT_EQ(kPeerEndpoint, _from_remote_peer_packets[i].first);
+        }
+        ASSERT_NO_FATAL_FAILURE(AssertPacket(_from_remote_peer_packets[0].second, 55));
+        ASSERT_NO_FATAL_FAILURE(AssertPacket(_from_remote_peer_packets[1].second, 55));
+        ASSERT_NO_FATAL_FAILURE(AssertPacket(_from_remote_peer_packets[2].second, 56));
+    });
+}
+
+INSTANTIATE_TEST_SUITE_P(Transport, TurnClientTcpTest, ::testing::Bool(),
+    [](const ::testing::TestParamInfo<bool>& info) { return info.param ? "Tls" : "Tcp"; });
+
+}
@@ -41,6 +41,7 @@ public:
         });
         _client->SetSendCallback([this](Endpoint remote, Buffer&& message) {
             TAU_LOG_INFO("[SetSendCallback] remote: " << ToString(remote));
+            _last_send_packet_size = message.GetSize();
             _nat.Send(std::move(message), kClientEndpoint, remote);
             _send_packets_count++;
         });
@@ -50,7 +51,7 @@ public:
         });
         _nat.SetOnSendCallback([this](Buffer&& message, Endpoint src, Endpoint dest) {
             TAU_LOG_INFO("[SetOnSendCallback] remote: " << ToString(dest) << ", kServerEndpoint: " << ToString(kServerEndpoint));
-            if(dest == kServerEndpoint) {
+            if((dest == kServerEndpoint) && !_server_unreachable) {
                 _turn_server.Recv(std::move(message), src, dest);
             }
         });
@@ -73,6 +74,17 @@ public:
         _nat.Process();
     }
 
+    Endpoint Allocate() {
+        _clock.Add(_options.start_delay);
+        _client->Process();
+        ProcessNat();
+        _clock.Add(50 * kMs);
+        _client->Process();
+        ProcessNat();
+        EXPECT_EQ(1, _local_candidates.size());
+        return _local_candidates.back();
+    }
+
     static Buffer CreatePacket(size_t size = 100) {
         auto packet = Buffer::Create(g_udp_allocator, size);
         for(size_t i = 0; i < size; ++i) {
@@ -98,6 +110,8 @@ protected:
 
     std::vector<Endpoint> _local_candidates;
     size_t _send_packets_count = 0;
+    size_t _last_send_packet_size = 0;
+    bool _server_unreachable = false;
     std::vector<std::pair<Endpoint, Buffer>> _from_remote_peer_packets;
     std::vector<std::pair<Endpoint, Buffer>> _to_remote_peer_packets;
 };
@@ -210,6 +224,141 @@ TEST_F(TurnClientTest, SendDataToRequestPermission) {
     ASSERT_EQ(5, _send_packets_count);
 }
 
+TEST_F(TurnClientTest, ChannelData) {
+    Init();
+    const auto relayed = Allocate();
+    ASSERT_EQ(2, _send_packets_count);
+
+    Endpoint remote_peer{MakeIpAddressV4("55.66.77.88"), 54321};
+    _client->BindChannel(remote_peer);
+    ASSERT_EQ(3, _send_packets_count);
+    ASSERT_FALSE(_client->HasChannel(remote_peer));
+
+    auto outgoing_packet = CreatePacket();
+    _client->Send(outgoing_packet.MakeCopy(), remote_peer); // queued until the channel is bound
+    ASSERT_EQ(3, _send_packets_count);
+    ProcessNat();
+    ASSERT_TRUE(_client->HasChannel(remote_peer));
+    ASSERT_EQ(4, _send_packets_count);
+    ASSERT_EQ(stun::kChannelDataHeaderSize + outgoing_packet.GetSize(), _last_send_packet_size);
+    ProcessNat();
+    ASSERT_EQ(1, _to_remote_peer_packets.size());
+    ASSERT_EQ(1, _turn_server.GetChannelDataCount());
+    {
+        auto& [dest, packet] = _to_remote_peer_packets.back();
+        ASSERT_EQ(remote_peer, dest);
+        ASSERT_EQ(outgoing_packet.GetSize(), packet.GetSize());
+        ASSERT_EQ(0, std::memcmp(outgoing_packet.GetView().ptr, packet.GetView().ptr, packet.GetSize()));
+    }
+
+    auto packet_with_headroom = Buffer::Create(g_udp_allocator);
+    packet_with_headroom.ReserveHeadroom(stun::kChannelDataHeaderSize);
+    packet_with_headroom.SetSize(outgoing_packet.GetSize());
+    std::memcpy(packet_with_headroom.GetView().ptr, outgoing_packet.GetView().ptr, outgoing_packet.GetSize());
+    _client->Send(std::move(packet_with_headroom), remote_peer); // header is written in place
+    ProcessNat();
+    ASSERT_EQ(2, _to_remote_peer_packets.size());
+    ASSERT_EQ(2, _turn_server.GetChannelDataCount());
+    {
+        auto& [dest, packet] = _to_remote_peer_packets.back();
+        ASSERT_EQ(remote_peer, dest);
+        ASSERT_EQ(0, std::memcmp(outgoing_packet.GetView().ptr, packet.GetView().ptr, packet.GetSize()));
+    }
+
+    auto incoming_packet = CreatePacket(1234);
+    _turn_server.Recv(incoming_packet.MakeCopy(), remote_peer, relayed);
+    ASSERT_EQ(3, _turn_server.GetChannelDataCount());
+    ASSERT_EQ(1, _from_remote_peer_packets.size());
+    {
+        auto& [from_remote, packet] = _from_remote_peer_packets.back();
+        ASSERT_EQ(remote_peer, from_remote);
+        ASSERT_EQ(incoming_packet.GetSize(), packet.GetSize());
+        ASSERT_EQ(0, std::memcmp(incoming_packet.GetView().ptr, packet.GetView().ptr, packet.GetSize()));
+    }
+
+    const auto send_packets_count = _send_packets_count;
+    _clock.Add(kMin);
+    _client->Process();
+    ASSERT_EQ(send_packets_count, _send_packets_count);
+    const auto refresh_tp = *_client->GetNextDeadline();
+    ASSERT_LT(_clock.Now() + 2 * kMin, refresh_tp);
+    ASSERT_GT(_clock.Now() + TurnClient::kChannelRefreshPeriod, refresh_tp);
+
+    _clock.Add(refresh_tp - _clock.Now());
+    _client->Process();
+    ASSERT_EQ(send_packets_count + 1, _send_packets_count); // ChannelBind refresh
+    ProcessNat();
+    ASSERT_TRUE(_client->HasChannel(remote_peer));
+    ASSERT_EQ(_clock.Now() + TurnClient::kChannelRefreshPeriod, _client->GetNextDeadline());
+
+    _client->Stop();
+    ProcessNat();
+}
+
+TEST_F(TurnClientTest, ChannelBindRejected) {
+    _turn_server.SetChannelBindEnabled(false);
+    Init();
+    Allocate();
+
+    Endpoint remote_peer{MakeIpAddressV4("55.66.77.88"), 54321};
+    etl::vector<IpAddress, 1> remote_ip_address;
+    remote_ip_address.push_back(remote_peer.address);
+    _client->CreatePermission(remote_ip_address);
+    ProcessNat();
+    ASSERT_TRUE(_client->HasPermission(remote_peer.address));
+
+    _client->BindChannel(remote_peer);
+    auto outgoing_packet = CreatePacket();
+    _client->Send(outgoing_packet.MakeCopy(), remote_peer);
+    ProcessNat();
+    ASSERT_FALSE(_client->HasChannel(remote_peer));
+    ProcessNat();
+    ASSERT_EQ(1, _to_remote_peer_packets.size()); // by Send indication
+    ASSERT_EQ(0, _turn_server.GetChannelDataCount());
+    auto& [dest, packet] = _to_remote_peer_packets.back();
+    ASSERT_EQ(remote_peer, dest);
+    ASSERT_EQ(0, std::memcmp(outgoing_packet.GetView().ptr, packet.GetView().ptr, packet.GetSize()));
+}
+
+TEST_F(TurnClientTest, ChannelRefreshUnanswered) {
+    Init();
+    Allocate();
+
+    Endpoint remote_peer{MakeIpAddressV4("55.66.77.88"), 54321};
+    _client->BindChannel(remote_peer);
+    ProcessNat();
+    ASSERT_TRUE(_client->HasChannel(remote_peer));
+
+    _server_unreachable = true;
+    _clock.Add(TurnClient::kChannelRefreshPeriod);
+    for(size_t i = 0; i < TurnClient::kChannelBindAttempts; ++i) {
+        ASSERT_TRUE(_client->HasChannel(remote_peer));
+        _client->Process(); // refresh and its retransmissions
+        _clock.Add(kRtoDefault);
+    }
+    _client->Process();
+    ASSERT_FALSE(_client->HasChannel(remote_peer)); // falls back to Send indications
+    _client->Stop();
+}
+
+TEST_F(TurnClientTest, TooBigPacketForSendIndication) {
+    Init();
+    Allocate();
+
+    Endpoint remote_peer{MakeIpAddressV4("55.66.77.88"), 54321};
+    etl::vector<IpAddress, 1> remote_ip_address;
+    remote_ip_address.push_back(remote_peer.address);
+    _client->CreatePermission(remote_ip_address);
+    ProcessNat();
+    ASSERT_TRUE(_client->HasPermission(remote_peer.address));
+
+    const auto send_packets_count = _send_packets_count;
+    _client->Send(CreatePacket(kUdpMtuSize - 20), remote_peer);
+    ASSERT_EQ(send_packets_count, _send_packets_count); // dropped, not sent w/o DATA
+    _client->Send(CreatePacket(), remote_peer);
+    ASSERT_EQ(send_packets_count + 1, _send_packets_count);
+}
+
 TEST_F(TurnClientTest, StopBeforeAllocationToPreventCreatingRelayedCandidate) {
     Init();
 
@@ -7,6 +7,8 @@
 #include "tau/stun/attribute/Data.h"
 #include "tau/stun/attribute/MessageIntegrity.h"
 #include "tau/stun/attribute/Fingerprint.h"
+#include "tau/stun/attribute/ErrorCode.h"
+#include "tau/stun/ChannelData.h"
 #include "tau/crypto/Md5.h"
 
 namespace tau::ice {
@@ -25,6 +27,9 @@ void TurnServerEmulator::Recv(Buffer&& packet, Endpoint src, Endpoint dest) {
         return OnRecvData(std::move(packet), src, dest);
     }
     auto view = ToConst(packet.GetView());
+    if(ChannelDataReader::IsChannelData(view)) {
+        return OnChannelData(std::move(packet), src);
+    }
     if(!Reader::Validate(view)) {
         return DropPacket("Invalid stun message");
     }
@@ -41,6 +46,9 @@ void TurnServerEmulator::Recv(Buffer&& packet, Endpoint src, Endpoint dest) {
         case kCreatePermissionRequest:
             OnCreatePermissionRequest(std::move(packet), src);
             break;
+        case kChannelBindRequest:
+            OnChannelBindRequest(std::move(packet), src);
+            break;
         case kSendIndication:
             OnSendIndication(std::move(packet), src);
             break;
@@ -223,6 +231,67 @@ void TurnServerEmulator::OnCreatePermissionRequest(Buffer&& message, Endpoint sr
     _on_send_callback(std::move(message), _public_endpoint, src);
 }
 
+void TurnServerEmulator::OnChannelBindRequest(Buffer&& message, Endpoint src) {
+    auto it = _client_to_allocation.find(src);
+    if(it == _client_to_allocation.end()) {
+        return DropPacket("Channel bind request from unknown endpoint");
+    }
+    auto& allocation = it->second;
+
+    std::optional<uint16_t> channel;
+    std::optional<Endpoint> remote_peer;
+    bool message_integrity = false;
+    auto request_view = ToConst(message.GetView());
+    auto ok = Reader::ForEachAttribute(request_view, [&](AttributeType type, BufferViewConst attr) {
+        switch(type) {
+            case AttributeType::kChannelNumber:
+                channel = DataUint32Reader::GetValue(attr) >> 16;
+                return IsChannelNumberValid(*channel);
+            case AttributeType::kXorPeerAddress:
+                if(XorMappedAddressReader::GetFamily(attr) == IpFamily::kIpv4) {
+                    auto address = XorMappedAddressReader::GetAddressV4(attr);
+                    auto port = XorMappedAddressReader::GetPort(attr);
+                    remote_peer.emplace(Endpoint{IpAddress{address}, port});
+                }
+                break;
+            case AttributeType::kUserName: return (allocation.user_name == ByteStringReader::GetValue(attr));
+            case AttributeType::kRealm:    return (_realm == ByteStringReader::GetValue(attr));
+            case AttributeType::kNonce:    return (allocation.nonce == ByteStringReader::GetValue(attr));
+            case AttributeType::kMessageIntegrity: {
+                etl::string<kLongTermPassword> message_integrity_password(kLongTermPassword, 'x');
+                auto password_ptr = reinterpret_cast<uint8_t*>(message_integrity_password.data());
+                if(!CalcLongTermPassword({allocation.user_name, _options.password}, _realm, password_ptr)) {
+                    return false;
+                }
+                crypto::HmacHasher hmac_hasher(crypto::HmacHasher::Type::Sha1, message_integrity_password);
+                message_integrity = MessageIntegrityReader::Validate(attr, request_view, hmac_hasher);
+                return message_integrity;
+            }
+            default:
+                break;
+        }
+        return true;
+    });
+    if(!ok || !message_integrity || !channel || !remote_peer) {
+        return DropPacket("stun message reader failed");
+    }
+
+    if(!_channel_bind_enabled) {
+        stun::Writer writer(message.GetViewWithCapacity(), kChannelBindErrorResponse);
+        ErrorCodeWriter::Write(writer, ErrorCode::kForbidden);
+        FinalizeStunMessage(message, writer, allocation.user_name);
+        _on_send_callback(std::move(message), _public_endpoint, src);
+        return;
+    }
+    allocation.permissions.insert(remote_peer->address);
+    allocation.channels[*channel] = *remote_peer;
+
+    stun::Writer writer(message.GetViewWithCapacity(), kChannelBindResponse);
+    FinalizeStunMessage(message, writer, allocation.user_name);
+
+    _on_send_callback(std::move(message), _public_endpoint, src);
+}
+
 void TurnServerEmulator::OnSendIndication(Buffer&& message, Endpoint src) {
     auto it = _client_to_allocation.find(src);
     if(it == _client_to_allocation.end()) {
@@ -263,9 +332,45 @@ void TurnServerEmulator::OnSendIndication(Buffer&& message, Endpoint src) {
     _on_send_callback(std::move(message), Endpoint{_options.public_ip, allocation.port}, *remote_peer);
 }
 
+void TurnServerEmulator::OnChannelData(Buffer&& message, Endpoint src) {
+    auto it = _client_to_allocation.find(src);
+    if(it == _client_to_allocation.end()) {
+        return DropPacket("Channel data from unknown endpoint");
+    }
+    auto& allocation = it->second;
+
+    auto view = ToConst(message.GetView());
+    if(!ChannelDataReader::Validate(view)) {
+        return DropPacket("Invalid channel data");
+    }
+    auto channel_it = allocation.channels.find(ChannelDataReader::GetChannelNumber(view));
+    if(channel_it == allocation.channels.end()) {
+        return DropPacket("Unknown channel");
+    }
+    _channel_data_count++;
+
+    message.TrimFront(kChannelDataHeaderSize);
+    message.SetSize(ChannelDataReader::GetData(view).size);
+
+    _on_send_callback(std::move(message), Endpoint{_options.public_ip, allocation.port}, channel_it->second);
+}
+
 void TurnServerEmulator::OnRecvData(Buffer&& packet, Endpoint src, Endpoint dest) {
     for(auto& [client, allocation] : _client_to_allocation) {
         if(allocation.port == dest.port) {
+            for(auto& [channel, peer] : allocation.channels) {
+                if(peer == src) {
+                    auto message = Buffer::Create(g_udp_allocator);
+                    auto view = message.GetViewWithCapacity();
+                    ChannelDataWriter::WriteHeader(view, channel, packet.GetSize());
+                    std::memcpy(view.ptr + kChannelDataHeaderSize, packet.GetView().ptr, packet.GetSize());
+                    message.SetSize(kChannelDataHeaderSize + packet.GetSize());
+                    _channel_data_count++;
+
+                    _on_send_callback(std::move(message), _public_endpoint, client);
+                    return;
+                }
+            }
             if(Contains(allocation.permissions, src.address)) {
                 auto indication = Buffer::Create(g_udp_allocator);
                 auto view = indication.GetViewWithCapacity();
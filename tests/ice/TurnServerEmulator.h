@@ -27,10 +27,12 @@ public:
     TurnServerEmulator(Clock& clock, Options&& options);
 
     void SetOnSendCallback(Callback&& callback) { _on_send_callback = std::move(callback); }
+    void SetChannelBindEnabled(bool enabled) { _channel_bind_enabled = enabled; } // rejects ChannelBind requests otherwise
 
     void Recv(Buffer&& packet, Endpoint src, Endpoint dest);
 
     size_t GetDroppedPacketsCount() const;
+    size_t GetChannelDataCount() const { return _channel_data_count; }
 
 private:
     void OnAllocateRequest(Buffer&& message, Endpoint src, uint32_t hash);
@@ -38,7 +40,9 @@ private:
     void OnAllocateRequest(Buffer&& message, Endpoint src, const etl::istring& user_name, const etl::istring& nonce);
     void OnRefreshRequest(Buffer&& message, Endpoint src);
     void OnCreatePermissionRequest(Buffer&& message, Endpoint src);
+    void OnChannelBindRequest(Buffer&& message, Endpoint src);
     void OnSendIndication(Buffer&& message, Endpoint src);
+    void OnChannelData(Buffer&& message, Endpoint src);
 
     void OnRecvData(Buffer&& packet, Endpoint src, Endpoint dest);
 
@@ -61,11 +65,14 @@ private:
         uint16_t port;
         Timepoint expire_time;
         etl::unordered_set<IpAddress, 16> permissions = {};
+        etl::unordered_map<uint16_t, Endpoint, 16> channels = {};
     };
 
     etl::unordered_map<uint32_t, etl::string<32>, 1024> _hash_to_nonce;
     etl::unordered_map<Endpoint, Allocation, 1024> _client_to_allocation;
     size_t _dropped_packets_count = 0;
+    size_t _channel_data_count = 0; // both directions
+    bool _channel_bind_enabled = true;
 
     Callback _on_send_callback;
 };
@@ -135,4 +135,110 @@ TEST(BufferTest, FromBase64_Randomized) {
     }
 }
 
+TEST(BufferTest, Headroom) {
+    auto buffer = Buffer::Create(g_system_allocator, 256);
+    ASSERT_TRUE(buffer.ReserveHeadroom(32));
+    ASSERT_EQ(32, buffer.GetHeadroom());
+    ASSERT_EQ(256 - 32, buffer.GetTailroom());
+    ASSERT_EQ(256 - 32, buffer.GetViewWithCapacity().size);
+
+    const auto payload_ptr = buffer.GetViewWithCapacity().ptr;
+    buffer.SetSize(1000);
+    ASSERT_EQ(256 - 32, buffer.GetSize());
+    buffer.SetSize(100);
+    for(size_t i = 0; i < 100; ++i) {
+        buffer.GetView().ptr[i] = static_cast<uint8_t>(i);
+    }
+    ASSERT_FALSE(buffer.ReserveHeadroom(0));
+
+    ASSERT_FALSE(buffer.Prepend(33));
+    ASSERT_TRUE(buffer.Prepend(12));
+    ASSERT_EQ(20, buffer.GetHeadroom());
+    ASSERT_EQ(112, buffer.GetSize());
+    ASSERT_EQ(payload_ptr - 12, buffer.GetView().ptr);
+    ASSERT_EQ(256 - 32 - 100, buffer.GetTailroom());
+
+    ASSERT_TRUE(buffer.TrimFront(12 + 10));
+    ASSERT_EQ(90, buffer.GetSize());
+    ASSERT_EQ(42, buffer.GetHeadroom());
+    for(size_t i = 0; i < 90; ++i) {
+        ASSERT_EQ(static_cast<uint8_t>(i + 10), buffer.GetView().ptr[i]);
+    }
+    ASSERT_FALSE(buffer.TrimFront(91));
+
+    auto copy = buffer.MakeCopy();
+    ASSERT_EQ(42, copy.GetHeadroom());
+    ASSERT_EQ(90, copy.GetSize());
+    ASSERT_EQ(0, memcmp(buffer.GetView().ptr, copy.GetView().ptr, buffer.GetSize()));
+
+    auto moved = std::move(buffer);
+    ASSERT_EQ(42, moved.GetHeadroom());
+    ASSERT_EQ(nullptr, buffer.GetView().ptr);
+}
+
+TEST(BufferTest, Shared) {
+    const auto allocator_free_blocks = g_udp_allocator.GetFreeBlockCount();
+    {
+        auto buffer = Buffer::CreateShared(g_udp_allocator, Buffer::Info{.tp = 42, .flags = kFlagsLast});
+        ASSERT_TRUE(buffer.IsShared());
+        ASSERT_EQ(1, buffer.GetRefCount());
+        ASSERT_EQ(g_udp_allocator.GetChunkSize() - 16, buffer.GetCapacity());
+        ASSERT_EQ(allocator_free_blocks - 1, g_udp_allocator.GetFreeBlockCount());
+
+        buffer.SetSize(100);
+        for(size_t i = 0; i < 100; ++i) {
+            buffer.GetView().ptr[i] = static_cast<uint8_t>(i);
+        }
+
+        std::vector<Buffer> references;
+        for(size_t i = 0; i < 10; ++i) {
+            references.push_back(buffer.Share());
+            ASSERT_EQ(i + 2, buffer.GetRefCount());
+        }
+        ASSERT_EQ(allocator_free_blocks - 1, g_udp_allocator.GetFreeBlockCount());
+        for(auto& reference : references) {
+            ASSERT_EQ(buffer.GetView().ptr, reference.GetView().ptr);
+            ASSERT_EQ(100, reference.GetSize());
+            ASSERT_EQ(buffer.GetInfo(), reference.GetInfo());
+        }
+
+        auto slice = buffer.Slice(12, 50);
+        ASSERT_EQ(12, slice.GetRefCount());
+        ASSERT_EQ(50, slice.GetSize());
+        ASSERT_EQ(buffer.GetView().ptr + 12, slice.GetView().ptr);
+        ASSERT_EQ(12, slice.GetView().ptr[0]);
+        ASSERT_ANY_THROW(buffer.Slice(51, 50));
+
+        references.clear();
+        buffer = Buffer::CreateEmpty(g_udp_allocator);
+        ASSERT_EQ(1, slice.GetRefCount());
+        ASSERT_EQ(allocator_free_blocks - 1, g_udp_allocator.GetFreeBlockCount());
+        ASSERT_EQ(49, slice.GetView().ptr[37]);
+
+        auto copy = slice.MakeCopy();
+        ASSERT_FALSE(copy.IsShared());
+        ASSERT_EQ(50, copy.GetSize());
+        ASSERT_EQ(allocator_free_blocks - 2, g_udp_allocator.GetFreeBlockCount());
+    }
+    ASSERT_EQ(allocator_free_blocks, g_udp_allocator.GetFreeBlockCount());
+}
+
+TEST(BufferTest, SharedWithCapacity) {
+    auto buffer = Buffer::CreateShared(g_system_allocator, 64);
+    ASSERT_EQ(64, buffer.GetCapacity());
+    ASSERT_TRUE(buffer.ReserveHeadroom(16));
+    buffer.SetSize(48);
+    ASSERT_EQ(0, buffer.GetTailroom());
+
+    auto reference = buffer.Share();
+    ASSERT_TRUE(reference.Prepend(16));
+    ASSERT_EQ(64, reference.GetSize());
+    ASSERT_EQ(48, buffer.GetSize());
+
+    auto exclusive = Buffer::Create(g_system_allocator, 64);
+    ASSERT_FALSE(exclusive.IsShared());
+    ASSERT_EQ(1, exclusive.GetRefCount());
+    ASSERT_ANY_THROW(exclusive.Share());
+}
+
 }
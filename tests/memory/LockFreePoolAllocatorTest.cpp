@@ -0,0 +1,202 @@
+#include <tau/memory/host/LockFreePoolAllocator.h>
+#include <tau/common/SteadyClock.h>
+#include "tests/lib/Common.h"
+
+namespace tau {
+
+class LockFreePoolAllocatorTest : public ::testing::Test {
+public:
+    static constexpr size_t kBufferSize = 256 * 1024;
+    static constexpr size_t kMaxHeld = 16; // chunks per thread in the contention benchmark
+
+public:
+    LockFreePoolAllocatorTest()
+        : _buffer(kBufferSize)
+    {}
+
+protected:
+    static void FillChunk(uint8_t* chunk, size_t size, uint8_t seed = 0) {
+        for(size_t i = 0; i < size; ++i) {
+            chunk[i] = static_cast<uint8_t>(i + seed);
+        }
+    }
+
+    static void AssertChunk(uint8_t* chunk, size_t size, uint8_t seed = 0) {
+        for(size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(static_cast<uint8_t>(i + seed), chunk[i]);
+        }
+    }
+
+    // each thread holds up to kMaxHeld chunks, allocates and deallocates them in random order
+    template<typename TAllocator>
+    static double RunContention(TAllocator& allocator, size_t threads_count, size_t iterations) {
+        std::atomic<size_t> errors = 0;
+        SteadyClock clock;
+        const auto begin = clock.Now();
+        std::vector<std::thread> threads;
+        for(size_t t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&allocator, &errors, iterations, t]() {
+                std::vector<uint8_t*> chunks;
+                chunks.reserve(kMaxHeld);
+                const auto seed = static_cast<uint8_t>(t);
+                for(size_t i = 0; i < iterations; ++i) {
+                    if((chunks.size() < kMaxHeld) && ((i % 3 != 0) || chunks.empty())) {
+                        auto chunk = allocator.Allocate();
+                        if(!chunk) {
+                            errors++;
+                            continue;
+                        }
+                        chunk[0] = seed;
+                        chunks.push_back(chunk);
+                    } else {
+                        auto chunk = chunks.back();
+                        if(chunk[0] != seed) {
+                            errors++;
+                        }
+                        allocator.Deallocate(chunk);
+                        chunks.pop_back();
+                    }
+                }
+                for(auto chunk : chunks) {
+                    allocator.Deallocate(chunk);
+                }
+            });
+        }
+        for(auto& thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(0, errors.load());
+        return DurationSec(begin, clock.Now());
+    }
+
+protected:
+    std::vector<uint8_t> _buffer;
+    Random _random;
+};
+
+TEST_F(LockFreePoolAllocatorTest, Basic) {
+    LockFreePoolAllocator allocator(_buffer.data(), _buffer.size(), 1500);
+    ASSERT_EQ(1504, allocator.GetChunkSize());
+    constexpr auto kMaxCount = kBufferSize / (1504 + sizeof(uint16_t));
+    ASSERT_EQ(kMaxCount, allocator.GetMaxBlockCount());
+
+    std::vector<uint8_t*> chunks;
+    for(size_t i = 0; i < kMaxCount; ++i) {
+        chunks.push_back(allocator.Allocate());
+        ASSERT_NE(nullptr, chunks.back());
+        ASSERT_EQ(kMaxCount - i - 1, allocator.GetFreeBlockCount());
+        FillChunk(chunks.back(), allocator.GetChunkSize());
+    }
+    ASSERT_EQ(0, allocator.GetFreeBlockCount());
+    ASSERT_EQ(nullptr, allocator.Allocate());
+
+    for(size_t i = 0; i < kMaxCount; ++i) {
+        auto& chunk = chunks[i];
+        ASSERT_NO_FATAL_FAILURE(AssertChunk(chunk, allocator.GetChunkSize()));
+        allocator.Deallocate(chunk);
+        ASSERT_EQ(i + 1, allocator.GetFreeBlockCount());
+    }
+    ASSERT_EQ(kMaxCount, allocator.GetMaxBlockCount());
+}
+
+TEST_F(LockFreePoolAllocatorTest, Randomized) {
+    const auto block_size = _random.Int<size_t>(1, 1500);
+    const auto block_size_aligned = Align(block_size, sizeof(size_t));
+    LockFreePoolAllocator allocator(_buffer.data(), _buffer.size(), block_size);
+    ASSERT_EQ(block_size_aligned, allocator.GetChunkSize());
+
+    const auto kMaxCount = kBufferSize / (block_size_aligned + sizeof(uint16_t));
+    ASSERT_EQ(kMaxCount, allocator.GetMaxBlockCount());
+
+    std::vector<uint8_t*> chunks;
+    for(size_t iter = 0; iter < 100; ++iter) {
+        if(_random.Bool()) {
+            const auto count = _random.Int<size_t>(0, allocator.GetFreeBlockCount());
+            for(size_t i = 0; i < count; ++i) {
+                chunks.push_back(allocator.Allocate());
+                ASSERT_NE(nullptr, chunks.back());
+                FillChunk(chunks.back(), allocator.GetChunkSize());
+            }
+        } else {
+            std::shuffle(chunks.begin(), chunks.end(), std::mt19937{std::random_device{}()});
+
+            const auto count = _random.Int<size_t>(0, chunks.size());
+            for(size_t i = 0; i < count; ++i) {
+                auto& chunk = chunks.back();
+                ASSERT_NO_FATAL_FAILURE(AssertChunk(chunk, allocator.GetChunkSize()));
+                allocator.Deallocate(chunk);
+                chunks.pop_back();
+            }
+        }
+    }
+
+    for(auto chunk : chunks) {
+        allocator.Deallocate(chunk);
+    }
+    ASSERT_EQ(kMaxCount, allocator.GetFreeBlockCount());
+}
+
+TEST_F(LockFreePoolAllocatorTest, Buffer) {
+    LockFreePoolAllocator allocator(_buffer.data(), _buffer.size(), 1500);
+    auto packet = Buffer::Create(allocator);
+    ASSERT_EQ(1504, packet.GetViewWithCapacity().size);
+}
+
+TEST_F(LockFreePoolAllocatorTest, FailOnBigSize) {
+    LockFreePoolAllocator allocator(_buffer.data(), _buffer.size(), 1500);
+    ASSERT_EQ(nullptr, allocator.Allocate(1504 + 1));
+}
+
+TEST_F(LockFreePoolAllocatorTest, MultiThreaded) {
+    LockFreePoolAllocator allocator(_buffer.data(), _buffer.size(), 64);
+    const auto max_count = allocator.GetMaxBlockCount();
+
+    constexpr size_t kThreads = 8;
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&allocator, t]() {
+            std::vector<uint8_t*> chunks;
+            for(size_t iter = 0; iter < 10'000; ++iter) {
+                for(size_t i = 0; i < 8; ++i) {
+                    auto chunk = allocator.Allocate();
+                    ASSERT_NE(nullptr, chunk);
+                    FillChunk(chunk, allocator.GetChunkSize(), static_cast<uint8_t>(t));
+                    chunks.push_back(chunk);
+                }
+                for(auto chunk : chunks) {
+                    ASSERT_NO_FATAL_FAILURE(AssertChunk(chunk, allocator.GetChunkSize(), static_cast<uint8_t>(t)));
+                    allocator.Deallocate(chunk);
+                }
+                chunks.clear();
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(max_count, allocator.GetFreeBlockCount());
+}
+
+TEST_F(LockFreePoolAllocatorTest, DISABLED_MANUAL_ContentionBenchmark) {
+    constexpr size_t kIterations = 500'000;
+    const size_t threads_count = std::max<size_t>(4, std::thread::hardware_concurrency());
+    const auto blocks_count = threads_count * kMaxHeld; // allocation never fails
+    _buffer.resize(blocks_count * (Align(kUdpMtuSize, sizeof(size_t)) + sizeof(uint16_t)));
+
+    PoolAllocator mutex_allocator(_buffer.data(), _buffer.size(), kUdpMtuSize);
+    ASSERT_EQ(blocks_count, mutex_allocator.GetMaxBlockCount());
+    const auto mutex_duration = RunContention(mutex_allocator, threads_count, kIterations);
+    ASSERT_EQ(mutex_allocator.GetMaxBlockCount(), mutex_allocator.GetFreeBlockCount());
+
+    LockFreePoolAllocator lock_free_allocator(_buffer.data(), _buffer.size(), kUdpMtuSize);
+    ASSERT_EQ(blocks_count, lock_free_allocator.GetMaxBlockCount());
+    const auto lock_free_duration = RunContention(lock_free_allocator, threads_count, kIterations);
+    ASSERT_EQ(lock_free_allocator.GetMaxBlockCount(), lock_free_allocator.GetFreeBlockCount());
+
+    const auto operations = static_cast<double>(threads_count * kIterations);
+    TAU_LOG_INFO("Threads: " << threads_count
+        << ", mutex: " << static_cast<size_t>(operations / mutex_duration) << " op/sec"
+        << ", lock-free: " << static_cast<size_t>(operations / lock_free_duration) << " op/sec");
+}
+
+}
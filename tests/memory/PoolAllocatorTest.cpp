@@ -35,6 +35,7 @@ TEST_F(PoolAllocatorTest, Basic) {
     ASSERT_EQ(1504, allocator.GetChunkSize());
     constexpr auto kMaxCount = kBufferSize / (1504 + sizeof(uint16_t));
     ASSERT_EQ(kMaxCount, allocator.GetMaxBlockCount());
+    ASSERT_EQ(kMaxCount * 1504, allocator.GetCapacity());
 
     std::vector<uint8_t*> chunks;
     for(size_t i = 0; i < kMaxCount; ++i) {
@@ -0,0 +1,85 @@
+#include <tau/memory/SgBuffer.h>
+#include <tau/memory/SystemAllocator.h>
+#include "tests/lib/Common.h"
+
+namespace tau {
+
+class SgBufferTest : public ::testing::Test {
+protected:
+    static Buffer CreateBuffer(size_t capacity, size_t size, uint8_t seed) {
+        auto buffer = Buffer::Create(g_system_allocator, capacity, Buffer::Info{.tp = 42, .flags = kFlagsLast});
+        buffer.SetSize(size);
+        for(size_t i = 0; i < size; ++i) {
+            buffer.GetView().ptr[i] = static_cast<uint8_t>(i + seed);
+        }
+        return buffer;
+    }
+
+    static Buffer CreateSharedBuffer(size_t size) {
+        auto buffer = Buffer::CreateShared(g_system_allocator, size);
+        buffer.SetSize(size);
+        for(size_t i = 0; i < size; ++i) {
+            buffer.GetView().ptr[i] = static_cast<uint8_t>(i);
+        }
+        return buffer;
+    }
+};
+
+TEST_F(SgBufferTest, HeaderOnly) {
+    SgBuffer packet(CreateBuffer(100, 12, 0));
+    ASSERT_FALSE(packet.HasPayload());
+    ASSERT_EQ(12, packet.GetSize());
+    ASSERT_EQ(42, packet.GetInfo().tp);
+    ASSERT_EQ(1, packet.GetViews().size());
+
+    auto gathered = packet.Gather();
+    ASSERT_EQ(12, gathered.GetSize());
+    ASSERT_EQ(0, std::memcmp(packet.GetHeader().GetView().ptr, gathered.GetView().ptr, 12));
+}
+
+TEST_F(SgBufferTest, Gather) {
+    auto payload = CreateSharedBuffer(1000);
+    SgBuffer packet(CreateBuffer(100, 14, 200), payload.Slice(500, 80));
+    ASSERT_TRUE(packet.HasPayload());
+    ASSERT_EQ(94, packet.GetSize());
+    ASSERT_EQ(2, payload.GetRefCount());
+
+    const auto views = packet.GetViews();
+    ASSERT_EQ(2, views.size());
+    ASSERT_EQ(packet.GetHeader().GetView().ptr, views[0].ptr);
+    ASSERT_EQ(payload.GetView().ptr + 500, views[1].ptr);
+    ASSERT_EQ(80, views[1].size);
+
+    auto gathered = packet.Gather();
+    ASSERT_EQ(94, gathered.GetSize());
+    ASSERT_EQ(100, gathered.GetCapacity());
+    ASSERT_EQ(packet.GetInfo(), gathered.GetInfo());
+    for(size_t i = 0; i < 14; ++i) {
+        ASSERT_EQ(static_cast<uint8_t>(i + 200), gathered.GetView().ptr[i]);
+    }
+    ASSERT_EQ(0, std::memcmp(payload.GetView().ptr + 500, gathered.GetView().ptr + 14, 80));
+}
+
+TEST_F(SgBufferTest, NotEnoughTailroom) {
+    auto payload = CreateSharedBuffer(1000);
+    SgBuffer packet(CreateBuffer(100, 14, 0), payload.Slice(0, 87));
+    ASSERT_EQ(0, packet.Gather().GetSize());
+}
+
+TEST_F(SgBufferTest, MoveAssignment) {
+    auto payload = CreateSharedBuffer(1000);
+    SgBuffer packet1(CreateBuffer(100, 12, 0), payload.Slice(0, 10));
+    SgBuffer packet2(CreateBuffer(100, 12, 0));
+
+    packet2 = std::move(packet1);
+    ASSERT_TRUE(packet2.HasPayload());
+    ASSERT_FALSE(packet1.HasPayload());
+    ASSERT_EQ(22, packet2.GetSize());
+    ASSERT_EQ(2, payload.GetRefCount());
+
+    packet2 = SgBuffer(CreateBuffer(100, 12, 0));
+    ASSERT_FALSE(packet2.HasPayload());
+    ASSERT_EQ(1, payload.GetRefCount());
+}
+
+}
@@ -0,0 +1,164 @@
+#include <tau/memory/host/SizeClassAllocator.h>
+#include "tests/lib/Common.h"
+
+namespace tau {
+
+class SizeClassAllocatorTest : public ::testing::Test {
+public:
+    static inline const SizeClassAllocator::SizeClasses kClasses = {
+        {.block_size = 128,       .block_count = 64},
+        {.block_size = 256,       .block_count = 32},
+        {.block_size = 512,       .block_count = 16},
+        {.block_size = 1500,      .block_count = 16},
+        {.block_size = 4 * 1024,  .block_count = 4},
+        {.block_size = 64 * 1024, .block_count = 2},
+    };
+
+public:
+    SizeClassAllocatorTest()
+        : _buffer(SizeClassAllocator::GetRequiredSize(kClasses))
+    {}
+
+protected:
+    static void FillChunk(uint8_t* chunk, size_t size) {
+        for(size_t i = 0; i < size; ++i) {
+            chunk[i] = static_cast<uint8_t>(i);
+        }
+    }
+
+    static void AssertChunk(uint8_t* chunk, size_t size) {
+        for(size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(static_cast<uint8_t>(i), chunk[i]);
+        }
+    }
+
+protected:
+    std::vector<uint8_t> _buffer;
+    Random _random;
+};
+
+TEST_F(SizeClassAllocatorTest, Basic) {
+    SizeClassAllocator allocator(_buffer.data(), _buffer.size(), kClasses, kUdpMtuSize);
+    ASSERT_EQ(kClasses.size(), allocator.GetClassesCount());
+    ASSERT_EQ(1504, allocator.GetChunkSize());
+
+    for(size_t i = 0; i < kClasses.size(); ++i) {
+        const auto stats = allocator.GetStats(i);
+        ASSERT_EQ(Align(kClasses[i].block_size, sizeof(size_t)), stats.block_size);
+        ASSERT_EQ(kClasses[i].block_count, stats.max_block_count);
+        ASSERT_EQ(0, stats.used_block_count);
+    }
+
+    const std::vector<std::pair<size_t, size_t>> size_to_class = {
+        {1, 0}, {128, 0}, {129, 1}, {500, 2}, {1200, 3}, {1504, 3}, {4000, 4}, {60'000, 5}, {64 * 1024, 5}
+    };
+    for(auto [size, class_idx] : size_to_class) {
+        auto chunk = allocator.Allocate(size);
+        ASSERT_NE(nullptr, chunk);
+        FillChunk(chunk, size);
+        ASSERT_EQ(1, allocator.GetStats(class_idx).used_block_count);
+        ASSERT_NO_FATAL_FAILURE(AssertChunk(chunk, size));
+        allocator.Deallocate(chunk);
+        ASSERT_EQ(0, allocator.GetStats(class_idx).used_block_count);
+        ASSERT_EQ(1, allocator.GetStats(class_idx).peak_used_block_count);
+    }
+    ASSERT_EQ(nullptr, allocator.Allocate(64 * 1024 + 1));
+
+    auto chunk = allocator.Allocate();
+    ASSERT_EQ(1, allocator.GetStats(3).used_block_count);
+    allocator.Deallocate(chunk);
+}
+
+TEST_F(SizeClassAllocatorTest, Fallback) {
+    SizeClassAllocator allocator(_buffer.data(), _buffer.size(), kClasses, kUdpMtuSize);
+
+    std::vector<uint8_t*> chunks;
+    for(size_t i = 0; i < 64 + 32; ++i) {
+        chunks.push_back(allocator.Allocate(100));
+        ASSERT_NE(nullptr, chunks.back());
+    }
+    ASSERT_EQ(64, allocator.GetStats(0).used_block_count);
+    ASSERT_EQ(32, allocator.GetStats(1).used_block_count);
+    ASSERT_EQ(32, allocator.GetStats(1).fallback_count);
+
+    chunks.push_back(allocator.Allocate(100));
+    ASSERT_EQ(1, allocator.GetStats(2).used_block_count);
+
+    for(auto chunk : chunks) {
+        allocator.Deallocate(chunk);
+    }
+    for(size_t i = 0; i < kClasses.size(); ++i) {
+        ASSERT_EQ(0, allocator.GetStats(i).used_block_count);
+        ASSERT_EQ(0, allocator.GetStats(i).failed_count);
+    }
+}
+
+TEST_F(SizeClassAllocatorTest, Exhausted) {
+    SizeClassAllocator allocator(_buffer.data(), _buffer.size(), kClasses, kUdpMtuSize);
+
+    auto chunk1 = allocator.Allocate(64 * 1024);
+    auto chunk2 = allocator.Allocate(64 * 1024);
+    ASSERT_NE(nullptr, chunk1);
+    ASSERT_NE(nullptr, chunk2);
+    ASSERT_EQ(nullptr, allocator.Allocate(64 * 1024));
+    ASSERT_EQ(1, allocator.GetStats(5).failed_count);
+
+    allocator.Deallocate(chunk1);
+    allocator.Deallocate(chunk2);
+    ASSERT_EQ(2, allocator.GetStats(5).peak_used_block_count);
+}
+
+TEST_F(SizeClassAllocatorTest, NotEnoughMemory) {
+    ASSERT_ANY_THROW(SizeClassAllocator(_buffer.data(), _buffer.size() - 1, kClasses, kUdpMtuSize));
+    ASSERT_ANY_THROW(SizeClassAllocator(_buffer.data(), _buffer.size(), {}, kUdpMtuSize));
+}
+
+TEST_F(SizeClassAllocatorTest, Buffer) {
+    SizeClassAllocator allocator(_buffer.data(), _buffer.size(), kClasses, kUdpMtuSize);
+    {
+        auto packet = Buffer::Create(allocator);
+        ASSERT_EQ(1504, packet.GetViewWithCapacity().size);
+        auto rtcp = Buffer::Create(allocator, 80);
+        ASSERT_EQ(80, rtcp.GetViewWithCapacity().size);
+        auto nal_unit = Buffer::Create(allocator, 50'000);
+        ASSERT_EQ(50'000, nal_unit.GetViewWithCapacity().size);
+
+        ASSERT_EQ(1, allocator.GetStats(0).used_block_count);
+        ASSERT_EQ(1, allocator.GetStats(3).used_block_count);
+        ASSERT_EQ(1, allocator.GetStats(5).used_block_count);
+    }
+    for(size_t i = 0; i < kClasses.size(); ++i) {
+        ASSERT_EQ(0, allocator.GetStats(i).used_block_count);
+    }
+}
+
+TEST_F(SizeClassAllocatorTest, Randomized) {
+    SizeClassAllocator allocator(_buffer.data(), _buffer.size(), kClasses, kUdpMtuSize);
+
+    std::vector<std::pair<uint8_t*, size_t>> chunks;
+    for(size_t iter = 0; iter < 10'000; ++iter) {
+        if(_random.Bool()) {
+            const auto size = _random.Int<size_t>(1, 64 * 1024);
+            if(auto chunk = allocator.Allocate(size)) {
+                FillChunk(chunk, size);
+                chunks.emplace_back(chunk, size);
+            }
+        } else if(!chunks.empty()) {
+            const auto idx = _random.Int<size_t>(0, chunks.size() - 1);
+            auto [chunk, size] = chunks[idx];
+            ASSERT_NO_FATAL_FAILURE(AssertChunk(chunk, size));
+            allocator.Deallocate(chunk);
+            chunks.erase(chunks.begin() + idx);
+        }
+    }
+
+    for(auto [chunk, size] : chunks) {
+        ASSERT_NO_FATAL_FAILURE(AssertChunk(chunk, size));
+        allocator.Deallocate(chunk);
+    }
+    for(size_t i = 0; i < kClasses.size(); ++i) {
+        ASSERT_EQ(0, allocator.GetStats(i).used_block_count);
+    }
+}
+
+}
@@ -15,4 +15,22 @@ TEST(IpAddressTest, Basic) {
     ASSERT_NE(ip1, MakeIpAddressV4("127.0.255.99"));
 }
 
+TEST(IpAddressTest, Scope) {
+    ASSERT_TRUE(MakeIpAddressV4("127.0.0.1").IsLoopback());
+    ASSERT_TRUE(MakeIpAddressV4("127.1.2.3").IsLoopback());
+    ASSERT_FALSE(MakeIpAddressV4("128.0.0.1").IsLoopback());
+
+    ASSERT_TRUE(MakeIpAddressV4("169.254.10.1").IsLinkLocal());
+    ASSERT_FALSE(MakeIpAddressV4("169.253.10.1").IsLinkLocal());
+
+    ASSERT_TRUE(MakeIpAddressV4("10.1.2.3").IsPrivate());
+    ASSERT_TRUE(MakeIpAddressV4("172.16.0.1").IsPrivate());
+    ASSERT_TRUE(MakeIpAddressV4("172.31.255.255").IsPrivate());
+    ASSERT_FALSE(MakeIpAddressV4("172.32.0.1").IsPrivate());
+    ASSERT_FALSE(MakeIpAddressV4("172.15.0.1").IsPrivate());
+    ASSERT_TRUE(MakeIpAddressV4("192.168.0.1").IsPrivate());
+    ASSERT_FALSE(MakeIpAddressV4("192.169.0.1").IsPrivate());
+    ASSERT_FALSE(MakeIpAddressV4("8.8.8.8").IsPrivate());
+}
+
 }
@@ -0,0 +1,200 @@
+#include "tau/net/TcpSocket.h"
+#include "tau/asio/ThreadPool.h"
+#include "tau/asio/ToString.h"
+#include "tau/common/Event.h"
+#include "tests/lib/Common.h"
+
+namespace tau::net {
+
+class TcpSocketTest : public ::testing::Test {
+public:
+    static inline const IpAddress kLocalHost{MakeIpAddressV4("127.0.0.1")};
+    static constexpr size_t kFrameHeaderSize = sizeof(uint16_t);
+
+public:
+    TcpSocketTest()
+        : _io(1)
+        , _acceptor(_io.GetExecutor(), asio::ip::tcp::endpoint{asio::ip::make_address_v4("127.0.0.1"), 0})
+    {}
+
+    ~TcpSocketTest() {
+        Post([this]() {
+            _client.reset();
+            _server.reset();
+            boost_ec ec;
+            _acceptor.close(ec);
+        });
+        _io.Join();
+    }
+
+protected:
+    // 2-byte length prefix (RFC 4571 style) for the test
+    static size_t GetFrameSize(const BufferViewConst& view) {
+        return kFrameHeaderSize + Read16(view.ptr);
+    }
+
+    TcpSocket::Options CreateOptions() {
+        return TcpSocket::Options{
+            .allocator = g_udp_allocator,
+            .executor = _io.GetExecutor(),
+            .frame_header_size = kFrameHeaderSize,
+            .frame_size_callback = &GetFrameSize
+        };
+    }
+
+    void Init() {
+        Accept();
+        InitClient();
+    }
+
+    void Accept() {
+        _acceptor.async_accept([this](boost_ec ec, asio::ip::tcp::socket socket) {
+            ASSERT_FALSE(ec);
+            _server = TcpSocket::Create(CreateOptions(), std::move(socket));
+            _server->SetRecvCallback([this](Buffer&& message) {
+                _server_messages.push_back(std::move(message));
+            });
+            _server->SetErrorCallback([this](boost_ec) {
+                _server_error.Set();
+            });
+            _server->Start();
+        });
+    }
+
+    void InitClient() {
+        _client = TcpSocket::Create(CreateOptions());
+        _client->SetConnectCallback([this]() {
+            _client_connected.Set();
+        });
+        _client->SetRecvCallback([this](Buffer&& message) {
+            _client_messages.push_back(std::move(message));
+        });
+        _client->SetErrorCallback([this](boost_ec) {
+            _client_error.Set();
+        });
+    }
+
+    void Connect() {
+        const auto local_endpoint = _acceptor.local_endpoint();
+        Post([this, port = local_endpoint.port()]() {
+            _client->Connect(Endpoint{kLocalHost, port});
+        });
+    }
+
+    template<typename TFunction>
+    void Post(TFunction&& function) {
+        Event event;
+        asio::post(_io.GetExecutor(), [&]() {
+            function();
+            event.Set();
+        });
+        ASSERT_TRUE(event.WaitFor(1000ms));
+    }
+
+    static Buffer CreateMessage(size_t payload_size) {
+        auto message = Buffer::Create(g_udp_allocator);
+        auto view = message.GetViewWithCapacity();
+        Write16(view.ptr, static_cast<uint16_t>(payload_size));
+        for(size_t i = 0; i < payload_size; ++i) {
+            view.ptr[kFrameHeaderSize + i] = static_cast<uint8_t>(payload_size + i);
+        }
+        message.SetSize(kFrameHeaderSize + payload_size);
+        return message;
+    }
+
+    static void AssertMessage(const Buffer& message, size_t payload_size) {
+        const auto view = message.GetView();
+        ASSERT_EQ(kFrameHeaderSize + payload_size, view.size);
+        ASSERT_EQ(payload_size, Read16(view.ptr));
+        for(size_t i = 0; i < payload_size; ++i) {
+            ASSERT_EQ(static_cast<uint8_t>(payload_size + i), view.ptr[kFrameHeaderSize + i]);
+        }
+    }
+
+protected:
+    ThreadPool _io;
+    asio::ip::tcp::acceptor _acceptor;
+    TcpSocketPtr _client;
+    TcpSocketPtr _server;
+
+    Event _client_connected;
+    Event _client_error;
+    Event _server_error;
+    std::vector<Buffer> _client_messages;
+    std::vector<Buffer> _server_messages;
+};
+
+TEST_F(TcpSocketTest, Basic) {
+    Init();
+    Connect();
+    ASSERT_TRUE(_client_connected.WaitFor(1000ms));
+
+    constexpr size_t kMessages = 100;
+    Post([this]() {
+        for(size_t i = 0; i < kMessages; ++i) {
+            _client->Send(CreateMessage(i * 10));
+        }
+    });
+    ASSERT_TRUE(WaitForCondition([this]() { return _server_messages.size() == kMessages; }));
+    for(size_t i = 0; i < kMessages; ++i) {
+        ASSERT_NO_FATAL_FAILURE(AssertMessage(_server_messages[i], i * 10));
+    }
+
+    Post([this]() {
+        _server->Send(CreateMessage(1000));
+        _server->Send(CreateMessage(0));
+    });
+    ASSERT_TRUE(WaitForCondition([this]() { return _client_messages.size() == 2; }));
+    ASSERT_NO_FATAL_FAILURE(AssertMessage(_client_messages[0], 1000));
+    ASSERT_NO_FATAL_FAILURE(AssertMessage(_client_messages[1], 0));
+
+    // messages queued while the first write is in flight go out with one write
+    const auto& stats = _client->GetTxStats();
+    ASSERT_EQ(kMessages, stats.messages);
+    ASSERT_LT(stats.writes, kMessages);
+    ASSERT_EQ(0, stats.dropped);
+}
+
+TEST_F(TcpSocketTest, QueuedUntilConnected) {
+    Init();
+    Post([this]() {
+        for(size_t i = 0; i < 10; ++i) {
+            _client->Send(CreateMessage(100 + i));
+        }
+        ASSERT_FALSE(_client->IsConnected());
+    });
+    Connect();
+    ASSERT_TRUE(WaitForCondition([this]() { return _server_messages.size() == 10; }));
+    for(size_t i = 0; i < 10; ++i) {
+        ASSERT_NO_FATAL_FAILURE(AssertMessage(_server_messages[i], 100 + i));
+    }
+    ASSERT_EQ(1, _client->GetTxStats().writes);
+}
+
+TEST_F(TcpSocketTest, TooBigFrame) {
+    Init();
+    Connect();
+    ASSERT_TRUE(_client_connected.WaitFor(1000ms));
+
+    Post([this]() {
+        auto message = CreateMessage(100);
+        Write16(message.GetView().ptr, 0xFFFF); // doesn't fit the allocator block
+        _client->Send(std::move(message));
+    });
+    ASSERT_TRUE(_server_error.WaitFor(1000ms));
+    ASSERT_TRUE(_client_error.WaitFor(1000ms)); // closed by server
+    ASSERT_TRUE(_server_messages.empty());
+}
+
+TEST_F(TcpSocketTest, ConnectionRefused) {
+    const auto port = _acceptor.local_endpoint().port();
+    _acceptor.close();
+    InitClient();
+    Post([this, port]() {
+        _client->Connect(Endpoint{kLocalHost, port});
+    });
+    ASSERT_TRUE(_client_error.WaitFor(1000ms));
+    ASSERT_FALSE(_client_connected.IsSet());
+}
+
+}
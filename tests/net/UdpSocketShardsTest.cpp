@@ -0,0 +1,190 @@
+#include "tau/net/UdpSocketShards.h"
+#include "tau/net/UdpSocket.h"
+#include "tests/lib/Common.h"
+
+namespace tau::net {
+
+class UdpSocketShardsTest : public ::testing::Test {
+public:
+    static inline const IpAddress kLocalHost{MakeIpAddressV4("127.0.0.1")};
+    static constexpr size_t kMaxShards = 8;
+
+protected:
+    struct ShardContext {
+        size_t received = 0;
+        size_t wrong_owner = 0;
+        std::optional<std::thread::id> thread_id;
+        size_t wrong_thread = 0;
+        uint32_t work_result = 0;
+    };
+
+    static std::vector<UdpSocketPtr> CreateSenders(size_t count) {
+        std::vector<UdpSocketPtr> senders;
+        for(size_t i = 0; i < count; ++i) {
+            senders.push_back(UdpSocket::Create(UdpSocket::Options{
+                .allocator = g_udp_allocator,
+                .local_address = kLocalHost
+            }));
+        }
+        return senders;
+    }
+
+    // packets count expected by each shard owning the senders
+    static std::vector<size_t> GetExpectedDistribution(const UdpSocketShards& shards, const std::vector<UdpSocketPtr>& senders, size_t packets_count) {
+        std::vector<size_t> expected(shards.GetShardsCount(), 0);
+        for(size_t i = 0; i < packets_count; ++i) {
+            const auto& sender = senders[i % senders.size()];
+            expected[shards.GetShardIdx(sender->GetLocalEndpoint().value())]++;
+        }
+        return expected;
+    }
+
+    // must be called on the shard thread
+    static void OnPacket(ShardContext& ctx, const UdpSocketShards& shards, size_t shard_idx, const Buffer& packet, const Endpoint& remote) {
+        ctx.received++;
+        if(shards.GetShardIdx(remote) != shard_idx) {
+            ctx.wrong_owner++;
+        }
+        const auto thread_id = std::this_thread::get_id();
+        if(!ctx.thread_id) {
+            ctx.thread_id = thread_id;
+        } else if(*ctx.thread_id != thread_id) {
+            ctx.wrong_thread++;
+        }
+        // emulate per-packet SRTP-like processing
+        const auto view = packet.GetView();
+        for(size_t round = 0; round < 8; ++round) {
+            for(size_t i = 0; i < view.size; ++i) {
+                ctx.work_result = (ctx.work_result * 31) ^ view.ptr[i];
+            }
+        }
+    }
+};
+
+TEST_F(UdpSocketShardsTest, Basic) {
+    constexpr size_t kShardsCount = 4;
+    constexpr size_t kSendersCount = 8;
+    constexpr size_t kPacketsPerSender = 10;
+
+    UdpSocketShards shards(UdpSocketShards::Options{
+        .allocator = g_udp_allocator,
+        .local_address = kLocalHost,
+        .shards_count = kShardsCount
+    });
+    ASSERT_EQ(kShardsCount, shards.GetShardsCount());
+    const auto local_endpoint = shards.GetLocalEndpoint().value();
+    TAU_LOG_INFO("Kernel steering: " << shards.IsKernelSteering());
+
+    std::array<ShardContext, kShardsCount> contexts;
+    std::atomic<size_t> received{0};
+    shards.SetRecvCallback([&](size_t shard_idx, Buffer&& packet, Endpoint remote) {
+        OnPacket(contexts[shard_idx], shards, shard_idx, packet, remote);
+        shards.GetSocket(shard_idx).Send(std::move(packet), remote); // echo
+        received++;
+    });
+
+    auto senders = CreateSenders(kSendersCount);
+    const auto expected = GetExpectedDistribution(shards, senders, kSendersCount * kPacketsPerSender);
+    std::vector<size_t> echoed(kSendersCount, 0);
+    for(size_t i = 0; i < kSendersCount; ++i) {
+        senders[i]->SetRecvCallback([&echoed, i](Buffer&&, Endpoint) {
+            echoed[i]++;
+        });
+    }
+    for(size_t k = 0; k < kPacketsPerSender; ++k) {
+        for(auto& sender : senders) {
+            auto packet = Buffer::Create(g_udp_allocator);
+            packet.SetSize(100);
+            sender->Send(std::move(packet), local_endpoint);
+        }
+    }
+    ASSERT_TRUE(WaitForCondition([&]() {
+        size_t total = 0;
+        for(size_t i = 0; i < kSendersCount; ++i) {
+            senders[i]->Receive();
+            total += echoed[i];
+        }
+        return (total == kSendersCount * kPacketsPerSender);
+    }, 1 * kSec));
+    shards.Stop();
+    shards.Stop(); // no-op, the same for the destructor
+
+    ASSERT_EQ(kSendersCount * kPacketsPerSender, received);
+    size_t forwarded = 0;
+    for(size_t i = 0; i < kShardsCount; ++i) {
+        ASSERT_EQ(expected[i], contexts[i].received);
+        ASSERT_EQ(0, contexts[i].wrong_owner);
+        ASSERT_EQ(0, contexts[i].wrong_thread);
+        forwarded += shards.GetStats(i).forwarded;
+        TAU_LOG_INFO("Shard: " << i << ", received: " << contexts[i].received << ", forwarded: " << shards.GetStats(i).forwarded);
+    }
+    if(shards.IsKernelSteering()) {
+        ASSERT_EQ(0, forwarded);
+    }
+}
+
+TEST_F(UdpSocketShardsTest, DISABLED_MANUAL_Benchmark) {
+    constexpr size_t kSendersCount = 16;
+    constexpr size_t kPacketsCount = 40'000;
+    constexpr size_t kPacketSize = 1200;
+    std::vector<uint8_t> payload(kPacketSize, 0xAB);
+    const auto payload_view = BufferViewConst{.ptr = payload.data(), .size = payload.size()};
+    const auto max_shards = std::min<size_t>(kMaxShards, std::max(1u, std::thread::hardware_concurrency()));
+
+    for(size_t shards_count = 1; shards_count <= max_shards; shards_count *= 2) {
+        UdpSocketShards shards(UdpSocketShards::Options{
+            .allocator = g_udp_allocator,
+            .local_address = kLocalHost,
+            .shards_count = shards_count
+        });
+        const auto local_endpoint = shards.GetLocalEndpoint().value();
+
+        std::array<ShardContext, kMaxShards> contexts;
+        std::atomic<size_t> received{0};
+        shards.SetRecvCallback([&](size_t shard_idx, Buffer&& packet, Endpoint remote) {
+            OnPacket(contexts[shard_idx], shards, shard_idx, packet, remote);
+            received.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        auto senders = CreateSenders(kSendersCount);
+        const auto expected = GetExpectedDistribution(shards, senders, kPacketsCount);
+        SteadyClock clock;
+        const auto begin = clock.Now();
+        std::atomic<bool> sent{false};
+        std::thread tx_thread([&]() {
+            for(size_t i = 0; i < kPacketsCount; ++i) {
+                senders[i % kSendersCount]->Send(payload_view, local_endpoint);
+            }
+            sent = true;
+        });
+
+        auto last_rx_tp = begin;
+        auto last_received = received.load();
+        while(true) {
+            std::this_thread::sleep_for(1ms);
+            const auto now = clock.Now();
+            if(received != last_received) {
+                last_received = received;
+                last_rx_tp = now;
+            } else if(sent && (now - last_rx_tp > 50 * kMs)) {
+                break;
+            }
+        }
+        tx_thread.join();
+        shards.Stop();
+
+        const auto duration_sec = DurationSec(begin, last_rx_tp);
+        TAU_LOG_INFO("Shards: " << shards_count << ", received: " << received.load() << "/" << kPacketsCount
+            << ", packets/sec: " << static_cast<size_t>(received.load() / duration_sec));
+        ASSERT_LT(0, received);
+        for(size_t i = 0; i < shards_count; ++i) {
+            TAU_LOG_INFO("Shard: " << i << ", received: " << contexts[i].received << "/" << expected[i]);
+            ASSERT_GE(expected[i], contexts[i].received); // packets may be dropped under load
+            ASSERT_EQ(expected[i] > 0, contexts[i].received > 0);
+            ASSERT_EQ(0, contexts[i].wrong_owner);
+            ASSERT_EQ(0, contexts[i].wrong_thread);
+        }
+    }
+}
+
+}
@@ -134,6 +134,180 @@ TEST_F(UdpSocketTest, Load) {
     }
 }
 
+TEST_F(UdpSocketTest, TxBatch) {
+    constexpr size_t kPacketsCount = 40;
+    constexpr size_t kPacketSize = 1000;
+    constexpr size_t kLastPacketSize = 500;
+
+    for(bool gso : {false, true}) {
+        auto receiver = UdpSocket::Create(
+            UdpSocket::Options{
+                .allocator = g_udp_allocator,
+                .local_address = kLocalHost
+            });
+        auto sender = UdpSocket::Create(
+            UdpSocket::Options{
+                .allocator = g_udp_allocator,
+                .local_address = kLocalHost,
+                .tx_batch_size = 16,
+                .tx_gso = gso
+            });
+
+        size_t received = 0;
+        receiver->SetRecvCallback([&](Buffer&& packet, Endpoint remote_endpoint) {
+            EXPECT_EQ(sender->GetLocalEndpoint().value(), remote_endpoint);
+            const auto target_size = (received + 1 == kPacketsCount) ? kLastPacketSize : kPacketSize;
+            EXPECT_NO_FATAL_FAILURE(AssertPacket(packet, target_size));
+            received++;
+        });
+
+        for(size_t i = 0; i < kPacketsCount; ++i) {
+            const auto size = (i + 1 == kPacketsCount) ? kLastPacketSize : kPacketSize;
+            sender->Send(CreatePacket(size), receiver->GetLocalEndpoint().value());
+        }
+        ASSERT_EQ(32, sender->GetTxStats().packets);
+        sender->Flush();
+
+        auto begin = _clock.Now();
+        while((received < kPacketsCount) && (_clock.Now() - begin < 100 * kMs)) {
+            receiver->Receive();
+        }
+        ASSERT_EQ(kPacketsCount, received);
+
+        const auto& stats = sender->GetTxStats();
+        TAU_LOG_INFO("GSO: " << gso << ", packets: " << stats.packets << ", syscalls: " << stats.syscalls
+            << ", syscalls saved: " << stats.syscalls_saved << ", gso sends: " << stats.gso_sends);
+        ASSERT_EQ(kPacketsCount, stats.packets);
+        ASSERT_EQ(stats.packets, stats.syscalls + stats.syscalls_saved);
+        ASSERT_LT(0, stats.syscalls_saved);
+        ASSERT_EQ(0, stats.dropped);
+        if(!gso) {
+            ASSERT_EQ(0, stats.gso_sends);
+        }
+    }
+}
+
+TEST_F(UdpSocketTest, TxBatchFailed) {
+    auto sender = UdpSocket::Create(
+        UdpSocket::Options{
+            .allocator = g_udp_allocator,
+            .local_address = kLocalHost,
+            .tx_batch_size = 16,
+            .tx_gso = false
+        });
+    const Endpoint invalid_endpoint{.address = kLocalHost, .port = 0};
+    for(size_t i = 0; i < 4; ++i) {
+        sender->Send(CreatePacket(100), invalid_endpoint);
+    }
+    ASSERT_EQ(0, sender->GetTxStats().packets);
+    sender->Flush();
+
+    const auto& stats = sender->GetTxStats();
+    ASSERT_EQ(4, stats.packets);
+    ASSERT_EQ(4, stats.dropped);
+}
+
+TEST_F(UdpSocketTest, TxBatchConcurrentSend) {
+    constexpr size_t kThreads = 4;
+    constexpr size_t kPacketsPerThread = 25;
+    constexpr size_t kPacketSize = 100;
+
+    auto receiver = UdpSocket::Create(
+        UdpSocket::Options{
+            .allocator = g_udp_allocator,
+            .local_address = kLocalHost
+        });
+    auto sender = UdpSocket::Create(
+        UdpSocket::Options{
+            .allocator = g_udp_allocator,
+            .local_address = kLocalHost,
+            .tx_batch_size = 16,
+            .tx_gso = false
+        });
+    const auto receiver_endpoint = receiver->GetLocalEndpoint().value();
+
+    size_t received = 0;
+    receiver->SetRecvCallback([&](Buffer&& packet, Endpoint) {
+        EXPECT_NO_FATAL_FAILURE(AssertPacket(packet, kPacketSize));
+        received++;
+    });
+
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&]() {
+            for(size_t j = 0; j < kPacketsPerThread; ++j) {
+                sender->Send(CreatePacket(kPacketSize), receiver_endpoint);
+            }
+            sender->Flush();
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    auto begin = _clock.Now();
+    while((received < kThreads * kPacketsPerThread) && (_clock.Now() - begin < 100 * kMs)) {
+        receiver->Receive();
+    }
+    ASSERT_EQ(kThreads * kPacketsPerThread, received);
+    const auto stats = sender->GetTxStats();
+    ASSERT_EQ(kThreads * kPacketsPerThread, stats.packets);
+    ASSERT_EQ(0, stats.dropped);
+}
+
+TEST_F(UdpSocketTest, DISABLED_MANUAL_RxBatchBenchmark) {
+    constexpr size_t kPacketsCount = 50'000;
+    constexpr size_t kPacketSize = 1200;
+    std::vector<uint8_t> payload(kPacketSize, 0xAB);
+    const auto payload_view = BufferViewConst{.ptr = payload.data(), .size = payload.size()};
+
+    for(size_t batch_size : {1, 8, 32}) {
+        auto receiver = UdpSocket::Create(
+            UdpSocket::Options{
+                .allocator = g_udp_allocator,
+                .local_address = kLocalHost,
+                .rx_batch_size = batch_size
+            });
+        auto sender = UdpSocket::Create(
+            UdpSocket::Options{
+                .allocator = g_udp_allocator,
+                .local_address = kLocalHost
+            });
+        const auto receiver_endpoint = receiver->GetLocalEndpoint().value();
+
+        size_t received = 0;
+        receiver->SetRecvCallback([&](Buffer&& packet, Endpoint) {
+            EXPECT_EQ(kPacketSize, packet.GetSize());
+            received++;
+        });
+
+        std::atomic<bool> sent{false};
+        const auto begin = _clock.Now();
+        std::thread tx_thread([&]() {
+            for(size_t i = 0; i < kPacketsCount; ++i) {
+                sender->Send(payload_view, receiver_endpoint);
+            }
+            sent = true;
+        });
+
+        auto last_rx_tp = begin;
+        while(true) {
+            const auto now = _clock.Now();
+            if(receiver->Receive()) {
+                last_rx_tp = now;
+            } else if(sent && (now - last_rx_tp > 50 * kMs)) {
+                break;
+            }
+        }
+        tx_thread.join();
+
+        const auto duration_sec = DurationSec(begin, last_rx_tp);
+        TAU_LOG_INFO("Batch size: " << batch_size << ", received: " << received << "/" << kPacketsCount
+            << ", packets/sec: " << static_cast<size_t>(received / duration_sec));
+        ASSERT_LT(0, received);
+    }
+}
+
 TEST_F(UdpSocketTest, DISABLED_MANUAL_Multicast) {
     auto mdns_socket = UdpSocket::Create(
         UdpSocket::Options{
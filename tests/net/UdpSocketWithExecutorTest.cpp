@@ -80,6 +80,74 @@ TEST_F(UdpSocketWithExecutorTest, Basic) {
     ASSERT_TRUE(event2.WaitFor(100ms));
 }
 
+TEST_F(UdpSocketWithExecutorTest, RxHeadroom) {
+    constexpr auto kPacketSize = 1000;
+    constexpr auto kHeadroom = 36;
+
+    auto socket1 = UdpSocketWithExecutor::Create(
+        UdpSocketWithExecutor::Options{
+            .allocator = g_udp_allocator,
+            .executor = _io.GetExecutor(),
+            .local_address = kLocalHost,
+            .rx_headroom = kHeadroom
+        });
+    Event event;
+    socket1->SetRecvCallback([&](Buffer&& packet, Endpoint) {
+        EXPECT_EQ(kHeadroom, packet.GetHeadroom());
+        EXPECT_NO_FATAL_FAILURE(AssertPacket(packet, kPacketSize));
+        EXPECT_TRUE(packet.Prepend(kHeadroom));
+        event.Set();
+    });
+
+    auto socket2 = UdpSocketWithExecutor::Create(
+        UdpSocketWithExecutor::Options{
+            .allocator = g_udp_allocator,
+            .executor = _io.GetExecutor(),
+            .local_address = kLocalHost
+        });
+    socket2->Send(CreatePacket(kPacketSize), socket1->GetLocalEndpoint().value());
+    ASSERT_TRUE(event.WaitFor(100ms));
+}
+
+TEST_F(UdpSocketWithExecutorTest, RxBatch) {
+    constexpr size_t kPacketsCount = 100; // within the default socket receive buffer
+    constexpr size_t kPacketSize = 500;
+    constexpr auto kHeadroom = 36;
+
+    auto receiver = UdpSocketWithExecutor::Create(
+        UdpSocketWithExecutor::Options{
+            .allocator = g_udp_allocator,
+            .executor = _io.GetExecutor(),
+            .local_address = kLocalHost,
+            .rx_batch_size = 16,
+            .rx_headroom = kHeadroom
+        });
+    auto sender = UdpSocketWithExecutor::Create(
+        UdpSocketWithExecutor::Options{
+            .allocator = g_udp_allocator,
+            .executor = _io.GetExecutor(),
+            .local_address = kLocalHost
+        });
+    const auto sender_endpoint = sender->GetLocalEndpoint().value();
+
+    std::atomic<size_t> received = 0;
+    Event event;
+    receiver->SetRecvCallback([&](Buffer&& packet, Endpoint remote_endpoint) {
+        EXPECT_EQ(sender_endpoint, remote_endpoint);
+        EXPECT_EQ(kHeadroom, packet.GetHeadroom());
+        EXPECT_NO_FATAL_FAILURE(AssertPacket(packet, kPacketSize));
+        if(++received == kPacketsCount) {
+            event.Set();
+        }
+    });
+
+    for(size_t i = 0; i < kPacketsCount; ++i) {
+        sender->Send(CreatePacket(kPacketSize), receiver->GetLocalEndpoint().value());
+    }
+    ASSERT_TRUE(event.WaitFor(1000ms));
+    ASSERT_EQ(kPacketsCount, received);
+}
+
 TEST_F(UdpSocketWithExecutorTest, PortsPair) {
     auto [socket1, socket2] = CreateUdpSocketsPair<UdpSocketWithExecutor>(
         UdpSocketWithExecutor::Options{
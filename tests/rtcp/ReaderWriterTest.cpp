@@ -12,6 +12,8 @@
 #include "tau/rtcp/FirWriter.h"
 #include "tau/rtcp/NackReader.h"
 #include "tau/rtcp/NackWriter.h"
+#include "tau/rtcp/TwccReader.h"
+#include "tau/rtcp/TwccWriter.h"
 #include "tau/rtcp/SdesReader.h"
 #include "tau/rtcp/SdesWriter.h"
 #include "tau/memory/Buffer.h"
@@ -203,12 +205,145 @@ TEST_F(ReaderWriterTest, Nack_Randomized) {
     }
 }
 
+TEST_F(ReaderWriterTest, Nack_Bitmap) {
+    for(size_t i = 0; i < 100; ++i) {
+        const auto sn_begin = g_random.Int<uint16_t>();
+        const auto loss_rate = g_random.Real() * 0.2;
+        NackBitmap bitmap(sn_begin);
+        std::vector<uint16_t> sns;
+        for(size_t j = 0; j < NackBitmap::kSize; ++j) {
+            if(g_random.Real() < loss_rate) {
+                sns.push_back(static_cast<uint16_t>(sn_begin + j));
+                ASSERT_TRUE(bitmap.Set(sns.back()));
+            }
+        }
+        ASSERT_FALSE(bitmap.Set(static_cast<uint16_t>(sn_begin + NackBitmap::kSize)));
+        ASSERT_EQ(sns.size(), bitmap.GetSize());
+        if(sns.empty()) {
+            continue;
+        }
+
+        auto packet = Buffer::Create(g_system_allocator, 1500);
+        Writer writer(packet.GetViewWithCapacity());
+        ASSERT_TRUE(NackWriter::Write(writer, _sender_ssrc, _media_ssrc, bitmap));
+        packet.SetSize(writer.GetSize());
+
+        const auto view = ToConst(packet.GetView());
+        ASSERT_TRUE(Reader::Validate(view));
+        ASSERT_EQ(_sender_ssrc, NackReader::GetSenderSsrc(view));
+        ASSERT_EQ(_media_ssrc, NackReader::GetMediaSsrc(view));
+        std::vector<uint16_t> actual;
+        NackReader::ForEachSn(view, [&](uint16_t sn) { actual.push_back(sn); });
+        ASSERT_EQ(sns, actual);
+    }
+}
+
+// the oldest SNs are written if FCIs don't fit
+TEST_F(ReaderWriterTest, Nack_BitmapTruncated) {
+    NackBitmap bitmap(65500);
+    std::vector<uint16_t> sns;
+    for(uint16_t i = 0; i < 1000; i += 20) {
+        sns.push_back(static_cast<uint16_t>(65500 + i));
+        ASSERT_TRUE(bitmap.Set(sns.back()));
+    }
+    ASSERT_EQ(50, sns.size());
+
+    auto packet = Buffer::Create(g_system_allocator, 1500);
+    Writer small(BufferView{.ptr = packet.GetViewWithCapacity().ptr, .size = 15});
+    ASSERT_EQ(0, NackWriter::Write(small, _sender_ssrc, _media_ssrc, bitmap));
+    ASSERT_EQ(0, small.GetSize());
+
+    Writer writer(BufferView{.ptr = packet.GetViewWithCapacity().ptr, .size = 12 + 10 * sizeof(NackMessage)});
+    ASSERT_EQ(10, NackWriter::Write(writer, _sender_ssrc, _media_ssrc, bitmap));
+    packet.SetSize(writer.GetSize());
+
+    const auto view = ToConst(packet.GetView());
+    ASSERT_TRUE(Reader::Validate(view));
+    std::vector<uint16_t> actual;
+    NackReader::ForEachSn(view, [&](uint16_t sn) { actual.push_back(sn); });
+    ASSERT_EQ(std::vector<uint16_t>(sns.begin(), sns.begin() + 10), actual);
+}
+
 TEST_F(ReaderWriterTest, WrongNack_EmptySns) {
     auto packet = Buffer::Create(g_system_allocator, 1500);
     Writer writer(packet.GetViewWithCapacity());
     ASSERT_FALSE(NackWriter::Write(writer, _sender_ssrc, _media_ssrc, {}));
 }
 
+TEST_F(ReaderWriterTest, Twcc) {
+    auto packet = Buffer::Create(g_system_allocator, 1500);
+    TwccFeedback feedback{
+        .base_sn = 65530,
+        .fb_count = 7,
+        .reference_time = -2,
+        .deltas = {}
+    };
+    const std::vector<std::optional<int16_t>> deltas = {4, 0, std::nullopt, 255, 256, -1, std::nullopt, std::nullopt, 1000};
+    feedback.deltas.assign(deltas.begin(), deltas.end());
+    for(size_t i = 0; i < 20; ++i) {
+        feedback.deltas.push_back(std::nullopt); // run-length chunk
+    }
+    feedback.deltas.push_back(8);
+
+    Writer writer(packet.GetViewWithCapacity());
+    ASSERT_TRUE(TwccWriter::Write(writer, _sender_ssrc, _media_ssrc, feedback));
+    packet.SetSize(writer.GetSize());
+    ASSERT_EQ(0, packet.GetSize() % sizeof(uint32_t));
+
+    const auto view = ToConst(packet.GetView());
+    ASSERT_TRUE(Reader::Validate(view));
+    ASSERT_EQ(_sender_ssrc, TwccReader::GetSenderSsrc(view));
+    ASSERT_EQ(_media_ssrc, TwccReader::GetMediaSsrc(view));
+    ASSERT_EQ(feedback, TwccReader::GetFeedback(view).value());
+}
+
+TEST_F(ReaderWriterTest, Twcc_Randomized) {
+    for(size_t i = 0; i < 100; ++i) {
+        auto packet = Buffer::Create(g_system_allocator, 1500);
+        TwccFeedback feedback{
+            .base_sn = g_random.Int<uint16_t>(),
+            .fb_count = g_random.Int<uint8_t>(),
+            .reference_time = g_random.Int<int32_t>(-(1 << 23), (1 << 23) - 1),
+            .deltas = {}
+        };
+        const auto count = g_random.Int<size_t>(1, 300);
+        const auto loss_rate = g_random.Real();
+        const auto large_rate = g_random.Real() * 0.1;
+        for(size_t j = 0; j < count; ++j) {
+            if(g_random.Real() < loss_rate) {
+                feedback.deltas.push_back(std::nullopt);
+            } else if(g_random.Real() < large_rate) {
+                feedback.deltas.push_back(g_random.Int<int16_t>());
+            } else {
+                feedback.deltas.push_back(g_random.Int<int16_t>(0, 255));
+            }
+        }
+
+        Writer writer(packet.GetViewWithCapacity());
+        ASSERT_TRUE(TwccWriter::Write(writer, _sender_ssrc, _media_ssrc, feedback));
+        packet.SetSize(writer.GetSize());
+
+        const auto view = ToConst(packet.GetView());
+        ASSERT_TRUE(Reader::Validate(view));
+        ASSERT_EQ(feedback, TwccReader::GetFeedback(view).value());
+    }
+}
+
+TEST_F(ReaderWriterTest, WrongTwcc) {
+    auto packet = Buffer::Create(g_system_allocator, 1500);
+    Writer writer(packet.GetViewWithCapacity());
+    ASSERT_FALSE(TwccWriter::Write(writer, _sender_ssrc, _media_ssrc, TwccFeedback{}));
+
+    TwccFeedback feedback{.base_sn = 1, .fb_count = 0, .reference_time = 0, .deltas = {}};
+    feedback.deltas.push_back(1000);
+    feedback.deltas.push_back(1000);
+    ASSERT_TRUE(TwccWriter::Write(writer, _sender_ssrc, _media_ssrc, feedback));
+    packet.SetSize(writer.GetSize() - sizeof(uint32_t)); // recv deltas are truncated
+    const auto view = ToConst(packet.GetView());
+    ASSERT_FALSE(TwccReader::GetFeedback(view).has_value());
+    ASSERT_FALSE(Reader::Validate(view));
+}
+
 TEST_F(ReaderWriterTest, Sdes) {
     auto packet = Buffer::Create(g_system_allocator, 1500);
 
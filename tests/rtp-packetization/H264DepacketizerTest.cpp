@@ -98,6 +98,16 @@ TEST_F(H264DepacketizerTest, StapA_MalformedSize) {
     ASSERT_NO_FATAL_FAILURE(AssertNalUnit(_nal_units[0], NaluType::kSps, 2, tp));
 }
 
+TEST_F(H264DepacketizerTest, FuASharedNalu) {
+    auto nalu = CreateH264Nalu(NaluType::kIdr, 23456);
+    ASSERT_TRUE(_ctx->packetizer.Process(nalu, true));
+
+    ASSERT_TRUE(_ctx->depacketizer.Process(std::move(_rtp_packets)));
+    ASSERT_EQ(1, _nal_units.size());
+    ASSERT_TRUE(_nal_units[0].IsShared());
+    ASSERT_NO_FATAL_FAILURE(AssertBufferView(nalu.GetView(), _nal_units[0].GetView()));
+}
+
 TEST_F(H264DepacketizerTest, SkipFuAWithoutEnd) {
     auto nalu1 = CreateH264Nalu(NaluType::kIdr, 2222);
     auto nalu2 = CreateH264Nalu(NaluType::kSei, 777);
@@ -162,4 +172,33 @@ TEST_F(H264DepacketizerTest, NaluForbiddenBit) {
     ASSERT_EQ(0, _nal_units.size());
 }
 
+TEST_F(H264DepacketizerTest, IsKeyFrameStart) {
+    auto is_key_frame_start = [](const Buffer& packet) {
+        return H264Depacketizer::IsKeyFrameStart(Reader(packet.GetView()).Payload());
+    };
+    ASSERT_TRUE(_ctx->packetizer.Process(CreateH264Nalu(NaluType::kIdr, 2222), true)); // fragmented
+    ASSERT_LT(1, _rtp_packets.size());
+    for(size_t i = 0; i < _rtp_packets.size(); ++i) {
+        ASSERT_EQ(i == 0, is_key_frame_start(_rtp_packets[i]));
+    }
+
+    _rtp_packets.clear();
+    ASSERT_TRUE(_ctx->packetizer.Process(CreateH264Nalu(NaluType::kNonIdr, 100), true));
+    ASSERT_TRUE(_ctx->packetizer.Process(CreateH264Nalu(NaluType::kIdr, 100), true));
+    ASSERT_EQ(2, _rtp_packets.size());
+    ASSERT_FALSE(is_key_frame_start(_rtp_packets[0]));
+    ASSERT_TRUE(is_key_frame_start(_rtp_packets[1]));
+
+    _rtp_packets.clear();
+    _rtp_packets.push_back(
+        CreateRtpPacket(etl::vector<uint8_t, 1024>{
+            CreateNalUnitHeader(NaluType::kStapA, 0b11),
+            0, 3,
+            CreateNalUnitHeader(NaluType::kPps, 0b11), 1, 2,
+            0, 2,
+            CreateNalUnitHeader(NaluType::kSps, 0b11), 1
+        }));
+    ASSERT_TRUE(is_key_frame_start(_rtp_packets[0])); // aggregated SPS
+}
+
 }
@@ -6,6 +6,29 @@ namespace tau::rtp {
 using namespace h264;
 
 class H264PacketizationTest : public H264PacketizationBase, public ::testing::Test {
+protected:
+    // the frame exceeds Frame capacity, so it's passed by chunks as FrameProcessor does
+    static bool ProcessByChunks(H264Depacketizer& depacketizer, std::vector<Buffer>&& rtp_packets) {
+        bool ok = true;
+        Frame chunk;
+        for(size_t i = 0; i < rtp_packets.size(); ++i) {
+            if(chunk.full()) {
+                ok &= depacketizer.ProcessChunk(std::move(chunk));
+                chunk.clear();
+            }
+            chunk.push_back(std::move(rtp_packets[i]));
+        }
+        return ok && depacketizer.Process(std::move(chunk));
+    }
+
+    std::vector<Buffer> PacketizeHugeNalu(const Buffer& nalu) {
+        std::vector<Buffer> rtp_packets;
+        _ctx->packetizer.SetCallback([&](Buffer&& rtp_packet) {
+            rtp_packets.push_back(std::move(rtp_packet));
+        });
+        EXPECT_TRUE(_ctx->packetizer.Process(nalu, true));
+        return rtp_packets;
+    }
 };
 
 TEST_F(H264PacketizationTest, Randomized) {
@@ -70,4 +93,30 @@ TEST_F(H264PacketizationTest, Randomized_Au) {
     }
 }
 
+TEST_F(H264PacketizationTest, HugeNalu) {
+    constexpr size_t kNaluSize = 600'000; // 4K key-frame
+    auto nalu = CreateH264Nalu(NaluType::kIdr, kNaluSize);
+    auto rtp_packets = PacketizeHugeNalu(nalu);
+    ASSERT_LT(4 * kFrameChunkSize, rtp_packets.size());
+    ASSERT_TRUE(ProcessByChunks(_ctx->depacketizer, std::move(rtp_packets)));
+    ASSERT_EQ(1, _nal_units.size());
+    ASSERT_NO_FATAL_FAILURE(AssertBufferView(nalu.GetView(), _nal_units[0].GetView()));
+    ASSERT_EQ(kFlagsLast, _nal_units[0].GetInfo().flags);
+    ASSERT_EQ(kNaluSize, _nal_units[0].GetCapacity());
+}
+
+TEST_F(H264PacketizationTest, HugeNalu_MaxSize) {
+    constexpr size_t kNaluSize = 600'000;
+    size_t nal_units = 0;
+    H264Depacketizer depacketizer(g_system_allocator, kNaluSize - 1);
+    depacketizer.SetCallback([&](Buffer&&) { nal_units++; });
+    ASSERT_FALSE(ProcessByChunks(depacketizer, PacketizeHugeNalu(CreateH264Nalu(NaluType::kIdr, kNaluSize))));
+    ASSERT_EQ(0, nal_units);
+
+    H264Depacketizer depacketizer_fit(g_system_allocator, kNaluSize);
+    depacketizer_fit.SetCallback([&](Buffer&&) { nal_units++; });
+    ASSERT_TRUE(ProcessByChunks(depacketizer_fit, PacketizeHugeNalu(CreateH264Nalu(NaluType::kIdr, kNaluSize))));
+    ASSERT_EQ(1, nal_units);
+}
+
 }
@@ -37,6 +37,44 @@ TEST_F(H264PacketizerTest, FuA) {
     }
 }
 
+TEST_F(H264PacketizerTest, ScatterGather) {
+    const auto nalu = CreateH264Nalu(NaluType::kIdr, 23456);
+    auto shared_nalu = Buffer::CreateShared(g_system_allocator, nalu.GetSize(), nalu.GetInfo());
+    shared_nalu.SetSize(nalu.GetSize());
+    std::memcpy(shared_nalu.GetView().ptr, nalu.GetView().ptr, nalu.GetSize());
+
+    ASSERT_TRUE(_ctx->packetizer.Process(nalu, true));
+    ASSERT_EQ(21, _rtp_packets.size());
+
+    auto rtp_packets = std::move(_rtp_packets);
+    Init();
+    std::vector<SgBuffer> sg_packets;
+    _ctx->packetizer.SetSgCallback([&sg_packets](SgBuffer&& rtp_packet) {
+        sg_packets.push_back(std::move(rtp_packet));
+    });
+
+    ASSERT_TRUE(_ctx->packetizer.Process(shared_nalu, true));
+    ASSERT_EQ(0, _rtp_packets.size());
+    ASSERT_EQ(rtp_packets.size(), sg_packets.size());
+    ASSERT_EQ(1 + sg_packets.size(), shared_nalu.GetRefCount());
+
+    const auto nalu_view = shared_nalu.GetView();
+    for(size_t i = 0; i < sg_packets.size(); ++i) {
+        auto& sg_packet = sg_packets[i];
+        ASSERT_TRUE(sg_packet.HasPayload());
+        const auto payload = sg_packet.GetPayload().GetView();
+        ASSERT_LE(nalu_view.ptr, payload.ptr);
+        ASSERT_GE(nalu_view.ptr + nalu_view.size, payload.ptr + payload.size);
+        ASSERT_EQ(rtp_packets[i].GetSize(), sg_packet.GetSize());
+
+        auto packet = sg_packet.Gather();
+        ASSERT_NO_FATAL_FAILURE(AssertBufferView(rtp_packets[i].GetView(), packet.GetView()));
+    }
+
+    sg_packets.clear();
+    ASSERT_EQ(1, shared_nalu.GetRefCount());
+}
+
 TEST_F(H264PacketizerTest, SkipHeaderOnlyNalu) {
     auto nalu = CreateH264Nalu(NaluType::kAud, 1);
     ASSERT_FALSE(_ctx->packetizer.Process(nalu, true));
@@ -166,4 +166,33 @@ TEST_F(H265DepacketizerTest, NaluForbiddenBit) {
     ASSERT_EQ(0, _nal_units.size());
 }
 
+TEST_F(H265DepacketizerTest, IsKeyFrameStart) {
+    auto is_key_frame_start = [](const Buffer& packet) {
+        return H265Depacketizer::IsKeyFrameStart(Reader(packet.GetView()).Payload());
+    };
+    ASSERT_TRUE(_ctx->packetizer.Process(CreateH265Nalu(NaluType::kIdrWRadl, 2222), true)); // fragmented
+    ASSERT_LT(1, _rtp_packets.size());
+    for(size_t i = 0; i < _rtp_packets.size(); ++i) {
+        ASSERT_EQ(i == 0, is_key_frame_start(_rtp_packets[i]));
+    }
+
+    _rtp_packets.clear();
+    ASSERT_TRUE(_ctx->packetizer.Process(CreateH265Nalu(NaluType::kTrailR, 100), true));
+    ASSERT_TRUE(_ctx->packetizer.Process(CreateH265Nalu(NaluType::kIdrWRadl, 100), true));
+    ASSERT_EQ(2, _rtp_packets.size());
+    ASSERT_FALSE(is_key_frame_start(_rtp_packets[0]));
+    ASSERT_TRUE(is_key_frame_start(_rtp_packets[1]));
+
+    _rtp_packets.clear();
+    _rtp_packets.push_back(
+        CreateRtpPacket(etl::vector<uint8_t, 1024>{
+            NaluType::kAp << 1, 0,
+            0, 5,
+            NaluType::kPps << 1, 0, 2, 3, 4,
+            0, 4,
+            NaluType::kSps << 1, 0, 2, 3
+        }));
+    ASSERT_TRUE(is_key_frame_start(_rtp_packets[0])); // aggregated SPS
+}
+
 }
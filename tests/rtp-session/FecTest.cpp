@@ -0,0 +1,266 @@
+#include "tau/rtp-session/FecEncoder.h"
+#include "tau/rtp-session/FecDecoder.h"
+#include "tau/rtp-session/Session.h"
+#include "tau/rtp-session/TwccSender.h"
+#include "tau/rtp-session/TwccReceiver.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/Writer.h"
+#include "tau/rtp/Extension.h"
+#include "tau/rtp/Constants.h"
+#include "tau/common/NetToHost.h"
+#include "tests/lib/Common.h"
+
+namespace tau::rtp::session {
+
+class FecTest : public ::testing::Test {
+public:
+    static constexpr uint8_t kPt = 96;
+    static constexpr uint8_t kFecPt = 98;
+    static constexpr uint32_t kSsrc = 0x11223344;
+    static constexpr uint32_t kFecSsrc = 0x55667788;
+
+protected:
+    static Buffer CreatePacket(uint16_t sn, uint32_t ts, bool marker, size_t payload_size, bool random_extension = true) {
+        auto packet = Buffer::Create(g_udp_allocator, Buffer::Info{});
+        const auto extension = random_extension ? g_random.Int<uint16_t>(0, 2) : uint16_t{0};
+        auto result = Writer::Write(packet.GetViewWithCapacity(), Writer::Options{
+            .pt = kPt,
+            .ssrc = kSsrc,
+            .ts = ts,
+            .sn = sn,
+            .marker = marker,
+            .extension_length_in_words = extension
+        });
+        for(size_t i = 0; i < result.extension.size; ++i) {
+            result.extension.ptr[i] = g_random.Int<uint8_t>();
+        }
+        for(size_t i = 0; i < payload_size; ++i) {
+            result.payload.ptr[i] = g_random.Int<uint8_t>();
+        }
+        packet.SetSize(result.size + payload_size);
+        return packet;
+    }
+
+    static void AssertEqual(const Buffer& target, const Buffer& actual) {
+        ASSERT_EQ(target.GetSize(), actual.GetSize());
+        ASSERT_EQ(0, std::memcmp(target.GetView().ptr, actual.GetView().ptr, target.GetSize()));
+    }
+};
+
+TEST_F(FecTest, Recovery) {
+    constexpr size_t kPackets = 1000;
+    FecEncoder encoder(FecEncoder::Dependencies{.allocator = g_udp_allocator}, FecEncoder::Options{.pt = kFecPt, .ssrc = kFecSsrc, .sn = 100, .protection = 0.25});
+    ASSERT_EQ(4, encoder.GetGroupSize());
+    FecDecoder decoder(FecDecoder::Dependencies{.allocator = g_udp_allocator});
+    std::vector<Buffer> recovered;
+    decoder.SetCallback([&](Buffer&& packet) { recovered.push_back(std::move(packet)); });
+
+    std::vector<Buffer> lost;
+    size_t repairs = 0;
+    uint16_t sn = g_random.Int<uint16_t>();
+    for(size_t i = 0; i < kPackets; ++i, ++sn) {
+        const auto marker = (g_random.Int<uint8_t>(0, 9) == 0);
+        auto packet = CreatePacket(sn, static_cast<uint32_t>(i / 10 * 3000), marker, g_random.Int<size_t>(1, 1200));
+        auto repair = encoder.Push(SgBuffer::Views{ToConst(packet.GetView())});
+        if(g_random.Int<uint8_t>(0, 9) == 0) {
+            lost.push_back(std::move(packet));
+        } else {
+            decoder.PushMedia(packet);
+        }
+        if(repair) {
+            Reader reader(ToConst(repair->GetView()));
+            ASSERT_EQ(kFecPt, reader.Pt());
+            ASSERT_EQ(kFecSsrc, reader.Ssrc());
+            ASSERT_EQ(static_cast<uint16_t>(100 + repairs), reader.Sn());
+            ASSERT_FALSE(reader.Marker());
+            const auto view = repair->GetView();
+            ASSERT_EQ(1, view.ptr[0] & 0x0F);
+            ASSERT_EQ(kSsrc, Read32(view.ptr + kFixedHeaderSize));
+            repairs++;
+            decoder.PushRepair(std::move(*repair));
+        }
+    }
+    ASSERT_LE(kPackets / 4, repairs);
+
+    // single loss of the group is recovered
+    ASSERT_LT(lost.size() / 2, recovered.size());
+    for(auto& packet : recovered) {
+        const auto sn = Reader(ToConst(packet.GetView())).Sn();
+        auto it = std::find_if(lost.begin(), lost.end(), [sn](const Buffer& lost_packet) {
+            return Reader(lost_packet.GetView()).Sn() == sn;
+        });
+        ASSERT_NE(lost.end(), it);
+        ASSERT_NO_FATAL_FAILURE(AssertEqual(*it, packet));
+    }
+}
+
+TEST_F(FecTest, ProtectedSsrc) {
+    FecEncoder encoder(FecEncoder::Dependencies{.allocator = g_udp_allocator}, FecEncoder::Options{.pt = kFecPt, .ssrc = kFecSsrc, .protection = 0.5});
+    FecDecoder decoder(FecDecoder::Dependencies{.allocator = g_udp_allocator});
+    std::vector<Buffer> recovered;
+    decoder.SetCallback([&](Buffer&& packet) { recovered.push_back(std::move(packet)); });
+
+    auto first = CreatePacket(0, 0, false, 100);
+    auto second = CreatePacket(1, 0, false, 200);
+    ASSERT_FALSE(encoder.Push(SgBuffer::Views{ToConst(first.GetView())}));
+    auto repair = encoder.Push(SgBuffer::Views{ToConst(second.GetView())});
+    ASSERT_TRUE(repair.has_value());
+    auto other_repair = repair->MakeCopy();
+    Write32(other_repair.GetView().ptr + kFixedHeaderSize, kSsrc + 1);
+
+    decoder.PushMedia(first);
+    decoder.PushRepair(std::move(other_repair));
+    ASSERT_TRUE(recovered.empty());
+    decoder.PushRepair(std::move(*repair));
+    ASSERT_EQ(1, recovered.size());
+    ASSERT_NO_FATAL_FAILURE(AssertEqual(second, recovered[0]));
+}
+
+TEST_F(FecTest, ScatterGatherAndLateMedia) {
+    FecEncoder encoder(FecEncoder::Dependencies{.allocator = g_udp_allocator}, FecEncoder::Options{.pt = kFecPt, .ssrc = kFecSsrc, .protection = 0.2});
+    ASSERT_EQ(5, encoder.GetGroupSize());
+    FecDecoder decoder(FecDecoder::Dependencies{.allocator = g_udp_allocator});
+    std::vector<Buffer> recovered;
+    decoder.SetCallback([&](Buffer&& packet) { recovered.push_back(std::move(packet)); });
+
+    std::vector<Buffer> packets;
+    std::optional<Buffer> repair;
+    for(uint16_t sn = 0; sn < 5; ++sn) {
+        packets.push_back(CreatePacket(sn, 0, false, 100 * (sn + 1)));
+        const auto view = ToConst(packets.back().GetView());
+        const auto header_size = Reader(view).Payload().ptr - view.ptr;
+        const auto split = g_random.Int<size_t>(header_size, view.size);
+        repair = encoder.Push(SgBuffer::Views{
+            BufferViewConst{.ptr = view.ptr, .size = split},
+            BufferViewConst{.ptr = view.ptr + split, .size = view.size - split}
+        });
+    }
+    ASSERT_TRUE(repair.has_value());
+
+    // two packets are missing, the repair packet waits for late media
+    decoder.PushMedia(packets[0]);
+    decoder.PushMedia(packets[2]);
+    decoder.PushMedia(packets[4]);
+    decoder.PushRepair(std::move(*repair));
+    ASSERT_TRUE(recovered.empty());
+    decoder.PushMedia(packets[3]);
+    ASSERT_EQ(1, recovered.size());
+    ASSERT_NO_FATAL_FAILURE(AssertEqual(packets[1], recovered[0]));
+}
+
+TEST_F(FecTest, Session) {
+    constexpr size_t kFrames = 100;
+    constexpr size_t kPacketsPerFrame = 6;
+    constexpr size_t kPacketLostPeriod = 9;
+    TestClock clock;
+    Session sender(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = clock, .system_clock = clock},
+        Session::Options{.rate = 90'000, .sender_ssrc = kSsrc, .base_ts = 0, .rtx = false,
+            .fec = FecEncoder::Options{.pt = kFecPt, .ssrc = kFecSsrc, .protection = 0.25}});
+    Session receiver(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = clock, .system_clock = clock},
+        Session::Options{.rate = 90'000, .sender_ssrc = g_random.Int<uint32_t>(), .base_ts = 0, .rtx = false,
+            .fec = FecEncoder::Options{.pt = kFecPt, .ssrc = g_random.Int<uint32_t>()}});
+
+    size_t sent = 0;
+    size_t dropped = 0;
+    sender.SetSendRtpCallback([&](Buffer&& packet) {
+        if((Reader(ToConst(packet.GetView())).Pt() == kPt) && (++sent % kPacketLostPeriod == 0)) {
+            dropped++;
+            return;
+        }
+        receiver.RecvRtp(std::move(packet));
+    });
+    sender.SetSendRtcpCallback([&](Buffer&& packet) { receiver.RecvRtcp(std::move(packet)); });
+    std::vector<Buffer> received;
+    receiver.SetRecvRtpCallback([&](Buffer&& packet) { received.push_back(std::move(packet)); });
+    receiver.SetSendRtcpCallback([&](Buffer&& packet) { sender.RecvRtcp(std::move(packet)); });
+
+    uint16_t sn = 0;
+    for(size_t i = 0; i < kFrames; ++i) {
+        for(size_t j = 0; j < kPacketsPerFrame; ++j) {
+            auto packet = CreatePacket(sn, static_cast<uint32_t>(i * 3000), j + 1 == kPacketsPerFrame, 1000);
+            auto view = packet.GetView();
+            Write16(view.ptr + (Reader(ToConst(view)).Payload().ptr - view.ptr), sn++);
+            sender.SendRtp(std::move(packet));
+        }
+        clock.Add(33 * kMs);
+    }
+
+    // groups of 4 packets and frame tails, no more than one loss per group
+    ASSERT_LT(0, dropped);
+    ASSERT_EQ(kFrames * 2, sender.GetStats().outgoing.fec);
+    ASSERT_EQ(kFrames * kPacketsPerFrame, received.size());
+    for(size_t i = 0; i < received.size(); ++i) {
+        Reader reader(ToConst(received[i].GetView()));
+        ASSERT_EQ(kPt, reader.Pt());
+        ASSERT_EQ(kSsrc, reader.Ssrc());
+        ASSERT_EQ(static_cast<uint16_t>(i), reader.Sn());
+        ASSERT_EQ(reader.Sn(), Read16(reader.Payload().ptr));
+    }
+    const auto& stats = receiver.GetStats();
+    ASSERT_EQ(sent - dropped, stats.incoming.rtp);
+    ASSERT_EQ(kFrames * 2, stats.incoming.fec);
+    ASSERT_EQ(dropped, stats.incoming.recovered);
+    ASSERT_EQ(0, stats.incoming.discarded);
+}
+
+// transport-wide sn is written after FEC encoding and differs for RTX, it's zeroed in the protected packets
+TEST_F(FecTest, SessionWithTwcc) {
+    constexpr uint8_t kExtensionId = 5;
+    constexpr size_t kFrames = 100;
+    constexpr size_t kPacketsPerFrame = 6;
+    constexpr size_t kPacketLostPeriod = 9;
+    TestClock clock;
+    TwccSender twcc_sender(TwccSender::Dependencies{.clock = clock}, TwccSender::Options{.extension_id = kExtensionId});
+    TwccReceiver twcc_receiver(TwccReceiver::Dependencies{.clock = clock}, TwccReceiver::Options{.extension_id = kExtensionId});
+    Session sender(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = clock, .system_clock = clock, .twcc_sender = &twcc_sender},
+        Session::Options{.rate = 90'000, .sender_ssrc = kSsrc, .base_ts = 0, .rtx = false,
+            .fec = FecEncoder::Options{.pt = kFecPt, .ssrc = kFecSsrc, .protection = 0.25}});
+    Session receiver(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = clock, .system_clock = clock, .twcc_receiver = &twcc_receiver},
+        Session::Options{.rate = 90'000, .sender_ssrc = g_random.Int<uint32_t>(), .base_ts = 0, .rtx = false,
+            .fec = FecEncoder::Options{.pt = kFecPt, .ssrc = g_random.Int<uint32_t>()}});
+
+    size_t sent = 0;
+    size_t dropped = 0;
+    sender.SetSendRtpCallback([&](Buffer&& packet) {
+        ASSERT_TRUE(ExtensionReader::Find(Reader(ToConst(packet.GetView())).Extensions(), kExtensionId).has_value());
+        if((Reader(ToConst(packet.GetView())).Pt() == kPt) && (++sent % kPacketLostPeriod == 0)) {
+            dropped++;
+            return;
+        }
+        receiver.RecvRtp(std::move(packet));
+    });
+    sender.SetSendRtcpCallback([&](Buffer&& packet) { receiver.RecvRtcp(std::move(packet)); });
+    std::vector<Buffer> received;
+    receiver.SetRecvRtpCallback([&](Buffer&& packet) { received.push_back(std::move(packet)); });
+    receiver.SetSendRtcpCallback([&](Buffer&& packet) { sender.RecvRtcp(std::move(packet)); });
+
+    std::vector<Buffer> packets;
+    uint16_t sn = 0;
+    for(size_t i = 0; i < kFrames; ++i) {
+        for(size_t j = 0; j < kPacketsPerFrame; ++j) {
+            auto packet = CreatePacket(sn++, static_cast<uint32_t>(i * 3000), j + 1 == kPacketsPerFrame, 1000, false);
+            packets.push_back(packet.MakeCopy());
+            sender.SendRtp(std::move(packet));
+        }
+        clock.Add(33 * kMs);
+    }
+
+    ASSERT_LT(0, dropped);
+    ASSERT_EQ(sent + kFrames * 2, twcc_sender.GetStats().stamped);
+    ASSERT_EQ(packets.size(), received.size());
+    for(size_t i = 0; i < received.size(); ++i) {
+        const auto expected = Reader(ToConst(packets[i].GetView())).Payload();
+        const auto actual = Reader(ToConst(received[i].GetView())).Payload();
+        ASSERT_EQ(static_cast<uint16_t>(i), Reader(ToConst(received[i].GetView())).Sn());
+        ASSERT_EQ(expected.size, actual.size);
+        ASSERT_EQ(0, std::memcmp(expected.ptr, actual.ptr, expected.size));
+    }
+    ASSERT_EQ(dropped, receiver.GetStats().incoming.recovered);
+    ASSERT_EQ(0, receiver.GetStats().incoming.discarded);
+}
+
+}
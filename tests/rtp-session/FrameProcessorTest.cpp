@@ -133,4 +133,36 @@ TEST_F(FrameProcessorTest, DropPacketWithMarkerAndNextOne) {
     ASSERT_NO_FATAL_FAILURE(AssertFrame(1, 3, false));
 }
 
+TEST_F(FrameProcessorTest, HugeFrame) {
+    etl::vector<size_t, 8> chunks;
+    _frame_processor.SetChunkCallback([&](Frame&& chunk, bool losses) {
+        ASSERT_FALSE(losses);
+        chunks.push_back(chunk.size());
+    });
+    uint32_t ts = g_random.Int<uint32_t>();
+    uint16_t sn = g_random.Int<uint16_t>();
+    for(size_t i = 0; i < 300; ++i, ++sn) {
+        _frame_processor.PushRtp(CreatePacket(ts, sn, i + 1 == 300));
+    }
+    ASSERT_EQ(2, chunks.size());
+    ASSERT_EQ(kFrameChunkSize, chunks[0]);
+    ASSERT_EQ(kFrameChunkSize, chunks[1]);
+    ASSERT_EQ(1, _frames.size());
+    ASSERT_NO_FATAL_FAILURE(AssertFrame(0, 300 - 2 * kFrameChunkSize, false));
+}
+
+TEST_F(FrameProcessorTest, HugeFrameWithoutChunkCallback) {
+    uint32_t ts = g_random.Int<uint32_t>();
+    uint16_t sn = g_random.Int<uint16_t>();
+    for(size_t i = 0; i < 300; ++i, ++sn) {
+        _frame_processor.PushRtp(CreatePacket(ts, sn, i + 1 == 300));
+    }
+    ASSERT_EQ(1, _frames.size());
+    ASSERT_NO_FATAL_FAILURE(AssertFrame(0, 300 - 2 * kFrameChunkSize, true));
+
+    ts += 90000 / 30;
+    PushPackets(ts, ToVector({sn, SnForward(sn, 1)}), SnForward(sn, 1));
+    ASSERT_NO_FATAL_FAILURE(AssertFrame(1, 2, false));
+}
+
 }
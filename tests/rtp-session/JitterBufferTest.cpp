@@ -0,0 +1,187 @@
+#include "tau/rtp-session/JitterBuffer.h"
+#include "tests/lib/Common.h"
+#include "tests/lib/RtpUtils.h"
+
+namespace tau::rtp::session {
+
+class JitterBufferTest : public ::testing::Test {
+public:
+    static constexpr uint32_t kRate = 90'000;
+    static constexpr uint32_t kTsStep = kRate / 30;
+    static constexpr Timepoint kFrameDuration = kSec * kTsStep / kRate;
+    static constexpr Timepoint kNetworkDelay = 20 * kMs;
+    static constexpr size_t kPacketsPerFrame = 3;
+
+    JitterBufferTest()
+        : _jitter_buffer(JitterBuffer::Dependencies{.clock = _clock}, JitterBuffer::Options{.rate = kRate})
+        , _sender_tp(_clock.Now())
+    {
+        _jitter_buffer.SetCallback([this](Frame&& frame, bool losses) {
+            _released.push_back(Released{
+                .tp = _clock.Now(),
+                .ts = Reader(ToConst(frame.front().GetView())).Ts(),
+                .losses = losses
+            });
+        });
+    }
+
+protected:
+    struct Released {
+        Timepoint tp;
+        uint32_t ts;
+        bool losses;
+    };
+
+    // frames are sent each kFrameDuration, packets of the frame arrive in order with the same network delay,
+    // the first packet of each lost_period-th frame is lost
+    void Run(size_t frames, Timepoint jitter_max, size_t lost_period = 0) {
+        for(size_t i = 0; i < frames; ++i) {
+            const auto arrival = std::max(_last_arrival, _sender_tp + kNetworkDelay + g_random.Int<Timepoint>(0, jitter_max));
+            AdvanceTo(arrival);
+            _last_arrival = arrival;
+            for(size_t j = 0; j < kPacketsPerFrame; ++j, ++_sn) {
+                if(lost_period && (i % lost_period == 1) && (j == 0)) {
+                    continue;
+                }
+                _jitter_buffer.Push(CreatePacket(_ts, _sn, j + 1 == kPacketsPerFrame));
+            }
+            _ts += kTsStep;
+            _sender_tp += kFrameDuration;
+        }
+    }
+
+    void AdvanceTo(Timepoint tp) {
+        while(auto deadline = _jitter_buffer.GetNextDeadline()) {
+            if(*deadline > tp) {
+                break;
+            }
+            _clock.Add(*deadline - _clock.Now());
+            _jitter_buffer.Process();
+        }
+        _clock.Add(tp - _clock.Now());
+        _jitter_buffer.Process();
+    }
+
+    void AssertReleasedInOrder() const {
+        for(size_t i = 1; i < _released.size(); ++i) {
+            ASSERT_EQ(_released[i - 1].ts + kTsStep, _released[i].ts);
+            ASSERT_LE(_released[i - 1].tp, _released[i].tp);
+        }
+    }
+
+protected:
+    TestClock _clock;
+    JitterBuffer _jitter_buffer;
+    std::vector<Released> _released;
+
+    Timepoint _sender_tp;
+    Timepoint _last_arrival = 0;
+    uint32_t _ts = g_random.Int<uint32_t>();
+    uint16_t _sn = g_random.Int<uint16_t>();
+};
+
+TEST_F(JitterBufferTest, Basic) {
+    Run(1, 0);
+    ASSERT_TRUE(_released.empty());
+    const auto deadline = _jitter_buffer.GetNextDeadline();
+    ASSERT_TRUE(deadline.has_value());
+    ASSERT_EQ(_clock.Now() + 10 * kMs, *deadline);
+
+    _clock.Add(10 * kMs - 1);
+    _jitter_buffer.Process();
+    ASSERT_TRUE(_released.empty());
+    _clock.Add(1);
+    _jitter_buffer.Process();
+    ASSERT_EQ(1, _released.size());
+    ASSERT_FALSE(_released[0].losses);
+    ASSERT_FALSE(_jitter_buffer.GetNextDeadline().has_value());
+}
+
+TEST_F(JitterBufferTest, NoJitter) {
+    Run(300, 0);
+    AdvanceTo(_clock.Now() + kSec);
+    ASSERT_EQ(300, _released.size());
+    ASSERT_NO_FATAL_FAILURE(AssertReleasedInOrder());
+    for(size_t i = 1; i < _released.size(); ++i) {
+        ASSERT_NEAR(kFrameDuration, _released[i].tp - _released[i - 1].tp, 1);
+    }
+    const auto& stats = _jitter_buffer.GetStats();
+    ASSERT_EQ(300, stats.frames);
+    ASSERT_EQ(0, stats.late);
+    ASSERT_EQ(10 * kMs, stats.delay);
+}
+
+TEST_F(JitterBufferTest, GrowAndShrink) {
+    // a few late frames until the lateness history is collected
+    Run(100, 60 * kMs);
+    const auto& stats = _jitter_buffer.GetStats();
+    const auto late = stats.late;
+    Run(200, 60 * kMs);
+    const auto jittery_delay = stats.delay;
+    ASSERT_LT(40 * kMs, jittery_delay);
+    ASSERT_GE(60 * kMs, jittery_delay);
+    ASSERT_GT(200 * 15 / 100, stats.late - late); // 95th percentile of lateness is the target
+
+    // smooth playout in spite of the jittery arrival
+    const auto released = _released.size();
+    size_t smooth = 0;
+    for(size_t i = released - 200; i < released; ++i) {
+        const auto interval = _released[i].tp - _released[i - 1].tp;
+        smooth += (AbsDelta(interval, kFrameDuration) <= 2 * kMs) ? 1 : 0;
+    }
+    ASSERT_LT(200 * 8 / 10, smooth);
+
+    // delay shrinks gradually once the jitter is gone from the lateness history
+    size_t frames = 0;
+    size_t shrink_steps = 0;
+    auto delay = jittery_delay;
+    while((stats.delay > 10 * kMs) && (frames < 2 * JitterBuffer::kLatenessHistorySize)) {
+        Run(1, 0);
+        frames++;
+        ASSERT_GE(delay, stats.delay);
+        ASSERT_GE(2 * kFrameDuration * 0.05 + 1, delay - stats.delay); // up to two frames are released per arrival
+        shrink_steps += (delay > stats.delay) ? 1 : 0;
+        delay = stats.delay;
+    }
+    ASSERT_EQ(10 * kMs, stats.delay);
+    ASSERT_EQ(10 * kMs, stats.target_delay);
+    ASSERT_LT(10, shrink_steps);
+
+    Run(300, 0);
+    AdvanceTo(_clock.Now() + kSec);
+    ASSERT_EQ(600 + frames, _released.size());
+    ASSERT_NO_FATAL_FAILURE(AssertReleasedInOrder());
+    for(size_t i = released + JitterBuffer::kLatenessHistorySize; i < _released.size(); ++i) {
+        ASSERT_LE(_released[i].tp - _released[i - 1].tp, kFrameDuration);
+        ASSERT_LE(kFrameDuration * 0.95 - 1, _released[i].tp - _released[i - 1].tp);
+    }
+}
+
+TEST_F(JitterBufferTest, Losses) {
+    Run(100, 0, 7);
+    AdvanceTo(_clock.Now() + kSec);
+    ASSERT_EQ(100, _released.size());
+    ASSERT_NO_FATAL_FAILURE(AssertReleasedInOrder());
+    const auto losses = std::count_if(_released.begin(), _released.end(), [](const Released& r) { return r.losses; });
+    ASSERT_EQ(15, losses);
+    ASSERT_EQ(losses, _jitter_buffer.GetStats().losses);
+}
+
+TEST_F(JitterBufferTest, LateFrameOrder) {
+    _jitter_buffer.Push(CreatePacket(_ts, _sn++, true));
+    _jitter_buffer.Push(CreatePacket(_ts + kTsStep, _sn++, true));
+    AdvanceTo(_clock.Now() + 20 * kMs);
+    ASSERT_EQ(2, _released.size());
+
+    _jitter_buffer.Push(CreatePacket(_ts + 3 * kTsStep, _sn++, true));
+    _jitter_buffer.Push(CreatePacket(_ts + kTsStep / 2, _sn++, true)); // older than the released one
+    ASSERT_EQ(2, _released.size()); // waits for the frame before it
+    AdvanceTo(_clock.Now() + kSec);
+    ASSERT_EQ(4, _released.size());
+    ASSERT_EQ(_ts + 3 * kTsStep, _released[2].ts);
+    ASSERT_EQ(_ts + kTsStep / 2, _released[3].ts);
+    ASSERT_EQ(_released[2].tp, _released[3].tp);
+    ASSERT_EQ(1, _jitter_buffer.GetStats().late);
+}
+
+}
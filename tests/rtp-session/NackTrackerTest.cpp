@@ -0,0 +1,178 @@
+#include "tau/rtp-session/NackTracker.h"
+#include "tau/rtcp/NackReader.h"
+#include "tau/rtcp/NackWriter.h"
+#include "tests/lib/Common.h"
+#include <etl/set.h>
+#include <set>
+
+namespace tau::rtp::session {
+
+class NackTrackerTest : public ::testing::Test {
+public:
+    static constexpr size_t kWindow = 1024;
+    static constexpr Timepoint kNackPeriod = 5 * kMs;
+    static constexpr Timepoint kRtt = 100 * kMs;
+
+protected:
+    struct Result {
+        Timepoint cpu_ns = 0;
+        size_t lost = 0;      // packets passed the window
+        size_t requested = 0; // lost SNs requested at least once
+        size_t nack_bytes = 0;
+    };
+
+    // 4K stream: 25 Mbps of 1200 bytes packets with random losses, NACK is written each 5ms
+    // and parsed back to count the requested SNs
+    template<typename OnLost, typename OnAdvance, typename WriteNack>
+    static Result Run(double loss_rate, OnLost&& on_lost, OnAdvance&& on_advance, WriteNack&& write_nack) {
+        constexpr size_t kPackets = 25'000'000 / 8 / 1200 * 10;
+        constexpr Timepoint kPacketPeriod = 10 * kSec / kPackets;
+        std::vector<bool> lost(kPackets, false);
+        std::vector<bool> requested(kPackets, false);
+        auto packet = Buffer::Create(g_udp_allocator);
+
+        Result result;
+        SteadyClock clock;
+        const auto begin = clock.Now();
+        Timepoint now = kSec;
+        Timepoint nack_tp = now;
+        for(size_t i = 0; i < kPackets; ++i, now += kPacketPeriod) {
+            const auto sn = static_cast<uint16_t>(i);
+            if(g_random.Real() < loss_rate) {
+                lost[i] = true;
+                on_lost(sn);
+            }
+            if(i >= kWindow) {
+                on_advance(static_cast<uint16_t>(i - kWindow));
+            }
+            if(now >= nack_tp + kNackPeriod) {
+                nack_tp = now;
+                rtcp::Writer writer(packet.GetViewWithCapacity());
+                if(write_nack(writer, now)) {
+                    result.nack_bytes += writer.GetSize();
+                    rtcp::NackReader::ForEachSn(BufferViewConst{.ptr = packet.GetView().ptr, .size = writer.GetSize()}, [&](uint16_t sn) {
+                        requested[sn] = true;
+                    });
+                }
+            }
+        }
+        result.cpu_ns = clock.Now() - begin;
+        // the losses of the last NACK period aren't requested yet
+        for(size_t i = 0; i + kWindow < kPackets; ++i) {
+            result.lost += lost[i] ? 1 : 0;
+            result.requested += (lost[i] && requested[i]) ? 1 : 0;
+        }
+        return result;
+    }
+
+    static void Log(const char* name, double loss_rate, const Result& result) {
+        TAU_LOG_INFO(name << ", loss rate: " << loss_rate << ", lost: " << result.lost << ", requested: " << result.requested
+            << ", NACK bytes: " << result.nack_bytes << ", CPU: " << result.cpu_ns / kMs << " ms");
+    }
+};
+
+TEST_F(NackTrackerTest, Basic) {
+    NackTracker tracker;
+    tracker.Reset(65530);
+    tracker.Add(65531);
+    tracker.Add(2);
+    tracker.Add(2);
+    ASSERT_EQ(2, tracker.GetLost().GetSize());
+
+    const auto& sns = tracker.GetSnsToNack(kSec, kRtt);
+    ASSERT_EQ(2, sns.GetSize());
+    ASSERT_TRUE(sns.Test(65531));
+    ASSERT_TRUE(sns.Test(2));
+    tracker.OnNacked(sns, sns.GetSize(), kSec);
+    ASSERT_TRUE(tracker.GetSnsToNack(kSec + kRtt - 1, kRtt).IsEmpty());
+
+    tracker.Remove(2);
+    tracker.Advance(0);
+    ASSERT_TRUE(tracker.GetLost().IsEmpty());
+    ASSERT_TRUE(tracker.GetSnsToNack(kSec + kRtt, kRtt).IsEmpty());
+}
+
+// SNs which weren't written to NACK (no room in the packet) are requested again at once, not after the retry interval
+TEST_F(NackTrackerTest, PartiallyNacked) {
+    NackTracker tracker;
+    tracker.Reset(100);
+    for(uint16_t sn = 100; sn < 110; sn += 2) {
+        tracker.Add(sn);
+    }
+    ASSERT_EQ(5, tracker.GetSnsToNack(kSec, kRtt).GetSize());
+    ASSERT_EQ(5, tracker.GetSnsToNack(kSec + 1, kRtt).GetSize()); // nothing written
+
+    tracker.OnNacked(tracker.GetSnsToNack(kSec + 1, kRtt), 2, kSec + 1);
+    const auto& sns = tracker.GetSnsToNack(kSec + 2, kRtt);
+    ASSERT_EQ(3, sns.GetSize());
+    ASSERT_FALSE(sns.Test(100));
+    ASSERT_FALSE(sns.Test(102));
+    ASSERT_TRUE(sns.Test(104));
+    ASSERT_EQ(5, tracker.GetSnsToNack(kSec + 1 + kRtt, kRtt).GetSize());
+}
+
+// all lost SNs are requested over several NACKs if they don't fit a packet
+TEST_F(NackTrackerTest, NackPacketOverflow) {
+    NackTracker tracker;
+    tracker.Reset(0);
+    for(uint16_t sn = 0; sn < NackTracker::kSize; sn += 2) {
+        tracker.Add(sn);
+    }
+    auto packet = Buffer::Create(g_udp_allocator);
+    std::set<uint16_t> requested;
+    size_t nacks = 0;
+    Timepoint now = kSec;
+    for(; requested.size() < tracker.GetLost().GetSize(); now += kMs, ++nacks) {
+        rtcp::Writer writer(BufferView{.ptr = packet.GetViewWithCapacity().ptr, .size = 256});
+        const auto& sns = tracker.GetSnsToNack(now, kRtt);
+        const auto written = rtcp::NackWriter::Write(writer, 0x11223344, 0x55667788, sns);
+        ASSERT_LT(0, written);
+        tracker.OnNacked(sns, written, now);
+        size_t count = 0;
+        rtcp::NackReader::ForEachSn(BufferViewConst{.ptr = packet.GetView().ptr, .size = writer.GetSize()}, [&](uint16_t sn) {
+            ASSERT_TRUE(requested.insert(sn).second); // once per retry interval
+            count++;
+        });
+        ASSERT_EQ(written, count);
+    }
+    ASSERT_LT(1, nacks);
+    ASSERT_TRUE(tracker.GetSnsToNack(now, kRtt).IsEmpty());
+}
+
+// etl::set<uint16_t, 32> tracking silently stops requesting new losses when it's full
+TEST_F(NackTrackerTest, DISABLED_MANUAL_BenchmarkHighLoss) {
+    for(auto loss_rate : {0.01, 0.05, 0.1}) {
+        rtcp::NackSns set;
+        const auto set_result = Run(loss_rate,
+            [&](uint16_t sn) {
+                if(!set.full()) {
+                    set.insert(sn);
+                }
+            },
+            [&](uint16_t sn) { set.erase(sn); },
+            [&](rtcp::Writer& writer, Timepoint) {
+                return rtcp::NackWriter::Write(writer, 0x11223344, 0x55667788, set);
+            });
+        Log("etl::set", loss_rate, set_result);
+
+        NackTracker tracker;
+        const auto tracker_result = Run(loss_rate,
+            [&](uint16_t sn) { tracker.Add(sn); },
+            [&](uint16_t sn) { tracker.Advance(SnForward(sn, 1)); },
+            [&](rtcp::Writer& writer, Timepoint now) {
+                const auto& sns = tracker.GetSnsToNack(now, kRtt);
+                const auto written = rtcp::NackWriter::Write(writer, 0x11223344, 0x55667788, sns);
+                tracker.OnNacked(sns, written, now);
+                return (written != 0);
+            });
+        Log("NackTracker", loss_rate, tracker_result);
+
+        ASSERT_EQ(tracker_result.lost, tracker_result.requested);
+        ASSERT_GT(set_result.nack_bytes, tracker_result.nack_bytes); // retries once per RTT
+        if(loss_rate >= 0.05) {
+            ASSERT_GT(set_result.lost, set_result.requested);
+        }
+    }
+}
+
+}
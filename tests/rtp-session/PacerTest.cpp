@@ -0,0 +1,226 @@
+#include "tau/rtp-session/Pacer.h"
+#include "tau/rtp-session/Session.h"
+#include "tau/rtp/Writer.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtcp/Writer.h"
+#include "tau/rtcp/NackWriter.h"
+#include "tests/lib/Common.h"
+
+namespace tau::rtp::session {
+
+class PacerTest : public ::testing::Test {
+public:
+    static constexpr uint32_t kBitrate = 1'000'000;
+    static constexpr size_t kPacketSize = 1000;
+    static constexpr Timepoint kPacketDuration = 8 * kPacketSize * kSec / kBitrate;
+
+protected:
+    struct Sent {
+        Timepoint tp;
+        size_t sink;
+        uint16_t sn;
+    };
+
+    Pacer::SinkId AddSink(Pacer& pacer) {
+        const auto idx = _sinks_count++;
+        return pacer.AddSink([this, idx](Buffer&& packet) {
+            _sent.push_back(Sent{.tp = _clock.Now(), .sink = idx, .sn = Reader(ToConst(packet.GetView())).Sn()});
+        });
+    }
+
+    // processes the pacer at its deadlines till the queue is empty
+    void Drain(Pacer& pacer) {
+        while(auto deadline = pacer.GetNextDeadline()) {
+            if(*deadline > _clock.Now()) {
+                _clock.Add(*deadline - _clock.Now());
+            }
+            pacer.Process();
+        }
+    }
+
+    static Buffer CreateRtpPacket(uint16_t sn, uint32_t ssrc = 0x11223344, size_t size = kPacketSize) {
+        auto packet = Buffer::Create(g_udp_allocator, Buffer::Info{});
+        Writer::Write(packet.GetViewWithCapacity(), Writer::Options{
+            .pt = 96,
+            .ssrc = ssrc,
+            .ts = 0,
+            .sn = sn,
+            .marker = false
+        });
+        packet.SetSize(size);
+        return packet;
+    }
+
+protected:
+    TestClock _clock;
+    size_t _sinks_count = 0;
+    std::vector<Sent> _sent;
+};
+
+TEST_F(PacerTest, Basic) {
+    constexpr size_t kPackets = 100;
+    constexpr size_t kBurstPackets = 2;
+    Pacer pacer(Pacer::Dependencies{.clock = _clock}, Pacer::Options{.bitrate = kBitrate, .burst = kBurstPackets * kPacketSize});
+    const auto sink = AddSink(pacer);
+    ASSERT_FALSE(pacer.GetNextDeadline().has_value());
+
+    const auto begin = _clock.Now();
+    for(size_t i = 0; i < kPackets; ++i) {
+        pacer.Push(sink, CreateRtpPacket(i), Pacer::kVideo);
+    }
+    ASSERT_TRUE(_sent.empty());
+    ASSERT_EQ(kPackets, pacer.GetQueueSize());
+    ASSERT_EQ(kPackets * kPacketSize, pacer.GetQueueBytes());
+
+    Drain(pacer);
+    ASSERT_EQ(kPackets, _sent.size());
+    ASSERT_EQ(0, pacer.GetQueueSize());
+    ASSERT_EQ(0, pacer.GetQueueBytes());
+    for(size_t i = 0; i < kPackets; ++i) {
+        ASSERT_EQ(i, _sent[i].sn);
+        if(i < kBurstPackets) {
+            ASSERT_EQ(begin, _sent[i].tp);
+        } else {
+            ASSERT_EQ(kPacketDuration, _sent[i].tp - _sent[i - 1].tp);
+        }
+    }
+
+    const auto expected_duration = (kPackets - kBurstPackets) * kPacketDuration;
+    ASSERT_EQ(expected_duration, _sent.back().tp - begin);
+    const auto& stats = pacer.GetStats();
+    ASSERT_EQ(kPackets, stats.packets);
+    ASSERT_EQ(kPackets * kPacketSize, stats.bytes);
+    ASSERT_EQ(0, stats.dropped);
+    ASSERT_EQ(expected_duration, stats.queue_delay);
+    ASSERT_EQ(stats.queue_delay, stats.max_queue_delay);
+
+    // idle period refills the budget up to burst only
+    _clock.Add(kSec);
+    for(size_t i = 0; i < 2 * kBurstPackets; ++i) {
+        pacer.Push(sink, CreateRtpPacket(kPackets + i), Pacer::kVideo);
+    }
+    const auto idle_end = _clock.Now();
+    pacer.Process();
+    ASSERT_EQ(kPackets + kBurstPackets, _sent.size());
+    ASSERT_EQ(kBurstPackets, pacer.GetQueueSize());
+    Drain(pacer);
+    ASSERT_EQ(kBurstPackets * kPacketDuration, _sent.back().tp - idle_end);
+}
+
+TEST_F(PacerTest, Priority) {
+    Pacer pacer(Pacer::Dependencies{.clock = _clock}, Pacer::Options{.bitrate = kBitrate, .burst = kPacketSize});
+    const auto audio_sink = AddSink(pacer);
+    const auto video_sink = AddSink(pacer);
+
+    // empty the bucket
+    pacer.Push(video_sink, CreateRtpPacket(0), Pacer::kVideo);
+    pacer.Process();
+    ASSERT_EQ(1, _sent.size());
+
+    pacer.Push(video_sink, CreateRtpPacket(1), Pacer::kVideo);
+    pacer.Push(video_sink, CreateRtpPacket(2), Pacer::kVideo);
+    pacer.Push(video_sink, CreateRtpPacket(100), Pacer::kRtx);
+    pacer.Push(audio_sink, CreateRtpPacket(200, 0x55667788, 100), Pacer::kAudio);
+    pacer.Push(video_sink, CreateRtpPacket(101), Pacer::kRtx);
+    pacer.Push(audio_sink, CreateRtpPacket(201, 0x55667788, 100), Pacer::kAudio);
+    Drain(pacer);
+
+    const std::vector<std::pair<size_t, uint16_t>> expected = {
+        {video_sink, 0}, {audio_sink, 200}, {audio_sink, 201}, {video_sink, 100}, {video_sink, 101}, {video_sink, 1}, {video_sink, 2}
+    };
+    ASSERT_EQ(expected.size(), _sent.size());
+    for(size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].first, _sent[i].sink);
+        ASSERT_EQ(expected[i].second, _sent[i].sn);
+    }
+}
+
+TEST_F(PacerTest, Overflow) {
+    constexpr size_t kMaxQueueSize = 10;
+    Pacer pacer(Pacer::Dependencies{.clock = _clock}, Pacer::Options{.bitrate = kBitrate, .max_queue_size = kMaxQueueSize});
+    const auto sink = AddSink(pacer);
+
+    pacer.Push(sink, CreateRtpPacket(0), Pacer::kAudio);
+    for(size_t i = 1; i < kMaxQueueSize + 3; ++i) {
+        pacer.Push(sink, CreateRtpPacket(i), Pacer::kVideo);
+    }
+    ASSERT_EQ(kMaxQueueSize, pacer.GetQueueSize());
+    ASSERT_EQ(3, pacer.GetStats().dropped);
+
+    Drain(pacer);
+    ASSERT_EQ(kMaxQueueSize, _sent.size());
+    ASSERT_EQ(0, _sent[0].sn);
+    for(size_t i = 1; i < kMaxQueueSize; ++i) {
+        ASSERT_EQ(i + 3, _sent[i].sn); // the oldest video packets are dropped
+    }
+}
+
+TEST_F(PacerTest, HighBitrate) {
+    constexpr uint32_t kHighBitrate = 12'000'000;
+    constexpr Timepoint kProcessPeriod = 10 * kMs;
+    constexpr size_t kPackets = 1500;
+    Pacer pacer(Pacer::Dependencies{.clock = _clock}, Pacer::Options{.bitrate = kHighBitrate, .process_period = kProcessPeriod});
+    const auto sink = AddSink(pacer);
+
+    for(size_t i = 0; i < kPackets; ++i) {
+        pacer.Push(sink, CreateRtpPacket(i), Pacer::kVideo);
+    }
+    const auto begin = _clock.Now();
+    pacer.Process();
+    while(pacer.GetQueueSize() > 0) {
+        _clock.Add(kProcessPeriod);
+        pacer.Process();
+    }
+    ASSERT_EQ(kPackets, _sent.size());
+
+    // bucket depth isn't limited by burst, the owner's tick doesn't cap the throughput
+    const auto duration = _sent.back().tp - begin;
+    const auto bitrate = 8 * kPackets * kPacketSize * kSec / duration;
+    ASSERT_GE(bitrate, kHighBitrate);
+    ASSERT_LE(bitrate, kHighBitrate * 102 / 100);
+}
+
+TEST_F(PacerTest, Session) {
+    constexpr size_t kKeyframePackets = 100;
+    const auto sender_ssrc = g_random.Int<uint32_t>();
+    Pacer pacer(Pacer::Dependencies{.clock = _clock}, Pacer::Options{.bitrate = kBitrate, .burst = kPacketSize, .process_period = kPacketDuration});
+    Session session(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = _clock, .system_clock = _clock, .pacer = &pacer},
+        Session::Options{.rate = 90'000, .sender_ssrc = sender_ssrc, .base_ts = 0, .rtx = true});
+
+    std::vector<Sent> sent;
+    session.SetSendRtpCallback([&](Buffer&& packet) {
+        sent.push_back(Sent{.tp = _clock.Now(), .sink = 0, .sn = Reader(ToConst(packet.GetView())).Sn()});
+    });
+    session.SetSendRtcpCallback([](Buffer&&) {});
+
+    const auto begin = _clock.Now();
+    for(size_t i = 0; i < kKeyframePackets; ++i) {
+        session.SendRtp(CreateRtpPacket(i, sender_ssrc));
+    }
+    ASSERT_TRUE(sent.empty());
+    pacer.Process();
+    ASSERT_EQ(1, sent.size());
+
+    // NACK of the first packets, retransmissions go before the queued media
+    auto nack = Buffer::Create(g_udp_allocator, Buffer::Info{});
+    rtcp::Writer writer(nack.GetViewWithCapacity());
+    ASSERT_TRUE(rtcp::NackWriter::Write(writer, 0x55667788, sender_ssrc, rtcp::NackSns{0, 1}));
+    nack.SetSize(writer.GetSize());
+    session.RecvRtcp(std::move(nack));
+
+    Drain(pacer);
+    ASSERT_EQ(kKeyframePackets + 2, sent.size());
+    ASSERT_EQ(0, sent[0].sn);
+    ASSERT_EQ(0, sent[1].sn);
+    ASSERT_EQ(1, sent[2].sn);
+    ASSERT_EQ(1, sent[3].sn);
+    ASSERT_EQ(kKeyframePackets - 1, sent.back().sn);
+    ASSERT_EQ((kKeyframePackets + 1) * kPacketDuration, sent.back().tp - begin);
+
+    session.Process();
+    ASSERT_EQ(pacer.GetStats().queue_delay, session.GetStats().outgoing.pacer_queue_delay);
+    ASSERT_LT(0, session.GetStats().outgoing.pacer_queue_delay);
+}
+
+}
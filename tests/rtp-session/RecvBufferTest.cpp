@@ -59,9 +59,9 @@ protected:
 
     void AssertSnToRecover(const SnsIVector& sns) {
         const auto& sns_to_recover = _recv_buffer.GetSnsToRecover();
-        ASSERT_EQ(sns.size(), sns_to_recover.size());
+        ASSERT_EQ(sns.size(), sns_to_recover.GetSize());
         for(auto sn : sns) {
-            ASSERT_TRUE(Contains(sns_to_recover, sn));
+            ASSERT_TRUE(sns_to_recover.Test(sn));
         }
     }
 
@@ -86,6 +86,83 @@ TEST_F(RecvBufferTest, LostPackets) {
     ASSERT_NO_FATAL_FAILURE(AssertStats(6, 0, 2));
 }
 
+TEST_F(RecvBufferTest, ManyLostPackets) {
+    SnsVector sns, lost;
+    for(uint16_t i = 0; i < 200 - 1; ++i) {
+        const uint16_t sn = 65500 + i;
+        if(i % 3 == 1) {
+            lost.push_back(sn);
+        } else {
+            sns.push_back(sn);
+        }
+    }
+    ASSERT_NO_FATAL_FAILURE(PushPackets(sns));
+    ASSERT_NO_FATAL_FAILURE(AssertSnToRecover(lost));
+
+    // all lost SNs are requested at once, then again after the retry interval
+    constexpr Timepoint kRetryInterval = 100 * kMs;
+    auto nack = [this](Timepoint now) {
+        const auto& nack_sns = _recv_buffer.GetSnsToNack(now, kRetryInterval);
+        _recv_buffer.OnNacked(nack_sns, nack_sns.GetSize(), now);
+        return nack_sns.GetSize();
+    };
+    Timepoint now = 1000 * kMs;
+    ASSERT_EQ(lost.size(), nack(now));
+    now += kRetryInterval - 1;
+    ASSERT_EQ(0, nack(now));
+    now += 1;
+    ASSERT_EQ(lost.size(), nack(now));
+
+    // till recovery or max retries
+    ASSERT_NO_FATAL_FAILURE(PushPackets(ToVector({lost[0], lost[1]})));
+    for(size_t i = 2; i < NackTracker::kMaxRetries; ++i) {
+        now += kRetryInterval;
+        ASSERT_EQ(lost.size() - 2, nack(now));
+    }
+    now += kRetryInterval;
+    ASSERT_EQ(0, nack(now));
+    ASSERT_EQ(lost.size() - 2, _recv_buffer.GetSnsToRecover().GetSize());
+}
+
+TEST_F(RecvBufferTest, Resize) {
+    ASSERT_NO_FATAL_FAILURE(PushPackets(ToVector({1, 3, 4, 6, 7, 9})));
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToVector({1})));
+    const auto memory = _recv_buffer.GetMemoryUsage();
+
+    // held packets are kept on growth
+    _recv_buffer.SetSize(1000);
+    ASSERT_LT(memory, _recv_buffer.GetMemoryUsage());
+    ASSERT_NO_FATAL_FAILURE(PushPackets(ToVector({500})));
+    ASSERT_EQ(500 - 10 + 3, _recv_buffer.GetSnsToRecover().GetSize());
+    ASSERT_NO_FATAL_FAILURE(PushPackets(ToVector({2})));
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToVector({1, 2, 3, 4})));
+
+    // the oldest gaps are skipped on shrink
+    _recv_buffer.SetSize(4);
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToVector({1, 2, 3, 4, 6, 7, 9})));
+    ASSERT_NO_FATAL_FAILURE(AssertSnToRecover(ToVector({497, 498, 499})));
+    ASSERT_GT(memory, _recv_buffer.GetMemoryUsage());
+    ASSERT_NO_FATAL_FAILURE(PushPackets(ToVector({502, 503})));
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToVector({1, 2, 3, 4, 6, 7, 9, 500})));
+    ASSERT_NO_FATAL_FAILURE(AssertSnToRecover(ToVector({501})));
+}
+
+TEST_F(RecvBufferTest, MaxBytes) {
+    RecvBuffer recv_buffer(RecvBuffer::kMaxSize, 3 * 1200);
+    std::vector<uint16_t> sns;
+    recv_buffer.SetCallback([&](Buffer&& packet) { sns.push_back(Reader(ToConst(packet.GetView())).Sn()); });
+    for(uint16_t sn : {1, 3, 4, 5}) {
+        recv_buffer.Push(CreatePacket(sn), sn);
+    }
+    ASSERT_EQ((std::vector<uint16_t>{1}), sns);
+    ASSERT_EQ(3 * 1200, recv_buffer.GetMemoryUsage() - RecvBuffer(RecvBuffer::kMaxSize).GetMemoryUsage());
+
+    // 4 held packets are over the budget, the gap is skipped
+    recv_buffer.Push(CreatePacket(6), 6);
+    ASSERT_EQ((std::vector<uint16_t>{1, 3, 4, 5, 6}), sns);
+    ASSERT_EQ(1, recv_buffer.GetStats().lost);
+}
+
 TEST_F(RecvBufferTest, FillBufferOnLostPackets) {
     uint16_t sn = 1;
     SnsVector sns = {sn};
@@ -14,7 +14,8 @@ protected:
 protected:
     SendBufferTest()
         : _send_buffer(kSmallCapacity) {
-        _send_buffer.SetCallback([this](Buffer&& packet) {
+        _send_buffer.SetCallback([this](Buffer&& packet, bool rtx) {
+            _processed_rtx.push_back(rtx);
             // Reader reader(ToConst(packet.GetView()));
             // LOG_INFO << "processed sn: " << reader.Sn();
             _processed_packets.push_back(std::move(packet));
@@ -48,6 +49,7 @@ protected:
             const auto& packet = _processed_packets[i];
             Reader reader(packet.GetView());
             ASSERT_EQ(sns[i], reader.Sn());
+            ASSERT_FALSE(_processed_rtx[i]);
         }
     }
 
@@ -56,6 +58,7 @@ protected:
             const auto processed_packets = _processed_packets.size();
             ASSERT_TRUE(_send_buffer.SendRtx(sn));
             ASSERT_EQ(processed_packets + 1, _processed_packets.size());
+            ASSERT_TRUE(_processed_rtx.back());
 
             const auto& packet = _processed_packets.back();
             Reader reader(packet.GetView());
@@ -81,6 +84,7 @@ protected:
 protected:
     SendBuffer _send_buffer;
     std::vector<Buffer> _processed_packets;
+    std::vector<bool> _processed_rtx;
 };
 
 TEST_F(SendBufferTest, Basic) {
@@ -95,4 +99,84 @@ TEST_F(SendBufferTest, Basic) {
     ASSERT_NO_FATAL_FAILURE(AssertStats(24, 14));
 }
 
+TEST_F(SendBufferTest, RtxMinInterval) {
+    constexpr Timepoint kRtt = 50 * kMs;
+    const Timepoint now = 1000 * kSec;
+    PushPackets(5);
+    ASSERT_TRUE(_send_buffer.SendRtx(3, now, kRtt));
+    ASSERT_TRUE(_send_buffer.SendRtx(4, now, kRtt));
+    ASSERT_FALSE(_send_buffer.SendRtx(3, now + kRtt - 1, kRtt)); // repeated NACK within RTT
+    ASSERT_TRUE(_send_buffer.SendRtx(3, now + kRtt, kRtt));
+    ASSERT_EQ(1, _send_buffer.GetStats().rtx_suppressed);
+    ASSERT_NO_FATAL_FAILURE(AssertStats(8, 3));
+
+    // the slot is reused by a new packet
+    PushPackets(kSmallCapacity, 6);
+    ASSERT_TRUE(_send_buffer.SendRtx(10, now + kRtt, kRtt));
+    ASSERT_FALSE(_send_buffer.SendRtx(10, now + kRtt, kRtt));
+    ASSERT_EQ(2, _send_buffer.GetStats().rtx_suppressed);
+}
+
+TEST_F(SendBufferTest, ScatterGather) {
+    auto payload = Buffer::CreateShared(g_system_allocator, 4 * 1188);
+    payload.SetSize(4 * 1188);
+    for(size_t i = 0; i < payload.GetSize(); ++i) {
+        payload.GetView().ptr[i] = static_cast<uint8_t>(i);
+    }
+
+    for(uint16_t sn = 1; sn <= 4; ++sn) {
+        auto header = CreatePacket(sn);
+        header.SetSize(kFixedHeaderSize);
+        _send_buffer.Push(SgBuffer(std::move(header), payload.Slice((sn - 1) * 1188, 1188)), sn);
+    }
+    ASSERT_EQ(5, payload.GetRefCount());
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(ToVector({1, 2, 3, 4})));
+    ASSERT_NO_FATAL_FAILURE(AssertSendRtxSuccessful(ToVector({3})));
+    ASSERT_NO_FATAL_FAILURE(AssertStats(5, 1));
+
+    const auto& rtx_packet = _processed_packets.back();
+    ASSERT_EQ(1200, rtx_packet.GetSize());
+    ASSERT_EQ(0, std::memcmp(rtx_packet.GetView().ptr + kFixedHeaderSize, payload.GetView().ptr + 2 * 1188, 1188));
+}
+
+TEST_F(SendBufferTest, Resize) {
+    PushPackets(10);
+    ASSERT_EQ(kSmallCapacity, _send_buffer.GetCount());
+    const auto small_memory = _send_buffer.GetMemoryUsage();
+
+    // history is kept on growth
+    _send_buffer.SetSize(16);
+    ASSERT_NO_FATAL_FAILURE(AssertSendRtxSuccessful(ToVector({4, 10})));
+    PushPackets(9, 11);
+    ASSERT_EQ(16, _send_buffer.GetCount());
+    ASSERT_NO_FATAL_FAILURE(AssertSendRtxSuccessful(ToVector({4, 19})));
+    ASSERT_NO_FATAL_FAILURE(AssertSendRtxFailed(ToVector({3, 20})));
+    ASSERT_LT(small_memory, _send_buffer.GetMemoryUsage());
+
+    // the oldest packets are dropped on shrink
+    _send_buffer.SetSize(5);
+    ASSERT_EQ(5, _send_buffer.GetCount());
+    ASSERT_NO_FATAL_FAILURE(AssertSendRtxSuccessful(ToVector({15, 19})));
+    ASSERT_NO_FATAL_FAILURE(AssertSendRtxFailed(ToVector({14})));
+    ASSERT_GT(small_memory, _send_buffer.GetMemoryUsage());
+    PushPackets(1, 20);
+    ASSERT_NO_FATAL_FAILURE(AssertSendRtxSuccessful(ToVector({16, 20})));
+    ASSERT_NO_FATAL_FAILURE(AssertSendRtxFailed(ToVector({15})));
+
+    _send_buffer.SetSize(100'000);
+    ASSERT_EQ(SendBuffer::kMaxSize, _send_buffer.GetSize());
+}
+
+TEST_F(SendBufferTest, MaxBytes) {
+    SendBuffer send_buffer(SendBuffer::kMaxSize, 3 * 1200);
+    send_buffer.SetCallback([](Buffer&&, bool) {});
+    for(uint16_t sn = 1; sn <= 10; ++sn) {
+        send_buffer.Push(CreatePacket(sn), sn);
+    }
+    ASSERT_EQ(3, send_buffer.GetCount());
+    ASSERT_FALSE(send_buffer.SendRtx(7));
+    ASSERT_TRUE(send_buffer.SendRtx(8));
+    ASSERT_TRUE(send_buffer.SendRtx(10));
+}
+
 }
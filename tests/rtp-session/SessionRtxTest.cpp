@@ -1,6 +1,8 @@
 #include "SessionBaseTest.h"
 #include "tau/rtcp/NackReader.h"
 #include "tau/rtcp/NackWriter.h"
+#include "tau/rtp/Reader.h"
+#include "tau/common/Math.h"
 
 namespace tau::rtp::session {
 
@@ -94,12 +96,177 @@ TEST_F(SessionRtxTest, Recv_SendNackOnLosses) {
     ASSERT_EQ(kTestFrames - 1, _output_rtcp.size());
     ASSERT_EQ(0, _events.size());
 
+    // new losses are requested at once, the others are repeated after RTT
+    constexpr size_t kRetryFrames = DivCeil<size_t>(Session::kDefaultRtt, 33 * kMs);
+    std::vector<size_t> last_request_frame;
     for(size_t i = 0; i < kTestFrames - 1; ++i) {
         const auto view = _output_rtcp[i].GetView();
         const auto send_packets = (i + 1) * kPacketPerFrame;
-        const auto sns_count = std::min<size_t>(32, (send_packets + 1) / kPacketLostPeriod);
-        ASSERT_NO_FATAL_FAILURE(AssertRtcpNack(ToConst(view), CreateNackSns(sns_count, kPacketLostPeriod)));
+        const auto sns_count = (send_packets + 1) / kPacketLostPeriod;
+        rtcp::NackSns sns;
+        uint16_t sn = _source_options.sn + (kPacketLostPeriod - 1);
+        for(size_t j = 0; j < sns_count; ++j, sn += kPacketLostPeriod) {
+            if(j == last_request_frame.size()) {
+                last_request_frame.push_back(i);
+                sns.insert(sn);
+            } else if(i - last_request_frame[j] >= kRetryFrames) {
+                last_request_frame[j] = i;
+                sns.insert(sn);
+            }
+        }
+        ASSERT_NO_FATAL_FAILURE(AssertRtcpNack(ToConst(view), sns));
+    }
+}
+
+TEST_F(SessionRtxTest, Rfc4588_Loopback) {
+    constexpr uint8_t kPt = 96;
+    constexpr uint8_t kRtxPt = 97;
+    constexpr uint16_t kRtxBaseSn = 1000;
+    constexpr size_t kPacketLostPeriod = 7;
+    const auto rtx_ssrc = g_random.Int<uint32_t>();
+
+    Session sender(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = _media_clock, .system_clock = _media_clock},
+        Session::Options{.rate = 90'000, .sender_ssrc = _sender_ssrc, .base_ts = 0, .rtx = true,
+            .rtx_stream = Session::RtxStream{.pt = kRtxPt, .ssrc = rtx_ssrc, .sn = kRtxBaseSn}});
+    Session receiver(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = _media_clock, .system_clock = _media_clock},
+        Session::Options{.rate = 90'000, .sender_ssrc = _receiver_ssrc, .base_ts = 0, .rtx = true,
+            .rtx_stream = Session::RtxStream{.pt = kRtxPt, .ssrc = g_random.Int<uint32_t>()}});
+
+    size_t sent = 0;
+    size_t dropped = 0;
+    std::vector<uint16_t> rtx_sns;
+    sender.SetSendRtpCallback([&](Buffer&& packet) {
+        rtp::Reader reader(ToConst(packet.GetView()));
+        if(reader.Pt() == kRtxPt) {
+            EXPECT_EQ(rtx_ssrc, reader.Ssrc());
+            rtx_sns.push_back(reader.Sn());
+        } else {
+            EXPECT_EQ(_sender_ssrc, reader.Ssrc());
+            if(++sent % kPacketLostPeriod == 0) {
+                dropped++;
+                return;
+            }
+        }
+        receiver.RecvRtp(std::move(packet));
+    });
+    sender.SetSendRtcpCallback([&](Buffer&& packet) { receiver.RecvRtcp(std::move(packet)); });
+    std::vector<Buffer> received;
+    receiver.SetRecvRtpCallback([&](Buffer&& packet) { received.push_back(std::move(packet)); });
+    receiver.SetSendRtcpCallback([&](Buffer&& packet) { sender.RecvRtcp(std::move(packet)); });
+
+    uint16_t sn = _source_options.sn;
+    for(size_t i = 0; i < kTestFrames; ++i) {
+        for(size_t j = 0; j < kPacketPerFrame; ++j) {
+            auto packet = Buffer::Create(g_udp_allocator, Buffer::Info{.tp = _media_clock.Now()});
+            const auto result = Writer::Write(packet.GetViewWithCapacity(), Writer::Options{
+                .pt = kPt,
+                .ssrc = _sender_ssrc,
+                .ts = static_cast<uint32_t>(i * 3000),
+                .sn = sn,
+                .marker = (j + 1 == kPacketPerFrame)
+            });
+            Write16(result.payload.ptr, sn++);
+            packet.SetSize(result.size + 1000);
+            sender.SendRtp(std::move(packet));
+        }
+        _media_clock.Add(33 * kMs);
+        receiver.Process();
+    }
+    for(size_t i = 0; i < 3; ++i) {
+        _media_clock.Add(33 * kMs);
+        receiver.Process();
+    }
+
+    ASSERT_LT(0, dropped);
+    ASSERT_EQ(kTestFrames * kPacketPerFrame, received.size());
+    for(size_t i = 0; i < received.size(); ++i) {
+        rtp::Reader reader(ToConst(received[i].GetView()));
+        ASSERT_EQ(kPt, reader.Pt());
+        ASSERT_EQ(_sender_ssrc, reader.Ssrc());
+        ASSERT_EQ(static_cast<uint16_t>(_source_options.sn + i), reader.Sn());
+        ASSERT_EQ(1000, reader.Payload().size);
+        ASSERT_EQ(reader.Sn(), Read16(reader.Payload().ptr));
+    }
+
+    // every lost packet is resent once: repeated NACKs within RTT are suppressed
+    ASSERT_EQ(dropped, rtx_sns.size());
+    for(size_t i = 0; i < rtx_sns.size(); ++i) {
+        ASSERT_EQ(static_cast<uint16_t>(kRtxBaseSn + i), rtx_sns[i]);
+    }
+    const auto& stats = receiver.GetStats();
+    ASSERT_EQ(sent - dropped, stats.incoming.rtp);
+    ASSERT_EQ(dropped, stats.incoming.rtx);
+    ASSERT_EQ(0, stats.incoming.discarded);
+}
+
+TEST_F(SessionRtxTest, BuffersFollowBitrate) {
+    Session sender(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = _media_clock, .system_clock = _media_clock},
+        Session::Options{.rate = 90'000, .sender_ssrc = _sender_ssrc, .base_ts = 0, .rtx = true});
+    sender.SetSendRtpCallback([](Buffer&&) {});
+    sender.SetSendRtcpCallback([](Buffer&&) {});
+
+    uint16_t sn = 0;
+    auto send_frames = [&](size_t frames, size_t packets_per_frame) {
+        for(size_t i = 0; i < frames; ++i) {
+            for(size_t j = 0; j < packets_per_frame; ++j) {
+                auto packet = Buffer::Create(g_udp_allocator, Buffer::Info{.tp = _media_clock.Now()});
+                const auto result = Writer::Write(packet.GetViewWithCapacity(), Writer::Options{
+                    .pt = 96, .ssrc = _sender_ssrc, .ts = static_cast<uint32_t>(i * 3000), .sn = sn++, .marker = false
+                });
+                packet.SetSize(result.size + 1000);
+                sender.SendRtp(std::move(packet));
+            }
+            _media_clock.Add(33'333'333);
+        }
+    };
+
+    const auto& stats = sender.GetStats();
+    ASSERT_EQ(SendBuffer::kDefaultSize, stats.outgoing.buffer_size);
+    const auto initial_memory = stats.memory;
+
+    // 1800 packets/sec, history of 4 RTTs (100 ms by default)
+    send_frames(70, 60);
+    ASSERT_NEAR(1800 * 4 * Session::kDefaultRtt / kSec, stats.outgoing.buffer_size, 20);
+    ASSERT_LT(initial_memory + stats.outgoing.buffer_size * 1000, stats.memory);
+
+    // back to the minimal window on low bitrate
+    send_frames(70, 5);
+    ASSERT_EQ(SendBuffer::kDefaultSize, stats.outgoing.buffer_size);
+    ASSERT_GT(initial_memory + SendBuffer::kDefaultSize * 1100, stats.memory);
+}
+
+TEST_F(SessionRtxTest, BuffersIgnoreRetransmissions) {
+    Session sender(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = _media_clock, .system_clock = _media_clock},
+        Session::Options{.rate = 90'000, .sender_ssrc = _sender_ssrc, .base_ts = 0, .rtx = true});
+    size_t sent = 0;
+    sender.SetSendRtpCallback([&](Buffer&&) { sent++; });
+    sender.SetSendRtcpCallback([](Buffer&&) {});
+
+    // 600 packets/sec, each one is retransmitted
+    constexpr size_t kPacketsPerFrame = 20;
+    uint16_t sn = 0;
+    for(size_t i = 0; i < 70; ++i) {
+        rtcp::NackSns sns;
+        for(size_t j = 0; j < kPacketsPerFrame; ++j) {
+            auto packet = Buffer::Create(g_udp_allocator, Buffer::Info{.tp = _media_clock.Now()});
+            const auto result = Writer::Write(packet.GetViewWithCapacity(), Writer::Options{
+                .pt = 96, .ssrc = _sender_ssrc, .ts = static_cast<uint32_t>(i * 3000), .sn = sn, .marker = false
+            });
+            packet.SetSize(result.size + 1000);
+            sender.SendRtp(std::move(packet));
+            sns.insert(sn++);
+        }
+        sender.RecvRtcp(CreateNackRequest(sns));
+        _media_clock.Add(33'333'333);
     }
+
+    const auto& stats = sender.GetStats();
+    ASSERT_EQ(2 * 70 * kPacketsPerFrame, sent);
+    ASSERT_EQ(SendBuffer::kDefaultSize, stats.outgoing.buffer_size);
 }
 
 }
@@ -48,6 +48,25 @@ TEST_F(SessionSendTest, Basic) {
     ASSERT_EQ(Session::kDefaultRtt, stats.rtt);
 }
 
+TEST_F(SessionSendTest, RtcpDeadline) {
+    ASSERT_FALSE(_session->GetNextDeadline().has_value()); // no RTP yet
+
+    _source->PushFrame(_media_clock.Now(), kPacketPerFrame);
+    _media_clock.Add(1 * kSec);
+    _source->PushFrame(_media_clock.Now(), kPacketPerFrame);
+    ASSERT_EQ(1, _output_rtcp.size());
+    ASSERT_EQ(_media_clock.Now() + 1 * kSec, _session->GetNextDeadline());
+
+    // RTP is paused, reports are sent by Process at the deadline
+    for(size_t i = 0; i < 3; ++i) {
+        _media_clock.Add(*_session->GetNextDeadline() - _media_clock.Now());
+        _session->Process();
+        ASSERT_EQ(2 + i, _output_rtcp.size());
+        ASSERT_EQ(_media_clock.Now() + 1 * kSec, _session->GetNextDeadline());
+    }
+    ASSERT_EQ(2 * kPacketPerFrame, _output_rtp.size());
+}
+
 TEST_F(SessionSendTest, IncomingRrReport) {
     _source->PushFrame(_media_clock.Now(), kPacketPerFrame);
     _media_clock.Add(1 * kSec);
@@ -0,0 +1,191 @@
+#include "tau/rtp-session/SimulcastForwarder.h"
+#include "tau/rtp/Reader.h"
+#include "tests/lib/Common.h"
+#include "tests/lib/RtpUtils.h"
+
+namespace tau::rtp::session {
+
+class SimulcastForwarderTest : public ::testing::Test {
+public:
+    static constexpr uint32_t kSsrc = 0x55667788;
+    static constexpr uint32_t kTsStep = 90'000 / 30;
+    static constexpr Timepoint kFrameDuration = 33 * kMs;
+    static constexpr size_t kLayers = 3;
+    static constexpr size_t kKeyFramePeriod = 30;
+
+    SimulcastForwarderTest()
+        : _forwarder(SimulcastForwarder::Dependencies{.clock = _clock}, SimulcastForwarder::Options{.ssrc = kSsrc, .sn = 1000, .ts = 5000})
+    {
+        _forwarder.SetCallback([this](Buffer&& packet) {
+            Reader reader(ToConst(packet.GetView()));
+            ASSERT_EQ(kSsrc, reader.Ssrc());
+            _output.push_back(Output{.sn = reader.Sn(), .ts = reader.Ts()});
+        });
+        _forwarder.SetKeyFrameRequestCallback([this](size_t layer) {
+            _key_frame_requests.push_back(layer);
+        });
+        for(auto& layer : _layers) {
+            layer.sn = g_random.Int<uint16_t>();
+            layer.ts = g_random.Int<uint32_t>();
+        }
+    }
+
+protected:
+    struct Output {
+        uint16_t sn;
+        uint32_t ts;
+    };
+
+    struct InputLayer {
+        uint16_t sn;
+        uint32_t ts;
+    };
+
+    // layer i sends 2^i packets per frame, each kKeyFramePeriod-th frame is a key-frame (at different frames for the layers)
+    void Run(size_t frames) {
+        for(size_t i = 0; i < frames; ++i, ++_frame) {
+            for(size_t l = 0; l < kLayers; ++l) {
+                auto& layer = _layers[l];
+                const size_t packets = size_t{1} << l;
+                const bool key_frame = ((_frame + l * 7) % kKeyFramePeriod == 0);
+                for(size_t j = 0; j < packets; ++j, ++layer.sn) {
+                    _forwarder.Push(l, CreatePacket(layer.ts, layer.sn, j + 1 == packets), key_frame && (j == 0));
+                }
+                layer.ts += kTsStep;
+            }
+            _clock.Add(kFrameDuration);
+        }
+    }
+
+    void AssertContinuous() const {
+        for(size_t i = 1; i < _output.size(); ++i) {
+            ASSERT_EQ(static_cast<uint16_t>(_output[i - 1].sn + 1), _output[i].sn);
+            ASSERT_GE(2 * kTsStep, _output[i].ts - _output[i - 1].ts); // TS gap on switch is the elapsed time
+        }
+    }
+
+protected:
+    TestClock _clock;
+    SimulcastForwarder _forwarder;
+    std::array<InputLayer, kLayers> _layers;
+    size_t _frame = 0;
+    std::vector<Output> _output;
+    std::vector<size_t> _key_frame_requests;
+};
+
+TEST_F(SimulcastForwarderTest, Basic) {
+    Run(10);
+    ASSERT_TRUE(_output.empty()); // no target layer
+
+    _forwarder.SetTargetLayer(1);
+    ASSERT_EQ(1, _key_frame_requests.size());
+    ASSERT_EQ(1, _key_frame_requests[0]);
+    ASSERT_FALSE(_forwarder.GetLayer().has_value());
+
+    Run(kKeyFramePeriod);
+    ASSERT_EQ(1, _forwarder.GetLayer());
+    ASSERT_FALSE(_output.empty());
+    ASSERT_EQ(1000, _output.front().sn);
+    ASSERT_EQ(5000, _output.front().ts);
+    ASSERT_NO_FATAL_FAILURE(AssertContinuous());
+    ASSERT_EQ(1, _key_frame_requests.size()); // the key-frame came within kKeyFrameRequestPeriod
+}
+
+TEST_F(SimulcastForwarderTest, KeyFrameRequestRepeated) {
+    Run(17); // just after the layer 2 key-frame
+    _forwarder.SetTargetLayer(2);
+    Run(kKeyFramePeriod - 2);
+    ASSERT_FALSE(_forwarder.GetLayer().has_value());
+    ASSERT_EQ(2, _key_frame_requests.size()); // ~1s without the key-frame
+    ASSERT_EQ(2, _key_frame_requests.back());
+
+    Run(2);
+    ASSERT_EQ(2, _forwarder.GetLayer());
+    ASSERT_EQ(2, _key_frame_requests.size());
+}
+
+TEST_F(SimulcastForwarderTest, SwitchKeepsSnTsContinuous) {
+    _forwarder.SetTargetLayer(0);
+    Run(2 * kKeyFramePeriod);
+    ASSERT_EQ(0, _forwarder.GetLayer());
+
+    for(size_t target : {2, 1, 0, 2}) {
+        _forwarder.SetTargetLayer(target);
+        const auto switched_at = _output.size();
+        Run(2 * kKeyFramePeriod);
+        ASSERT_EQ(target, _forwarder.GetLayer());
+        ASSERT_LT(switched_at, _output.size());
+        ASSERT_NO_FATAL_FAILURE(AssertContinuous());
+    }
+
+    const auto& stats = _forwarder.GetStats();
+    ASSERT_EQ(5, stats.switches);
+    ASSERT_EQ(0, stats.dropped);
+    ASSERT_EQ(_output.size(), stats.packets);
+}
+
+TEST_F(SimulcastForwarderTest, SwitchTsGap) {
+    _forwarder.SetTargetLayer(0);
+    Run(kKeyFramePeriod);
+    const auto last = _output.back();
+
+    // the new layer's key-frame comes after a pause
+    _forwarder.SetTargetLayer(1);
+    _clock.Add(100 * kMs);
+    _forwarder.Push(1, CreatePacket(_layers[1].ts, _layers[1].sn, true), true);
+    ASSERT_EQ(1, _forwarder.GetLayer());
+    ASSERT_EQ(static_cast<uint16_t>(last.sn + 1), _output.back().sn);
+    ASSERT_EQ(last.ts + (kFrameDuration + 100 * kMs) * 90'000 / kSec, _output.back().ts);
+
+    // the packet before the switch point is late
+    _forwarder.Push(1, CreatePacket(_layers[1].ts - kTsStep, _layers[1].sn - 1, true), false);
+    ASSERT_EQ(1, _forwarder.GetStats().dropped);
+}
+
+// SN of the switch point isn't compared to the packets of the next SN cycle
+TEST_F(SimulcastForwarderTest, SwitchGuardSnWraparound) {
+    _forwarder.SetTargetLayer(0);
+    Run(kKeyFramePeriod);
+    ASSERT_EQ(0, _forwarder.GetLayer());
+
+    const auto forwarded = _output.size();
+    constexpr size_t kPackets = 0x10000 + 100;
+    auto& layer = _layers[0];
+    for(size_t i = 0; i < kPackets; ++i, ++layer.sn, layer.ts += kTsStep) {
+        _forwarder.Push(0, CreatePacket(layer.ts, layer.sn, true), false);
+    }
+    ASSERT_EQ(0, _forwarder.GetStats().dropped);
+    ASSERT_EQ(forwarded + kPackets, _output.size());
+}
+
+TEST_F(SimulcastForwarderTest, AvailableBitrate) {
+    Run(2 * kKeyFramePeriod);
+    const auto bitrate0 = _forwarder.GetLayerBitrate(0);
+    const auto bitrate1 = _forwarder.GetLayerBitrate(1);
+    const auto bitrate2 = _forwarder.GetLayerBitrate(2);
+    ASSERT_LT(0, bitrate0);
+    ASSERT_NEAR(2 * bitrate0, bitrate1, bitrate0 / 10);
+    ASSERT_NEAR(4 * bitrate0, bitrate2, bitrate0 / 10);
+
+    _forwarder.SetAvailableBitrate(bitrate0 / 2);
+    ASSERT_EQ(0, _forwarder.GetTargetLayer()); // the lowest one anyway
+    Run(kKeyFramePeriod);
+    ASSERT_EQ(0, _forwarder.GetLayer());
+
+    _forwarder.SetAvailableBitrate(bitrate1);
+    ASSERT_EQ(0, _forwarder.GetTargetLayer()); // up margin
+    _forwarder.SetAvailableBitrate(bitrate1 * 1.3);
+    ASSERT_EQ(1, _forwarder.GetTargetLayer());
+    Run(kKeyFramePeriod);
+    ASSERT_EQ(1, _forwarder.GetLayer());
+
+    _forwarder.SetAvailableBitrate(bitrate2 * 2);
+    ASSERT_EQ(2, _forwarder.GetTargetLayer());
+    _forwarder.SetAvailableBitrate(bitrate1 * 1.05);
+    ASSERT_EQ(1, _forwarder.GetTargetLayer()); // no margin for the current layer
+    Run(kKeyFramePeriod);
+    ASSERT_EQ(1, _forwarder.GetLayer());
+    ASSERT_NO_FATAL_FAILURE(AssertContinuous());
+}
+
+}
@@ -0,0 +1,185 @@
+#include "tau/rtp-session/Session.h"
+#include "tau/rtp-session/TwccSender.h"
+#include "tau/rtp-session/TwccReceiver.h"
+#include "tau/rtp-session/DelayBasedEstimator.h"
+#include "tau/rtp/Writer.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/Extension.h"
+#include "tau/rtcp/Reader.h"
+#include "tau/rtcp/TwccReader.h"
+#include "tests/lib/Common.h"
+
+namespace tau::rtp::session {
+
+class TwccTest : public ::testing::Test {
+public:
+    static constexpr uint8_t kExtensionId = 3;
+    static constexpr size_t kPacketSize = 1200;
+    static constexpr Timepoint kPropagationDelay = 20 * kMs;
+    static constexpr Timepoint kFeedbackPeriod = 100 * kMs;
+    static constexpr Timepoint kSendPeriod = 5 * kMs;
+
+protected:
+    // bottleneck link with unlimited queue
+    struct Link {
+        uint32_t capacity;
+        Timepoint free_tp = 0;
+
+        Timepoint Send(Timepoint send_tp, size_t size) {
+            free_tp = std::max(free_tp, send_tp) + 8 * size * kSec / capacity;
+            return free_tp + kPropagationDelay;
+        }
+    };
+
+    // sends with the target bitrate, returns target bitrate samples per feedback
+    std::vector<uint32_t> Simulate(DelayBasedEstimator& estimator, Link& link, Timepoint duration) {
+        std::vector<uint32_t> targets;
+        std::vector<DelayBasedEstimator::PacketResult> in_flight;
+        std::vector<DelayBasedEstimator::PacketResult> results;
+        double budget = 0;
+        for(Timepoint now = kSendPeriod; now <= duration; now += kSendPeriod) {
+            budget += estimator.GetTargetBitrate() * DurationSec(0, kSendPeriod) / 8;
+            for(; budget >= kPacketSize; budget -= kPacketSize) {
+                in_flight.push_back(DelayBasedEstimator::PacketResult{
+                    .send_tp = now,
+                    .recv_tp = link.Send(now, kPacketSize),
+                    .size = kPacketSize
+                });
+            }
+            if(now % kFeedbackPeriod == 0) {
+                results.clear();
+                auto it = in_flight.begin();
+                for(; (it != in_flight.end()) && (*it->recv_tp <= now); ++it) {
+                    results.push_back(*it);
+                }
+                in_flight.erase(in_flight.begin(), it);
+                estimator.Update(results, now + kPropagationDelay);
+                targets.push_back(estimator.GetTargetBitrate());
+            }
+        }
+        return targets;
+    }
+
+    static Buffer CreateRtpPacket(uint16_t sn, uint32_t ts, uint32_t ssrc, size_t payload_size) {
+        auto packet = Buffer::Create(g_udp_allocator, Buffer::Info{});
+        const auto result = Writer::Write(packet.GetViewWithCapacity(), Writer::Options{
+            .pt = 96,
+            .ssrc = ssrc,
+            .ts = ts,
+            .sn = sn,
+            .marker = false
+        });
+        packet.SetSize(result.size + payload_size);
+        return packet;
+    }
+
+    static std::optional<uint16_t> GetTransportSn(const Buffer& packet) {
+        const auto element = ExtensionReader::Find(Reader(packet.GetView()).Extensions(), kExtensionId);
+        if(!element || (element->size != sizeof(uint16_t))) {
+            return std::nullopt;
+        }
+        return Read16(element->ptr);
+    }
+};
+
+TEST_F(TwccTest, Estimator_NoCongestion) {
+    DelayBasedEstimator estimator(DelayBasedEstimator::Options{});
+    Link link{.capacity = 20'000'000};
+    const auto targets = Simulate(estimator, link, 20 * kSec);
+    ASSERT_EQ(DelayBasedEstimator::Usage::kNormal, estimator.GetUsage());
+    ASSERT_TRUE(std::is_sorted(targets.begin(), targets.end()));
+    ASSERT_LT(1'000'000, targets.back());
+    ASSERT_GT(link.capacity, targets.back());
+    TAU_LOG_INFO("Target bitrate: " << targets.back() << ", acked: " << estimator.GetAckedBitrate().value());
+}
+
+TEST_F(TwccTest, Estimator_Bottleneck) {
+    constexpr uint32_t kCapacity = 1'000'000;
+    DelayBasedEstimator estimator(DelayBasedEstimator::Options{.initial_bitrate = 3 * kCapacity});
+    Link link{.capacity = kCapacity};
+    const auto targets = Simulate(estimator, link, 60 * kSec);
+
+    // the last 20 sec: the link is utilized, but the target doesn't go far above the capacity
+    const auto begin = targets.end() - 20 * kSec / kFeedbackPeriod;
+    const auto average = std::accumulate(begin, targets.end(), uint64_t{0}) / std::distance(begin, targets.end());
+    const auto [min, max] = std::minmax_element(begin, targets.end());
+    TAU_LOG_INFO("Target bitrate, average: " << average << ", min: " << *min << ", max: " << *max);
+    ASSERT_LT(kCapacity / 2, average);
+    ASSERT_GT(kCapacity * 12 / 10, average);
+    ASSERT_GT(kCapacity * 3 / 2, *max);
+    // standing queue is drained
+    ASSERT_GT(500 * kMs, link.free_tp - std::min(link.free_tp, 60 * kSec));
+}
+
+TEST_F(TwccTest, Estimator_Limits) {
+    DelayBasedEstimator estimator(DelayBasedEstimator::Options{.initial_bitrate = 100, .min_bitrate = 50'000, .max_bitrate = 400'000});
+    ASSERT_EQ(50'000, estimator.GetTargetBitrate());
+    Link link{.capacity = 20'000'000};
+    const auto targets = Simulate(estimator, link, 60 * kSec);
+    ASSERT_EQ(400'000, targets.back());
+}
+
+TEST_F(TwccTest, Session) {
+    constexpr size_t kFrames = 100;
+    constexpr size_t kPacketsPerFrame = 5;
+    const auto sender_ssrc = g_random.Int<uint32_t>();
+    const auto receiver_ssrc = g_random.Int<uint32_t>();
+
+    TestClock clock;
+    TwccSender twcc_sender(TwccSender::Dependencies{.clock = clock}, TwccSender::Options{.extension_id = kExtensionId});
+    TwccReceiver twcc_receiver(TwccReceiver::Dependencies{.clock = clock}, TwccReceiver::Options{.extension_id = kExtensionId});
+    Session sender(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = clock, .system_clock = clock, .twcc_sender = &twcc_sender},
+        Session::Options{.rate = 90'000, .sender_ssrc = sender_ssrc, .base_ts = 0});
+    Session receiver(
+        Session::Dependencies{.allocator = g_udp_allocator, .media_clock = clock, .system_clock = clock, .twcc_receiver = &twcc_receiver},
+        Session::Options{.rate = 90'000, .sender_ssrc = receiver_ssrc, .base_ts = 0});
+
+    std::vector<uint16_t> transport_sns;
+    size_t received = 0;
+    size_t feedbacks = 0;
+    sender.SetSendRtpCallback([&](Buffer&& packet) {
+        transport_sns.push_back(GetTransportSn(packet).value());
+        receiver.RecvRtp(std::move(packet));
+    });
+    sender.SetSendRtcpCallback([&](Buffer&& packet) { receiver.RecvRtcp(std::move(packet)); });
+    receiver.SetRecvRtpCallback([&](Buffer&&) { received++; });
+    receiver.SetSendRtcpCallback([&](Buffer&& packet) {
+        const auto view = ToConst(packet.GetView());
+        EXPECT_TRUE(rtcp::Reader::Validate(view));
+        rtcp::Reader::ForEachReport(view, [&](rtcp::Type type, const BufferViewConst& report) {
+            if((type == rtcp::Type::kRtpfb) && (rtcp::GetRc(report.ptr[0]) == rtcp::RtpfbType::kTwcc)) {
+                EXPECT_EQ(receiver_ssrc, rtcp::TwccReader::GetSenderSsrc(report));
+                EXPECT_EQ(sender_ssrc, rtcp::TwccReader::GetMediaSsrc(report));
+                feedbacks++;
+            }
+            return true;
+        });
+        sender.RecvRtcp(std::move(packet));
+    });
+
+    ASSERT_FALSE(receiver.GetNextDeadline().has_value());
+    uint16_t sn = g_random.Int<uint16_t>();
+    for(size_t i = 0; i < kFrames; ++i) {
+        for(size_t j = 0; j < kPacketsPerFrame; ++j) {
+            sender.SendRtp(CreateRtpPacket(sn++, i * 3000, sender_ssrc, 1000));
+        }
+        ASSERT_TRUE(receiver.GetNextDeadline().has_value());
+        clock.Add(33 * kMs);
+        receiver.Process();
+        sender.Process();
+    }
+    ASSERT_EQ(kFrames * kPacketsPerFrame, received);
+    ASSERT_EQ(kFrames * kPacketsPerFrame, transport_sns.size());
+    for(size_t i = 0; i < transport_sns.size(); ++i) {
+        ASSERT_EQ(i, transport_sns[i]);
+    }
+    ASSERT_NEAR(kFrames / 4, feedbacks, 1); // feedback period is rounded up to 4 frames
+    ASSERT_EQ(feedbacks, twcc_sender.GetStats().feedbacks);
+    ASSERT_EQ(0, twcc_sender.GetStats().lost);
+    ASSERT_LE(kFrames * kPacketsPerFrame - kPacketsPerFrame * 4, twcc_sender.GetStats().acked);
+    ASSERT_EQ(twcc_sender.GetTargetBitrate(), sender.GetStats().outgoing.target_bitrate);
+    ASSERT_LT(DelayBasedEstimator::Options{}.initial_bitrate, sender.GetStats().outgoing.target_bitrate);
+}
+
+}
@@ -0,0 +1,161 @@
+#include "tau/rtp/Extension.h"
+#include "tau/rtp/Writer.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/Constants.h"
+#include "tau/memory/Buffer.h"
+#include "tests/lib/Common.h"
+
+namespace tau::rtp {
+
+class ExtensionTest : public ::testing::Test {
+protected:
+    static constexpr auto kDefaultOptions = Writer::Options{
+        .pt     = 100,
+        .ssrc   = 0x01234567,
+        .ts     = 90000,
+        .sn     = 12345,
+        .marker = true
+    };
+
+protected:
+    static Buffer CreatePacket(const Writer::Options& options, size_t payload_size) {
+        auto packet = Buffer::Create(g_udp_allocator);
+        auto result = Writer::Write(packet.GetViewWithCapacity(), options);
+        for(size_t i = 0; i < payload_size; ++i) {
+            result.payload.ptr[i] = static_cast<uint8_t>(i);
+        }
+        packet.SetSize(result.size + payload_size);
+        return packet;
+    }
+
+    static void AssertPacket(const Buffer& packet, size_t payload_size) {
+        const auto view = packet.GetView();
+        ASSERT_TRUE(Reader::Validate(view));
+        Reader reader(view);
+        ASSERT_EQ(kDefaultOptions.pt, reader.Pt());
+        ASSERT_EQ(kDefaultOptions.sn, reader.Sn());
+        ASSERT_EQ(kDefaultOptions.ts, reader.Ts());
+        ASSERT_EQ(kDefaultOptions.ssrc, reader.Ssrc());
+        ASSERT_EQ(kDefaultOptions.marker, reader.Marker());
+        const auto payload = reader.Payload();
+        ASSERT_EQ(payload_size, payload.size);
+        for(size_t i = 0; i < payload_size; ++i) {
+            ASSERT_EQ(static_cast<uint8_t>(i), payload.ptr[i]);
+        }
+    }
+
+    static std::optional<uint16_t> Find16(const Buffer& packet, uint8_t id) {
+        const auto element = ExtensionReader::Find(Reader(packet.GetView()).Extensions(), id);
+        if(!element || (element->size != sizeof(uint16_t))) {
+            return std::nullopt;
+        }
+        return Read16(element->ptr);
+    }
+
+    static bool Set16(Buffer& packet, uint8_t id, uint16_t value) {
+        uint8_t data[sizeof(uint16_t)];
+        Write16(data, value);
+        return ExtensionWriter::Set(packet, id, BufferViewConst{.ptr = data, .size = sizeof(data)});
+    }
+};
+
+TEST_F(ExtensionTest, WriteAndFind) {
+    auto options = kDefaultOptions;
+    options.extension_length_in_words = 2;
+    auto packet = Buffer::Create(g_udp_allocator);
+    auto result = Writer::Write(packet.GetViewWithCapacity(), options);
+    const uint8_t audio_level[] = {0x7F, 0, 0, 0, 0};
+    const uint8_t twcc_sn[] = {0x12, 0x34};
+    size_t offset = 0;
+    offset += ExtensionWriter::Write(result.extension, offset, 1, BufferViewConst{.ptr = audio_level, .size = 1});
+    offset += ExtensionWriter::Write(result.extension, offset, 3, BufferViewConst{.ptr = twcc_sn, .size = sizeof(twcc_sn)});
+    ASSERT_EQ(5, offset);
+    ASSERT_EQ(0, ExtensionWriter::Write(result.extension, offset, 4, BufferViewConst{.ptr = audio_level, .size = 3 * sizeof(audio_level) + 1}));
+    ASSERT_EQ(0, ExtensionWriter::Write(result.extension, 0, 15, BufferViewConst{.ptr = twcc_sn, .size = sizeof(twcc_sn)}));
+    packet.SetSize(result.size);
+
+    ASSERT_TRUE(Reader::Validate(ToConst(packet.GetView())));
+    const auto extensions = Reader(ToConst(packet.GetView())).Extensions();
+    const auto level = ExtensionReader::Find(extensions, 1);
+    ASSERT_TRUE(level.has_value());
+    ASSERT_EQ(1, level->size);
+    ASSERT_EQ(0x7F, level->ptr[0]);
+    ASSERT_EQ(0x1234, Find16(packet, 3).value());
+    ASSERT_FALSE(ExtensionReader::Find(extensions, 2).has_value());
+}
+
+TEST_F(ExtensionTest, SetWithoutExtension) {
+    constexpr size_t kPayloadSize = 100;
+    auto packet = CreatePacket(kDefaultOptions, kPayloadSize);
+    ASSERT_FALSE(Find16(packet, 5).has_value());
+
+    ASSERT_TRUE(Set16(packet, 5, 0xABCD));
+    ASSERT_EQ(kFixedHeaderSize + HeaderExtensionSize(1) + kPayloadSize, packet.GetSize());
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(packet, kPayloadSize));
+    ASSERT_EQ(0xABCD, Find16(packet, 5).value());
+
+    // in-place update, size isn't changed
+    ASSERT_TRUE(Set16(packet, 5, 0x0001));
+    ASSERT_EQ(kFixedHeaderSize + HeaderExtensionSize(1) + kPayloadSize, packet.GetSize());
+    ASSERT_EQ(0x0001, Find16(packet, 5).value());
+
+    // the 2nd element doesn't fit the padding of the 1st word
+    ASSERT_TRUE(Set16(packet, 7, 0x0203));
+    ASSERT_EQ(kFixedHeaderSize + HeaderExtensionSize(2) + kPayloadSize, packet.GetSize());
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(packet, kPayloadSize));
+    ASSERT_EQ(0x0001, Find16(packet, 5).value());
+    ASSERT_EQ(0x0203, Find16(packet, 7).value());
+}
+
+TEST_F(ExtensionTest, SetWithExistingExtension) {
+    constexpr size_t kPayloadSize = 33;
+    auto options = kDefaultOptions;
+    options.extension_length_in_words = 1;
+    auto packet = Buffer::Create(g_udp_allocator);
+    auto result = Writer::Write(packet.GetViewWithCapacity(), options);
+    const uint8_t audio_level[] = {0x55};
+    ASSERT_EQ(2, ExtensionWriter::Write(result.extension, 0, 1, BufferViewConst{.ptr = audio_level, .size = sizeof(audio_level)}));
+    for(size_t i = 0; i < kPayloadSize; ++i) {
+        result.payload.ptr[i] = static_cast<uint8_t>(i);
+    }
+    packet.SetSize(result.size + kPayloadSize);
+
+    // the element is placed into the padding, no need to grow
+    const uint8_t video_orientation[] = {0x03};
+    ASSERT_TRUE(ExtensionWriter::Set(packet, 2, BufferViewConst{.ptr = video_orientation, .size = sizeof(video_orientation)}));
+    ASSERT_EQ(kFixedHeaderSize + HeaderExtensionSize(1) + kPayloadSize, packet.GetSize());
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(packet, kPayloadSize));
+
+    ASSERT_TRUE(Set16(packet, 3, 0x4321));
+    ASSERT_EQ(kFixedHeaderSize + HeaderExtensionSize(2) + kPayloadSize, packet.GetSize());
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(packet, kPayloadSize));
+    ASSERT_EQ(0x4321, Find16(packet, 3).value());
+    const auto extensions = Reader(ToConst(packet.GetView())).Extensions();
+    ASSERT_EQ(0x55, ExtensionReader::Find(extensions, 1)->ptr[0]);
+    ASSERT_EQ(0x03, ExtensionReader::Find(extensions, 2)->ptr[0]);
+}
+
+TEST_F(ExtensionTest, SetWithCsrcs) {
+    constexpr size_t kPayloadSize = 10;
+    auto packet = CreatePacket(kDefaultOptions, kPayloadSize + 2 * sizeof(uint32_t));
+    // fake two CSRCs: payload bytes are shifted by CSRC list
+    auto view = packet.GetView();
+    view.ptr[0] |= 2;
+    for(size_t i = 0; i < kPayloadSize; ++i) {
+        view.ptr[kFixedHeaderSize + 2 * sizeof(uint32_t) + i] = static_cast<uint8_t>(i);
+    }
+    ASSERT_TRUE(Set16(packet, 1, 0x7788));
+    ASSERT_EQ(kFixedHeaderSize + 2 * sizeof(uint32_t) + HeaderExtensionSize(1) + kPayloadSize, packet.GetSize());
+    ASSERT_NO_FATAL_FAILURE(AssertPacket(packet, kPayloadSize));
+    ASSERT_EQ(0x7788, Find16(packet, 1).value());
+}
+
+TEST_F(ExtensionTest, SetNoCapacity) {
+    auto packet = CreatePacket(kDefaultOptions, 0);
+    packet.SetSize(packet.GetCapacity() - packet.GetHeadroom());
+    const auto size = packet.GetSize();
+    ASSERT_FALSE(Set16(packet, 1, 0x7788));
+    ASSERT_EQ(size, packet.GetSize());
+}
+
+}
@@ -0,0 +1,52 @@
+#include "tau/rtp/FlexFec.h"
+#include "tests/lib/Common.h"
+
+namespace tau::rtp {
+
+TEST(FlexFecTest, Header) {
+    const std::vector<std::pair<size_t, size_t>> mask_and_header_sizes = {
+        {1, 12}, {15, 12}, {16, 16}, {46, 16}, {47, 24}, {FlexFec::kMaxMaskSize, 24}
+    };
+    for(auto [mask_size, header_size] : mask_and_header_sizes) {
+        ASSERT_EQ(header_size, FlexFec::GetHeaderSize(mask_size));
+
+        FlexFec::Mask mask;
+        for(size_t i = 0; i < mask_size; ++i) {
+            mask[i] = (i == 0) || (i + 1 == mask_size) || (g_random.Int<uint8_t>() & 1);
+        }
+        const uint16_t sn_base = g_random.Int<uint16_t>();
+        std::array<uint8_t, 32> payload = {};
+        FlexFec::WriteHeader(payload.data(), sn_base, mask, header_size);
+
+        auto header = FlexFec::ReadHeader(BufferViewConst{.ptr = payload.data(), .size = payload.size()});
+        ASSERT_TRUE(header.has_value());
+        ASSERT_EQ(sn_base, header->sn_base);
+        ASSERT_EQ(mask, header->mask);
+        ASSERT_EQ(header_size, header->size);
+
+        ASSERT_FALSE(FlexFec::ReadHeader(BufferViewConst{.ptr = payload.data(), .size = header_size - 1}).has_value());
+    }
+}
+
+TEST(FlexFecTest, Xor) {
+    std::array<uint8_t, 8> fields = {};
+    const std::array<uint8_t, 12> header_a = {0x90, 0xE0, 0x00, 0x01, 0x11, 0x22, 0x33, 0x44, 0xFF, 0xFF, 0xFF, 0xFF};
+    const std::array<uint8_t, 12> header_b = {0x80, 0x60, 0x00, 0x02, 0x11, 0x22, 0x33, 0x45, 0xFF, 0xFF, 0xFF, 0xFF};
+    FlexFec::XorRecoveryFields(fields.data(), header_a.data(), 1012);
+    FlexFec::XorRecoveryFields(fields.data(), header_b.data(), 112);
+    const std::array<uint8_t, 8> expected = {0x10, 0x80, 0x03, 0xE8 ^ 0x64, 0x00, 0x00, 0x00, 0x01};
+    ASSERT_EQ(expected, fields);
+
+    std::vector<uint8_t> data(37), other(37);
+    for(size_t i = 0; i < data.size(); ++i) {
+        data[i] = g_random.Int<uint8_t>();
+        other[i] = g_random.Int<uint8_t>();
+    }
+    auto result = data;
+    FlexFec::XorData(result.data(), other.data(), other.size());
+    for(size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(data[i] ^ other[i], result[i]);
+    }
+}
+
+}
@@ -30,12 +30,13 @@ TEST_F(RtpAllocatorTest, Basic) {
             .base_tp = start_tp,
             .clock_rate = kDefaultClockRate
         });
-    ASSERT_EQ(1140, allocator.MaxRtpPayload());
+    ASSERT_EQ(1133, allocator.MaxRtpPayload());
 
     {
         auto packet = allocator.Allocate(start_tp, false);
         ASSERT_EQ(kFixedHeaderSize, packet.GetSize());
-        ASSERT_EQ(1200, packet.GetViewWithCapacity().size);
+        ASSERT_EQ(RtpAllocator::kTurnHeadroom, packet.GetHeadroom());
+        ASSERT_EQ(1200 - RtpAllocator::kTurnHeadroom, packet.GetViewWithCapacity().size);
 
         ASSERT_TRUE(Reader::Validate(ToConst(packet.GetView())));
         Reader reader(ToConst(packet.GetView()));
@@ -48,7 +49,8 @@ TEST_F(RtpAllocatorTest, Basic) {
     {
         auto packet = allocator.Allocate(start_tp + 500 * kMs, true);
         ASSERT_EQ(kFixedHeaderSize, packet.GetSize());
-        ASSERT_EQ(1200, packet.GetViewWithCapacity().size);
+        ASSERT_EQ(RtpAllocator::kTurnHeadroom, packet.GetHeadroom());
+        ASSERT_EQ(1200 - RtpAllocator::kTurnHeadroom, packet.GetViewWithCapacity().size);
 
         ASSERT_TRUE(Reader::Validate(ToConst(packet.GetView())));
         Reader reader(ToConst(packet.GetView()));
@@ -71,7 +73,7 @@ TEST_F(RtpAllocatorTest, TsOverflow) {
             .base_tp = start_tp,
             .clock_rate = kDefaultClockRate,
         });
-    ASSERT_EQ(540, allocator.MaxRtpPayload());
+    ASSERT_EQ(533, allocator.MaxRtpPayload());
 
     auto prev_ts = _header_options.ts;
     const auto max_seconds = 1 + std::numeric_limits<uint32_t>::max() / kDefaultClockRate;
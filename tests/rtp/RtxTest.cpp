@@ -0,0 +1,109 @@
+#include "tau/rtp/Rtx.h"
+#include "tau/rtp/Writer.h"
+#include "tau/rtp/Reader.h"
+#include "tau/rtp/details/FixedHeader.h"
+#include "tau/memory/Buffer.h"
+#include "tests/lib/Common.h"
+
+namespace tau::rtp {
+
+class RtxTest : public ::testing::Test {
+protected:
+    static constexpr uint8_t kRtxPt = 101;
+    static constexpr uint32_t kRtxSsrc = 0x76543210;
+    static constexpr uint16_t kRtxSn = 777;
+    static constexpr auto kDefaultOptions = Writer::Options{
+        .pt     = 100,
+        .ssrc   = 0x01234567,
+        .ts     = 90000,
+        .sn     = 12345,
+        .marker = true,
+        .extension_length_in_words = 2
+    };
+
+protected:
+    static Buffer CreatePacket(size_t payload_size, uint8_t padding = 0) {
+        auto packet = Buffer::Create(g_udp_allocator);
+        auto result = Writer::Write(packet.GetViewWithCapacity(), kDefaultOptions);
+        for(size_t i = 0; i < result.extension.size; ++i) {
+            result.extension.ptr[i] = static_cast<uint8_t>(0xE0 + i);
+        }
+        for(size_t i = 0; i < payload_size; ++i) {
+            result.payload.ptr[i] = static_cast<uint8_t>(i);
+        }
+        if(padding) {
+            std::memset(result.payload.ptr + payload_size, 0, padding);
+            result.payload.ptr[payload_size + padding - 1] = padding;
+            reinterpret_cast<detail::FixedHeader*>(packet.GetViewWithCapacity().ptr)->p = 1;
+        }
+        packet.SetSize(result.size + payload_size + padding);
+        return packet;
+    }
+
+    static void AssertPayload(const BufferViewConst& payload, size_t payload_size) {
+        ASSERT_EQ(payload_size, payload.size);
+        for(size_t i = 0; i < payload_size; ++i) {
+            ASSERT_EQ(static_cast<uint8_t>(i), payload.ptr[i]);
+        }
+    }
+};
+
+TEST_F(RtxTest, Basic) {
+    constexpr size_t kPayloadSize = 1000;
+    auto packet = CreatePacket(kPayloadSize);
+    const auto original_extensions = Reader(ToConst(packet.GetView())).Extensions();
+    const std::vector<uint8_t> extensions(original_extensions.ptr, original_extensions.ptr + original_extensions.size);
+
+    ASSERT_TRUE(Rtx::Wrap(packet, kRtxPt, kRtxSsrc, kRtxSn));
+    ASSERT_TRUE(Reader::Validate(ToConst(packet.GetView())));
+    Reader rtx_reader(ToConst(packet.GetView()));
+    ASSERT_EQ(kRtxPt, rtx_reader.Pt());
+    ASSERT_EQ(kRtxSsrc, rtx_reader.Ssrc());
+    ASSERT_EQ(kRtxSn, rtx_reader.Sn());
+    ASSERT_EQ(kDefaultOptions.ts, rtx_reader.Ts());
+    ASSERT_EQ(kDefaultOptions.marker, rtx_reader.Marker());
+    ASSERT_EQ(kRtxOsnSize + kPayloadSize, rtx_reader.Payload().size);
+    ASSERT_EQ(kDefaultOptions.sn, Read16(rtx_reader.Payload().ptr));
+    ASSERT_EQ(0, std::memcmp(extensions.data(), rtx_reader.Extensions().ptr, extensions.size()));
+
+    ASSERT_TRUE(Rtx::Unwrap(packet, kDefaultOptions.pt, kDefaultOptions.ssrc));
+    ASSERT_TRUE(Reader::Validate(ToConst(packet.GetView())));
+    Reader reader(ToConst(packet.GetView()));
+    ASSERT_EQ(kDefaultOptions.pt, reader.Pt());
+    ASSERT_EQ(kDefaultOptions.ssrc, reader.Ssrc());
+    ASSERT_EQ(kDefaultOptions.sn, reader.Sn());
+    ASSERT_EQ(kDefaultOptions.ts, reader.Ts());
+    ASSERT_EQ(kDefaultOptions.marker, reader.Marker());
+    ASSERT_EQ(0, std::memcmp(extensions.data(), reader.Extensions().ptr, extensions.size()));
+    ASSERT_NO_FATAL_FAILURE(AssertPayload(reader.Payload(), kPayloadSize));
+}
+
+TEST_F(RtxTest, Padding) {
+    constexpr size_t kPayloadSize = 100;
+    constexpr uint8_t kPadding = 7;
+    auto packet = CreatePacket(kPayloadSize, kPadding);
+    ASSERT_EQ(kPadding, Reader(ToConst(packet.GetView())).Padding());
+
+    ASSERT_TRUE(Rtx::Wrap(packet, kRtxPt, kRtxSsrc, kRtxSn));
+    ASSERT_EQ(0, Reader(ToConst(packet.GetView())).Padding());
+    ASSERT_EQ(kRtxOsnSize + kPayloadSize, Reader(ToConst(packet.GetView())).Payload().size);
+
+    ASSERT_TRUE(Rtx::Unwrap(packet, kDefaultOptions.pt, kDefaultOptions.ssrc));
+    ASSERT_NO_FATAL_FAILURE(AssertPayload(Reader(ToConst(packet.GetView())).Payload(), kPayloadSize));
+}
+
+TEST_F(RtxTest, Malformed) {
+    auto packet = CreatePacket(0);
+    ASSERT_FALSE(Rtx::Unwrap(packet, kDefaultOptions.pt, kDefaultOptions.ssrc)); // no OSN
+
+    auto full_packet = CreatePacket(0);
+    full_packet.SetSize(full_packet.GetSize() + full_packet.GetTailroom() - 1);
+    ASSERT_FALSE(Rtx::Wrap(full_packet, kRtxPt, kRtxSsrc, kRtxSn));
+
+    auto broken_packet = CreatePacket(10);
+    broken_packet.GetView().ptr[0] = 0;
+    ASSERT_FALSE(Rtx::Wrap(broken_packet, kRtxPt, kRtxSsrc, kRtxSn));
+    ASSERT_FALSE(Rtx::Unwrap(broken_packet, kDefaultOptions.pt, kDefaultOptions.ssrc));
+}
+
+}
@@ -164,6 +164,41 @@ TEST_F(NegotiationTest, Video) {
     ASSERT_EQ("level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=4d0029", codec.format);
 }
 
+TEST_F(NegotiationTest, VideoSimulcast) {
+    auto remote = kDefaultRemoteVideo;
+    remote.direction = Direction::kSend;
+    remote.mid_extension_id = 4;
+    remote.rid_extension_id = 10;
+    remote.simulcast = Simulcast{.direction = Direction::kSend, .rids = {"f", "h", "q"}};
+
+    Media local{
+        .type = MediaType::kVideo,
+        .mid = "video",
+        .direction = Direction::kRecv,
+        .codecs = MakeCodecsMap({
+            {103, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = RtcpFb::kNack, .format = "profile-level-id=4d0029"}},
+        }),
+        .ssrc = g_random.Int<uint32_t>(),
+        .mid_extension_id = 1,
+        .rid_extension_id = 2
+    };
+    auto media = SelectMedia(remote, local);
+    ASSERT_TRUE(media.has_value());
+    ASSERT_EQ(4, media->mid_extension_id);
+    ASSERT_EQ(10, media->rid_extension_id);
+    ASSERT_FALSE(media->repaired_rid_extension_id.has_value());
+    ASSERT_TRUE(media->simulcast.has_value());
+    ASSERT_EQ(Direction::kRecv, media->simulcast->direction);
+    ASSERT_EQ(3, media->simulcast->rids.size());
+    ASSERT_EQ("f", media->simulcast->rids[0]);
+
+    // RID header extension isn't supported locally
+    local.rid_extension_id.reset();
+    media = SelectMedia(remote, local);
+    ASSERT_TRUE(media.has_value());
+    ASSERT_FALSE(media->simulcast.has_value());
+}
+
 TEST_F(NegotiationTest, VideoH265) {
     const Media local{
         .type = MediaType::kVideo,
@@ -294,4 +329,95 @@ TEST_F(NegotiationTest, RtcpFb) {
     ASSERT_EQ(RtcpFb::kNone,  SelectRtcpFb(RtcpFb::kNack, RtcpFb::kPli | RtcpFb::kFir));
 }
 
+TEST_F(NegotiationTest, TwccExtension) {
+    Media remote = kDefaultRemoteVideo;
+    Media local{
+        .type = MediaType::kVideo,
+        .mid = "video",
+        .direction = Direction::kRecv,
+        .codecs = MakeCodecsMap({
+            {103, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = RtcpFb::kNack | RtcpFb::kTwcc, .format = "profile-level-id=4d0029"}},
+        }),
+        .ssrc = g_random.Int<uint32_t>(),
+        .twcc_extension_id = 5
+    };
+    ASSERT_FALSE(SelectMedia(remote, local)->twcc_extension_id.has_value());
+
+    remote.twcc_extension_id = 3;
+    remote.codecs.at(127).rtcp_fb |= RtcpFb::kTwcc;
+    auto media = SelectMedia(remote, local);
+    ASSERT_EQ(3, media->twcc_extension_id.value());
+    ASSERT_EQ(RtcpFb::kNack | RtcpFb::kTwcc, media->codecs.at(127).rtcp_fb);
+
+    local.twcc_extension_id.reset();
+    ASSERT_FALSE(SelectMedia(remote, local)->twcc_extension_id.has_value());
+}
+
+TEST_F(NegotiationTest, Rtx) {
+    Media local{
+        .type = MediaType::kVideo,
+        .mid = "video",
+        .direction = Direction::kSendRecv,
+        .codecs = MakeCodecsMap({
+            {103, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = RtcpFb::kNack, .format = "profile-level-id=4d0029", .rtx_pt = 104}},
+        }),
+        .ssrc = g_random.Int<uint32_t>(),
+        .rtx_ssrc = g_random.Int<uint32_t>()
+    };
+    auto media = SelectMedia(kDefaultRemoteVideo, local);
+    ASSERT_EQ(125, media->codecs.at(127).rtx_pt);
+    ASSERT_EQ(local.rtx_ssrc, media->rtx_ssrc);
+
+    // no NACK, no retransmissions
+    local.codecs.at(103).rtcp_fb = RtcpFb::kPli;
+    media = SelectMedia(kDefaultRemoteVideo, local);
+    ASSERT_FALSE(media->codecs.at(127).rtx_pt.has_value());
+    ASSERT_FALSE(media->rtx_ssrc.has_value());
+
+    // rtx isn't supported locally
+    local.codecs.at(103).rtcp_fb = RtcpFb::kNack;
+    local.codecs.at(103).rtx_pt.reset();
+    media = SelectMedia(kDefaultRemoteVideo, local);
+    ASSERT_FALSE(media->codecs.at(127).rtx_pt.has_value());
+    ASSERT_FALSE(media->rtx_ssrc.has_value());
+
+    // rtx isn't offered by remote
+    local.codecs.at(103).rtx_pt = 104;
+    auto remote = kDefaultRemoteVideo;
+    remote.codecs.erase(125);
+    media = SelectMedia(remote, local);
+    ASSERT_FALSE(media->codecs.at(127).rtx_pt.has_value());
+    ASSERT_FALSE(media->rtx_ssrc.has_value());
+}
+
+TEST_F(NegotiationTest, Fec) {
+    Media local{
+        .type = MediaType::kVideo,
+        .mid = "video",
+        .direction = Direction::kSendRecv,
+        .codecs = MakeCodecsMap({
+            {103, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = RtcpFb::kNack, .format = "profile-level-id=4d0029"}},
+        }),
+        .ssrc = g_random.Int<uint32_t>(),
+        .fec_pt = 49,
+        .fec_ssrc = g_random.Int<uint32_t>()
+    };
+    auto remote = kDefaultRemoteVideo;
+    auto media = SelectMedia(remote, local);
+    ASSERT_FALSE(media->fec_pt.has_value());
+    ASSERT_FALSE(media->fec_ssrc.has_value());
+
+    remote.codecs.insert({35, Codec{.index = 30, .name = "flexfec-03", .clock_rate = 90000, .rtcp_fb = 0, .format = "repair-window=10000000"}});
+    media = SelectMedia(remote, local);
+    ASSERT_EQ(35, media->fec_pt);
+    ASSERT_EQ(local.fec_ssrc, media->fec_ssrc);
+    ASSERT_FALSE(media->codecs.contains(35));
+
+    // flexfec isn't supported locally
+    local.fec_pt.reset();
+    media = SelectMedia(remote, local);
+    ASSERT_FALSE(media->fec_pt.has_value());
+    ASSERT_FALSE(media->fec_ssrc.has_value());
+}
+
 }
@@ -4,6 +4,8 @@
 namespace tau::sdp {
 
 class ReaderTest :public ReaderWriterBase, public ::testing::Test {
+protected:
+    static constexpr uint8_t kRtcpFbTwcc = kRtcpFbDefault | RtcpFb::kTwcc;
 };
 
 TEST_F(ReaderTest, Rtsp) {
@@ -104,7 +106,7 @@ TEST_F(ReaderTest, WebrtcChrome) {
         .mid = "0",
         .direction = Direction::kRecv,
         .codecs = MakeCodecsMap({
-            {111, Codec{.index = 0, .name = "opus", .clock_rate = 48000, .rtcp_fb = 0, .format = "minptime=10;useinbandfec=1"}},
+            {111, Codec{.index = 0, .name = "opus", .clock_rate = 48000, .rtcp_fb = RtcpFb::kTwcc, .format = "minptime=10;useinbandfec=1"}},
             { 63, Codec{.index = 1, .name = "red", .clock_rate = 48000, .rtcp_fb = 0, .format = "111/111"}},
             {  9, Codec{.index = 2, .name = "G722", .clock_rate = 8000}},
             {  0, Codec{.index = 3, .name = "PCMU", .clock_rate = 8000}},
@@ -113,38 +115,41 @@ TEST_F(ReaderTest, WebrtcChrome) {
             {110, Codec{.index = 6, .name = "telephone-event", .clock_rate = 48000}},
             {126, Codec{.index = 7, .name = "telephone-event", .clock_rate = 8000}},
         }),
-        .ssrc = 3461839429
+        .ssrc = 3461839429,
+        .twcc_extension_id = 3
     });
     target_sdp.medias.push_back(Media{
         .type = MediaType::kVideo,
         .mid = "1",
         .direction = Direction::kSendRecv,
         .codecs = MakeCodecsMap({
-            { 96, Codec{.index = 0,  .name = "VP8",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = {}}},
+            { 96, Codec{.index = 0,  .name = "VP8",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = {}}},
             { 97, Codec{.index = 1,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=96"}},
-            {102, Codec{.index = 2,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42001f"}},
+            {102, Codec{.index = 2,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42001f"}},
             {103, Codec{.index = 3,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=102"}},
-            {104, Codec{.index = 4,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=42001f"}},
+            {104, Codec{.index = 4,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=42001f"}},
             {105, Codec{.index = 5,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=104"}},
-            {106, Codec{.index = 6,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f"}},
+            {106, Codec{.index = 6,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f"}},
             {107, Codec{.index = 7,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=106"}},
-            {108, Codec{.index = 8,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=42e01f"}},
+            {108, Codec{.index = 8,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=42e01f"}},
             {109, Codec{.index = 9,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=108"}},
-            {127, Codec{.index = 10, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=4d001f"}},
+            {127, Codec{.index = 10, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=4d001f"}},
             {125, Codec{.index = 11, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=127"}},
-            { 39, Codec{.index = 12, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=4d001f"}},
+            { 39, Codec{.index = 12, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=4d001f"}},
             { 40, Codec{.index = 13, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=39"}},
-            { 45, Codec{.index = 14, .name = "AV1",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-idx=5;profile=0;tier=0"}},
+            { 45, Codec{.index = 14, .name = "AV1",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-idx=5;profile=0;tier=0"}},
             { 46, Codec{.index = 15, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=45"}},
-            { 98, Codec{.index = 16, .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "profile-id=0"}},
+            { 98, Codec{.index = 16, .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "profile-id=0"}},
             { 99, Codec{.index = 17, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=98"}},
-            {100, Codec{.index = 18, .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "profile-id=2"}},
+            {100, Codec{.index = 18, .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "profile-id=2"}},
             {101, Codec{.index = 19, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=100"}},
             {112, Codec{.index = 20, .name = "red",  .clock_rate = 90000}},
             {113, Codec{.index = 21, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=112"}},
             {114, Codec{.index = 22, .name = "ulpfec", .clock_rate = 90000}},
         }),
-        .ssrc = 3218536253
+        .ssrc = 3218536253,
+        .twcc_extension_id = 3,
+        .rtx_ssrc = 2426449402
     });
     const auto parsed_sdp = ParseSdp(kWebrtcChromeSdpExample);
     ASSERT_NE(nullptr, parsed_sdp);
@@ -174,7 +179,7 @@ TEST_F(ReaderTest, WebrtcSafari) {
         .mid = "0",
         .direction = Direction::kSendRecv,
         .codecs = MakeCodecsMap({
-            {111, Codec{.index = 0, .name = "opus", .clock_rate = 48000, .rtcp_fb = 0, .format = "minptime=10;useinbandfec=1"}},
+            {111, Codec{.index = 0, .name = "opus", .clock_rate = 48000, .rtcp_fb = RtcpFb::kTwcc, .format = "minptime=10;useinbandfec=1"}},
             { 63, Codec{.index = 1, .name = "red", .clock_rate = 48000, .rtcp_fb = 0, .format = "111/111"}},
             {  9, Codec{.index = 2, .name = "G722", .clock_rate = 8000}},
             {  0, Codec{.index = 3, .name = "PCMU", .clock_rate = 8000}},
@@ -183,34 +188,37 @@ TEST_F(ReaderTest, WebrtcSafari) {
             {110, Codec{.index = 6, .name = "telephone-event", .clock_rate = 48000}},
             {126, Codec{.index = 7, .name = "telephone-event", .clock_rate = 8000}},
         }),
-        .ssrc = 616985218
+        .ssrc = 616985218,
+        .twcc_extension_id = 3
     });
     target_sdp.medias.push_back(Media{
         .type = MediaType::kVideo,
         .mid = "1",
         .direction = Direction::kSendRecv,
         .codecs = MakeCodecsMap({
-            { 96, Codec{.index = 0,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=640c1f"}},
+            { 96, Codec{.index = 0,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=640c1f"}},
             { 97, Codec{.index = 1,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=96"}},
-            { 98, Codec{.index = 2,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f"}},
+            { 98, Codec{.index = 2,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f"}},
             { 99, Codec{.index = 3,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=98"}},
-            {100, Codec{.index = 4,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=640c1f"}},
+            {100, Codec{.index = 4,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=640c1f"}},
             {101, Codec{.index = 5,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=100"}},
-            {102, Codec{.index = 6,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=42e01f"}},
+            {102, Codec{.index = 6,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=42e01f"}},
             {103, Codec{.index = 7,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=102"}},
-            {104, Codec{.index = 8,  .name = "H265", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = {}}},
+            {104, Codec{.index = 8,  .name = "H265", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = {}}},
             {105, Codec{.index = 9,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=104"}},
-            {106, Codec{.index = 10, .name = "VP8",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = {}}},
+            {106, Codec{.index = 10, .name = "VP8",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = {}}},
             {107, Codec{.index = 11, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=106"}},
-            {108, Codec{.index = 12, .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "profile-id=0"}},
+            {108, Codec{.index = 12, .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "profile-id=0"}},
             {109, Codec{.index = 13, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=108"}},
-            {127, Codec{.index = 14, .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "profile-id=2"}},
+            {127, Codec{.index = 14, .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "profile-id=2"}},
             {125, Codec{.index = 15, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=127"}},
             {112, Codec{.index = 16, .name = "red",  .clock_rate = 90000}},
             {113, Codec{.index = 17, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=112"}},
             {114, Codec{.index = 18, .name = "ulpfec", .clock_rate = 90000}},
         }),
-        .ssrc = 3201680545
+        .ssrc = 3201680545,
+        .twcc_extension_id = 3,
+        .rtx_ssrc = 2693598584
     });
     const auto parsed_sdp = ParseSdp(kWebrtcSafariSdpExample);
     ASSERT_NE(nullptr, parsed_sdp);
@@ -253,35 +261,78 @@ TEST_F(ReaderTest, WebrtcFirefox) {
         .mid = "1",
         .direction = Direction::kSendRecv,
         .codecs = MakeCodecsMap({
-            {120, Codec{.index = 0,  .name = "VP8",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "max-fs=12288;max-fr=60"}},
+            {120, Codec{.index = 0,  .name = "VP8",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "max-fs=12288;max-fr=60"}},
             {124, Codec{.index = 1,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=120"}},
-            {121, Codec{.index = 2,  .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "max-fs=12288;max-fr=60"}},
+            {121, Codec{.index = 2,  .name = "VP9",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "max-fs=12288;max-fr=60"}},
             {125, Codec{.index = 3,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=121"}},
-            {126, Codec{.index = 4,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "profile-level-id=42e01f;level-asymmetry-allowed=1;packetization-mode=1"}},
+            {126, Codec{.index = 4,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "profile-level-id=42e01f;level-asymmetry-allowed=1;packetization-mode=1"}},
             {127, Codec{.index = 5,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=126"}},
-            { 97, Codec{.index = 6,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "profile-level-id=42e01f;level-asymmetry-allowed=1"}},
+            { 97, Codec{.index = 6,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "profile-level-id=42e01f;level-asymmetry-allowed=1"}},
             { 98, Codec{.index = 7,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=97"}},
-            {105, Codec{.index = 8,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "profile-level-id=42001f;level-asymmetry-allowed=1;packetization-mode=1"}},
+            {105, Codec{.index = 8,  .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "profile-level-id=42001f;level-asymmetry-allowed=1;packetization-mode=1"}},
             {106, Codec{.index = 9,  .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=105"}},
-            {103, Codec{.index = 10, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "profile-level-id=42001f;level-asymmetry-allowed=1"}},
+            {103, Codec{.index = 10, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = "profile-level-id=42001f;level-asymmetry-allowed=1"}},
             {104, Codec{.index = 11, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=103"}},
-            { 99, Codec{.index = 12, .name = "AV1",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = {}}},
+            { 99, Codec{.index = 12, .name = "AV1",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc,    .format = {}}},
             {100, Codec{.index = 13, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=99"}},
-            {123, Codec{.index = 14, .name = "ulpfec", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault}},
-            {122, Codec{.index = 15, .name = "red",  .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault}},
+            {123, Codec{.index = 14, .name = "ulpfec", .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc}},
+            {122, Codec{.index = 15, .name = "red",  .clock_rate = 90000, .rtcp_fb = kRtcpFbTwcc}},
             {119, Codec{.index = 16, .name = "rtx",  .clock_rate = 90000, .rtcp_fb = 0,              .format = "apt=122"}}
         }),
-        .ssrc = 1713748556
+        .ssrc = 1713748556,
+        .twcc_extension_id = 7,
+        .rtx_ssrc = 1485109840
     });
     const auto parsed_sdp = ParseSdp(kWebrtcFirefoxSdpExample);
     ASSERT_NE(nullptr, parsed_sdp);
     ASSERT_NO_FATAL_FAILURE(AssertSdp(target_sdp, *parsed_sdp));
 }
 
+TEST_F(ReaderTest, WebrtcChromeSimulcast) {
+    ASSERT_TRUE(Reader::Validate(kWebrtcChromeSimulcastSdpExample));
+
+    const auto parsed_sdp = ParseSdp(kWebrtcChromeSimulcastSdpExample);
+    ASSERT_NE(nullptr, parsed_sdp);
+    ASSERT_EQ(1, parsed_sdp->medias.size());
+    const auto& media = parsed_sdp->medias[0];
+    ASSERT_EQ(Direction::kSend, media.direction);
+    ASSERT_FALSE(media.ssrc.has_value());
+    ASSERT_EQ(3, media.twcc_extension_id);
+    ASSERT_EQ(4, media.mid_extension_id);
+    ASSERT_EQ(10, media.rid_extension_id);
+    ASSERT_EQ(11, media.repaired_rid_extension_id);
+
+    // a=simulcast order, the first alternative, paused stream is kept
+    ASSERT_TRUE(media.simulcast.has_value());
+    ASSERT_EQ(Direction::kSend, media.simulcast->direction);
+    ASSERT_EQ(3, media.simulcast->rids.size());
+    ASSERT_EQ("f", media.simulcast->rids[0]);
+    ASSERT_EQ("h", media.simulcast->rids[1]);
+    ASSERT_EQ("q", media.simulcast->rids[2]);
+    ASSERT_EQ(1, GetSimulcastLayer(media, "h"));
+    ASSERT_FALSE(GetSimulcastLayer(media, "h2").has_value());
+}
+
+TEST_F(ReaderTest, WebrtcChromeSimulcastLongRid) {
+    const std::string kLongRid(Rid::MAX_SIZE + 1, 'x');
+    std::string sdp{kWebrtcChromeSimulcastSdpExample};
+    sdp.replace(sdp.find("a=rid:q send"), 0, "a=rid:" + kLongRid + " send\n");
+    sdp.replace(sdp.find("f;h,h2;~q"), 0, kLongRid + ";");
+
+    const auto parsed_sdp = ParseSdp(etl::string_view{sdp.data(), sdp.size()});
+    ASSERT_NE(nullptr, parsed_sdp);
+    const auto& media = parsed_sdp->medias[0];
+    ASSERT_TRUE(media.simulcast.has_value());
+    ASSERT_EQ(3, media.simulcast->rids.size()); // the long rid is skipped
+    ASSERT_EQ("f", media.simulcast->rids[0]);
+    ASSERT_EQ("h", media.simulcast->rids[1]);
+    ASSERT_EQ("q", media.simulcast->rids[2]);
+}
+
 TEST_F(ReaderTest, SizeOf) {
-    ASSERT_EQ(20832, sizeof(Sdp));
-    ASSERT_EQ(20064, sizeof(Medias));
-    ASSERT_EQ(6608, sizeof(CodecsMap));
+    ASSERT_EQ(22272, sizeof(Sdp));
+    ASSERT_EQ(21504, sizeof(Medias));
+    ASSERT_EQ(6800, sizeof(CodecsMap));
 }
 
 }
@@ -36,6 +36,9 @@ protected:
         } else {
             ASSERT_FALSE(actual.ssrc.has_value());
         }
+        ASSERT_EQ(target.twcc_extension_id, actual.twcc_extension_id);
+        ASSERT_EQ(target.rtx_ssrc, actual.rtx_ssrc);
+        ASSERT_EQ(target.fec_ssrc, actual.fec_ssrc);
     }
 
     static void AssertCodec(const Codec& target, const Codec& actual) {
@@ -44,6 +47,7 @@ protected:
         ASSERT_EQ(target.clock_rate, actual.clock_rate);
         ASSERT_EQ(target.rtcp_fb,    actual.rtcp_fb);
         ASSERT_EQ(target.format,     actual.format);
+        ASSERT_EQ(target.rtx_pt,     actual.rtx_pt);
     }
 
     static void AssertIce(const std::optional<Ice>& target, const std::optional<Ice>& actual) {
@@ -668,4 +668,44 @@ a=ssrc:1485109840 cname:{0081d7d9-16d1-465e-9c6f-a3f8e4832efb}
 a=ssrc-group:FID 1713748556 1485109840
 )";
 
+inline constexpr etl::string_view kWebrtcChromeSimulcastSdpExample = R"(v=0
+o=- 3021546213545456789 2 IN IP4 127.0.0.1
+s=-
+t=0 0
+a=group:BUNDLE 0
+a=extmap-allow-mixed
+a=msid-semantic: WMS
+m=video 9 UDP/TLS/RTP/SAVPF 96 97
+c=IN IP4 0.0.0.0
+a=rtcp:9 IN IP4 0.0.0.0
+a=ice-ufrag:Zq3o
+a=ice-pwd:nS0fi2cd1H4FbL3aPw0W7Zvj
+a=ice-options:trickle
+a=fingerprint:sha-256 6B:E1:D7:60:D1:71:54:F5:54:95:95:09:28:E3:DF:FD:83:12:71:EA:D6:0C:D8:C2:2E:F8:CB:1C:F7:55:E1:6B
+a=setup:actpass
+a=mid:0
+a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+a=extmap:4 urn:ietf:params:rtp-hdrext:sdes:mid
+a=extmap:10 urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id
+a=extmap:11 urn:ietf:params:rtp-hdrext:sdes:repaired-rtp-stream-id
+a=sendonly
+a=msid:- 9e54933d-0d0c-423e-ad8b-e94a8b80752c
+a=rtcp-mux
+a=rtcp-rsize
+a=rtpmap:96 H264/90000
+a=rtcp-fb:96 goog-remb
+a=rtcp-fb:96 transport-cc
+a=rtcp-fb:96 ccm fir
+a=rtcp-fb:96 nack
+a=rtcp-fb:96 nack pli
+a=fmtp:96 level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f
+a=rtpmap:97 rtx/90000
+a=fmtp:97 apt=96
+a=rid:q send
+a=rid:h send
+a=rid:f send pt=96;max-width=1920;max-height=1080
+a=simulcast:send f;h,h2;~q
+)";
+
 }
+
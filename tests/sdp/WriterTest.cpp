@@ -38,11 +38,12 @@ TEST_F(WriterTest, Basic) {
         .mid = "video",
         .direction = Direction::kSendRecv,
         .codecs = MakeCodecsMap({
-            {96, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=4d001f"}},
+            {96, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault | RtcpFb::kTwcc, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=4d001f"}},
             {97, Codec{.index = 1, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42001f"}},
             {98, Codec{.index = 2, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f"}},
         }),
-        .ssrc = 0x9ABCDEF0
+        .ssrc = 0x9ABCDEF0,
+        .twcc_extension_id = 5
     });
     sdp.medias.push_back(Media{
         .type = MediaType::kApplication,
@@ -59,6 +60,118 @@ TEST_F(WriterTest, Basic) {
     ASSERT_NO_FATAL_FAILURE(AssertSdp(sdp, *parsed_sdp));
 }
 
+TEST_F(WriterTest, Rtx) {
+    Sdp sdp{
+        .cname = "rand0m-cNaMe",
+        .bundle_mids = MakeBundleMids({"video"}),
+        .ice = std::nullopt,
+        .dtls = std::nullopt,
+        .medias = {}
+    };
+    sdp.medias.push_back(Media{
+        .type = MediaType::kVideo,
+        .mid = "video",
+        .direction = Direction::kSendRecv,
+        .codecs = MakeCodecsMap({
+            {96, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "packetization-mode=1", .rtx_pt = 97}},
+        }),
+        .ssrc = 0x9ABCDEF0,
+        .rtx_ssrc = 0x12345678
+    });
+    etl::string<8192> sdp_string;
+    WriteSdp(sdp_string, sdp);
+    TAU_LOG_INFO("Output sdp:\n" << sdp_string);
+    ASSERT_TRUE(Reader::Validate(sdp_string));
+
+    // rtx codec is parsed as is
+    auto& media = sdp.medias.back();
+    media.codecs.at(96).rtx_pt.reset();
+    media.codecs[97] = Codec{.index = 1, .name = "rtx", .clock_rate = 90000, .rtcp_fb = 0, .format = "apt=96"};
+    const auto parsed_sdp = ParseSdp(sdp_string);
+    ASSERT_NE(nullptr, parsed_sdp);
+    ASSERT_NO_FATAL_FAILURE(AssertSdp(sdp, *parsed_sdp));
+    ASSERT_EQ(97, GetRtxPt(parsed_sdp->medias.back().codecs, 96));
+    ASSERT_FALSE(GetRtxPt(parsed_sdp->medias.back().codecs, 97).has_value());
+}
+
+TEST_F(WriterTest, Fec) {
+    Sdp sdp{
+        .cname = "rand0m-cNaMe",
+        .bundle_mids = MakeBundleMids({"video"}),
+        .ice = std::nullopt,
+        .dtls = std::nullopt,
+        .medias = {}
+    };
+    sdp.medias.push_back(Media{
+        .type = MediaType::kVideo,
+        .mid = "video",
+        .direction = Direction::kSendRecv,
+        .codecs = MakeCodecsMap({
+            {96, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "packetization-mode=1", .rtx_pt = 97}},
+        }),
+        .ssrc = 0x9ABCDEF0,
+        .rtx_ssrc = 0x12345678,
+        .fec_pt = 49,
+        .fec_ssrc = 0x11223344
+    });
+    etl::string<8192> sdp_string;
+    WriteSdp(sdp_string, sdp);
+    TAU_LOG_INFO("Output sdp:\n" << sdp_string);
+    ASSERT_TRUE(Reader::Validate(sdp_string));
+    ASSERT_NE(etl::string_view::npos, etl::string_view{sdp_string}.find("a=rtpmap:49 flexfec-03/90000"));
+    ASSERT_NE(etl::string_view::npos, etl::string_view{sdp_string}.find("a=ssrc-group:FEC-FR 2596069104 287454020"));
+
+    // flexfec codec is parsed as is
+    auto& media = sdp.medias.back();
+    media.codecs.at(96).rtx_pt.reset();
+    media.codecs[97] = Codec{.index = 1, .name = "rtx", .clock_rate = 90000, .rtcp_fb = 0, .format = "apt=96"};
+    media.codecs[49] = Codec{.index = 2, .name = "flexfec-03", .clock_rate = 90000, .rtcp_fb = 0, .format = "repair-window=10000000"};
+    const auto parsed_sdp = ParseSdp(sdp_string);
+    ASSERT_NE(nullptr, parsed_sdp);
+    ASSERT_NO_FATAL_FAILURE(AssertSdp(sdp, *parsed_sdp));
+    ASSERT_EQ(49, GetFecPt(parsed_sdp->medias.back()));
+}
+
+TEST_F(WriterTest, Simulcast) {
+    Sdp sdp{
+        .cname = "rand0m-cNaMe",
+        .bundle_mids = MakeBundleMids({"video"}),
+        .ice = std::nullopt,
+        .dtls = std::nullopt,
+        .medias = {}
+    };
+    sdp.medias.push_back(Media{
+        .type = MediaType::kVideo,
+        .mid = "video",
+        .direction = Direction::kRecv,
+        .codecs = MakeCodecsMap({
+            {96, Codec{.index = 0, .name = "H264", .clock_rate = 90000, .rtcp_fb = kRtcpFbDefault, .format = "packetization-mode=1"}},
+        }),
+        .ssrc = 0x9ABCDEF0,
+        .mid_extension_id = 4,
+        .rid_extension_id = 10,
+        .repaired_rid_extension_id = 11,
+        .simulcast = Simulcast{.direction = Direction::kRecv, .rids = {"f", "h", "q"}}
+    });
+    etl::string<8192> sdp_string;
+    WriteSdp(sdp_string, sdp);
+    TAU_LOG_INFO("Output sdp:\n" << sdp_string);
+    ASSERT_TRUE(Reader::Validate(sdp_string));
+    ASSERT_NE(etl::string_view::npos, etl::string_view{sdp_string}.find("a=simulcast:recv f;h;q"));
+
+    const auto parsed_sdp = ParseSdp(sdp_string);
+    ASSERT_NE(nullptr, parsed_sdp);
+    ASSERT_NO_FATAL_FAILURE(AssertSdp(sdp, *parsed_sdp));
+    const auto& media = parsed_sdp->medias.back();
+    ASSERT_EQ(4, media.mid_extension_id);
+    ASSERT_EQ(10, media.rid_extension_id);
+    ASSERT_EQ(11, media.repaired_rid_extension_id);
+    ASSERT_TRUE(media.simulcast.has_value());
+    ASSERT_EQ(Direction::kRecv, media.simulcast->direction);
+    ASSERT_EQ(3, media.simulcast->rids.size());
+    ASSERT_EQ("q", media.simulcast->rids[2]);
+}
+
 TEST_F(WriterTest, EndOfLine) {
     Sdp sdp{
         .cname = "rand0m-cNaMe",
@@ -2,6 +2,7 @@
 #include "tau/srtp/Common.h"
 #include "tau/crypto/Random.h"
 #include "tau/rtp/Writer.h"
+#include "tau/rtp/Frame.h"
 #include "tau/rtcp/SrWriter.h"
 #include "tests/lib/Common.h"
 
@@ -64,7 +65,10 @@ public:
     }
 
     Buffer CreateRtpPacket() {
-        auto size = g_random.Int<size_t>(12, 1200);
+        return CreateRtpPacket(g_random.Int<size_t>(12, 1200));
+    }
+
+    Buffer CreateRtpPacket(size_t size) {
         auto packet = Buffer::Create(g_udp_allocator);
         packet.SetSize(size);
 
@@ -180,6 +184,85 @@ TEST_P(SessionTest, Rtcp) {
     ASSERT_NO_FATAL_FAILURE(AssertPackets(packet, _encrypted[0], _decrypted[0]));
 }
 
+TEST_P(SessionTest, Batch) {
+    constexpr size_t kPacketsCount = 10;
+    rtp::Frame originals;
+    rtp::Frame frame;
+    for(size_t i = 0; i < kPacketsCount; ++i) {
+        originals.push_back(CreateRtpPacket());
+        frame.push_back(originals.back().MakeCopy());
+    }
+    auto broken = Buffer::Create(g_udp_allocator);
+    broken.SetSize(4);
+    frame.insert(frame.begin() + 5, std::move(broken));
+
+    ASSERT_EQ(kPacketsCount, _encryptor->EncryptBatch(frame));
+    ASSERT_EQ(kPacketsCount, _encrypted.size());
+
+    size_t batches = 0;
+    _decryptor->SetBatchCallback([&](std::span<Buffer> packets, bool is_rtp) {
+        ASSERT_TRUE(is_rtp);
+        ASSERT_EQ(kPacketsCount, packets.size());
+        for(auto& packet : packets) {
+            _decrypted.push_back(std::move(packet));
+        }
+        batches++;
+    });
+    ASSERT_EQ(kPacketsCount, _decryptor->DecryptBatch(_encrypted));
+    ASSERT_EQ(1, batches);
+    ASSERT_EQ(kPacketsCount, _decrypted.size());
+    for(size_t i = 0; i < kPacketsCount; ++i) {
+        ASSERT_EQ(originals[i].GetSize(), _decrypted[i].GetSize());
+        ASSERT_EQ(0, std::memcmp(originals[i].GetView().ptr, _decrypted[i].GetView().ptr, originals[i].GetSize()));
+    }
+}
+
+TEST_P(SessionTest, DISABLED_MANUAL_Benchmark) {
+    constexpr size_t kPacketsCount = 5'000;
+    SteadyClock clock;
+
+    std::vector<Buffer> packets;
+    std::vector<Buffer> encrypted;
+    packets.reserve(kPacketsCount);
+    encrypted.reserve(kPacketsCount);
+    size_t decrypted_count = 0;
+    _encryptor->SetCallback([&](Buffer&& packet, bool) {
+        encrypted.push_back(std::move(packet));
+    });
+    _decryptor->SetCallback([&](Buffer&&, bool) {
+        decrypted_count++;
+    });
+
+    for(size_t packet_size : {200, 500, 1200}) {
+        for(size_t i = 0; i < kPacketsCount; ++i) {
+            packets.push_back(CreateRtpPacket(packet_size));
+        }
+
+        const auto encrypt_begin = clock.Now();
+        for(auto& packet : packets) {
+            ASSERT_TRUE(_encryptor->Encrypt(std::move(packet)));
+        }
+        const auto encrypt_sec = DurationSec(encrypt_begin, clock.Now());
+
+        const auto decrypt_begin = clock.Now();
+        for(auto& packet : encrypted) {
+            ASSERT_TRUE(_decryptor->Decrypt(std::move(packet)));
+        }
+        const auto decrypt_sec = DurationSec(decrypt_begin, clock.Now());
+        ASSERT_EQ(kPacketsCount, encrypted.size());
+        ASSERT_EQ(kPacketsCount, decrypted_count);
+
+        const auto megabits = 8.0 * kPacketsCount * packet_size / 1e6;
+        TAU_LOG_INFO("Profile: " << static_cast<int>(GetParam().profile) << ", packet size: " << packet_size
+            << ", encrypt: " << static_cast<size_t>(megabits / encrypt_sec) << " Mbps"
+            << ", decrypt: " << static_cast<size_t>(megabits / decrypt_sec) << " Mbps");
+
+        packets.clear();
+        encrypted.clear();
+        decrypted_count = 0;
+    }
+}
+
 TEST(SessionTest, WrongProfile) {
     Session session(Session::Options{
         .type = Session::Type::kEncryptor,
@@ -0,0 +1,118 @@
+#include "tau/stun/BindingResponder.h"
+#include "tau/stun/Reader.h"
+#include "tau/stun/Writer.h"
+#include "tau/stun/attribute/XorMappedAddress.h"
+#include "tau/stun/attribute/ByteString.h"
+#include "tau/stun/attribute/Fingerprint.h"
+#include "tests/lib/Common.h"
+
+namespace tau::stun {
+
+using namespace tau::stun::attribute;
+
+class BindingResponderTest : public ::testing::Test {
+public:
+    static constexpr uint32_t kAddress = 0xC0A80102;
+    static constexpr uint16_t kPort = 54321;
+    static constexpr etl::string_view kSoftware = "test software";
+
+protected:
+    Buffer CreateRequest(uint16_t type = kBindingRequest) {
+        auto request = Buffer::Create(g_system_allocator, kUdpMtuSize);
+        Writer writer(request.GetViewWithCapacity(), type);
+        GenerateTransactionId(request.GetViewWithCapacity().ptr + 2 * sizeof(uint32_t));
+        FingerprintWriter::Write(writer);
+        request.SetSize(writer.GetSize());
+        return request;
+    }
+
+    // the same response by attribute writers
+    Buffer CreateTargetResponse(const Buffer& request) {
+        auto response = Buffer::Create(g_system_allocator, kUdpMtuSize);
+        Writer writer(response.GetViewWithCapacity(), kBindingResponse);
+        std::memcpy(response.GetViewWithCapacity().ptr + 2 * sizeof(uint32_t), request.GetView().ptr + 2 * sizeof(uint32_t), kTransactionIdSize);
+        XorMappedAddressWriter::Write(writer, AttributeType::kXorMappedAddress, kAddress, kPort);
+        ByteStringWriter::Write(writer, AttributeType::kSoftware, kSoftware);
+        FingerprintWriter::Write(writer);
+        response.SetSize(writer.GetSize());
+        return response;
+    }
+
+protected:
+    BindingResponder _responder{BindingResponder::Options{.software = kSoftware}};
+};
+
+TEST_F(BindingResponderTest, Basic) {
+    for(size_t i = 0; i < 10; ++i) {
+        auto request = CreateRequest();
+        auto response = Buffer::Create(g_system_allocator, kUdpMtuSize);
+        const auto size = _responder.Process(ToConst(request.GetView()), kAddress, kPort, response.GetViewWithCapacity());
+        ASSERT_EQ(_responder.GetResponseSize(), size);
+        response.SetSize(size);
+
+        const auto view = ToConst(response.GetView());
+        ASSERT_TRUE(Reader::Validate(view));
+        ASSERT_EQ(kBindingResponse, HeaderReader::GetType(view));
+        ASSERT_EQ(HeaderReader::GetTransactionIdHash(ToConst(request.GetView())), HeaderReader::GetTransactionIdHash(view));
+        size_t attributes = 0;
+        ASSERT_TRUE(Reader::ForEachAttribute(view, [&](AttributeType type, const BufferViewConst& attr) {
+            attributes++;
+            switch(type) {
+                case AttributeType::kXorMappedAddress:
+                    EXPECT_EQ(kAddress, XorMappedAddressReader::GetAddressV4(attr));
+                    EXPECT_EQ(kPort, XorMappedAddressReader::GetPort(attr));
+                    break;
+                case AttributeType::kSoftware:
+                    EXPECT_EQ(kSoftware, ByteStringReader::GetValue(attr));
+                    break;
+                default:
+                    break;
+            }
+            return true;
+        }));
+        ASSERT_EQ(3, attributes);
+
+        const auto target = CreateTargetResponse(request);
+        ASSERT_EQ(target.GetSize(), response.GetSize());
+        ASSERT_EQ(0, std::memcmp(target.GetView().ptr, response.GetView().ptr, target.GetSize()));
+    }
+}
+
+TEST_F(BindingResponderTest, InPlace) {
+    auto request = CreateRequest();
+    const auto target = CreateTargetResponse(request);
+    const auto size = _responder.Process(ToConst(request.GetView()), kAddress, kPort, request.GetViewWithCapacity());
+    ASSERT_EQ(target.GetSize(), size);
+    ASSERT_EQ(0, std::memcmp(target.GetView().ptr, request.GetView().ptr, size));
+}
+
+TEST_F(BindingResponderTest, Invalid) {
+    std::array<uint8_t, BindingResponder::kMaxResponseSize> output;
+    const auto output_view = BufferView{.ptr = output.data(), .size = output.size()};
+
+    auto response = CreateRequest(kBindingResponse);
+    ASSERT_EQ(0, _responder.Process(ToConst(response.GetView()), kAddress, kPort, output_view));
+
+    auto request = CreateRequest();
+    request.GetView().ptr[request.GetSize() - 1] ^= 0x01; // wrong fingerprint
+    ASSERT_EQ(0, _responder.Process(ToConst(request.GetView()), kAddress, kPort, output_view));
+
+    request = CreateRequest();
+    ASSERT_EQ(0, _responder.Process(BufferViewConst{.ptr = request.GetView().ptr, .size = kMessageHeaderSize - 4}, kAddress, kPort, output_view));
+    ASSERT_EQ(0, _responder.Process(ToConst(request.GetView()), kAddress, kPort, BufferView{.ptr = output.data(), .size = 20}));
+    ASSERT_LT(0, _responder.Process(ToConst(request.GetView()), kAddress, kPort, output_view));
+}
+
+TEST_F(BindingResponderTest, LongSoftware) {
+    const std::string software(200, 'x');
+    BindingResponder responder(BindingResponder::Options{.software = etl::string_view{software.data(), software.size()}});
+    ASSERT_EQ(BindingResponder::kMaxResponseSize, responder.GetResponseSize());
+
+    auto request = CreateRequest();
+    std::array<uint8_t, BindingResponder::kMaxResponseSize> output;
+    const auto size = responder.Process(ToConst(request.GetView()), kAddress, kPort, BufferView{.ptr = output.data(), .size = output.size()});
+    ASSERT_EQ(BindingResponder::kMaxResponseSize, size);
+    ASSERT_TRUE(Reader::Validate(BufferViewConst{.ptr = output.data(), .size = size}));
+}
+
+}
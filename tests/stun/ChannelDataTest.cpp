@@ -0,0 +1,46 @@
+#include "tau/stun/ChannelData.h"
+#include "tau/stun/Writer.h"
+#include "tests/lib/Common.h"
+
+namespace tau::stun {
+
+TEST(ChannelDataTest, Basic) {
+    auto packet = Buffer::Create(g_system_allocator, kUdpMtuSize);
+    const std::string payload = "payload!!";
+    auto view = packet.GetViewWithCapacity();
+    ChannelDataWriter::WriteHeader(view, 0x4001, payload.size());
+    std::memcpy(view.ptr + kChannelDataHeaderSize, payload.data(), payload.size());
+    packet.SetSize(kChannelDataHeaderSize + payload.size());
+
+    const auto message = ToConst(packet.GetView());
+    ASSERT_TRUE(ChannelDataReader::IsChannelData(message));
+    ASSERT_TRUE(ChannelDataReader::Validate(message));
+    ASSERT_EQ(0x4001, ChannelDataReader::GetChannelNumber(message));
+    const auto data = ChannelDataReader::GetData(message);
+    ASSERT_EQ(payload.size(), data.size);
+    ASSERT_EQ(0, std::memcmp(payload.data(), data.ptr, data.size));
+
+    packet.SetSize(kChannelDataHeaderSize + Align(payload.size(), sizeof(uint32_t))); // padded
+    ASSERT_TRUE(ChannelDataReader::Validate(ToConst(packet.GetView())));
+    packet.SetSize(kChannelDataHeaderSize + payload.size() - 1);
+    ASSERT_FALSE(ChannelDataReader::Validate(ToConst(packet.GetView())));
+}
+
+TEST(ChannelDataTest, Demux) {
+    auto packet = Buffer::Create(g_system_allocator, kUdpMtuSize);
+    Writer writer(packet.GetViewWithCapacity(), kDataIndication);
+    packet.SetSize(writer.GetSize());
+    ASSERT_FALSE(ChannelDataReader::IsChannelData(ToConst(packet.GetView())));
+    ASSERT_FALSE(ChannelDataReader::IsChannelData(BufferViewConst{.ptr = packet.GetView().ptr, .size = 0}));
+
+    ChannelDataWriter::WriteHeader(packet.GetViewWithCapacity(), kChannelNumberMax + 1, 0);
+    packet.SetSize(kChannelDataHeaderSize);
+    ASSERT_TRUE(ChannelDataReader::IsChannelData(ToConst(packet.GetView())));
+    ASSERT_FALSE(ChannelDataReader::Validate(ToConst(packet.GetView()))); // reserved range
+
+    ASSERT_TRUE(IsChannelNumberValid(kChannelNumberMin));
+    ASSERT_TRUE(IsChannelNumberValid(kChannelNumberMax));
+    ASSERT_FALSE(IsChannelNumberValid(kChannelNumberMin - 1));
+}
+
+}
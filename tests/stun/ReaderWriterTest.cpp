@@ -9,6 +9,7 @@
 #include "tau/stun/attribute/Data.h"
 #include "tau/stun/attribute/MessageIntegrity.h"
 #include "tau/stun/attribute/Fingerprint.h"
+#include "tau/stun/attribute/ErrorCode.h"
 #include "tests/lib/Common.h"
 
 namespace tau::stun {
@@ -187,4 +188,30 @@ TEST_F(StunReaderWriterTest, Wireshark_Request) {
     ASSERT_EQ(target_attributes, attributes);
 }
 
+TEST_F(StunReaderWriterTest, ErrorCode) {
+    Writer writer(_packet.GetViewWithCapacity(), kAllocateErrorResponse);
+    ASSERT_TRUE(ErrorCodeWriter::Write(writer, ErrorCode::kUnauthorized, "Unauthorized"));
+    ASSERT_EQ(kMessageHeaderSize + kAttributeHeaderSize + sizeof(uint32_t) + Align(12, sizeof(uint32_t)), writer.GetSize());
+    ASSERT_TRUE(ErrorCodeWriter::Write(writer, ErrorCode::kStaleNonce));
+    _packet.SetSize(writer.GetSize());
+
+    const auto view = ToConst(_packet.GetView());
+    ASSERT_TRUE(Reader::Validate(view));
+    std::vector<std::pair<uint16_t, std::string>> errors;
+    ASSERT_TRUE(Reader::ForEachAttribute(view, [&](AttributeType type, const BufferViewConst& attr) {
+        EXPECT_EQ(AttributeType::kErrorCode, type);
+        const auto reason = ErrorCodeReader::GetReason(attr);
+        errors.emplace_back(ErrorCodeReader::GetCode(attr), std::string{reason.data(), reason.size()});
+        return true;
+    }));
+    ASSERT_EQ(2, errors.size());
+    ASSERT_EQ(401, errors[0].first);
+    ASSERT_EQ("Unauthorized", errors[0].second);
+    ASSERT_EQ(438, errors[1].first);
+    ASSERT_EQ("", errors[1].second);
+
+    _packet.GetView().ptr[kMessageHeaderSize + kAttributeHeaderSize + 2] = 0x07; // wrong class
+    ASSERT_FALSE(Reader::Validate(ToConst(_packet.GetView())));
+}
+
 }
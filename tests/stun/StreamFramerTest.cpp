@@ -0,0 +1,46 @@
+#include "tau/stun/StreamFramer.h"
+#include "tau/stun/ChannelData.h"
+#include "tau/stun/Header.h"
+#include "tau/stun/Writer.h"
+#include "tests/lib/Common.h"
+
+namespace tau::stun {
+
+TEST(StreamFramerTest, Stun) {
+    auto packet = Buffer::Create(g_system_allocator, kUdpMtuSize);
+    Writer writer(packet.GetViewWithCapacity(), kBindingRequest);
+    packet.SetSize(writer.GetSize());
+    ASSERT_EQ(kMessageHeaderSize, packet.GetSize());
+
+    const auto message = ToConst(packet.GetView());
+    ASSERT_EQ(kMessageHeaderSize, StreamFramer::GetFrameSize(message));
+    ASSERT_EQ(kMessageHeaderSize, StreamFramer::GetFrameSize(BufferViewConst{.ptr = message.ptr, .size = StreamFramer::kHeaderSize}));
+    ASSERT_EQ(0, StreamFramer::GetFrameSize(BufferViewConst{.ptr = message.ptr, .size = StreamFramer::kHeaderSize - 1}));
+
+    packet.GetView().ptr[3] = 2; // STUN length must be multiple of 4
+    ASSERT_EQ(0, StreamFramer::GetFrameSize(ToConst(packet.GetView())));
+    packet.GetView().ptr[3] = 8;
+    ASSERT_EQ(kMessageHeaderSize + 8, StreamFramer::GetFrameSize(ToConst(packet.GetView())));
+}
+
+TEST(StreamFramerTest, ChannelData) {
+    auto packet = Buffer::Create(g_system_allocator, kUdpMtuSize);
+    for(size_t length = 0; length < 16; ++length) {
+        ChannelDataWriter::WriteHeader(packet.GetViewWithCapacity(), kChannelNumberMin, length);
+        packet.SetSize(kChannelDataHeaderSize);
+        const auto frame_size = StreamFramer::GetFrameSize(ToConst(packet.GetView()));
+        ASSERT_EQ(0, frame_size % sizeof(uint32_t));
+        ASSERT_LE(kChannelDataHeaderSize + length, frame_size);
+        ASSERT_GT(kChannelDataHeaderSize + length + sizeof(uint32_t), frame_size);
+        ASSERT_EQ(frame_size, kChannelDataHeaderSize + length + StreamFramer::GetChannelDataPadding(kChannelDataHeaderSize + length));
+    }
+}
+
+TEST(StreamFramerTest, Invalid) {
+    const uint8_t data[] = {0x80, 0x00, 0x00, 0x00};
+    ASSERT_EQ(0, StreamFramer::GetFrameSize(BufferViewConst{.ptr = data, .size = sizeof(data)}));
+    const uint8_t data2[] = {0xC0, 0x00, 0x00, 0x00};
+    ASSERT_EQ(0, StreamFramer::GetFrameSize(BufferViewConst{.ptr = data2, .size = sizeof(data2)}));
+}
+
+}
@@ -15,6 +15,7 @@ public:
         sdp::Direction audio = sdp::Direction::kSendRecv;
         sdp::Direction video = sdp::Direction::kSendRecv;
         std::optional<double> loss_rate = std::nullopt;
+        std::optional<uint8_t> fec_pt = std::nullopt;
         etl::string<16> log_ctx;
     };
 
@@ -137,7 +138,8 @@ public:
                         {103, sdp::Codec{.index = 3, .name = "H264", .clock_rate = 90000, .rtcp_fb = sdp::kRtcpFbDefault,
                             .format = "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f"}},
                     },
-                    .ssrc = std::nullopt
+                    .ssrc = std::nullopt,
+                    .fec_pt = options.fec_pt
                 }
             },
             .ice = {
@@ -0,0 +1,127 @@
+#include "tau/webrtc/MediaDemuxer.h"
+#include "tau/rtp/Extension.h"
+#include "tau/rtp/Writer.h"
+#include "tests/lib/Common.h"
+
+namespace tau::webrtc {
+
+class MediaDemuxerTest : public ::testing::Test {
+public:
+    static constexpr uint8_t kMidExtensionId = 4;
+    static constexpr uint8_t kRidExtensionId = 10;
+    static constexpr uint8_t kRepairedRidExtensionId = 11;
+    static constexpr uint32_t kAudioSsrc = 0x11110000;
+
+public:
+    MediaDemuxerTest() {
+        sdp::Media audio{
+            .type = sdp::MediaType::kAudio,
+            .mid = "0",
+            .direction = sdp::Direction::kRecv,
+            .mid_extension_id = kMidExtensionId
+        };
+        sdp::Media video{
+            .type = sdp::MediaType::kVideo,
+            .mid = "1",
+            .direction = sdp::Direction::kRecv,
+            .mid_extension_id = kMidExtensionId,
+            .rid_extension_id = kRidExtensionId,
+            .repaired_rid_extension_id = kRepairedRidExtensionId,
+            .simulcast = sdp::Simulcast{.direction = sdp::Direction::kRecv, .rids = {"f", "h", "q"}}
+        };
+        _local_sdp.medias.push_back(audio);
+        _local_sdp.medias.push_back(video);
+        audio.ssrc = kAudioSsrc;
+        _remote_sdp.medias.push_back(audio);
+        _remote_sdp.medias.push_back(video);
+
+        _demuxer.emplace(MediaDemuxer::Options{.local_sdp = _local_sdp, .remote_sdp = _remote_sdp});
+        _demuxer->SetCallback([this](size_t idx, size_t layer, Buffer&&, bool is_rtp) {
+            ASSERT_TRUE(is_rtp);
+            _received.push_back(Received{.idx = idx, .layer = layer});
+        });
+    }
+
+protected:
+    struct Received {
+        size_t idx;
+        size_t layer;
+    };
+
+    static Buffer CreatePacket(uint32_t ssrc, etl::string_view mid = {}, etl::string_view rid = {}, bool repaired = false) {
+        auto packet = Buffer::Create(g_udp_allocator);
+        const auto result = rtp::Writer::Write(packet.GetViewWithCapacity(), rtp::Writer::Options{
+            .pt = 96,
+            .ssrc = ssrc,
+            .ts = g_random.Int<uint32_t>(),
+            .sn = g_random.Int<uint16_t>(),
+            .marker = false
+        });
+        packet.SetSize(result.size + 100);
+        if(!mid.empty()) {
+            EXPECT_TRUE(rtp::ExtensionWriter::Set(packet, kMidExtensionId, ToView(mid)));
+        }
+        if(!rid.empty()) {
+            EXPECT_TRUE(rtp::ExtensionWriter::Set(packet, repaired ? kRepairedRidExtensionId : kRidExtensionId, ToView(rid)));
+        }
+        return packet;
+    }
+
+    static BufferViewConst ToView(etl::string_view str) {
+        return BufferViewConst{.ptr = reinterpret_cast<const uint8_t*>(str.data()), .size = str.size()};
+    }
+
+    void AssertReceived(size_t idx, size_t layer) {
+        ASSERT_FALSE(_received.empty());
+        ASSERT_EQ(idx, _received.back().idx);
+        ASSERT_EQ(layer, _received.back().layer);
+        _received.clear();
+    }
+
+protected:
+    sdp::Sdp _local_sdp;
+    sdp::Sdp _remote_sdp;
+    std::optional<MediaDemuxer> _demuxer;
+    std::vector<Received> _received;
+};
+
+TEST_F(MediaDemuxerTest, SdpSsrc) {
+    _demuxer->Process(CreatePacket(kAudioSsrc), true);
+    ASSERT_NO_FATAL_FAILURE(AssertReceived(0, 0));
+}
+
+TEST_F(MediaDemuxerTest, Simulcast) {
+    const etl::string_view rids[] = {"f", "h", "q"};
+    for(size_t layer = 0; layer < 3; ++layer) {
+        const auto ssrc = 0x22220000 + layer;
+        const auto rtx_ssrc = 0x33330000 + layer;
+        _demuxer->Process(CreatePacket(ssrc, "1", rids[layer]), true);
+        ASSERT_NO_FATAL_FAILURE(AssertReceived(1, layer));
+        _demuxer->Process(CreatePacket(rtx_ssrc, "1", rids[layer], true), true);
+        ASSERT_NO_FATAL_FAILURE(AssertReceived(1, layer));
+
+        // header extensions are sent by the first packets only
+        _demuxer->Process(CreatePacket(ssrc), true);
+        ASSERT_NO_FATAL_FAILURE(AssertReceived(1, layer));
+        _demuxer->Process(CreatePacket(rtx_ssrc), true);
+        ASSERT_NO_FATAL_FAILURE(AssertReceived(1, layer));
+    }
+
+    // MID only, without RID
+    _demuxer->Process(CreatePacket(0x44440000, "0"), true);
+    ASSERT_NO_FATAL_FAILURE(AssertReceived(0, 0));
+}
+
+TEST_F(MediaDemuxerTest, Unknown) {
+    _demuxer->Process(CreatePacket(0x55550000), true);
+    _demuxer->Process(CreatePacket(0x55550001, "2"), true);
+    _demuxer->Process(CreatePacket(0x55550002, "1"), true);      // simulcast stream without RID
+    _demuxer->Process(CreatePacket(0x55550003, "1", "x"), true); // unknown RID
+    ASSERT_TRUE(_received.empty());
+
+    // isn't learned
+    _demuxer->Process(CreatePacket(0x55550003, "1", "h"), true);
+    ASSERT_NO_FATAL_FAILURE(AssertReceived(1, 1));
+}
+
+}
@@ -0,0 +1,164 @@
+#include "tests/webrtc/ClientContext.h"
+#include "tau/webrtc/UdpMux.h"
+#include "tau/common/TimerWheel.h"
+#include "tests/lib/Common.h"
+
+namespace tau::webrtc {
+
+// Idle connected sessions without media, only ICE/DTLS/RTP timers are left.
+// Answerers share a single UdpMux (server side), every offerer has own one, muxes are received each poll period.
+// Processing of every session each poll period vs timer wheel driven by PeerConnection::GetNextDeadline()
+class PeerConnectionIdleTest : public ::testing::Test {
+public:
+    static constexpr size_t kPairs = 8; // DTLS certificate per session is the setup bottleneck
+    static constexpr Timepoint kPollPeriod = 10 * kMs;
+    static constexpr Timepoint kDuration = 2 * kSec;
+    static inline const IpAddress kLocalHost{net::MakeIpAddressV4("127.0.0.1")};
+
+protected:
+    struct Stats {
+        size_t processed = 0;
+        Timepoint busy = 0;
+    };
+
+    void CreateSessions() {
+        _server_mux.emplace(
+            UdpMux::Dependencies{.clock = _clock, .allocator = g_udp_allocator},
+            UdpMux::Options{.local_address = kLocalHost, .log_ctx = "[server mux] "});
+        _client_muxes.reserve(kPairs);
+        for(size_t i = 0; i < kPairs; ++i) {
+            auto& client_mux = _client_muxes.emplace_back(std::make_unique<UdpMux>(
+                UdpMux::Dependencies{.clock = _clock, .allocator = g_udp_allocator},
+                UdpMux::Options{.local_address = kLocalHost}));
+            _pcs.push_back(CreatePeerConnection(*client_mux));
+            _pcs.push_back(CreatePeerConnection(*_server_mux));
+        }
+        _candidates.resize(_pcs.size());
+        for(size_t i = 0; i < _pcs.size(); ++i) {
+            _pcs[i]->SetIceCandidateCallback([this, i](ice::CandidateStr candidate) {
+                _candidates[i].push_back(std::move(candidate));
+            });
+        }
+
+        for(size_t i = 0; i < _pcs.size(); i += 2) {
+            auto& offerer = *_pcs[i];
+            auto& answerer = *_pcs[i + 1];
+            offerer.CreateSdpOffer();
+            ASSERT_TRUE(answerer.ProcessSdpOffer(offerer.GetLocalSdpStr()));
+            answerer.Start();
+            ASSERT_TRUE(offerer.ProcessSdpAnswer(answerer.GetLocalSdpStr()));
+            offerer.Start();
+        }
+        for(size_t i = 0; i < _pcs.size(); ++i) {
+            auto& remote = *_pcs[i ^ 1];
+            ASSERT_FALSE(_candidates[i].empty());
+            for(auto& candidate : _candidates[i]) {
+                remote.SetRemoteIceCandidate(std::move(candidate));
+            }
+            _pcs[i]->SetIceCandidateCallback([&remote](ice::CandidateStr candidate) {
+                remote.SetRemoteIceCandidate(std::move(candidate));
+            });
+        }
+    }
+
+    std::unique_ptr<PeerConnection> CreatePeerConnection(UdpMux& mux) {
+        auto options = ClientContext::CreateOptions(ClientContext::Options{});
+        options.ice = {}; // no STUN servers and mDNS, the mux endpoint only
+        auto pc = std::make_unique<PeerConnection>(
+            PeerConnection::Dependencies{.clock = _clock, .udp_allocator = g_udp_allocator, .udp_mux = &mux},
+            std::move(options));
+        pc->SetStateCallback([](State) {});
+        pc->SetRecvRtpCallback([](size_t, Buffer&&) {});
+        pc->SetEventCallback([](size_t, Event&&) {});
+        return pc;
+    }
+
+    void ReceiveMuxes() {
+        _server_mux->Receive();
+        for(auto& client_mux : _client_muxes) {
+            client_mux->Receive();
+        }
+    }
+
+    bool IsConnected() const {
+        return std::all_of(_pcs.begin(), _pcs.end(), [](auto& pc) { return pc->GetState() == State::kConnected; });
+    }
+
+    template<typename ProcessCallback>
+    Stats Run(Timepoint duration, ProcessCallback&& process) {
+        Stats stats;
+        const auto end = _clock.Now() + duration;
+        for(auto tick_tp = _clock.Now(); tick_tp < end; tick_tp += kPollPeriod) {
+            const auto begin = _clock.Now();
+            ReceiveMuxes();
+            stats.processed += process(begin);
+            const auto now = _clock.Now();
+            stats.busy += now - begin;
+            if(now < tick_tp + kPollPeriod) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(tick_tp + kPollPeriod - now));
+            }
+        }
+        return stats;
+    }
+
+    Stats RunPolling(Timepoint duration) {
+        return Run(duration, [this](Timepoint) {
+            for(auto& pc : _pcs) {
+                pc->Process();
+            }
+            return _pcs.size();
+        });
+    }
+
+    Stats RunTimerWheel(Timepoint duration) {
+        TimerWheel wheel(_clock.Now());
+        for(size_t i = 0; i < _pcs.size(); ++i) {
+            _pcs[i]->SetWakeupCallback([this, &wheel, i]() { wheel.Schedule(i, _clock.Now()); });
+            wheel.Schedule(i, _pcs[i]->GetNextDeadline().value_or(_clock.Now() + kMin));
+        }
+        auto stats = Run(duration, [&](Timepoint now) {
+            return wheel.Advance(now, [&](TimerWheel::Id id) {
+                auto& pc = *_pcs[id];
+                pc.Process();
+                wheel.Schedule(id, pc.GetNextDeadline().value_or(now + kMin));
+            });
+        });
+        for(auto& pc : _pcs) {
+            pc->SetWakeupCallback({});
+        }
+        return stats;
+    }
+
+protected:
+    SteadyClock _clock;
+    std::optional<UdpMux> _server_mux;
+    std::vector<std::unique_ptr<UdpMux>> _client_muxes;
+    std::vector<std::unique_ptr<PeerConnection>> _pcs; // offerer, answerer, offerer, ...
+    std::vector<std::vector<ice::CandidateStr>> _candidates;
+};
+
+TEST_F(PeerConnectionIdleTest, DISABLED_MANUAL_BenchmarkIdleSessions) {
+    ASSERT_NO_FATAL_FAILURE(CreateSessions());
+    ASSERT_TRUE(WaitForCondition([this]() {
+        ReceiveMuxes();
+        for(auto& pc : _pcs) {
+            pc->Process();
+        }
+        return IsConnected();
+    }, 5 * kSec));
+
+    const auto polling = RunPolling(kDuration);
+    ASSERT_TRUE(IsConnected());
+    const auto wheel = RunTimerWheel(kDuration);
+    ASSERT_TRUE(IsConnected());
+
+    const auto sessions = _pcs.size();
+    const auto duration_sec = DurationSec(kDuration);
+    TAU_LOG_INFO("Idle sessions: " << sessions << ", duration: " << duration_sec << " sec");
+    TAU_LOG_INFO("Polling, processed: " << polling.processed << ", CPU per session: " << (polling.busy / sessions / duration_sec) << " ns/sec");
+    TAU_LOG_INFO("Wheel, processed: " << wheel.processed << ", CPU per session: " << (wheel.busy / sessions / duration_sec) << " ns/sec");
+
+    ASSERT_GT(polling.processed / 10, wheel.processed);
+}
+
+}
@@ -28,4 +28,65 @@ TEST_F(PeerConnectionTest, Basic) {
     ctx.Stop();
 }
 
+TEST_F(PeerConnectionTest, Fec) {
+    CallContext ctx(
+        CreatePcDependencies(),
+        CallContext::Options{
+            .offerer = ClientContext::Options{.fec_pt = 49, .log_ctx = "[offerer] "},
+            .answerer = ClientContext::Options{.fec_pt = 50, .log_ctx = "[answerer] "},
+        });
+    ASSERT_NO_FATAL_FAILURE(ctx.SdpNegotiation());
+    for(auto* pc : {&ctx._pc1.Pc(), &ctx._pc2.Pc()}) {
+        const auto& media = pc->GetLocalSdp().medias.at(kVideoMediaIdx);
+        ASSERT_TRUE(media.fec_ssrc.has_value());
+        ASSERT_NE(std::string::npos, pc->GetLocalSdpStr().find("flexfec-03/90000"));
+    }
+    ASSERT_EQ(49, ctx._pc2.Pc().GetLocalSdp().medias.at(kVideoMediaIdx).fec_pt);
+    ASSERT_NO_FATAL_FAILURE(ctx.ProcessLocalCandidates());
+    ASSERT_NO_FATAL_FAILURE(ctx.ProcessUntilState(State::kConnected));
+
+    for(size_t i = 0; i < 10; ++i) {
+        std::this_thread::sleep_for(1ms);
+        ctx._pc1.PushFrame(kVideoMediaIdx);
+        ctx._pc2.PushFrame(kVideoMediaIdx);
+    }
+    EXPECT_NO_FATAL_FAILURE(ctx.ProcessUntilDone()); // repair packets aren't delivered as media
+    ctx.Stop();
+}
+
+TEST_F(PeerConnectionTest, SimulcastOffer) {
+    PeerConnection pc(
+        PeerConnection::Dependencies{.clock = _clock, .udp_allocator = g_udp_allocator},
+        ClientContext::CreateOptions(ClientContext::Options{}));
+    ASSERT_TRUE(pc.ProcessSdpOffer(sdp::kWebrtcChromeSimulcastSdpExample));
+
+    const auto& media = pc.GetLocalSdp().medias.at(0);
+    ASSERT_EQ(sdp::MediaType::kVideo, media.type);
+    ASSERT_EQ(4, media.mid_extension_id);
+    ASSERT_EQ(10, media.rid_extension_id);
+    ASSERT_EQ(11, media.repaired_rid_extension_id);
+    ASSERT_TRUE(media.simulcast.has_value());
+    ASSERT_EQ(sdp::Direction::kRecv, media.simulcast->direction);
+    ASSERT_EQ(3, media.simulcast->rids.size());
+    ASSERT_EQ("f", media.simulcast->rids[0]);
+    ASSERT_EQ("h", media.simulcast->rids[1]);
+    ASSERT_EQ("q", media.simulcast->rids[2]);
+    ASSERT_NE(std::string::npos, pc.GetLocalSdpStr().find("a=simulcast:recv f;h;q"));
+}
+
+TEST_F(PeerConnectionTest, OfferDemuxExtensions) {
+    PeerConnection pc(
+        PeerConnection::Dependencies{.clock = _clock, .udp_allocator = g_udp_allocator},
+        ClientContext::CreateOptions(ClientContext::Options{}));
+    pc.CreateSdpOffer();
+
+    const auto& media = pc.GetLocalSdp().medias.at(kVideoMediaIdx);
+    ASSERT_TRUE(media.mid_extension_id.has_value());
+    ASSERT_TRUE(media.rid_extension_id.has_value());
+    ASSERT_TRUE(media.repaired_rid_extension_id.has_value());
+    ASSERT_NE(media.mid_extension_id, media.rid_extension_id);
+    ASSERT_NE(media.rid_extension_id, media.repaired_rid_extension_id);
+    ASSERT_NE(media.twcc_extension_id, media.mid_extension_id);
+}
+
 }
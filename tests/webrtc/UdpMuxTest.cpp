@@ -0,0 +1,187 @@
+#include "tau/webrtc/UdpMux.h"
+#include "tau/stun/Writer.h"
+#include "tau/stun/attribute/ByteString.h"
+#include "tests/lib/Common.h"
+
+namespace tau::webrtc {
+
+class UdpMuxTest : public ::testing::Test {
+public:
+    static inline const IpAddress kLocalHost{net::MakeIpAddressV4("127.0.0.1")};
+
+public:
+    UdpMuxTest()
+        : _mux(
+            UdpMux::Dependencies{.clock = _clock, .allocator = g_udp_allocator},
+            UdpMux::Options{
+                .local_address = kLocalHost,
+                .log_ctx = "[mux] "
+            })
+        , _mux_endpoint(_mux.GetLocalEndpoint().value())
+    {
+        for(size_t i = 0; i < _clients.size(); ++i) {
+            _clients[i] = net::UdpSocket::Create(net::UdpSocket::Options{
+                .allocator = g_udp_allocator,
+                .local_address = kLocalHost
+            });
+            _clients[i]->SetRecvCallback([this, i](Buffer&&, Endpoint) {
+                _clients_received[i]++;
+            });
+        }
+        for(size_t i = 0; i < kUfrags.size(); ++i) {
+            EXPECT_TRUE(_mux.Register(kUfrags[i], [this, i](Buffer&& packet, Endpoint remote_endpoint) {
+                _received[i].emplace_back(packet.GetSize(), remote_endpoint);
+            }));
+        }
+    }
+
+protected:
+    static Buffer CreateBindingRequest(etl::string_view user_name) {
+        auto request = Buffer::Create(g_udp_allocator);
+        stun::Writer writer(request.GetViewWithCapacity(), stun::kBindingRequest);
+        stun::attribute::ByteStringWriter::Write(writer, stun::AttributeType::kUserName, user_name);
+        request.SetSize(writer.GetSize());
+        return request;
+    }
+
+    static Buffer CreatePacket(size_t size) {
+        auto packet = Buffer::Create(g_udp_allocator);
+        packet.SetSize(size);
+        std::memset(packet.GetView().ptr, 0x80, size);
+        return packet;
+    }
+
+    void SendAndReceive(size_t client_idx, Buffer&& packet) {
+        const auto packets = _mux.GetStats().packets;
+        _clients[client_idx]->Send(std::move(packet), _mux_endpoint);
+        ASSERT_TRUE(WaitForCondition([&]() {
+            _mux.Receive();
+            return (_mux.GetStats().packets > packets);
+        }, 100 * kMs));
+    }
+
+protected:
+    static inline const etl::array<etl::string_view, 2> kUfrags = {"abcdABCD", "efghEFGH"};
+
+    TestClock _clock;
+    UdpMux _mux;
+    Endpoint _mux_endpoint;
+    etl::array<net::UdpSocketPtr, 2> _clients;
+    etl::array<size_t, 2> _clients_received = {};
+    etl::array<std::vector<std::pair<size_t, Endpoint>>, 2> _received;
+};
+
+TEST_F(UdpMuxTest, Basic) {
+    ASSERT_FALSE(_mux.Register(kUfrags[0], {}));
+    ASSERT_EQ(2, _mux.GetSessionsCount());
+
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(0, CreatePacket(100)));
+    ASSERT_EQ(1, _mux.GetStats().dropped);
+
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(0, CreateBindingRequest("abcdABCD:remote1")));
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(1, CreateBindingRequest("efghEFGH:remote2")));
+    ASSERT_EQ(2, _mux.GetStats().by_ufrag);
+    ASSERT_EQ(0, _mux.GetEndpointsCount()); // not authenticated yet
+    ASSERT_EQ(1, _received[0].size());
+    ASSERT_EQ(1, _received[1].size());
+    ASSERT_EQ(_clients[0]->GetLocalEndpoint().value(), _received[0][0].second);
+    ASSERT_EQ(_clients[1]->GetLocalEndpoint().value(), _received[1][0].second);
+
+    // ICE answers authenticated requests
+    ASSERT_TRUE(_mux.Bind(kUfrags[0], _clients[0]->GetLocalEndpoint().value()));
+    ASSERT_TRUE(_mux.Bind(kUfrags[1], _clients[1]->GetLocalEndpoint().value()));
+    ASSERT_EQ(2, _mux.GetEndpointsCount());
+
+    // bound endpoints are demuxed w/o STUN
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(0, CreatePacket(200)));
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(1, CreatePacket(300)));
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(1, CreateBindingRequest("abcdABCD:remote1")));
+    ASSERT_EQ(2, _received[0].size());
+    ASSERT_EQ(3, _received[1].size());
+    ASSERT_EQ(200, _received[0][1].first);
+    ASSERT_EQ(300, _received[1][1].first);
+
+    _mux.Send(CreatePacket(100), _clients[0]->GetLocalEndpoint().value());
+    _mux.Flush();
+    ASSERT_TRUE(WaitForCondition([&]() {
+        _clients[0]->Receive();
+        return (_clients_received[0] == 1);
+    }, 100 * kMs));
+
+    _mux.Unregister(kUfrags[0]);
+    ASSERT_EQ(1, _mux.GetSessionsCount());
+    ASSERT_EQ(1, _mux.GetEndpointsCount());
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(0, CreatePacket(100)));
+    ASSERT_EQ(2, _mux.GetStats().dropped);
+    ASSERT_EQ(2, _received[0].size());
+}
+
+TEST_F(UdpMuxTest, Bind) {
+    const auto remote = _clients[0]->GetLocalEndpoint().value();
+    ASSERT_FALSE(_mux.Bind("unknown", remote));
+    ASSERT_TRUE(_mux.Bind(kUfrags[1], remote));
+    ASSERT_TRUE(_mux.Bind(kUfrags[1], remote));
+    ASSERT_FALSE(_mux.Bind(kUfrags[0], remote));
+
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(0, CreatePacket(100)));
+    ASSERT_EQ(0, _received[0].size());
+    ASSERT_EQ(1, _received[1].size());
+    ASSERT_EQ(0, _mux.GetStats().by_ufrag);
+}
+
+TEST_F(UdpMuxTest, UnauthenticatedIsNotBound) {
+    for(size_t i = 0; i < 3; ++i) {
+        ASSERT_NO_FATAL_FAILURE(SendAndReceive(0, CreateBindingRequest("abcdABCD:spoofed")));
+    }
+    ASSERT_EQ(3, _mux.GetStats().by_ufrag);
+    ASSERT_EQ(0, _mux.GetEndpointsCount());
+
+    // media from the endpoint isn't accepted
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(0, CreatePacket(100)));
+    ASSERT_EQ(1, _mux.GetStats().dropped);
+    ASSERT_EQ(3, _received[0].size());
+}
+
+TEST_F(UdpMuxTest, Expiration) {
+    const auto remote0 = _clients[0]->GetLocalEndpoint().value();
+    const auto remote1 = _clients[1]->GetLocalEndpoint().value();
+    ASSERT_TRUE(_mux.Bind(kUfrags[0], remote0));
+    ASSERT_TRUE(_mux.Bind(kUfrags[1], remote1));
+
+    _clock.Add(UdpMux::kEndpointTimeout / 2);
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(0, CreatePacket(100))); // keeps remote0
+    _clock.Add(UdpMux::kEndpointTimeout / 2);
+    _mux.Receive();
+    ASSERT_EQ(1, _mux.GetEndpointsCount());
+    ASSERT_EQ(1, _mux.GetStats().expired);
+
+    ASSERT_NO_FATAL_FAILURE(SendAndReceive(1, CreatePacket(100)));
+    ASSERT_EQ(1, _mux.GetStats().dropped);
+    ASSERT_TRUE(_mux.Bind(kUfrags[1], remote1)); // rebound by ICE
+    ASSERT_EQ(2, _mux.GetEndpointsCount());
+}
+
+TEST_F(UdpMuxTest, IsBindable) {
+    auto create_message = [](uint16_t type) {
+        auto message = Buffer::Create(g_udp_allocator);
+        stun::Writer writer(message.GetViewWithCapacity(), type);
+        message.SetSize(writer.GetSize());
+        return message;
+    };
+    ASSERT_FALSE(UdpMux::IsBindable(ToConst(CreateBindingRequest("remote:local").GetView()))); // ICE check
+    ASSERT_TRUE(UdpMux::IsBindable(ToConst(create_message(stun::kBindingRequest).GetView()))); // STUN server
+    ASSERT_TRUE(UdpMux::IsBindable(ToConst(create_message(stun::kBindingResponse).GetView())));
+    ASSERT_FALSE(UdpMux::IsBindable(ToConst(create_message(stun::kBindingErrorResponse).GetView())));
+    ASSERT_FALSE(UdpMux::IsBindable(ToConst(create_message(stun::kBindingIndication).GetView())));
+    ASSERT_TRUE(UdpMux::IsBindable(ToConst(create_message(stun::kAllocateRequest).GetView()))); // TURN server
+}
+
+#ifndef NDEBUG
+TEST_F(UdpMuxTest, SingleThread) {
+    ::testing::GTEST_FLAG(death_test_style) = "threadsafe";
+    _mux.Flush();
+    EXPECT_DEATH(std::thread([this]() { _mux.Flush(); }).join(), "another thread");
+}
+#endif
+
+}